@@ -0,0 +1,582 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define LINEARBUFFERS_DEBUG_NAME "compress"
+
+#include "debug.h"
+#include "compress.h"
+
+#if !defined(MIN)
+#define MIN(a, b)                       ((a) < (b) ? (a) : (b))
+#endif
+
+/*
+ * container:
+ *   header : magic[4], uint32 block_size, uint64 length, uint64 nblocks
+ *   index  : nblocks x { uint64 offset, uint32 length, uint32 flags }
+ *   blocks : each block is either stored as is, or lz compressed
+ *
+ * lz block format is a series of sequences; token high nibble is literal
+ * length, low nibble is match length - 4, both extended with 255 runs,
+ * followed by literals and 16 bit little endian match offset. last
+ * sequence carries literals only.
+ */
+
+#define LINEARBUFFERS_COMPRESS_MAGIC            "LBZ0"
+#define LINEARBUFFERS_COMPRESS_HEADER_SIZE      24
+#define LINEARBUFFERS_COMPRESS_INDEX_SIZE       16
+
+#define LINEARBUFFERS_COMPRESS_FLAG_RAW         0
+#define LINEARBUFFERS_COMPRESS_FLAG_LZ          1
+
+#define LINEARBUFFERS_COMPRESS_HASH_BITS        12
+#define LINEARBUFFERS_COMPRESS_MATCH_MIN        4
+#define LINEARBUFFERS_COMPRESS_MATCH_DISTANCE   65535
+
+struct linearbuffers_decompressor {
+        const uint8_t *buffer;
+        uint64_t length;
+        uint32_t block_size;
+        uint64_t dlength;
+        uint64_t nblocks;
+        const uint8_t *index;
+        uint8_t **blocks;
+        uint64_t *cache;
+        uint64_t ncache;
+        uint64_t ucache;
+        uint64_t pcache;
+        uint8_t *scratch;
+        uint64_t sscratch;
+};
+
+static inline uint32_t linearbuffers_read32 (const uint8_t *buffer)
+{
+        uint32_t value;
+        memcpy(&value, buffer, sizeof(value));
+        return value;
+}
+
+static inline uint32_t linearbuffers_compress_hash (uint32_t value)
+{
+        return (value * 2654435761U) >> (32 - LINEARBUFFERS_COMPRESS_HASH_BITS);
+}
+
+static inline int linearbuffers_compress_length (uint8_t **op, uint8_t *oend, uint64_t length)
+{
+        while (length >= 255) {
+                if (*op >= oend) {
+                        return -1;
+                }
+                *(*op)++ = 255;
+                length -= 255;
+        }
+        if (*op >= oend) {
+                return -1;
+        }
+        *(*op)++ = length;
+        return 0;
+}
+
+static int linearbuffers_compress_sequence (uint8_t **op, uint8_t *oend, const uint8_t *literals, uint64_t nliterals, uint64_t offset, uint64_t nmatch)
+{
+        uint8_t *token;
+        if (*op >= oend) {
+                return -1;
+        }
+        token = (*op)++;
+        *token = MIN(nliterals, 15) << 4;
+        if (nliterals >= 15) {
+                if (linearbuffers_compress_length(op, oend, nliterals - 15) != 0) {
+                        return -1;
+                }
+        }
+        if ((uint64_t) (oend - *op) < nliterals) {
+                return -1;
+        }
+        memcpy(*op, literals, nliterals);
+        *op += nliterals;
+        if (nmatch == 0) {
+                return 0;
+        }
+        nmatch -= LINEARBUFFERS_COMPRESS_MATCH_MIN;
+        *token |= MIN(nmatch, 15);
+        if (oend - *op < 2) {
+                return -1;
+        }
+        *(*op)++ = offset & 0xff;
+        *(*op)++ = (offset >> 8) & 0xff;
+        if (nmatch >= 15) {
+                if (linearbuffers_compress_length(op, oend, nmatch - 15) != 0) {
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+static uint64_t linearbuffers_compress_block (const uint8_t *src, uint64_t slength, uint8_t *dst, uint64_t dlength)
+{
+        uint64_t ip;
+        uint64_t ref;
+        uint64_t anchor;
+        uint64_t nmatch;
+        uint32_t hash;
+        uint32_t sequence;
+        uint8_t *op;
+        uint8_t *oend;
+        uint32_t table[1 << LINEARBUFFERS_COMPRESS_HASH_BITS];
+
+        memset(table, 0, sizeof(table));
+        op = dst;
+        oend = dst + dlength;
+        ip = 0;
+        anchor = 0;
+        while (slength >= LINEARBUFFERS_COMPRESS_MATCH_MIN && ip <= slength - LINEARBUFFERS_COMPRESS_MATCH_MIN) {
+                sequence = linearbuffers_read32(src + ip);
+                hash = linearbuffers_compress_hash(sequence);
+                ref = table[hash];
+                table[hash] = ip;
+                if (ref >= ip ||
+                    ip - ref > LINEARBUFFERS_COMPRESS_MATCH_DISTANCE ||
+                    linearbuffers_read32(src + ref) != sequence) {
+                        ip += 1;
+                        continue;
+                }
+                nmatch = LINEARBUFFERS_COMPRESS_MATCH_MIN;
+                while (ip + nmatch < slength && src[ref + nmatch] == src[ip + nmatch]) {
+                        nmatch += 1;
+                }
+                if (linearbuffers_compress_sequence(&op, oend, src + anchor, ip - anchor, ip - ref, nmatch) != 0) {
+                        return 0;
+                }
+                ip += nmatch;
+                anchor = ip;
+        }
+        if (linearbuffers_compress_sequence(&op, oend, src + anchor, slength - anchor, 0, 0) != 0) {
+                return 0;
+        }
+        return op - dst;
+}
+
+static inline int linearbuffers_decompress_length (const uint8_t **ip, const uint8_t *iend, uint64_t *length)
+{
+        uint8_t byte;
+        do {
+                if (*ip >= iend) {
+                        return -1;
+                }
+                byte = *(*ip)++;
+                *length += byte;
+        } while (byte == 255);
+        return 0;
+}
+
+static int linearbuffers_decompress_block (const uint8_t *src, uint64_t slength, uint8_t *dst, uint64_t dlength)
+{
+        uint8_t token;
+        uint64_t offset;
+        uint64_t nliterals;
+        uint64_t nmatch;
+        const uint8_t *ip;
+        const uint8_t *iend;
+        uint8_t *op;
+        uint8_t *oend;
+
+        ip = src;
+        iend = src + slength;
+        op = dst;
+        oend = dst + dlength;
+        while (ip < iend) {
+                token = *ip++;
+                nliterals = token >> 4;
+                if (nliterals == 15) {
+                        if (linearbuffers_decompress_length(&ip, iend, &nliterals) != 0) {
+                                return -1;
+                        }
+                }
+                if ((uint64_t) (iend - ip) < nliterals ||
+                    (uint64_t) (oend - op) < nliterals) {
+                        return -1;
+                }
+                memcpy(op, ip, nliterals);
+                ip += nliterals;
+                op += nliterals;
+                if (ip == iend) {
+                        break;
+                }
+                if (iend - ip < 2) {
+                        return -1;
+                }
+                offset = ip[0] | (ip[1] << 8);
+                ip += 2;
+                nmatch = token & 0x0f;
+                if (nmatch == 15) {
+                        if (linearbuffers_decompress_length(&ip, iend, &nmatch) != 0) {
+                                return -1;
+                        }
+                }
+                nmatch += LINEARBUFFERS_COMPRESS_MATCH_MIN;
+                if (offset == 0 ||
+                    offset > (uint64_t) (op - dst) ||
+                    (uint64_t) (oend - op) < nmatch) {
+                        return -1;
+                }
+                while (nmatch--) {
+                        *op = *(op - offset);
+                        op++;
+                }
+        }
+        return (op == oend) ? 0 : -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_compress (const void *buffer, uint64_t length, struct linearbuffers_compress_options *options, void **compressed, uint64_t *clength)
+{
+        uint64_t b;
+        uint64_t nblocks;
+        uint64_t offset;
+        uint64_t slength;
+        uint64_t dlength;
+        uint32_t flags;
+        uint32_t block_size;
+        uint32_t entry[2];
+        uint8_t *output;
+        uint8_t *tmp;
+        const uint8_t *src;
+
+        output = NULL;
+        if (buffer == NULL && length != 0) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        if (compressed == NULL) {
+                linearbuffers_errorf("compressed is invalid");
+                goto bail;
+        }
+        block_size = LINEARBUFFERS_COMPRESS_BLOCK_SIZE_DEFAULT;
+        if (options != NULL &&
+            options->block_size != 0) {
+                block_size = options->block_size;
+        }
+        src = buffer;
+        nblocks = (length + block_size - 1) / block_size;
+        output = malloc(LINEARBUFFERS_COMPRESS_HEADER_SIZE + nblocks * LINEARBUFFERS_COMPRESS_INDEX_SIZE + length);
+        if (output == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memcpy(output, LINEARBUFFERS_COMPRESS_MAGIC, 4);
+        memcpy(output + 4, &block_size, sizeof(uint32_t));
+        memcpy(output + 8, &length, sizeof(uint64_t));
+        memcpy(output + 16, &nblocks, sizeof(uint64_t));
+        offset = LINEARBUFFERS_COMPRESS_HEADER_SIZE + nblocks * LINEARBUFFERS_COMPRESS_INDEX_SIZE;
+        for (b = 0; b < nblocks; b++) {
+                slength = MIN(block_size, length - b * block_size);
+                dlength = linearbuffers_compress_block(src + b * block_size, slength, output + offset, slength - 1);
+                if (dlength == 0) {
+                        memcpy(output + offset, src + b * block_size, slength);
+                        dlength = slength;
+                        flags = LINEARBUFFERS_COMPRESS_FLAG_RAW;
+                } else {
+                        flags = LINEARBUFFERS_COMPRESS_FLAG_LZ;
+                }
+                entry[0] = dlength;
+                entry[1] = flags;
+                memcpy(output + LINEARBUFFERS_COMPRESS_HEADER_SIZE + b * LINEARBUFFERS_COMPRESS_INDEX_SIZE, &offset, sizeof(uint64_t));
+                memcpy(output + LINEARBUFFERS_COMPRESS_HEADER_SIZE + b * LINEARBUFFERS_COMPRESS_INDEX_SIZE + 8, entry, sizeof(entry));
+                offset += dlength;
+        }
+        tmp = realloc(output, offset);
+        if (tmp != NULL) {
+                output = tmp;
+        }
+        *compressed = output;
+        if (clength != NULL) {
+                *clength = offset;
+        }
+        return 0;
+bail:   if (output != NULL) {
+                free(output);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) void * linearbuffers_decompress (const void *buffer, uint64_t length, uint64_t *dlength)
+{
+        uint8_t *output;
+        struct linearbuffers_decompressor *decompressor;
+        struct linearbuffers_decompressor_create_options options;
+
+        output = NULL;
+        decompressor = NULL;
+        memset(&options, 0, sizeof(struct linearbuffers_decompressor_create_options));
+        options.cache = 1;
+        decompressor = linearbuffers_decompressor_create(buffer, length, &options);
+        if (decompressor == NULL) {
+                linearbuffers_errorf("can not create decompressor");
+                goto bail;
+        }
+        output = malloc(decompressor->dlength + 1);
+        if (output == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        if (linearbuffers_decompressor_read(decompressor, 0, output, decompressor->dlength) != 0) {
+                linearbuffers_errorf("can not read buffer");
+                goto bail;
+        }
+        if (dlength != NULL) {
+                *dlength = decompressor->dlength;
+        }
+        linearbuffers_decompressor_destroy(decompressor);
+        return output;
+bail:   if (decompressor != NULL) {
+                linearbuffers_decompressor_destroy(decompressor);
+        }
+        if (output != NULL) {
+                free(output);
+        }
+        return NULL;
+}
+
+__attribute__ ((__visibility__("default"))) void linearbuffers_decompressor_destroy (struct linearbuffers_decompressor *decompressor)
+{
+        uint64_t b;
+        if (decompressor == NULL) {
+                return;
+        }
+        if (decompressor->blocks != NULL) {
+                for (b = 0; b < decompressor->nblocks; b++) {
+                        if (decompressor->blocks[b] != NULL) {
+                                free(decompressor->blocks[b]);
+                        }
+                }
+                free(decompressor->blocks);
+        }
+        if (decompressor->cache != NULL) {
+                free(decompressor->cache);
+        }
+        if (decompressor->scratch != NULL) {
+                free(decompressor->scratch);
+        }
+        free(decompressor);
+}
+
+__attribute__ ((__visibility__("default"))) struct linearbuffers_decompressor * linearbuffers_decompressor_create (const void *buffer, uint64_t length, struct linearbuffers_decompressor_create_options *options)
+{
+        uint64_t b;
+        uint64_t offset;
+        uint32_t entry[2];
+        struct linearbuffers_decompressor *decompressor;
+
+        decompressor = NULL;
+        if (buffer == NULL ||
+            length < LINEARBUFFERS_COMPRESS_HEADER_SIZE ||
+            memcmp(buffer, LINEARBUFFERS_COMPRESS_MAGIC, 4) != 0) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        decompressor = malloc(sizeof(struct linearbuffers_decompressor));
+        if (decompressor == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(decompressor, 0, sizeof(struct linearbuffers_decompressor));
+        decompressor->buffer = buffer;
+        decompressor->length = length;
+        memcpy(&decompressor->block_size, decompressor->buffer + 4, sizeof(uint32_t));
+        memcpy(&decompressor->dlength, decompressor->buffer + 8, sizeof(uint64_t));
+        memcpy(&decompressor->nblocks, decompressor->buffer + 16, sizeof(uint64_t));
+        if (decompressor->block_size == 0 ||
+            decompressor->nblocks != (decompressor->dlength + decompressor->block_size - 1) / decompressor->block_size ||
+            decompressor->nblocks > (length - LINEARBUFFERS_COMPRESS_HEADER_SIZE) / LINEARBUFFERS_COMPRESS_INDEX_SIZE) {
+                linearbuffers_errorf("header is invalid");
+                goto bail;
+        }
+        decompressor->index = decompressor->buffer + LINEARBUFFERS_COMPRESS_HEADER_SIZE;
+        for (b = 0; b < decompressor->nblocks; b++) {
+                memcpy(&offset, decompressor->index + b * LINEARBUFFERS_COMPRESS_INDEX_SIZE, sizeof(uint64_t));
+                memcpy(entry, decompressor->index + b * LINEARBUFFERS_COMPRESS_INDEX_SIZE + 8, sizeof(entry));
+                if (offset > length ||
+                    entry[0] > length - offset ||
+                    entry[1] > LINEARBUFFERS_COMPRESS_FLAG_LZ) {
+                        linearbuffers_errorf("index is invalid");
+                        goto bail;
+                }
+        }
+        decompressor->ncache = LINEARBUFFERS_DECOMPRESSOR_CACHE_DEFAULT;
+        if (options != NULL &&
+            options->cache != 0) {
+                decompressor->ncache = options->cache;
+        }
+        decompressor->blocks = calloc(decompressor->nblocks + 1, sizeof(uint8_t *));
+        decompressor->cache = calloc(decompressor->ncache, sizeof(uint64_t));
+        if (decompressor->blocks == NULL ||
+            decompressor->cache == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        return decompressor;
+bail:   if (decompressor != NULL) {
+                linearbuffers_decompressor_destroy(decompressor);
+        }
+        return NULL;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_decompressor_length (struct linearbuffers_decompressor *decompressor)
+{
+        if (decompressor == NULL) {
+                return 0;
+        }
+        return decompressor->dlength;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_decompressor_block_size (struct linearbuffers_decompressor *decompressor)
+{
+        if (decompressor == NULL) {
+                return 0;
+        }
+        return decompressor->block_size;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_decompressor_block_count (struct linearbuffers_decompressor *decompressor)
+{
+        if (decompressor == NULL) {
+                return 0;
+        }
+        return decompressor->nblocks;
+}
+
+__attribute__ ((__visibility__("default"))) const void * linearbuffers_decompressor_block (struct linearbuffers_decompressor *decompressor, uint64_t block, uint64_t *length)
+{
+        uint64_t offset;
+        uint64_t dlength;
+        uint32_t entry[2];
+        uint8_t *output;
+
+        output = NULL;
+        if (decompressor == NULL) {
+                linearbuffers_errorf("decompressor is invalid");
+                goto bail;
+        }
+        if (block >= decompressor->nblocks) {
+                linearbuffers_errorf("block is invalid");
+                goto bail;
+        }
+        dlength = MIN(decompressor->block_size, decompressor->dlength - block * decompressor->block_size);
+        if (length != NULL) {
+                *length = dlength;
+        }
+        memcpy(&offset, decompressor->index + block * LINEARBUFFERS_COMPRESS_INDEX_SIZE, sizeof(uint64_t));
+        memcpy(entry, decompressor->index + block * LINEARBUFFERS_COMPRESS_INDEX_SIZE + 8, sizeof(entry));
+        if (entry[1] == LINEARBUFFERS_COMPRESS_FLAG_RAW) {
+                if (entry[0] != dlength) {
+                        linearbuffers_errorf("block is invalid");
+                        goto bail;
+                }
+                return decompressor->buffer + offset;
+        }
+        if (decompressor->blocks[block] != NULL) {
+                return decompressor->blocks[block];
+        }
+        output = malloc(dlength);
+        if (output == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        if (linearbuffers_decompress_block(decompressor->buffer + offset, entry[0], output, dlength) != 0) {
+                linearbuffers_errorf("can not decompress block: %" PRIu64 "", block);
+                goto bail;
+        }
+        if (decompressor->ucache == decompressor->ncache) {
+                free(decompressor->blocks[decompressor->cache[decompressor->pcache]]);
+                decompressor->blocks[decompressor->cache[decompressor->pcache]] = NULL;
+        } else {
+                decompressor->ucache += 1;
+        }
+        decompressor->blocks[block] = output;
+        decompressor->cache[decompressor->pcache] = block;
+        decompressor->pcache = (decompressor->pcache + 1) % decompressor->ncache;
+        return output;
+bail:   if (output != NULL) {
+                free(output);
+        }
+        return NULL;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_decompressor_read (struct linearbuffers_decompressor *decompressor, uint64_t offset, void *buffer, uint64_t length)
+{
+        uint64_t b;
+        uint64_t o;
+        uint64_t l;
+        uint64_t blength;
+        const uint8_t *block;
+
+        if (decompressor == NULL) {
+                linearbuffers_errorf("decompressor is invalid");
+                goto bail;
+        }
+        if (offset > decompressor->dlength ||
+            length > decompressor->dlength - offset) {
+                linearbuffers_errorf("range is invalid");
+                goto bail;
+        }
+        while (length > 0) {
+                b = offset / decompressor->block_size;
+                o = offset % decompressor->block_size;
+                block = linearbuffers_decompressor_block(decompressor, b, &blength);
+                if (block == NULL) {
+                        linearbuffers_errorf("can not get block");
+                        goto bail;
+                }
+                l = MIN(length, blength - o);
+                memcpy(buffer, block + o, l);
+                buffer = ((uint8_t *) buffer) + l;
+                offset += l;
+                length -= l;
+        }
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) const void * linearbuffers_decompressor_range (struct linearbuffers_decompressor *decompressor, uint64_t offset, uint64_t length)
+{
+        uint8_t *tmp;
+        const uint8_t *block;
+
+        if (decompressor == NULL) {
+                linearbuffers_errorf("decompressor is invalid");
+                goto bail;
+        }
+        if (offset > decompressor->dlength ||
+            length > decompressor->dlength - offset) {
+                linearbuffers_errorf("range is invalid");
+                goto bail;
+        }
+        if (length > 0 &&
+            offset / decompressor->block_size == (offset + length - 1) / decompressor->block_size) {
+                block = linearbuffers_decompressor_block(decompressor, offset / decompressor->block_size, NULL);
+                if (block == NULL) {
+                        linearbuffers_errorf("can not get block");
+                        goto bail;
+                }
+                return block + (offset % decompressor->block_size);
+        }
+        if (decompressor->sscratch < length + 1) {
+                tmp = realloc(decompressor->scratch, length + 1);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                decompressor->scratch = tmp;
+                decompressor->sscratch = length + 1;
+        }
+        if (linearbuffers_decompressor_read(decompressor, offset, decompressor->scratch, length) != 0) {
+                linearbuffers_errorf("can not read range");
+                goto bail;
+        }
+        return decompressor->scratch;
+bail:   return NULL;
+}
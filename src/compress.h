@@ -0,0 +1,49 @@
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if !defined(LINEARBUFFERS_COMPRESS_H)
+#define LINEARBUFFERS_COMPRESS_H
+
+struct linearbuffers_decompressor;
+
+#define LINEARBUFFERS_COMPRESS_BLOCK_SIZE_DEFAULT	(64 * 1024)
+#define LINEARBUFFERS_DECOMPRESSOR_CACHE_DEFAULT	4
+
+struct linearbuffers_compress_options {
+	uint32_t block_size;
+};
+
+struct linearbuffers_decompressor_create_options {
+	uint64_t cache;
+};
+
+int linearbuffers_compress (const void *buffer, uint64_t length, struct linearbuffers_compress_options *options, void **compressed, uint64_t *clength);
+void * linearbuffers_decompress (const void *buffer, uint64_t length, uint64_t *dlength);
+
+struct linearbuffers_decompressor * linearbuffers_decompressor_create (const void *buffer, uint64_t length, struct linearbuffers_decompressor_create_options *options);
+void linearbuffers_decompressor_destroy (struct linearbuffers_decompressor *decompressor);
+
+uint64_t linearbuffers_decompressor_length (struct linearbuffers_decompressor *decompressor);
+uint64_t linearbuffers_decompressor_block_size (struct linearbuffers_decompressor *decompressor);
+uint64_t linearbuffers_decompressor_block_count (struct linearbuffers_decompressor *decompressor);
+
+/*
+ * pointers returned by _block and _range are borrowed from the
+ * decompressor and are valid only until the next _block, _range or _read
+ * call on it, or until it is destroyed. a decompressed block lives in a
+ * small cache and is freed when evicted, and a range crossing a block
+ * boundary is assembled in a scratch buffer that the next call reuses.
+ * callers holding data across calls must copy it out, or use _read to
+ * decompress straight into their own buffer.
+ */
+const void * linearbuffers_decompressor_block (struct linearbuffers_decompressor *decompressor, uint64_t block, uint64_t *length);
+const void * linearbuffers_decompressor_range (struct linearbuffers_decompressor *decompressor, uint64_t offset, uint64_t length);
+int linearbuffers_decompressor_read (struct linearbuffers_decompressor *decompressor, uint64_t offset, void *buffer, uint64_t length);
+
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
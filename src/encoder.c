@@ -156,11 +156,25 @@ enum linearbuffers_entry_type {
         linearbuffers_entry_type_unknown,
         linearbuffers_entry_type_table,
         linearbuffers_entry_type_vector,
+        linearbuffers_entry_type_map,
+};
+
+struct linearbuffers_entry_table_slot {
+        uint64_t offset;
+        uint64_t size;
+        int referenced;
+        uint64_t reference;
+        uint64_t value;
 };
 
 struct linearbuffers_entry_table {
         uint64_t elements;
         struct linearbuffers_present_table present;
+        int compact;
+        int root;
+        uint64_t size;
+        uint8_t *buffer;
+        struct linearbuffers_entry_table_slot *slots;
 };
 
 enum linearbuffers_vector_type {
@@ -176,14 +190,32 @@ enum linearbuffers_vector_type {
         linearbuffers_vector_type_double,
         linearbuffers_vector_type_string,
         linearbuffers_vector_type_table,
+        linearbuffers_vector_type_struct,
 };
 
 struct linearbuffers_entry_vector {
         enum linearbuffers_vector_type type;
         uint64_t elements;
+        uint64_t size;
         struct linearbuffers_offset_table offset;
 };
 
+struct linearbuffers_entry_map {
+        uint64_t elements;
+        uint64_t size;
+        uint64_t key_size;
+        int key_reference;
+        uint64_t value_size;
+        int value_reference;
+        uint64_t *hashes;
+        uint8_t *keys;
+        uint8_t *values;
+        uint64_t *spans;
+        uint8_t *bytes;
+        uint64_t bytes_length;
+        uint64_t bytes_size;
+};
+
 TAILQ_HEAD(linearbuffers_entries, linearbuffers_entry);
 struct linearbuffers_entry {
         TAILQ_ENTRY(linearbuffers_entry) entries;
@@ -191,6 +223,7 @@ struct linearbuffers_entry {
         union {
                 struct linearbuffers_entry_table table;
                 struct linearbuffers_entry_vector vector;
+                struct linearbuffers_entry_map map;
         } u;
         uint64_t count_size;
         int (*count_emitter) (int (*function) (void *context, uint64_t offset, const void *buffer, int64_t length), void *context, uint64_t offset, uint64_t value);
@@ -203,6 +236,7 @@ struct linearbuffers_encoder {
         struct linearbuffers_entries entries;
         struct {
                 int (*function) (void *context, uint64_t offset, const void *buffer, int64_t length);
+                int (*reference) (void *context, uint64_t offset, const void *buffer, int64_t length);
                 void *context;
                 uint64_t offset;
         } emitter;
@@ -408,6 +442,21 @@ static int linearbuffers_present_table_mark (struct linearbuffers_present_table
         return 0;
 }
 
+static int linearbuffers_present_table_unmark (struct linearbuffers_present_table *table, uint64_t element)
+{
+        uint64_t byte;
+        uint64_t buffer;
+        struct linearbuffers_present_buffer *present_buffer;
+        byte = element / 8;
+        buffer = byte / LINEARBUFFERS_PRESENT_BUFFER_COUNT;
+        present_buffer = table->buffers;
+        while (buffer--) {
+                present_buffer = present_buffer->next;
+        }
+        present_buffer->buffer[byte % LINEARBUFFERS_PRESENT_BUFFER_COUNT] &= ~(1 << (element % 8));
+        return 0;
+}
+
 static void linearbuffers_present_table_uninit (struct linearbuffers_pool *pool, struct linearbuffers_present_table *table)
 {
         struct linearbuffers_present_buffer *buffer;
@@ -442,6 +491,35 @@ bail:   linearbuffers_present_table_uninit(pool, table);
         return -1;
 }
 
+static int linearbuffers_entry_table_store (struct linearbuffers_entry *entry, uint64_t element, uint64_t offset, const void *value, uint64_t size)
+{
+        struct linearbuffers_entry_table_slot *slot;
+        if (offset + size > entry->u.table.size) {
+                linearbuffers_errorf("logic error: offset is invalid");
+                return -1;
+        }
+        if (value != NULL) {
+                memcpy(entry->u.table.buffer + offset, value, size);
+        }
+        slot = &entry->u.table.slots[element];
+        slot->offset = offset;
+        slot->size = size;
+        slot->referenced = 0;
+        slot->reference = 0;
+        slot->value = 0;
+        return 0;
+}
+
+static int linearbuffers_entry_table_reference (struct linearbuffers_entry *entry, uint64_t element, uint64_t reference, uint64_t value)
+{
+        struct linearbuffers_entry_table_slot *slot;
+        slot = &entry->u.table.slots[element];
+        slot->referenced = 1;
+        slot->reference = reference;
+        slot->value = value;
+        return 0;
+}
+
 static void linearbuffers_entry_destroy (struct linearbuffers_pool *epool, struct linearbuffers_pool *ppool, struct linearbuffers_pool *opool, struct linearbuffers_entry *entry)
 {
         if (entry == NULL) {
@@ -449,12 +527,39 @@ static void linearbuffers_entry_destroy (struct linearbuffers_pool *epool, struc
         }
         if (entry->type == linearbuffers_entry_type_table) {
                 linearbuffers_present_table_uninit(ppool, &entry->u.table.present);
+                if (entry->u.table.buffer != NULL) {
+                        free(entry->u.table.buffer);
+                }
         } else if (entry->type == linearbuffers_entry_type_vector) {
                 linearbuffers_offset_table_uninit(opool, &entry->u.vector.offset);
+        } else if (entry->type == linearbuffers_entry_type_map) {
+                if (entry->u.map.hashes != NULL) {
+                        free(entry->u.map.hashes);
+                }
+                if (entry->u.map.keys != NULL) {
+                        free(entry->u.map.keys);
+                }
+                if (entry->u.map.values != NULL) {
+                        free(entry->u.map.values);
+                }
+                if (entry->u.map.spans != NULL) {
+                        free(entry->u.map.spans);
+                }
+                if (entry->u.map.bytes != NULL) {
+                        free(entry->u.map.bytes);
+                }
         }
         linearbuffers_pool_free(epool, entry);
 }
 
+static int linearbuffers_encoder_reference (struct linearbuffers_encoder *encoder, uint64_t offset, const void *buffer, int64_t length)
+{
+        if (encoder->emitter.reference != NULL) {
+                return encoder->emitter.reference(encoder->emitter.context, offset, buffer, length);
+        }
+        return encoder->emitter.function(encoder->emitter.context, offset, buffer, length);
+}
+
 __attribute__ ((__visibility__("default"))) const void * linearbuffers_encoder_linearized (struct linearbuffers_encoder *encoder, uint64_t *length)
 {
         if (encoder == NULL) {
@@ -486,6 +591,7 @@ __attribute__ ((__visibility__("default"))) struct linearbuffers_encoder * linea
         if (options != NULL) {
                 if (options->emitter.function != NULL) {
                         encoder->emitter.function = options->emitter.function;
+                        encoder->emitter.reference = options->emitter.reference;
                         encoder->emitter.context = options->emitter.context;
                 }
         }
@@ -530,11 +636,13 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_reset (str
         }
         encoder->emitter.offset = 0;
         encoder->emitter.function = linearbuffers_encoder_default_emitter;
+        encoder->emitter.reference = NULL;
         encoder->emitter.context = encoder;
         encoder->output.length = 0;
         if (options != NULL) {
                 if (options->emitter.function != NULL) {
                         encoder->emitter.function = options->emitter.function;
+                        encoder->emitter.reference = options->emitter.reference;
                         encoder->emitter.context = options->emitter.context;
                 }
         }
@@ -542,7 +650,7 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_reset (str
 bail:   return -1;
 }
 
-__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_start (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size)
+static int linearbuffers_encoder_table_start_layout (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size, int compact)
 {
         int rc;
         struct linearbuffers_entry *entry;
@@ -569,13 +677,35 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_star
                 linearbuffers_errorf("can not init table present");
                 goto bail;
         }
-        linearbuffers_debugf("creating table, size: (count_size: %" PRIi64 " + present_bytes: %" PRIi64 " + size:  %" PRIi64 ") = %" PRIi64 "", entry->count_size, entry->u.table.present.bytes, size, entry->count_size + entry->u.table.present.bytes + size);
-        rc = encoder->emitter.function(encoder->emitter.context, entry->offset, NULL, entry->count_size + entry->u.table.present.bytes + size);
-        if (rc != 0) {
-                linearbuffers_errorf("can not emit table space");
-                goto bail;
+        if (compact) {
+                entry->u.table.compact = 1;
+                entry->u.table.size = size;
+                entry->u.table.buffer = malloc(((size + 7) & ~7ULL) + sizeof(struct linearbuffers_entry_table_slot) * elements);
+                if (entry->u.table.buffer == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                entry->u.table.slots = (struct linearbuffers_entry_table_slot *) (entry->u.table.buffer + ((size + 7) & ~7ULL));
+                memset(entry->u.table.slots, 0, sizeof(struct linearbuffers_entry_table_slot) * elements);
+                if (TAILQ_EMPTY(&encoder->entries)) {
+                        linearbuffers_debugf("creating compact root, size: (offset_size: %" PRIi64 ")", entry->offset_size);
+                        rc = encoder->emitter.function(encoder->emitter.context, entry->offset, NULL, entry->offset_size);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not emit table root");
+                                goto bail;
+                        }
+                        encoder->emitter.offset += entry->offset_size;
+                        entry->u.table.root = 1;
+                }
+        } else {
+                linearbuffers_debugf("creating table, size: (count_size: %" PRIi64 " + present_bytes: %" PRIi64 " + size:  %" PRIi64 ") = %" PRIi64 "", entry->count_size, entry->u.table.present.bytes, size, entry->count_size + entry->u.table.present.bytes + size);
+                rc = encoder->emitter.function(encoder->emitter.context, entry->offset, NULL, entry->count_size + entry->u.table.present.bytes + size);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit table space");
+                        goto bail;
+                }
+                encoder->emitter.offset += entry->count_size + entry->u.table.present.bytes + size;
         }
-        encoder->emitter.offset += entry->count_size + entry->u.table.present.bytes + size;
         TAILQ_INSERT_TAIL(&encoder->entries, entry, entries);
         return 0;
 bail:   if (entry != NULL) {
@@ -584,13 +714,27 @@ bail:   if (entry != NULL) {
         return -1;
 }
 
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_start (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size)
+{
+        return linearbuffers_encoder_table_start_layout(encoder, count_type, offset_type, elements, size, 0);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_start_compact (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size)
+{
+        return linearbuffers_encoder_table_start_layout(encoder, count_type, offset_type, elements, size, 1);
+}
+
 __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_end (struct linearbuffers_encoder *encoder, uint64_t *offset)
 {
         int rc;
         struct linearbuffers_entry *entry;
+        uint64_t table;
+        uint64_t element;
+        uint64_t position;
         uint64_t present_bytes;
         uint64_t present_bufferi;
         struct linearbuffers_present_buffer *present_buffer;
+        struct linearbuffers_entry_table_slot *slot;
         if (encoder == NULL) {
                 linearbuffers_errorf("encoder is invalid");
                 goto bail;
@@ -608,10 +752,11 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_end
                 linearbuffers_errorf("logic error: entry type is not table");
                 goto bail;
         }
+        table = (entry->u.table.compact) ? encoder->emitter.offset : entry->offset;
         if (offset != NULL) {
-                *offset = entry->offset;
+                *offset = table;
         }
-        rc = entry->count_emitter(encoder->emitter.function, encoder->emitter.context, entry->offset, entry->u.table.elements);
+        rc = entry->count_emitter(encoder->emitter.function, encoder->emitter.context, table, entry->u.table.elements);
         if (rc != 0) {
                 linearbuffers_errorf("can not emit table count");
                 goto bail;
@@ -619,12 +764,42 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_end
         for (present_bufferi = 0 , present_bytes = entry->u.table.present.bytes, present_buffer = entry->u.table.present.buffers;
              present_buffer;
              present_bufferi += 1, present_bytes -= LINEARBUFFERS_PRESENT_BUFFER_COUNT       , present_buffer = present_buffer->next) {
-                rc = encoder->emitter.function(encoder->emitter.context, entry->offset + entry->count_size + present_bufferi * LINEARBUFFERS_PRESENT_BUFFER_COUNT, present_buffer->buffer, MIN(present_bytes, LINEARBUFFERS_PRESENT_BUFFER_COUNT));
+                rc = encoder->emitter.function(encoder->emitter.context, table + entry->count_size + present_bufferi * LINEARBUFFERS_PRESENT_BUFFER_COUNT, present_buffer->buffer, MIN(present_bytes, LINEARBUFFERS_PRESENT_BUFFER_COUNT));
                 if (rc != 0) {
                         linearbuffers_errorf("can not emit table present");
                         goto bail;
                 }
         }
+        if (entry->u.table.compact) {
+                position = table + entry->count_size + entry->u.table.present.bytes;
+                for (element = 0; element < entry->u.table.elements; element++) {
+                        slot = &entry->u.table.slots[element];
+                        if (slot->size == 0) {
+                                continue;
+                        }
+                        rc = encoder->emitter.function(encoder->emitter.context, position, entry->u.table.buffer + slot->offset, slot->size);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not emit table element");
+                                goto bail;
+                        }
+                        if (slot->referenced) {
+                                rc = entry->offset_emitter(encoder->emitter.function, encoder->emitter.context, position + slot->reference, table - slot->value);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not emit table element offset");
+                                        goto bail;
+                                }
+                        }
+                        position += slot->size;
+                }
+                encoder->emitter.offset = position;
+                if (entry->u.table.root) {
+                        rc = entry->offset_emitter(encoder->emitter.function, encoder->emitter.context, entry->offset, table - entry->offset);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not emit table root");
+                                goto bail;
+                        }
+                }
+        }
         TAILQ_REMOVE(&encoder->entries, entry, entries);
         linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
         return 0;
@@ -690,7 +865,11 @@ bail:   return -1;
                         linearbuffers_errorf("logic error: element is invalid"); \
                         goto bail; \
                 } \
-                rc = encoder->emitter.function(encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, &value, sizeof(__type_t__)); \
+                if (parent->u.table.compact) { \
+                        rc = linearbuffers_entry_table_store(parent, element, offset, &value, sizeof(__type_t__)); \
+                } else { \
+                        rc = encoder->emitter.function(encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, &value, sizeof(__type_t__)); \
+                } \
                 if (rc != 0) { \
                         linearbuffers_errorf("can not emit table element"); \
                         goto bail; \
@@ -717,6 +896,44 @@ linearbuffers_encoder_table_set_scalar_type(uint64, uint64_t);
 linearbuffers_encoder_table_set_scalar_type(float, float);
 linearbuffers_encoder_table_set_scalar_type(double, double);
 
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_unset (struct linearbuffers_encoder *encoder, uint64_t element)
+{
+        int rc;
+        struct linearbuffers_entry *parent;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        parent = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (parent == NULL) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (parent->type != linearbuffers_entry_type_table) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (element >= parent->u.table.elements) {
+                linearbuffers_errorf("logic error: element is invalid");
+                goto bail;
+        }
+        if (parent->u.table.compact) {
+                parent->u.table.slots[element].size = 0;
+                parent->u.table.slots[element].referenced = 0;
+        }
+        rc = linearbuffers_present_table_unmark(&parent->u.table.present, element);
+        if (rc != 0) {
+                linearbuffers_errorf("can not unmark table element");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
+
 #define linearbuffers_encoder_table_set_type(__type__) \
         __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_set_ ## __type__ (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint64_t value) \
         { \
@@ -747,7 +964,12 @@ linearbuffers_encoder_table_set_scalar_type(double, double);
                         linearbuffers_errorf("logic error: element is invalid"); \
                         goto bail; \
                 } \
-                rc = parent->offset_emitter(encoder->emitter.function, encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, value - parent->offset); \
+                if (parent->u.table.compact) { \
+                        rc  = linearbuffers_entry_table_store(parent, element, offset, NULL, parent->offset_size); \
+                        rc |= linearbuffers_entry_table_reference(parent, element, 0, value); \
+                } else { \
+                        rc = parent->offset_emitter(encoder->emitter.function, encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, value - parent->offset); \
+                } \
                 if (rc != 0) { \
                         linearbuffers_errorf("can not emit table element offset"); \
                         goto bail; \
@@ -764,19 +986,16 @@ linearbuffers_encoder_table_set_scalar_type(double, double);
 linearbuffers_encoder_table_set_type(string);
 linearbuffers_encoder_table_set_type(table);
 linearbuffers_encoder_table_set_type(vector);
+linearbuffers_encoder_table_set_type(map);
 
-__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_create (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value)
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_set_struct (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, const void *value, uint64_t size)
 {
         int rc;
-        uint64_t length;
+        struct linearbuffers_entry *parent;
         if (encoder == NULL) {
                 linearbuffers_errorf("encoder is invalid");
                 goto bail;
         }
-        if (offset == NULL) {
-                linearbuffers_errorf("offset is invalid");
-                goto bail;
-        }
         if (value == NULL) {
                 linearbuffers_errorf("value is invalid");
                 goto bail;
@@ -785,44 +1004,50 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_cre
                 linearbuffers_errorf("logic error: entries is empty");
                 goto bail;
         }
-        *offset = encoder->emitter.offset;
-        length = strlen(value) + 1;
-        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, value, length);
+        parent = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (parent == NULL) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (parent->type != linearbuffers_entry_type_table) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (element >= parent->u.table.elements) {
+                linearbuffers_errorf("logic error: element is invalid");
+                goto bail;
+        }
+        if (parent->u.table.compact) {
+                rc = linearbuffers_entry_table_store(parent, element, offset, value, size);
+        } else {
+                rc = encoder->emitter.function(encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, value, size);
+        }
         if (rc != 0) {
-                linearbuffers_errorf("can not emit element");
+                linearbuffers_errorf("can not emit table element");
+                goto bail;
+        }
+        rc = linearbuffers_present_table_mark(&parent->u.table.present, element);
+        if (rc != 0) {
+                linearbuffers_errorf("can not mark table element");
                 goto bail;
         }
-        encoder->emitter.offset += length;
         return 0;
 bail:   return -1;
 }
 
-__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createf (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, ...)
-{
-        int rc;
-        va_list ap;
-        va_start(ap, value);
-        rc = linearbuffers_encoder_string_createv(encoder, offset, value, ap);
-        va_end(ap);
-        return rc;
-}
-
-__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createv (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, va_list va)
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_set_union (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint8_t type, uint64_t value)
 {
         int rc;
-        va_list vs;
-        char *buffer;
-        int length;
-        buffer = NULL;
+        struct linearbuffers_entry *parent;
         if (encoder == NULL) {
                 linearbuffers_errorf("encoder is invalid");
                 goto bail;
         }
-        if (offset == NULL) {
-                linearbuffers_errorf("offset is invalid");
+        if (type == 0) {
+                linearbuffers_errorf("type is invalid");
                 goto bail;
         }
-        if (value == NULL) {
+        if (value <= 0) {
                 linearbuffers_errorf("value is invalid");
                 goto bail;
         }
@@ -830,43 +1055,119 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_cre
                 linearbuffers_errorf("logic error: entries is empty");
                 goto bail;
         }
-        *offset = encoder->emitter.offset;
-        va_copy(vs, va);
-        length = vsnprintf(NULL, 0, value, vs);
-        va_end(vs);
-        if (length < 0) {
+        parent = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (parent == NULL) {
+                linearbuffers_errorf("logic error: parent is invalid");
                 goto bail;
         }
-        buffer = malloc(length + 1);
-        if (buffer == NULL) {
-                linearbuffers_errorf("can not allocate memory");
+        if (parent->type != linearbuffers_entry_type_table) {
+                linearbuffers_errorf("logic error: parent is invalid");
                 goto bail;
         }
-        va_copy(vs, va);
-        length = vsnprintf(buffer, length + 1, value, vs);
-        va_end(vs);
-        if (length < 0) {
-                linearbuffers_errorf("can not print string");
+        if (element >= parent->u.table.elements) {
+                linearbuffers_errorf("logic error: element is invalid");
                 goto bail;
         }
-        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, buffer, length + 1);
+        if (parent->u.table.compact) {
+                rc  = linearbuffers_entry_table_store(parent, element, offset, NULL, sizeof(type) + parent->offset_size);
+                rc |= linearbuffers_entry_table_reference(parent, element, sizeof(type), value);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit table element");
+                        goto bail;
+                }
+                parent->u.table.buffer[offset] = type;
+        } else {
+                rc = encoder->emitter.function(encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, &type, sizeof(type));
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit table element");
+                        goto bail;
+                }
+                rc = parent->offset_emitter(encoder->emitter.function, encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset + sizeof(type), value - parent->offset);
+        }
         if (rc != 0) {
-                linearbuffers_errorf("can not emit element");
+                linearbuffers_errorf("can not emit table element offset");
+                goto bail;
+        }
+        rc = linearbuffers_present_table_mark(&parent->u.table.present, element);
+        if (rc != 0) {
+                linearbuffers_errorf("can not mark table element");
                 goto bail;
         }
-        encoder->emitter.offset += length + 1;
-        free(buffer);
         return 0;
-bail:   if (buffer != NULL) {
-                free(buffer);
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_set_array (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, const void *value, uint64_t size)
+{
+        return linearbuffers_encoder_table_set_struct(encoder, element, offset, value, size);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_table_set_slots (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t elements, uint64_t offset, const void *value, const uint64_t *sizes)
+{
+        int rc;
+        uint64_t i;
+        uint64_t size;
+        struct linearbuffers_entry *parent;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
         }
-        return -1;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (sizes == NULL) {
+                linearbuffers_errorf("sizes is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        parent = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (parent == NULL) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (parent->type != linearbuffers_entry_type_table) {
+                linearbuffers_errorf("logic error: parent is invalid");
+                goto bail;
+        }
+        if (element + elements > parent->u.table.elements) {
+                linearbuffers_errorf("logic error: element is invalid");
+                goto bail;
+        }
+        size = 0;
+        for (i = 0; i < elements; i++) {
+                if (parent->u.table.compact) {
+                        rc = linearbuffers_entry_table_store(parent, element + i, offset + size, ((const uint8_t *) value) + size, sizes[i]);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not emit table element");
+                                goto bail;
+                        }
+                }
+                rc = linearbuffers_present_table_mark(&parent->u.table.present, element + i);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not mark table element");
+                        goto bail;
+                }
+                size += sizes[i];
+        }
+        if (!parent->u.table.compact) {
+                rc = encoder->emitter.function(encoder->emitter.context, parent->offset + parent->count_size + parent->u.table.present.bytes + offset, value, size);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit table element");
+                        goto bail;
+                }
+        }
+        return 0;
+bail:   return -1;
 }
 
-__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_ncreate (struct linearbuffers_encoder *encoder, uint64_t *offset, uint64_t n, const char *value)
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_create (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value)
 {
-        const char _null = 0;
         int rc;
+        uint64_t length;
         if (encoder == NULL) {
                 linearbuffers_errorf("encoder is invalid");
                 goto bail;
@@ -884,32 +1185,334 @@ __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_ncr
                 goto bail;
         }
         *offset = encoder->emitter.offset;
-        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, value, n);
+        length = strlen(value) + 1;
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, value, length);
         if (rc != 0) {
                 linearbuffers_errorf("can not emit element");
                 goto bail;
         }
-        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset + n, &_null, 1);
+        encoder->emitter.offset += length;
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_reference (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value)
+{
+        int rc;
+        uint64_t length;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset;
+        length = strlen(value) + 1;
+        rc = linearbuffers_encoder_reference(encoder, encoder->emitter.offset, value, length);
         if (rc != 0) {
                 linearbuffers_errorf("can not emit element");
                 goto bail;
         }
-        encoder->emitter.offset += n + 1;
+        encoder->emitter.offset += length;
         return 0;
 bail:   return -1;
 }
 
-#define linearbuffers_encoder_vector_start_scalar_type(__type__, __type_t__) \
-        __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_create_ ## __type__ (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const __type_t__ *value, uint64_t count) \
-        { \
-                int rc; \
-                (void) offset_type; \
-                if (encoder == NULL) { \
-                        linearbuffers_errorf("encoder is invalid"); \
-                        goto bail; \
-                } \
-                if (offset == NULL) { \
-                        linearbuffers_errorf("offset is invalid"); \
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_bytes_reference (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const void *value, uint64_t count)
+{
+        int rc;
+        (void) offset_type;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL && count > 0) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset;
+        rc = linearbuffers_encoder_count_types[count_type].emitter(encoder->emitter.function, encoder->emitter.context, encoder->emitter.offset, count);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector count");
+                goto bail;
+        }
+        if (count > 0) {
+                rc = linearbuffers_encoder_reference(encoder, encoder->emitter.offset + linearbuffers_encoder_count_types[count_type].size, value, count);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit vector values");
+                        goto bail;
+                }
+        }
+        encoder->emitter.offset += linearbuffers_encoder_count_types[count_type].size;
+        encoder->emitter.offset += count;
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createf (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, ...)
+{
+        int rc;
+        va_list ap;
+        va_start(ap, value);
+        rc = linearbuffers_encoder_string_createv(encoder, offset, value, ap);
+        va_end(ap);
+        return rc;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createv (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, va_list va)
+{
+        int rc;
+        va_list vs;
+        char *buffer;
+        int length;
+        buffer = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset;
+        va_copy(vs, va);
+        length = vsnprintf(NULL, 0, value, vs);
+        va_end(vs);
+        if (length < 0) {
+                goto bail;
+        }
+        buffer = malloc(length + 1);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        va_copy(vs, va);
+        length = vsnprintf(buffer, length + 1, value, vs);
+        va_end(vs);
+        if (length < 0) {
+                linearbuffers_errorf("can not print string");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, buffer, length + 1);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit element");
+                goto bail;
+        }
+        encoder->emitter.offset += length + 1;
+        free(buffer);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_ncreate (struct linearbuffers_encoder *encoder, uint64_t *offset, uint64_t n, const char *value)
+{
+        const char _null = 0;
+        int rc;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset;
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, value, n);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit element");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset + n, &_null, 1);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit element");
+                goto bail;
+        }
+        encoder->emitter.offset += n + 1;
+        return 0;
+bail:   return -1;
+}
+
+static int linearbuffers_encoder_string_emit_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value, uint64_t n, int reference)
+{
+        const char _null = 0;
+        int rc;
+        uint64_t size;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        size = linearbuffers_encoder_count_types[count_type].size;
+        if (size < sizeof(uint64_t) &&
+            (n >> (size * 8)) != 0) {
+                linearbuffers_errorf("string is too long: %" PRIu64 "", n);
+                goto bail;
+        }
+        rc = linearbuffers_encoder_count_types[count_type].emitter(encoder->emitter.function, encoder->emitter.context, encoder->emitter.offset, n);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit string length");
+                goto bail;
+        }
+        if (n > 0) {
+                if (reference) {
+                        rc = linearbuffers_encoder_reference(encoder, encoder->emitter.offset + size, value, n);
+                } else {
+                        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset + size, value, n);
+                }
+                if (rc != 0) {
+                        linearbuffers_errorf("can not emit element");
+                        goto bail;
+                }
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset + size + n, &_null, 1);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit element");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset + size;
+        encoder->emitter.offset += size + n + 1;
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_create_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value)
+{
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return linearbuffers_encoder_string_emit_prefixed(encoder, count_type, offset, value, strlen(value), 0);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createf_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value, ...)
+{
+        int rc;
+        va_list ap;
+        va_start(ap, value);
+        rc = linearbuffers_encoder_string_createv_prefixed(encoder, count_type, offset, value, ap);
+        va_end(ap);
+        return rc;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_createv_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value, va_list va)
+{
+        int rc;
+        va_list vs;
+        char *buffer;
+        int length;
+        buffer = NULL;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        va_copy(vs, va);
+        length = vsnprintf(NULL, 0, value, vs);
+        va_end(vs);
+        if (length < 0) {
+                goto bail;
+        }
+        buffer = malloc(length + 1);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        va_copy(vs, va);
+        length = vsnprintf(buffer, length + 1, value, vs);
+        va_end(vs);
+        if (length < 0) {
+                linearbuffers_errorf("can not print string");
+                goto bail;
+        }
+        rc = linearbuffers_encoder_string_emit_prefixed(encoder, count_type, offset, buffer, length, 0);
+        if (rc != 0) {
+                goto bail;
+        }
+        free(buffer);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_ncreate_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, uint64_t n, const char *value)
+{
+        return linearbuffers_encoder_string_emit_prefixed(encoder, count_type, offset, value, n, 0);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_reference_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value)
+{
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return linearbuffers_encoder_string_emit_prefixed(encoder, count_type, offset, value, strlen(value), 1);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_string_nreference_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, uint64_t n, const char *value)
+{
+        return linearbuffers_encoder_string_emit_prefixed(encoder, count_type, offset, value, n, 1);
+}
+
+#define linearbuffers_encoder_vector_start_scalar_type(__type__, __type_t__) \
+        __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_create_ ## __type__ (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const __type_t__ *value, uint64_t count) \
+        { \
+                int rc; \
+                (void) offset_type; \
+                if (encoder == NULL) { \
+                        linearbuffers_errorf("encoder is invalid"); \
+                        goto bail; \
+                } \
+                if (offset == NULL) { \
+                        linearbuffers_errorf("offset is invalid"); \
                         goto bail; \
                 } \
                 if (TAILQ_EMPTY(&encoder->entries)) { \
@@ -1106,16 +1709,539 @@ linearbuffers_encoder_vector_start_scalar_type(uint64, uint64_t);
 linearbuffers_encoder_vector_start_scalar_type(float, float);
 linearbuffers_encoder_vector_start_scalar_type(double, double);
 
-#define linearbuffers_encoder_vector_start_type(__type__) \
-        __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_start_ ## __type__ (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type) \
-        { \
-                int rc; \
-                struct linearbuffers_entry *entry; \
-                entry = NULL; \
-                if (encoder == NULL) { \
-                        linearbuffers_errorf("encoder is invalid"); \
-                        goto bail; \
-                } \
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_create_struct (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const void *value, uint64_t size, uint64_t count)
+{
+        int rc;
+        (void) offset_type;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        *offset = encoder->emitter.offset;
+        rc = linearbuffers_encoder_count_types[count_type].emitter(encoder->emitter.function, encoder->emitter.context, encoder->emitter.offset, count);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector count");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset + linearbuffers_encoder_count_types[count_type].size, value, count * size);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector values");
+                goto bail;
+        }
+        encoder->emitter.offset += linearbuffers_encoder_count_types[count_type].size;
+        encoder->emitter.offset += count * size;
+        return 0;
+bail:   return -1;
+}
+
+/*
+ * encoded integer vectors are stored as a uint8 vector:
+ *   header : uint64 count, uint8 encoding, uint8 size, uint8 signed, uint8 pad[5]
+ *   blocks : nblocks x { uint64 base, uint32 offset, uint8 width, uint8 pad[3] }
+ *   data   : little endian bit packed values per block, padded with 8 bytes
+ *
+ * per block values are:
+ *   bitpack: the value, zigzagged when signed, base is 0
+ *   for    : value - base, base is the block minimum
+ *   delta  : zigzag(value[i] - value[i - 1]), base is the block's first
+ *            value and its own slot is 0; decoding is a running sum from
+ *            base, so get_at walks the block up to the element
+ */
+
+#define LINEARBUFFERS_ENCODED_HEADER_SIZE       16
+#define LINEARBUFFERS_ENCODED_BLOCK_SIZE        16
+#define LINEARBUFFERS_ENCODED_BLOCK_LENGTH      128
+#define LINEARBUFFERS_ENCODED_PADDING           8
+
+static inline uint64_t linearbuffers_encoded_zigzag (uint64_t value)
+{
+        return (value << 1) ^ (uint64_t) (((int64_t) value) >> 63);
+}
+
+static inline uint64_t linearbuffers_encoded_load (const void *value, uint64_t size, int is_signed, uint64_t at)
+{
+        const uint8_t *v = ((const uint8_t *) value) + at * size;
+        if (size == sizeof(uint8_t)) {
+                uint8_t t;
+                memcpy(&t, v, sizeof(t));
+                return (is_signed) ? (uint64_t) (int64_t) (int8_t) t : t;
+        } else if (size == sizeof(uint16_t)) {
+                uint16_t t;
+                memcpy(&t, v, sizeof(t));
+                return (is_signed) ? (uint64_t) (int64_t) (int16_t) t : t;
+        } else if (size == sizeof(uint32_t)) {
+                uint32_t t;
+                memcpy(&t, v, sizeof(t));
+                return (is_signed) ? (uint64_t) (int64_t) (int32_t) t : t;
+        } else {
+                uint64_t t;
+                memcpy(&t, v, sizeof(t));
+                return t;
+        }
+}
+
+static inline uint64_t linearbuffers_encoded_value (enum linearbuffers_encoder_encoding encoding, const void *value, uint64_t size, int is_signed, uint64_t at, uint64_t base)
+{
+        uint64_t v;
+        v = linearbuffers_encoded_load(value, size, is_signed, at);
+        if (encoding == linearbuffers_encoder_encoding_delta) {
+                if ((at % LINEARBUFFERS_ENCODED_BLOCK_LENGTH) == 0) {
+                        return 0;
+                }
+                return linearbuffers_encoded_zigzag(v - linearbuffers_encoded_load(value, size, is_signed, at - 1));
+        } else if (encoding == linearbuffers_encoder_encoding_for) {
+                return v - base;
+        } else if (is_signed) {
+                return linearbuffers_encoded_zigzag(v);
+        }
+        return v;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_create_encoded (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, enum linearbuffers_encoder_encoding encoding, uint64_t *offset, const void *value, uint64_t size, int is_signed, uint64_t count)
+{
+        int rc;
+        uint64_t b;
+        uint64_t i;
+        uint64_t n;
+        uint64_t v;
+        uint64_t m;
+        uint64_t p;
+        uint64_t base;
+        uint64_t chunk;
+        uint64_t length;
+        uint64_t nblocks;
+        uint32_t doffset;
+        uint8_t width;
+        uint8_t *buffer;
+        uint8_t *block;
+        uint8_t *data;
+
+        buffer = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL && count > 0) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (size != sizeof(uint8_t) &&
+            size != sizeof(uint16_t) &&
+            size != sizeof(uint32_t) &&
+            size != sizeof(uint64_t)) {
+                linearbuffers_errorf("size is invalid");
+                goto bail;
+        }
+        if (encoding != linearbuffers_encoder_encoding_bitpack &&
+            encoding != linearbuffers_encoder_encoding_for &&
+            encoding != linearbuffers_encoder_encoding_delta) {
+                linearbuffers_errorf("encoding is invalid");
+                goto bail;
+        }
+        nblocks = (count + LINEARBUFFERS_ENCODED_BLOCK_LENGTH - 1) / LINEARBUFFERS_ENCODED_BLOCK_LENGTH;
+        length = LINEARBUFFERS_ENCODED_HEADER_SIZE + nblocks * LINEARBUFFERS_ENCODED_BLOCK_SIZE + count * sizeof(uint64_t) + LINEARBUFFERS_ENCODED_PADDING;
+        buffer = malloc(length);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(buffer, 0, length);
+        memcpy(buffer, &count, sizeof(uint64_t));
+        buffer[8] = encoding;
+        buffer[9] = size;
+        buffer[10] = !!is_signed;
+        data = buffer + LINEARBUFFERS_ENCODED_HEADER_SIZE + nblocks * LINEARBUFFERS_ENCODED_BLOCK_SIZE;
+        doffset = 0;
+        for (b = 0; b < nblocks; b++) {
+                n = MIN(LINEARBUFFERS_ENCODED_BLOCK_LENGTH, count - b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH);
+                base = 0;
+                if (encoding == linearbuffers_encoder_encoding_delta) {
+                        base = linearbuffers_encoded_load(value, size, is_signed, b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH);
+                } else if (encoding == linearbuffers_encoder_encoding_for) {
+                        base = linearbuffers_encoded_load(value, size, is_signed, b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH);
+                        for (i = 1; i < n; i++) {
+                                v = linearbuffers_encoded_load(value, size, is_signed, b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH + i);
+                                if ((is_signed) ? ((int64_t) v < (int64_t) base) : (v < base)) {
+                                        base = v;
+                                }
+                        }
+                }
+                m = 0;
+                for (i = 0; i < n; i++) {
+                        m |= linearbuffers_encoded_value(encoding, value, size, is_signed, b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH + i, base);
+                }
+                width = (m == 0) ? 0 : 64 - __builtin_clzll(m);
+                block = buffer + LINEARBUFFERS_ENCODED_HEADER_SIZE + b * LINEARBUFFERS_ENCODED_BLOCK_SIZE;
+                memcpy(block, &base, sizeof(uint64_t));
+                memcpy(block + 8, &doffset, sizeof(uint32_t));
+                block[12] = width;
+                p = 0;
+                for (i = 0; i < n && width > 0; i++) {
+                        v = linearbuffers_encoded_value(encoding, value, size, is_signed, b * LINEARBUFFERS_ENCODED_BLOCK_LENGTH + i, base);
+                        for (m = 0; m < width; m += chunk) {
+                                chunk = MIN(8 - (p % 8), width - m);
+                                data[doffset + p / 8] |= ((v >> m) & ((1U << chunk) - 1)) << (p % 8);
+                                p += chunk;
+                        }
+                }
+                doffset += (p + 7) / 8;
+        }
+        length = LINEARBUFFERS_ENCODED_HEADER_SIZE + nblocks * LINEARBUFFERS_ENCODED_BLOCK_SIZE + doffset + LINEARBUFFERS_ENCODED_PADDING;
+        rc = linearbuffers_encoder_vector_create_struct(encoder, count_type, offset_type, offset, buffer, sizeof(uint8_t), length);
+        if (rc != 0) {
+                linearbuffers_errorf("can not create vector");
+                goto bail;
+        }
+        free(buffer);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
+
+/*
+ * dictionary string vectors are stored as a uint8 vector:
+ *   header  : uint64 count, uint32 nentries, uint8 width, uint8 pad[3]
+ *   offsets : nentries x uint32, relative to strings
+ *   indices : count x width (1, 2 or 4 bytes)
+ *   strings : nentries x nul terminated unique strings
+ */
+
+#define LINEARBUFFERS_DICTIONARY_HEADER_SIZE    16
+
+static inline uint64_t linearbuffers_dictionary_hash (const char *value)
+{
+        uint64_t hash;
+        hash = UINT64_C(14695981039346656037);
+        while (*value != '\0') {
+                hash ^= (uint8_t) *value++;
+                hash *= UINT64_C(1099511628211);
+        }
+        return hash;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_create_dictionary (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const char **value, uint64_t count)
+{
+        int rc;
+        uint64_t i;
+        uint64_t h;
+        uint64_t nslots;
+        uint64_t length;
+        uint64_t slength;
+        uint32_t index;
+        uint32_t nentries;
+        uint32_t soffset;
+        uint8_t width;
+        uint8_t *buffer;
+        uint32_t *slots;
+        uint32_t *indices;
+        const char **entries;
+
+        buffer = NULL;
+        slots = NULL;
+        indices = NULL;
+        entries = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (value == NULL && count > 0) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (count > UINT32_MAX) {
+                linearbuffers_errorf("count is invalid");
+                goto bail;
+        }
+        for (nslots = 16; nslots < count * 2; nslots *= 2) {
+        }
+        slots = malloc(sizeof(uint32_t) * nslots);
+        indices = malloc(sizeof(uint32_t) * (count + 1));
+        entries = malloc(sizeof(const char *) * (count + 1));
+        if (slots == NULL ||
+            indices == NULL ||
+            entries == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(slots, 0xff, sizeof(uint32_t) * nslots);
+        nentries = 0;
+        slength = 0;
+        for (i = 0; i < count; i++) {
+                if (value[i] == NULL) {
+                        linearbuffers_errorf("value is invalid");
+                        goto bail;
+                }
+                for (h = linearbuffers_dictionary_hash(value[i]) & (nslots - 1); ; h = (h + 1) & (nslots - 1)) {
+                        if (slots[h] == UINT32_MAX) {
+                                slots[h] = nentries;
+                                entries[nentries] = value[i];
+                                slength += strlen(value[i]) + 1;
+                                nentries += 1;
+                                break;
+                        }
+                        if (strcmp(entries[slots[h]], value[i]) == 0) {
+                                break;
+                        }
+                }
+                indices[i] = slots[h];
+        }
+        if (nentries <= UINT8_MAX + 1) {
+                width = sizeof(uint8_t);
+        } else if (nentries <= UINT16_MAX + 1) {
+                width = sizeof(uint16_t);
+        } else {
+                width = sizeof(uint32_t);
+        }
+        length = LINEARBUFFERS_DICTIONARY_HEADER_SIZE + nentries * sizeof(uint32_t) + count * width + slength;
+        buffer = malloc(length);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(buffer, 0, LINEARBUFFERS_DICTIONARY_HEADER_SIZE);
+        memcpy(buffer, &count, sizeof(uint64_t));
+        memcpy(buffer + 8, &nentries, sizeof(uint32_t));
+        buffer[12] = width;
+        soffset = 0;
+        for (index = 0; index < nentries; index++) {
+                memcpy(buffer + LINEARBUFFERS_DICTIONARY_HEADER_SIZE + index * sizeof(uint32_t), &soffset, sizeof(uint32_t));
+                memcpy(buffer + LINEARBUFFERS_DICTIONARY_HEADER_SIZE + nentries * sizeof(uint32_t) + count * width + soffset, entries[index], strlen(entries[index]) + 1);
+                soffset += strlen(entries[index]) + 1;
+        }
+        for (i = 0; i < count; i++) {
+                uint8_t *p = buffer + LINEARBUFFERS_DICTIONARY_HEADER_SIZE + nentries * sizeof(uint32_t) + i * width;
+                if (width == sizeof(uint8_t)) {
+                        uint8_t t = indices[i];
+                        memcpy(p, &t, sizeof(t));
+                } else if (width == sizeof(uint16_t)) {
+                        uint16_t t = indices[i];
+                        memcpy(p, &t, sizeof(t));
+                } else {
+                        memcpy(p, &indices[i], sizeof(uint32_t));
+                }
+        }
+        rc = linearbuffers_encoder_vector_create_struct(encoder, count_type, offset_type, offset, buffer, sizeof(uint8_t), length);
+        if (rc != 0) {
+                linearbuffers_errorf("can not create vector");
+                goto bail;
+        }
+        free(buffer);
+        free(entries);
+        free(indices);
+        free(slots);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        if (entries != NULL) {
+                free(entries);
+        }
+        if (indices != NULL) {
+                free(indices);
+        }
+        if (slots != NULL) {
+                free(slots);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_start_struct (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t size)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        entry = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (size == 0) {
+                linearbuffers_errorf("size is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = linearbuffers_pool_malloc(&encoder->pool.entry);
+        if (entry == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(entry, 0, sizeof(struct linearbuffers_entry));
+        entry->type = linearbuffers_entry_type_vector;
+        entry->u.vector.type = linearbuffers_vector_type_struct;
+        entry->u.vector.elements = 0;
+        entry->u.vector.size = size;
+        entry->count_size = linearbuffers_encoder_count_types[count_type].size;
+        entry->count_emitter = linearbuffers_encoder_count_types[count_type].emitter;
+        entry->offset_size = linearbuffers_encoder_offset_types[offset_type].size;
+        entry->offset_emitter = linearbuffers_encoder_offset_types[offset_type].emitter;
+        rc = linearbuffers_offset_table_init(&encoder->pool.offset, &entry->u.vector.offset, offset_type);
+        if (rc != 0) {
+                linearbuffers_errorf("can not init table present");
+                goto bail;
+        }
+        entry->offset = encoder->emitter.offset;
+        rc = encoder->emitter.function(encoder->emitter.context, entry->offset, NULL, entry->count_size);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector place");
+                goto bail;
+        }
+        encoder->emitter.offset += entry->count_size;
+        TAILQ_INSERT_TAIL(&encoder->entries, entry, entries);
+        return 0;
+bail:   if (entry != NULL) {
+                linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_end_struct (struct linearbuffers_encoder *encoder, uint64_t *offset)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (offset == NULL) {
+                linearbuffers_errorf("offset is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->type != linearbuffers_entry_type_vector) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->u.vector.type != linearbuffers_vector_type_struct) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        *offset = entry->offset;
+        rc = entry->count_emitter(encoder->emitter.function, encoder->emitter.context, entry->offset, entry->u.vector.elements);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector count");
+                goto bail;
+        }
+        TAILQ_REMOVE(&encoder->entries, entry, entries);
+        linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_cancel_struct (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->type != linearbuffers_entry_type_vector) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->u.vector.type != linearbuffers_vector_type_struct) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, NULL, entry->offset - encoder->emitter.offset);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector cancel");
+                goto bail;
+        }
+        encoder->emitter.offset = entry->offset;
+        TAILQ_REMOVE(&encoder->entries, entry, entries);
+        linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_push_struct (struct linearbuffers_encoder *encoder, const void *value)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->type != linearbuffers_entry_type_vector) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->u.vector.type != linearbuffers_vector_type_struct) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, value, entry->u.vector.size);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit vector element");
+                goto bail;
+        }
+        entry->u.vector.elements += 1;
+        encoder->emitter.offset += entry->u.vector.size;
+        return 0;
+bail:   return -1;
+}
+
+#define linearbuffers_encoder_vector_start_type(__type__) \
+        __attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_start_ ## __type__ (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type) \
+        { \
+                int rc; \
+                struct linearbuffers_entry *entry; \
+                entry = NULL; \
+                if (encoder == NULL) { \
+                        linearbuffers_errorf("encoder is invalid"); \
+                        goto bail; \
+                } \
                 if (TAILQ_EMPTY(&encoder->entries)) { \
                         linearbuffers_errorf("logic error: entries is empty"); \
                         goto bail; \
@@ -1280,3 +2406,486 @@ linearbuffers_encoder_vector_start_scalar_type(double, double);
 
 linearbuffers_encoder_vector_start_type(string);
 linearbuffers_encoder_vector_start_type(table);
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_push_linearized (struct linearbuffers_encoder *encoder, const void *buffer, uint64_t length, uint64_t root)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (buffer == NULL || length == 0) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        if (root >= length) {
+                linearbuffers_errorf("root is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->type != linearbuffers_entry_type_vector) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->u.vector.type != linearbuffers_vector_type_table) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        rc = linearbuffers_encoder_reference(encoder, encoder->emitter.offset, buffer, length);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit linearized table");
+                goto bail;
+        }
+        rc = linearbuffers_offset_table_push(&entry->u.vector.offset, encoder->emitter.offset + root, &encoder->pool.offset);
+        if (rc != 0) {
+                linearbuffers_errorf("can not push element offset");
+                goto bail;
+        }
+        encoder->emitter.offset += length;
+        entry->u.vector.elements += 1;
+        return 0;
+bail:   return -1;
+}
+
+static uint64_t linearbuffers_offset_buffer_get (struct linearbuffers_offset_buffer *buffer, uint64_t size, uint64_t i)
+{
+        switch (size) {
+                case sizeof(uint8_t):  return buffer->u._8[i];
+                case sizeof(uint16_t): return buffer->u._16[i];
+                case sizeof(uint32_t): return buffer->u._32[i];
+        }
+        return buffer->u._64[i];
+}
+
+static void linearbuffers_offset_buffer_set (struct linearbuffers_offset_buffer *buffer, uint64_t size, uint64_t i, uint64_t value)
+{
+        switch (size) {
+                case sizeof(uint8_t):  buffer->u._8[i]  = value; return;
+                case sizeof(uint16_t): buffer->u._16[i] = value; return;
+                case sizeof(uint32_t): buffer->u._32[i] = value; return;
+        }
+        buffer->u._64[i] = value;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_sort_table (struct linearbuffers_encoder *encoder, int (*compare) (void *context, uint64_t a, uint64_t b), void *context)
+{
+        uint64_t i;
+        uint64_t j;
+        uint64_t k;
+        uint64_t l;
+        uint64_t m;
+        uint64_t r;
+        uint64_t w;
+        uint64_t n;
+        uint64_t mask;
+        uint64_t *values;
+        uint64_t *scratch;
+        uint64_t *swap;
+        uint64_t *allocated;
+        uint64_t per_buffer;
+        struct linearbuffers_entry *entry;
+        struct linearbuffers_offset_buffer *buffer;
+        allocated = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (compare == NULL) {
+                linearbuffers_errorf("compare is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL ||
+            entry->type != linearbuffers_entry_type_vector ||
+            entry->u.vector.type != linearbuffers_vector_type_table) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        n = entry->u.vector.elements;
+        if (n < 2) {
+                return 0;
+        }
+        allocated = malloc(sizeof(uint64_t) * n * 2);
+        if (allocated == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        values = allocated;
+        scratch = allocated + n;
+        per_buffer = (LINEARBUFFERS_OFFSET_BUFFER_64_COUNT * sizeof(uint64_t)) / entry->offset_size;
+        mask = (entry->offset_size < sizeof(uint64_t)) ? ((UINT64_C(1) << (entry->offset_size * 8)) - 1) : UINT64_MAX;
+        for (i = 0, buffer = entry->u.vector.offset.buffers; i < n; i++) {
+                if (i > 0 && (i % per_buffer) == 0) {
+                        buffer = buffer->next;
+                }
+                values[i] = entry->offset + ((linearbuffers_offset_buffer_get(buffer, entry->offset_size, i % per_buffer) - entry->offset) & mask);
+        }
+        for (w = 1; w < n; w *= 2) {
+                for (l = 0; l < n; l += 2 * w) {
+                        m = MIN(l + w, n);
+                        r = MIN(l + 2 * w, n);
+                        for (i = l, j = m, k = l; k < r; k++) {
+                                if (i < m && (j >= r || compare(context, values[i], values[j]) <= 0)) {
+                                        scratch[k] = values[i++];
+                                } else {
+                                        scratch[k] = values[j++];
+                                }
+                        }
+                }
+                swap = values;
+                values = scratch;
+                scratch = swap;
+        }
+        for (i = 0, buffer = entry->u.vector.offset.buffers; i < n; i++) {
+                if (i > 0 && (i % per_buffer) == 0) {
+                        buffer = buffer->next;
+                }
+                linearbuffers_offset_buffer_set(buffer, entry->offset_size, i % per_buffer, values[i]);
+        }
+        free(allocated);
+        return 0;
+bail:   if (allocated != NULL) {
+                free(allocated);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_vector_end_table_sorted (struct linearbuffers_encoder *encoder, uint64_t *offset, int (*compare) (void *context, uint64_t a, uint64_t b), void *context)
+{
+        int rc;
+        rc = linearbuffers_encoder_vector_sort_table(encoder, compare, context);
+        if (rc != 0) {
+                linearbuffers_errorf("can not sort vector");
+                return -1;
+        }
+        return linearbuffers_encoder_vector_end_table(encoder, offset);
+}
+
+/*
+ * map layout, all slots are open addressed with linear probing:
+ *
+ *   count    : count type, number of present slots
+ *   capacity : count type, power of two, zero for empty map
+ *   present  : (capacity + 7) / 8 bytes
+ *   keys     : capacity x key size, references are offsets back from map
+ *   values   : capacity x value size, references are offsets back from map
+ *
+ * hashes are computed by the caller, so that encoder and decoder agree
+ * on the function without the library knowing the key type. reference
+ * keys are put with their content bytes, so that equal keys emitted at
+ * different offsets still collapse into one slot.
+ */
+
+static void linearbuffers_map_store (uint8_t *buffer, uint64_t size, uint64_t value)
+{
+        uint8_t v8;
+        uint16_t v16;
+        uint32_t v32;
+        switch (size) {
+                case sizeof(uint8_t):  v8  = value; memcpy(buffer, &v8,  sizeof(v8));  return;
+                case sizeof(uint16_t): v16 = value; memcpy(buffer, &v16, sizeof(v16)); return;
+                case sizeof(uint32_t): v32 = value; memcpy(buffer, &v32, sizeof(v32)); return;
+        }
+        memcpy(buffer, &value, sizeof(value));
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_map_start (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t key_size, int key_reference, uint64_t value_size, int value_reference)
+{
+        struct linearbuffers_entry *entry;
+        entry = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = linearbuffers_pool_malloc(&encoder->pool.entry);
+        if (entry == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(entry, 0, sizeof(struct linearbuffers_entry));
+        entry->type = linearbuffers_entry_type_map;
+        entry->count_size = linearbuffers_encoder_count_types[count_type].size;
+        entry->count_emitter = linearbuffers_encoder_count_types[count_type].emitter;
+        entry->offset_size = linearbuffers_encoder_offset_types[offset_type].size;
+        entry->offset_emitter = linearbuffers_encoder_offset_types[offset_type].emitter;
+        entry->u.map.key_reference = key_reference;
+        entry->u.map.key_size = (key_reference) ? entry->offset_size : key_size;
+        entry->u.map.value_reference = value_reference;
+        entry->u.map.value_size = (value_reference) ? entry->offset_size : value_size;
+        if (entry->u.map.key_size == 0 ||
+            entry->u.map.key_size > sizeof(uint64_t) ||
+            entry->u.map.value_size == 0 ||
+            entry->u.map.value_size > sizeof(uint64_t)) {
+                linearbuffers_errorf("map key or value size is invalid");
+                goto bail;
+        }
+        entry->offset = encoder->emitter.offset;
+        TAILQ_INSERT_TAIL(&encoder->entries, entry, entries);
+        return 0;
+bail:   if (entry != NULL) {
+                linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_map_put_reference (struct linearbuffers_encoder *encoder, uint64_t hash, const void *key, const void *bytes, uint64_t length, const void *value)
+{
+        void *tmp;
+        uint64_t size;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (key == NULL ||
+            value == NULL) {
+                linearbuffers_errorf("key or value is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL ||
+            entry->type != linearbuffers_entry_type_map) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        if (entry->u.map.elements >= entry->u.map.size) {
+                size = (entry->u.map.size == 0) ? 16 : entry->u.map.size * 2;
+                tmp = realloc(entry->u.map.hashes, sizeof(uint64_t) * size);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                entry->u.map.hashes = tmp;
+                tmp = realloc(entry->u.map.keys, sizeof(uint64_t) * size);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                entry->u.map.keys = tmp;
+                tmp = realloc(entry->u.map.values, sizeof(uint64_t) * size);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                entry->u.map.values = tmp;
+                if (entry->u.map.key_reference) {
+                        tmp = realloc(entry->u.map.spans, sizeof(uint64_t) * 2 * size);
+                        if (tmp == NULL) {
+                                linearbuffers_errorf("can not allocate memory");
+                                goto bail;
+                        }
+                        entry->u.map.spans = tmp;
+                }
+                entry->u.map.size = size;
+        }
+        if (entry->u.map.key_reference) {
+                if (bytes == NULL) {
+                        bytes = key;
+                        length = sizeof(uint64_t);
+                }
+                if (entry->u.map.bytes_length + length > entry->u.map.bytes_size) {
+                        for (size = (entry->u.map.bytes_size == 0) ? 256 : entry->u.map.bytes_size; size < entry->u.map.bytes_length + length; size *= 2) {
+                        }
+                        tmp = realloc(entry->u.map.bytes, size);
+                        if (tmp == NULL) {
+                                linearbuffers_errorf("can not allocate memory");
+                                goto bail;
+                        }
+                        entry->u.map.bytes = tmp;
+                        entry->u.map.bytes_size = size;
+                }
+                if (length > 0) {
+                        memcpy(entry->u.map.bytes + entry->u.map.bytes_length, bytes, length);
+                }
+                entry->u.map.spans[entry->u.map.elements * 2 + 0] = entry->u.map.bytes_length;
+                entry->u.map.spans[entry->u.map.elements * 2 + 1] = length;
+                entry->u.map.bytes_length += length;
+        }
+        entry->u.map.hashes[entry->u.map.elements] = hash;
+        memcpy(entry->u.map.keys + entry->u.map.elements * sizeof(uint64_t), key, (entry->u.map.key_reference) ? sizeof(uint64_t) : entry->u.map.key_size);
+        memcpy(entry->u.map.values + entry->u.map.elements * sizeof(uint64_t), value, (entry->u.map.value_reference) ? sizeof(uint64_t) : entry->u.map.value_size);
+        entry->u.map.elements += 1;
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_map_put (struct linearbuffers_encoder *encoder, uint64_t hash, const void *key, const void *value)
+{
+        return linearbuffers_encoder_map_put_reference(encoder, hash, key, NULL, 0, value);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_map_end (struct linearbuffers_encoder *encoder, uint64_t *offset)
+{
+        int rc;
+        uint64_t e;
+        uint64_t h;
+        uint64_t n;
+        uint64_t map;
+        uint64_t mask;
+        uint64_t count;
+        uint64_t length;
+        uint64_t capacity;
+        uint64_t reference;
+        uint64_t *slots;
+        uint8_t *buffer;
+        uint8_t *present;
+        uint8_t *keys;
+        uint8_t *values;
+        struct linearbuffers_entry *entry;
+        slots = NULL;
+        buffer = NULL;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL ||
+            entry->type != linearbuffers_entry_type_map) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        n = entry->u.map.elements;
+        for (capacity = (n > 0) ? 1 : 0; capacity < n * 2; capacity *= 2) {
+        }
+        if (entry->count_size < sizeof(uint64_t) &&
+            capacity > (UINT64_C(1) << (entry->count_size * 8)) - 1) {
+                linearbuffers_errorf("map is too large for count type");
+                goto bail;
+        }
+        length = entry->count_size * 2 + (capacity + 7) / 8 + capacity * (entry->u.map.key_size + entry->u.map.value_size);
+        buffer = malloc(length);
+        slots = malloc(sizeof(uint64_t) * (capacity + 1));
+        if (buffer == NULL ||
+            slots == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(buffer, 0, length);
+        memset(slots, 0xff, sizeof(uint64_t) * (capacity + 1));
+        map = encoder->emitter.offset;
+        mask = capacity - 1;
+        count = 0;
+        for (e = 0; e < n; e++) {
+                for (h = entry->u.map.hashes[e] & mask; ; h = (h + 1) & mask) {
+                        if (slots[h] == UINT64_MAX) {
+                                slots[h] = e;
+                                count += 1;
+                                break;
+                        }
+                        if (entry->u.map.hashes[slots[h]] != entry->u.map.hashes[e]) {
+                                continue;
+                        }
+                        if (entry->u.map.key_reference) {
+                                if (entry->u.map.spans[slots[h] * 2 + 1] == entry->u.map.spans[e * 2 + 1] &&
+                                    (entry->u.map.spans[e * 2 + 1] == 0 ||
+                                     memcmp(entry->u.map.bytes + entry->u.map.spans[slots[h] * 2 + 0], entry->u.map.bytes + entry->u.map.spans[e * 2 + 0], entry->u.map.spans[e * 2 + 1]) == 0)) {
+                                        slots[h] = e;
+                                        break;
+                                }
+                        } else if (memcmp(entry->u.map.keys + slots[h] * sizeof(uint64_t), entry->u.map.keys + e * sizeof(uint64_t), entry->u.map.key_size) == 0) {
+                                slots[h] = e;
+                                break;
+                        }
+                }
+        }
+        linearbuffers_map_store(buffer, entry->count_size, count);
+        linearbuffers_map_store(buffer + entry->count_size, entry->count_size, capacity);
+        present = buffer + entry->count_size * 2;
+        keys = present + (capacity + 7) / 8;
+        values = keys + capacity * entry->u.map.key_size;
+        for (h = 0; h < capacity; h++) {
+                if (slots[h] == UINT64_MAX) {
+                        continue;
+                }
+                e = slots[h];
+                present[h / 8] |= (1 << (h % 8));
+                if (entry->u.map.key_reference) {
+                        memcpy(&reference, entry->u.map.keys + e * sizeof(uint64_t), sizeof(reference));
+                        linearbuffers_map_store(keys + h * entry->u.map.key_size, entry->u.map.key_size, map - reference);
+                } else {
+                        memcpy(keys + h * entry->u.map.key_size, entry->u.map.keys + e * sizeof(uint64_t), entry->u.map.key_size);
+                }
+                if (entry->u.map.value_reference) {
+                        memcpy(&reference, entry->u.map.values + e * sizeof(uint64_t), sizeof(reference));
+                        linearbuffers_map_store(values + h * entry->u.map.value_size, entry->u.map.value_size, map - reference);
+                } else {
+                        memcpy(values + h * entry->u.map.value_size, entry->u.map.values + e * sizeof(uint64_t), entry->u.map.value_size);
+                }
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, map, buffer, length);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit map");
+                goto bail;
+        }
+        encoder->emitter.offset += length;
+        if (offset != NULL) {
+                *offset = map;
+        }
+        TAILQ_REMOVE(&encoder->entries, entry, entries);
+        linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        free(slots);
+        free(buffer);
+        return 0;
+bail:   if (slots != NULL) {
+                free(slots);
+        }
+        if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_encoder_map_cancel (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        struct linearbuffers_entry *entry;
+        if (encoder == NULL) {
+                linearbuffers_errorf("encoder is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&encoder->entries)) {
+                linearbuffers_errorf("logic error: entries is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&encoder->entries, linearbuffers_entries);
+        if (entry == NULL ||
+            entry->type != linearbuffers_entry_type_map) {
+                linearbuffers_errorf("logic error: entry is invalid");
+                goto bail;
+        }
+        rc = encoder->emitter.function(encoder->emitter.context, encoder->emitter.offset, NULL, entry->offset - encoder->emitter.offset);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit map cancel");
+                goto bail;
+        }
+        encoder->emitter.offset = entry->offset;
+        TAILQ_REMOVE(&encoder->entries, entry, entries);
+        linearbuffers_entry_destroy(&encoder->pool.entry, &encoder->pool.present, &encoder->pool.offset, entry);
+        return 0;
+bail:   return -1;
+}
@@ -22,9 +22,17 @@ enum linearbuffers_encoder_offset_type {
 	linearbuffers_encoder_offset_type_uint64
 };
 
+enum linearbuffers_encoder_encoding {
+	linearbuffers_encoder_encoding_none,
+	linearbuffers_encoder_encoding_bitpack,
+	linearbuffers_encoder_encoding_for,
+	linearbuffers_encoder_encoding_delta
+};
+
 struct linearbuffers_encoder_create_options {
 	struct {
 		int (*function) (void *context, uint64_t offset, const void *buffer, int64_t length);
+		int (*reference) (void *context, uint64_t offset, const void *buffer, int64_t length);
 		void *context;
 	} emitter;
 };
@@ -32,6 +40,7 @@ struct linearbuffers_encoder_create_options {
 struct linearbuffers_encoder_reset_options {
 	struct {
 		int (*function) (void *context, uint64_t offset, const void *buffer, int64_t length);
+		int (*reference) (void *context, uint64_t offset, const void *buffer, int64_t length);
 		void *context;
 	} emitter;
 };
@@ -42,6 +51,7 @@ void linearbuffers_encoder_destroy (struct linearbuffers_encoder *encoder);
 int linearbuffers_encoder_reset (struct linearbuffers_encoder *encoder, struct linearbuffers_encoder_reset_options *options);
 
 int linearbuffers_encoder_table_start (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size);
+int linearbuffers_encoder_table_start_compact (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t elements, uint64_t size);
 int linearbuffers_encoder_table_end (struct linearbuffers_encoder *encoder, uint64_t *offset);
 int linearbuffers_encoder_table_cancel (struct linearbuffers_encoder *encoder);
 
@@ -61,11 +71,27 @@ int linearbuffers_encoder_table_set_double (struct linearbuffers_encoder *encode
 int linearbuffers_encoder_table_set_string (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint64_t value);
 int linearbuffers_encoder_table_set_table (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint64_t value);
 int linearbuffers_encoder_table_set_vector (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint64_t value);
+int linearbuffers_encoder_table_set_map (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint64_t value);
+int linearbuffers_encoder_table_set_struct (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, const void *value, uint64_t size);
+int linearbuffers_encoder_table_set_union (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, uint8_t type, uint64_t value);
+int linearbuffers_encoder_table_set_array (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, const void *value, uint64_t size);
+int linearbuffers_encoder_table_set_slots (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t elements, uint64_t offset, const void *value, const uint64_t *sizes);
+int linearbuffers_encoder_table_unset (struct linearbuffers_encoder *encoder, uint64_t element);
 
 int linearbuffers_encoder_string_create (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value);
 int linearbuffers_encoder_string_createf (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, ...)  __attribute__((format(printf, 3, 4)));
 int linearbuffers_encoder_string_createv (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value, va_list va);
 int linearbuffers_encoder_string_ncreate (struct linearbuffers_encoder *encoder, uint64_t *offset, uint64_t n, const char *value);
+int linearbuffers_encoder_string_reference (struct linearbuffers_encoder *encoder, uint64_t *offset, const char *value);
+
+int linearbuffers_encoder_string_create_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value);
+int linearbuffers_encoder_string_createf_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value, ...)  __attribute__((format(printf, 4, 5)));
+int linearbuffers_encoder_string_createv_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value, va_list va);
+int linearbuffers_encoder_string_ncreate_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, uint64_t n, const char *value);
+int linearbuffers_encoder_string_reference_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, const char *value);
+int linearbuffers_encoder_string_nreference_prefixed (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, uint64_t *offset, uint64_t n, const char *value);
+
+int linearbuffers_encoder_bytes_reference (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const void *value, uint64_t count);
 
 int linearbuffers_encoder_vector_start_int8 (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type);
 int linearbuffers_encoder_vector_end_int8 (struct linearbuffers_encoder *encoder, uint64_t *offset);
@@ -136,6 +162,24 @@ int linearbuffers_encoder_vector_start_table (struct linearbuffers_encoder *enco
 int linearbuffers_encoder_vector_end_table (struct linearbuffers_encoder *encoder, uint64_t *offset);
 int linearbuffers_encoder_vector_cancel_table (struct linearbuffers_encoder *encoder);
 int linearbuffers_encoder_vector_push_table (struct linearbuffers_encoder *encoder, uint64_t value);
+int linearbuffers_encoder_vector_push_linearized (struct linearbuffers_encoder *encoder, const void *buffer, uint64_t length, uint64_t root);
+int linearbuffers_encoder_vector_sort_table (struct linearbuffers_encoder *encoder, int (*compare) (void *context, uint64_t a, uint64_t b), void *context);
+int linearbuffers_encoder_vector_end_table_sorted (struct linearbuffers_encoder *encoder, uint64_t *offset, int (*compare) (void *context, uint64_t a, uint64_t b), void *context);
+
+int linearbuffers_encoder_vector_start_struct (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t size);
+int linearbuffers_encoder_vector_end_struct (struct linearbuffers_encoder *encoder, uint64_t *offset);
+int linearbuffers_encoder_vector_cancel_struct (struct linearbuffers_encoder *encoder);
+int linearbuffers_encoder_vector_push_struct (struct linearbuffers_encoder *encoder, const void *value);
+int linearbuffers_encoder_vector_create_struct (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const void *value, uint64_t size, uint64_t count);
+
+int linearbuffers_encoder_vector_create_encoded (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, enum linearbuffers_encoder_encoding encoding, uint64_t *offset, const void *value, uint64_t size, int is_signed, uint64_t count);
+int linearbuffers_encoder_vector_create_dictionary (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t *offset, const char **value, uint64_t count);
+
+int linearbuffers_encoder_map_start (struct linearbuffers_encoder *encoder, enum linearbuffers_encoder_count_type count_type, enum linearbuffers_encoder_offset_type offset_type, uint64_t key_size, int key_reference, uint64_t value_size, int value_reference);
+int linearbuffers_encoder_map_put (struct linearbuffers_encoder *encoder, uint64_t hash, const void *key, const void *value);
+int linearbuffers_encoder_map_put_reference (struct linearbuffers_encoder *encoder, uint64_t hash, const void *key, const void *bytes, uint64_t length, const void *value);
+int linearbuffers_encoder_map_end (struct linearbuffers_encoder *encoder, uint64_t *offset);
+int linearbuffers_encoder_map_cancel (struct linearbuffers_encoder *encoder);
 
 const void * linearbuffers_encoder_linearized (struct linearbuffers_encoder *encoder, uint64_t *length);
 
@@ -20,6 +20,8 @@
 #define OPTION_DECODER_USE_MEMCPY       'm'
 #define OPTION_JSONIFY                  'j'
 #define OPTION_NAMESPACE                'n'
+#define OPTION_CONVERT                  'c'
+#define OPTION_REFLECT                  'r'
 
 #define DEFAULT_SCHEMA                  NULL
 #define DEFAULT_OUTPUT                  NULL
@@ -31,23 +33,30 @@
 #define DEFAULT_DECODER_USE_MEMCPY      0
 #define DEFAULT_JSONIFY                 0
 #define DEFAULT_NAMESPACE               NULL
+#define DEFAULT_CONVERT                 NULL
+#define DEFAULT_REFLECT                 0
 
 int schema_generate_pretty (struct schema *schema, FILE *fp);
 
 int schema_generate_c_encoder (struct schema *schema, FILE *fp, int encoder_include_library);
 int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_memcpy);
 int schema_generate_c_jsonify (struct schema *schema, FILE *fp);
+int schema_generate_c_convert (struct schema *schema, struct schema *from, FILE *fp);
+int schema_generate_c_reflect (struct schema *schema, FILE *fp);
 
 int schema_generate_js_encoder (struct schema *schema, FILE *fp, int encoder_include_library);
 int schema_generate_js_decoder (struct schema *schema, FILE *fp, int decoder_use_memcpy);
 int schema_generate_js_jsonify (struct schema *schema, FILE *fp);
 
+int schema_generate_binary_reflect (struct schema *schema, FILE *fp);
+
 struct generator {
         const char *language;
         int (*encoder) (struct schema *schema, FILE *fp, int encoder_include_library);
         int (*decoder) (struct schema *schema, FILE *fp, int decoder_use_memcpy);
         int (*jsonify) (struct schema *schema, FILE *fp);
-
+        int (*convert) (struct schema *schema, struct schema *from, FILE *fp);
+        int (*reflect) (struct schema *schema, FILE *fp);
 };
 
 static const struct generator *generators[] = {
@@ -55,13 +64,25 @@ static const struct generator *generators[] = {
                 "c",
                 schema_generate_c_encoder,
                 schema_generate_c_decoder,
-                schema_generate_c_jsonify
+                schema_generate_c_jsonify,
+                schema_generate_c_convert,
+                schema_generate_c_reflect
         },
         &(struct generator) {
                 "js",
                 schema_generate_js_encoder,
                 schema_generate_js_decoder,
-                schema_generate_js_jsonify
+                schema_generate_js_jsonify,
+                NULL,
+                NULL
+        },
+        &(struct generator) {
+                "binary",
+                NULL,
+                NULL,
+                NULL,
+                NULL,
+                schema_generate_binary_reflect
         },
         NULL,
 };
@@ -77,6 +98,8 @@ static struct option options[] = {
         { "decoder"                     , required_argument, 0, OPTION_DECODER                  },
         { "decoder-use-memcpy"          , required_argument, 0, OPTION_DECODER_USE_MEMCPY       },
         { "jsonify"                     , required_argument, 0, OPTION_JSONIFY                  },
+        { "convert"                     , required_argument, 0, OPTION_CONVERT                  },
+        { "reflect"                     , required_argument, 0, OPTION_REFLECT                  },
         { 0                             , 0                , 0, 0                               }
 };
 
@@ -88,13 +111,15 @@ static void print_help (const char *name)
         fprintf(stdout, "  -s, --schema   : schema file (default: %s)\n", (DEFAULT_SCHEMA == NULL) ? "(null)" : DEFAULT_SCHEMA);
         fprintf(stdout, "  -o, --output   : output file (default: %s)\n", (DEFAULT_OUTPUT == NULL) ? "(null)" : DEFAULT_OUTPUT);
         fprintf(stdout, "  -p, --pretty   : generate pretty (values: { 0, 1 }, default: %d)\n", DEFAULT_PRETTY);
-        fprintf(stdout, "  -l, --language : generate language (values: { c, js }, default: %s)\n", DEFAULT_LANGUAGE);
+        fprintf(stdout, "  -l, --language : generate language (values: { c, js, binary }, default: %s)\n", DEFAULT_LANGUAGE);
         fprintf(stdout, "  -e, --encoder: generate encoder (values: { 0, 1 }, default: %d)\n", DEFAULT_ENCODER);
         fprintf(stdout, "  -i, --encoder-include-library: generate encoder with builtin library(values: { 0, 1 }, default: %d)\n", DEFAULT_ENCODER_INCLUDE_LIBRARY);
         fprintf(stdout, "  -d, --decoder  : generate decoder (values: { 0, 1 }, default: %d)\n", DEFAULT_DECODER);
         fprintf(stdout, "  -m, --decoder-use-memcpy: decode using memcpy, rather than casting (values: { 0, 1 }, default: %d)\n", DEFAULT_DECODER_USE_MEMCPY);
         fprintf(stdout, "  -j, --jsonify  : generate jsonify (values: { 0, 1 }, default: %d)\n", DEFAULT_JSONIFY);
         fprintf(stdout, "  -n, --namespace: namespace (default: %s)\n", (DEFAULT_NAMESPACE == NULL) ? "(null)" : DEFAULT_NAMESPACE);
+        fprintf(stdout, "  -c, --convert  : generate converter from old schema file to schema (default: %s)\n", (DEFAULT_CONVERT == NULL) ? "(null)" : DEFAULT_CONVERT);
+        fprintf(stdout, "  -r, --reflect  : generate binary reflection schema (values: { 0, 1 }, default: %d)\n", DEFAULT_REFLECT);
         fprintf(stdout, "  -h, --help     : this text\n");
 }
 
@@ -116,11 +141,15 @@ int main (int argc, char *argv[])
         int option_decoder_use_memcpy;
         int option_jsonify;
         const char *option_namespace;
+        const char *option_convert;
+        int option_reflect;
 
         int rc;
         struct schema *schema;
+        struct schema *convert;
 
         schema = NULL;
+        convert = NULL;
         output_file = NULL;
 
         option_schema                   = DEFAULT_SCHEMA;
@@ -133,9 +162,11 @@ int main (int argc, char *argv[])
         option_decoder_use_memcpy       = DEFAULT_DECODER_USE_MEMCPY;
         option_jsonify                  = DEFAULT_JSONIFY;
         option_namespace                = DEFAULT_NAMESPACE;
+        option_convert                  = DEFAULT_CONVERT;
+        option_reflect                  = DEFAULT_REFLECT;
 
         while (1) {
-                c = getopt_long(argc, argv, "s:o:p:l:e:i:d:m:j:n:h", options, &option_index);
+                c = getopt_long(argc, argv, "s:o:p:l:e:i:d:m:j:n:c:r:h", options, &option_index);
                 if (c == -1) {
                         break;
                 }
@@ -245,6 +276,24 @@ int main (int argc, char *argv[])
                         case OPTION_NAMESPACE:
                                 option_namespace = optarg;
                                 break;
+                        case OPTION_CONVERT:
+                                option_convert = optarg;
+                                break;
+                        case OPTION_REFLECT:
+                                if (strcasecmp(optarg, "t") == 0 ||
+                                    strcasecmp(optarg, "true") == 0 ||
+                                    strcasecmp(optarg, "y") == 0 ||
+                                    strcasecmp(optarg, "yes") == 0) {
+                                        option_reflect = 1;
+                                } else if (strcasecmp(optarg, "f") == 0 ||
+                                           strcasecmp(optarg, "false") == 0 ||
+                                           strcasecmp(optarg, "n") == 0 ||
+                                           strcasecmp(optarg, "no") == 0) {
+                                        option_reflect = 0;
+                                } else {
+                                        option_reflect = !!atoi(optarg);
+                                }
+                                break;
                 }
         }
 
@@ -259,12 +308,14 @@ int main (int argc, char *argv[])
         if (option_pretty == 0 &&
             option_encoder == 0 &&
             option_decoder == 0 &&
-            option_jsonify == 0) {
+            option_jsonify == 0 &&
+            option_convert == NULL &&
+            option_reflect == 0) {
                 fprintf(stderr, "nothing to generate\n");
                 goto bail;
         }
-        if (option_pretty && (option_encoder || option_decoder || option_jsonify)) {
-                fprintf(stderr, "pretty and (encoder | decoder | jsonify) are different things\n");
+        if (option_pretty && (option_encoder || option_decoder || option_jsonify || option_convert != NULL || option_reflect)) {
+                fprintf(stderr, "pretty and (encoder | decoder | jsonify | convert | reflect) are different things\n");
                 goto bail;
         }
         for (generator = generators; generator && *generator; generator++) {
@@ -277,6 +328,31 @@ int main (int argc, char *argv[])
                 fprintf(stderr, "language: %s is invalid\n", option_language);
                 goto bail;
         }
+        if (option_encoder &&
+            (*generator)->encoder == NULL) {
+                fprintf(stderr, "language: %s does not support encoder\n", option_language);
+                goto bail;
+        }
+        if ((option_decoder || option_jsonify) &&
+            (*generator)->decoder == NULL) {
+                fprintf(stderr, "language: %s does not support decoder\n", option_language);
+                goto bail;
+        }
+        if (option_jsonify &&
+            (*generator)->jsonify == NULL) {
+                fprintf(stderr, "language: %s does not support jsonify\n", option_language);
+                goto bail;
+        }
+        if (option_convert != NULL &&
+            (*generator)->convert == NULL) {
+                fprintf(stderr, "language: %s does not support convert\n", option_language);
+                goto bail;
+        }
+        if (option_reflect &&
+            (*generator)->reflect == NULL) {
+                fprintf(stderr, "language: %s does not support reflect\n", option_language);
+                goto bail;
+        }
 
         schema = schema_parse_file(option_schema);
         if (schema == NULL) {
@@ -290,6 +366,13 @@ int main (int argc, char *argv[])
                         goto bail;
                 }
         }
+        if (option_convert != NULL) {
+                convert = schema_parse_file(option_convert);
+                if (convert == NULL) {
+                        fprintf(stderr, "can not read schema file: %s\n", option_convert);
+                        goto bail;
+                }
+        }
 
         if (strcmp(option_output, "stdout") == 0) {
                 output_file = stdout;
@@ -339,12 +422,29 @@ int main (int argc, char *argv[])
                         goto bail;
                 }
         }
+        if (option_convert != NULL) {
+                rc = (*generator)->convert(schema, convert, output_file);
+                if (rc != 0) {
+                        fprintf(stderr, "can not generate convert file: %s\n", option_output);
+                        goto bail;
+                }
+        }
+        if (option_reflect) {
+                rc = (*generator)->reflect(schema, output_file);
+                if (rc != 0) {
+                        fprintf(stderr, "can not generate reflect file: %s\n", option_output);
+                        goto bail;
+                }
+        }
 
         if (output_file != NULL &&
             output_file != stdout &&
             output_file != stderr) {
                 fclose(output_file);
         }
+        if (convert != NULL) {
+                schema_destroy(convert);
+        }
         schema_destroy(schema);
 
 out:    return 0;
@@ -358,6 +458,9 @@ bail:   if (output_file != NULL &&
             output_file != stderr) {
                 unlink(option_output);
         }
+        if (convert != NULL) {
+                schema_destroy(convert);
+        }
         if (schema != NULL) {
                 schema_destroy(schema);
         }
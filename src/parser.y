@@ -22,6 +22,7 @@
 %token ENUM
 %token TABLE
 %token STRUCT
+%token UNION
 %token BLOCK
 %token ENDBLOCK
 %token COLON
@@ -61,6 +62,7 @@ Schema:
     |    Schema Option
     |    Schema Enum
     |    Schema Struct
+    |    Schema Union
     |    Schema Table
     ;
 
@@ -85,6 +87,24 @@ Option:
                                                                     fprintf(stderr, "can not set schema offset_type\n");
                                                                     YYERROR;
                                                                 }
+                                                            } else if (strcmp($2, "table_layout") == 0) {
+                                                                rc = schema_set_table_layout(schema_parser->schema, $4);
+                                                                if (rc != 0) {
+                                                                    fprintf(stderr, "can not set schema table_layout\n");
+                                                                    YYERROR;
+                                                                }
+                                                            } else if (strcmp($2, "string_layout") == 0) {
+                                                                rc = schema_set_string_layout(schema_parser->schema, $4);
+                                                                if (rc != 0) {
+                                                                    fprintf(stderr, "can not set schema string_layout\n");
+                                                                    YYERROR;
+                                                                }
+                                                            } else if (strcmp($2, "elide_defaults") == 0) {
+                                                                rc = schema_set_elide_defaults(schema_parser->schema, $4);
+                                                                if (rc != 0) {
+                                                                    fprintf(stderr, "can not set schema elide_defaults\n");
+                                                                    YYERROR;
+                                                                }
                                                             } else {
                                                                 fprintf(stderr, "unknown option: '%s' = '%s';\n", $2, $4);
                                                                 YYERROR;
@@ -233,8 +253,72 @@ Struct:
                                                         }
     ;
 
+Union:
+        UNION STRING BLOCK                              {
+                                                            int rc;
+                                                            schema_parser->schema_table = schema_table_create();
+                                                            if (schema_parser->schema_table == NULL) {
+                                                                fprintf(stderr, "can not create schema table\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_set_name(schema_parser->schema_table, $2);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table name\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_set_type(schema_parser->schema_table, schema_container_type_union);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table type\n");
+                                                                YYERROR;
+                                                            }
+                                                            free($2);
+                                                        }
+            UnionEntries
+        ENDBLOCK                                        {
+                                                            int rc;
+                                                            rc = schema_add_table(schema_parser->schema, schema_parser->schema_table);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not add schema table\n");
+                                                                YYERROR;
+                                                            }
+                                                        }
+    ;
+
+UnionEntries:
+         UnionEntry
+    |    UnionEntries COMMA UnionEntry
+    ;
+
+UnionEntry:
+        STRING                                          {
+                                                            int rc;
+                                                            schema_parser->schema_table_field = schema_table_field_create();
+                                                            if (schema_parser->schema_table_field == NULL) {
+                                                                fprintf(stderr, "can not create schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_name(schema_parser->schema_table_field, $1);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field name\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_type(schema_parser->schema_table_field, schema_container_type_none, $1);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field type\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_add_field(schema_parser->schema_table, schema_parser->schema_table_field);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not add schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            schema_parser->schema_table_field = NULL;
+                                                            free($1);
+                                                        }
+    ;
+
 Table:
-        TABLE STRING BLOCK                              {
+        TABLE STRING                                    {
                                                             int rc;
                                                             schema_parser->schema_table = schema_table_create();
                                                             if (schema_parser->schema_table == NULL) {
@@ -246,8 +330,11 @@ Table:
                                                                 fprintf(stderr, "can not set schema table name\n");
                                                                 YYERROR;
                                                             }
+                                                            schema_parser->schema_table_field = NULL;
                                                             free($2);
                                                         }
+            Attributes
+        BLOCK
             TableFields
         ENDBLOCK                                        {
                                                             int rc;
@@ -366,6 +453,82 @@ TableField:
                                                             schema_parser->schema_table_field = NULL;
                                                         }
 
+    |    STRING COLON BLOCK STRING COLON STRING ENDBLOCK
+                                                        {
+                                                            int rc;
+                                                            schema_parser->schema_table_field = schema_table_field_create();
+                                                            if (schema_parser->schema_table_field == NULL) {
+                                                                fprintf(stderr, "can not create schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_name(schema_parser->schema_table_field, $1);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field name\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_type(schema_parser->schema_table_field, schema_container_type_map, $6);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field type\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_key(schema_parser->schema_table_field, $4);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field key\n");
+                                                                YYERROR;
+                                                            }
+                                                            free($1);
+                                                            free($4);
+                                                            free($6);
+                                                        }
+            Attributes
+        SEMICOLON                                       {
+                                                            int rc;
+                                                            rc = schema_table_add_field(schema_parser->schema_table, schema_parser->schema_table_field);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not add schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            schema_parser->schema_table_field = NULL;
+                                                        }
+
+    |    STRING COLON BRACKET STRING COLON STRING ENDBRACKET
+                                                        {
+                                                            int rc;
+                                                            schema_parser->schema_table_field = schema_table_field_create();
+                                                            if (schema_parser->schema_table_field == NULL) {
+                                                                fprintf(stderr, "can not create schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_name(schema_parser->schema_table_field, $1);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field name\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_type(schema_parser->schema_table_field, schema_container_type_array, $4);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field type\n");
+                                                                YYERROR;
+                                                            }
+                                                            rc = schema_table_field_set_length(schema_parser->schema_table_field, $6);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not set schema table field length\n");
+                                                                YYERROR;
+                                                            }
+                                                            free($1);
+                                                            free($4);
+                                                            free($6);
+                                                        }
+            Attributes
+        SEMICOLON                                       {
+                                                            int rc;
+                                                            rc = schema_table_add_field(schema_parser->schema_table, schema_parser->schema_table_field);
+                                                            if (rc != 0) {
+                                                                fprintf(stderr, "can not add schema table field\n");
+                                                                YYERROR;
+                                                            }
+                                                            schema_parser->schema_table_field = NULL;
+                                                        }
+
     ;
 
 Attributes:
@@ -387,6 +550,12 @@ AttributeEntry:
                                                                     fprintf(stderr, "can not add schema table field attribute\n");
                                                                     YYERROR;
                                                                 }
+                                                            } else if (schema_parser->schema_table != NULL) {
+                                                                rc = schema_table_add_attribute(schema_parser->schema_table, $1, "true");
+                                                                if (rc != 0) {
+                                                                    fprintf(stderr, "can not add schema table attribute\n");
+                                                                    YYERROR;
+                                                                }
                                                             }
                                                             free($1);
                                                         }
@@ -399,6 +568,12 @@ AttributeEntry:
                                                                     fprintf(stderr, "can not add schema table field attribute\n");
                                                                     YYERROR;
                                                                 }
+                                                            } else if (schema_parser->schema_table != NULL) {
+                                                                rc = schema_table_add_attribute(schema_parser->schema_table, $1, $3);
+                                                                if (rc != 0) {
+                                                                    fprintf(stderr, "can not add schema table attribute\n");
+                                                                    YYERROR;
+                                                                }
                                                             }
                                                             free($1);
                                                             free($3);
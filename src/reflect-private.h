@@ -0,0 +1,53 @@
+
+/*
+ * layout of the tables in reflect.lbs, shared by the compiler writing
+ * reflection buffers and the library reading them. a table is an
+ * elements, slots size pair, a field is an element index, slot offset
+ * pair. keep in sync with reflect.lbs.
+ */
+
+#define REFLECT_COUNT_SIZE                      4
+#define REFLECT_OFFSET_SIZE                     4
+
+#define REFLECT_ENUM_FIELD                      2, 12
+#define REFLECT_ENUM_FIELD_NAME                 0, 0
+#define REFLECT_ENUM_FIELD_VALUE                1, 4
+
+#define REFLECT_ENUM                            3, 9
+#define REFLECT_ENUM_NAME                       0, 0
+#define REFLECT_ENUM_TYPE                       1, 4
+#define REFLECT_ENUM_FIELDS                     2, 5
+
+#define REFLECT_FIELD                           12, 45
+#define REFLECT_FIELD_NAME                      0, 0
+#define REFLECT_FIELD_TYPE                      1, 4
+#define REFLECT_FIELD_CONTAINER                 2, 5
+#define REFLECT_FIELD_FLAGS                     3, 6
+#define REFLECT_FIELD_ENCODING                  4, 7
+#define REFLECT_FIELD_REFERENCE                 5, 8
+#define REFLECT_FIELD_KEY_TYPE                  6, 12
+#define REFLECT_FIELD_KEY_REFERENCE             7, 13
+#define REFLECT_FIELD_OFFSET                    8, 17
+#define REFLECT_FIELD_SIZE                      9, 25
+#define REFLECT_FIELD_LENGTH                    10, 33
+#define REFLECT_FIELD_VALUE                     11, 41
+
+#define REFLECT_TABLE                           7, 26
+#define REFLECT_TABLE_NAME                      0, 0
+#define REFLECT_TABLE_CONTAINER                 1, 4
+#define REFLECT_TABLE_COMPACT                   2, 5
+#define REFLECT_TABLE_SIZE                      3, 6
+#define REFLECT_TABLE_FIELDS                    4, 14
+#define REFLECT_TABLE_SEEDS                     5, 18
+#define REFLECT_TABLE_SLOTS                     6, 22
+
+#define REFLECT_SCHEMA                          9, 27
+#define REFLECT_SCHEMA_NAMESPACE                0, 0
+#define REFLECT_SCHEMA_COUNT_SIZE               1, 4
+#define REFLECT_SCHEMA_OFFSET_SIZE              2, 5
+#define REFLECT_SCHEMA_STRING_LAYOUT            3, 6
+#define REFLECT_SCHEMA_ROOT                     4, 7
+#define REFLECT_SCHEMA_ENUMS                    5, 11
+#define REFLECT_SCHEMA_TABLES                   6, 15
+#define REFLECT_SCHEMA_SEEDS                    7, 19
+#define REFLECT_SCHEMA_SLOTS                    8, 23
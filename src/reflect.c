@@ -0,0 +1,1472 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define LINEARBUFFERS_DEBUG_NAME "reflect"
+
+#include "debug.h"
+#include "reflect.h"
+#include "reflect-private.h"
+
+/*
+ * create() validates a reflection buffer written by the compiler, see
+ * reflect.lbs, once and unpacks it into arrays with resolved references,
+ * so field lookups by index are array accesses and lookups by name are a
+ * perfect hash probe and one strcmp.
+ *
+ * objects are (table, buffer, position) cursors into a message. the
+ * input is not assumed to be verified, every read is range checked. a
+ * slot in a non compact table is at a fixed offset, in a compact table
+ * the present fields before it are summed.
+ */
+
+struct linearbuffers_reflect_enum_field {
+        const char *name;
+        int64_t value;
+};
+
+struct linearbuffers_reflect_enum {
+        const char *name;
+        enum linearbuffers_reflect_type type;
+        struct linearbuffers_reflect_enum_field *fields;
+        uint64_t nfields;
+};
+
+struct linearbuffers_reflect_field {
+        const struct linearbuffers_reflect_table *parent;
+        const char *name;
+        uint64_t index;
+        enum linearbuffers_reflect_type type;
+        enum linearbuffers_reflect_type scalar;
+        enum linearbuffers_reflect_container container;
+        enum linearbuffers_reflect_encoding encoding;
+        uint32_t flags;
+        const struct linearbuffers_reflect_table *table;
+        const struct linearbuffers_reflect_enum *anum;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t length;
+        uint64_t element_size;
+        const char *value;
+        int64_t ivalue;
+        uint64_t uvalue;
+        double fvalue;
+};
+
+struct linearbuffers_reflect_table {
+        const struct linearbuffers_reflect *reflect;
+        const char *name;
+        uint64_t index;
+        enum linearbuffers_reflect_container container;
+        int compact;
+        uint64_t size;
+        struct linearbuffers_reflect_field *fields;
+        uint64_t nfields;
+        uint32_t *seeds;
+        uint32_t *slots;
+};
+
+struct linearbuffers_reflect {
+        uint8_t *buffer;
+        uint64_t length;
+        const char *namespace;
+        uint64_t count_size;
+        uint64_t offset_size;
+        int prefixed;
+        struct linearbuffers_reflect_enum *enums;
+        uint64_t nenums;
+        struct linearbuffers_reflect_table *tables;
+        uint64_t ntables;
+        const struct linearbuffers_reflect_table *root;
+        uint32_t *seeds;
+        uint32_t *slots;
+};
+
+static int reflect_range (uint64_t length, uint64_t position, uint64_t size)
+{
+        if (position > length || size > length - position) {
+                return -1;
+        }
+        return 0;
+}
+
+static uint64_t reflect_read (const uint8_t *buffer, uint64_t position, uint64_t size)
+{
+        uint8_t value8;
+        uint16_t value16;
+        uint32_t value32;
+        uint64_t value64;
+        switch (size) {
+                case sizeof(uint8_t):
+                        memcpy(&value8, buffer + position, sizeof(value8));
+                        return value8;
+                case sizeof(uint16_t):
+                        memcpy(&value16, buffer + position, sizeof(value16));
+                        return value16;
+                case sizeof(uint32_t):
+                        memcpy(&value32, buffer + position, sizeof(value32));
+                        return value32;
+        }
+        memcpy(&value64, buffer + position, sizeof(value64));
+        return value64;
+}
+
+static uint64_t reflect_type_size (enum linearbuffers_reflect_type type)
+{
+        switch (type) {
+                case linearbuffers_reflect_type_int8:   return sizeof(int8_t);
+                case linearbuffers_reflect_type_int16:  return sizeof(int16_t);
+                case linearbuffers_reflect_type_int32:  return sizeof(int32_t);
+                case linearbuffers_reflect_type_int64:  return sizeof(int64_t);
+                case linearbuffers_reflect_type_uint8:  return sizeof(uint8_t);
+                case linearbuffers_reflect_type_uint16: return sizeof(uint16_t);
+                case linearbuffers_reflect_type_uint32: return sizeof(uint32_t);
+                case linearbuffers_reflect_type_uint64: return sizeof(uint64_t);
+                case linearbuffers_reflect_type_float:  return sizeof(float);
+                case linearbuffers_reflect_type_double: return sizeof(double);
+                default:                                break;
+        }
+        return 0;
+}
+
+static int reflect_type_is_signed (enum linearbuffers_reflect_type type)
+{
+        return type >= linearbuffers_reflect_type_int8 && type <= linearbuffers_reflect_type_int64;
+}
+
+static int reflect_type_is_float (enum linearbuffers_reflect_type type)
+{
+        return type == linearbuffers_reflect_type_float || type == linearbuffers_reflect_type_double;
+}
+
+static void reflect_number (const uint8_t *buffer, uint64_t position, enum linearbuffers_reflect_type type, int64_t *ivalue, uint64_t *uvalue, double *fvalue)
+{
+        float f32;
+        double f64;
+        uint64_t size;
+        uint64_t value;
+        if (type == linearbuffers_reflect_type_float) {
+                memcpy(&f32, buffer + position, sizeof(f32));
+                *fvalue = f32;
+                *ivalue = f32;
+                *uvalue = f32;
+                return;
+        }
+        if (type == linearbuffers_reflect_type_double) {
+                memcpy(&f64, buffer + position, sizeof(f64));
+                *fvalue = f64;
+                *ivalue = f64;
+                *uvalue = f64;
+                return;
+        }
+        size = reflect_type_size(type);
+        value = reflect_read(buffer, position, size);
+        if (reflect_type_is_signed(type) &&
+            size < sizeof(uint64_t) &&
+            (value & (UINT64_C(1) << (size * 8 - 1)))) {
+                value |= ~((UINT64_C(1) << (size * 8)) - 1);
+        }
+        *uvalue = value;
+        *ivalue = (int64_t) value;
+        *fvalue = (reflect_type_is_signed(type)) ? (double) (int64_t) value : (double) value;
+}
+
+/* reflection buffer readers, element and offset pairs are from reflect-private.h */
+
+static int reflect_slot (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t element, uint64_t offset, uint64_t size, uint64_t *slot)
+{
+        uint64_t count;
+        if (reflect_range(reflect->length, table, REFLECT_COUNT_SIZE) != 0) {
+                return -1;
+        }
+        count = reflect_read(reflect->buffer, table, REFLECT_COUNT_SIZE);
+        if (element >= count) {
+                return 0;
+        }
+        if (reflect_range(reflect->length, table + REFLECT_COUNT_SIZE, (count + 7) / 8) != 0) {
+                return -1;
+        }
+        if (!(reflect->buffer[table + REFLECT_COUNT_SIZE + element / 8] & (1 << (element % 8)))) {
+                return 0;
+        }
+        *slot = table + REFLECT_COUNT_SIZE + (count + 7) / 8 + offset;
+        if (reflect_range(reflect->length, *slot, size) != 0) {
+                return -1;
+        }
+        return 1;
+}
+
+static int reflect_uint (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t element, uint64_t offset, uint64_t size, uint64_t *value)
+{
+        int rc;
+        uint64_t slot;
+        rc = reflect_slot(reflect, table, element, offset, size, &slot);
+        if (rc > 0) {
+                *value = reflect_read(reflect->buffer, slot, size);
+        }
+        return (rc < 0) ? -1 : 0;
+}
+
+static int reflect_child (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t element, uint64_t offset, uint64_t *child)
+{
+        int rc;
+        uint64_t slot;
+        rc = reflect_slot(reflect, table, element, offset, REFLECT_OFFSET_SIZE, &slot);
+        if (rc <= 0) {
+                return rc;
+        }
+        *child = table + reflect_read(reflect->buffer, slot, REFLECT_OFFSET_SIZE);
+        if (*child >= reflect->length) {
+                return -1;
+        }
+        return 1;
+}
+
+static int reflect_string (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t element, uint64_t offset, const char **value)
+{
+        int rc;
+        uint64_t child;
+        *value = NULL;
+        rc = reflect_child(reflect, table, element, offset, &child);
+        if (rc <= 0) {
+                return rc;
+        }
+        if (memchr(reflect->buffer + child, 0, reflect->length - child) == NULL) {
+                return -1;
+        }
+        *value = (const char *) reflect->buffer + child;
+        return 0;
+}
+
+static int reflect_vector (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t element, uint64_t offset, uint64_t element_size, uint64_t *vector, uint64_t *count)
+{
+        int rc;
+        *count = 0;
+        rc = reflect_child(reflect, table, element, offset, vector);
+        if (rc <= 0) {
+                return rc;
+        }
+        if (reflect_range(reflect->length, *vector, REFLECT_COUNT_SIZE) != 0) {
+                return -1;
+        }
+        *count = reflect_read(reflect->buffer, *vector, REFLECT_COUNT_SIZE);
+        if (*count > (reflect->length - *vector - REFLECT_COUNT_SIZE) / element_size) {
+                return -1;
+        }
+        return 0;
+}
+
+static int reflect_vector_table_at (const struct linearbuffers_reflect *reflect, uint64_t vector, uint64_t at, uint64_t *table)
+{
+        uint64_t offset;
+        if (reflect_range(reflect->length, vector + REFLECT_COUNT_SIZE, REFLECT_OFFSET_SIZE) != 0) {
+                return -1;
+        }
+        offset = reflect_read(reflect->buffer, vector + REFLECT_COUNT_SIZE, REFLECT_OFFSET_SIZE);
+        if (reflect_range(reflect->length, vector + offset, (at + 1) * REFLECT_OFFSET_SIZE) != 0) {
+                return -1;
+        }
+        *table = vector + (uint32_t) (offset + reflect_read(reflect->buffer, vector + offset + at * REFLECT_OFFSET_SIZE, REFLECT_OFFSET_SIZE));
+        if (*table >= reflect->length) {
+                return -1;
+        }
+        return 0;
+}
+
+static int reflect_hash (const struct linearbuffers_reflect *reflect, uint64_t table, uint64_t seeds_element, uint64_t seeds_offset, uint64_t slots_element, uint64_t slots_offset, uint64_t n, uint32_t **seeds, uint32_t **slots)
+{
+        int rc;
+        uint64_t i;
+        uint64_t count;
+        uint64_t vector;
+        rc = reflect_vector(reflect, table, seeds_element, seeds_offset, sizeof(uint32_t), &vector, &count);
+        if (rc != 0 || count != n) {
+                return -1;
+        }
+        *seeds = malloc(sizeof(uint32_t) * (n + 1));
+        if (*seeds == NULL) {
+                return -1;
+        }
+        for (i = 0; i < n; i++) {
+                (*seeds)[i] = reflect_read(reflect->buffer, vector + REFLECT_COUNT_SIZE + i * sizeof(uint32_t), sizeof(uint32_t));
+        }
+        rc = reflect_vector(reflect, table, slots_element, slots_offset, sizeof(uint32_t), &vector, &count);
+        if (rc != 0 || count != n) {
+                return -1;
+        }
+        *slots = malloc(sizeof(uint32_t) * (n + 1));
+        if (*slots == NULL) {
+                return -1;
+        }
+        for (i = 0; i < n; i++) {
+                (*slots)[i] = reflect_read(reflect->buffer, vector + REFLECT_COUNT_SIZE + i * sizeof(uint32_t), sizeof(uint32_t));
+                if ((*slots)[i] >= n) {
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+static uint64_t reflect_lookup (const uint32_t *seeds, const uint32_t *slots, uint64_t n, const char *name)
+{
+        uint32_t seed;
+        if (n == 0) {
+                return UINT64_MAX;
+        }
+        seed = seeds[linearbuffers_reflect_hash(name, 0) % n];
+        return slots[linearbuffers_reflect_hash(name, seed) % n];
+}
+
+static int reflect_load_enum (struct linearbuffers_reflect *reflect, uint64_t position, struct linearbuffers_reflect_enum *anum)
+{
+        int rc;
+        uint64_t i;
+        uint64_t type;
+        uint64_t value;
+        uint64_t vector;
+        uint64_t element;
+        type = linearbuffers_reflect_type_none;
+        rc  = reflect_string(reflect, position, REFLECT_ENUM_NAME, &anum->name);
+        rc |= reflect_uint(reflect, position, REFLECT_ENUM_TYPE, sizeof(uint8_t), &type);
+        rc |= reflect_vector(reflect, position, REFLECT_ENUM_FIELDS, REFLECT_OFFSET_SIZE, &vector, &anum->nfields);
+        if (rc != 0 ||
+            anum->name == NULL ||
+            reflect_type_size(type) == 0 ||
+            reflect_type_is_float(type)) {
+                return -1;
+        }
+        anum->type = type;
+        anum->fields = calloc(anum->nfields + 1, sizeof(struct linearbuffers_reflect_enum_field));
+        if (anum->fields == NULL) {
+                return -1;
+        }
+        for (i = 0; i < anum->nfields; i++) {
+                value = 0;
+                rc  = reflect_vector_table_at(reflect, vector, i, &element);
+                rc |= reflect_string(reflect, element, REFLECT_ENUM_FIELD_NAME, &anum->fields[i].name);
+                rc |= reflect_uint(reflect, element, REFLECT_ENUM_FIELD_VALUE, sizeof(int64_t), &value);
+                if (rc != 0 ||
+                    anum->fields[i].name == NULL) {
+                        return -1;
+                }
+                anum->fields[i].value = (int64_t) value;
+        }
+        return 0;
+}
+
+static int reflect_load_value (struct linearbuffers_reflect_field *field)
+{
+        uint64_t i;
+        char *end;
+        if (field->value == NULL) {
+                return 0;
+        }
+        if (reflect_type_is_float(field->scalar)) {
+                field->fvalue = strtod(field->value, &end);
+                field->ivalue = field->fvalue;
+                field->uvalue = field->fvalue;
+                return 0;
+        }
+        if (field->anum != NULL) {
+                for (i = 0; i < field->anum->nfields; i++) {
+                        if (strcmp(field->anum->fields[i].name, field->value) == 0) {
+                                field->ivalue = field->anum->fields[i].value;
+                                field->uvalue = field->ivalue;
+                                field->fvalue = (reflect_type_is_signed(field->scalar)) ? (double) field->ivalue : (double) field->uvalue;
+                                return 0;
+                        }
+                }
+        }
+        if (*field->value == '-') {
+                field->ivalue = strtoll(field->value, &end, 0);
+                field->uvalue = field->ivalue;
+                field->fvalue = field->ivalue;
+        } else {
+                field->uvalue = strtoull(field->value, &end, 0);
+                field->ivalue = field->uvalue;
+                field->fvalue = (reflect_type_is_signed(field->scalar)) ? (double) field->ivalue : (double) field->uvalue;
+        }
+        return 0;
+}
+
+static int reflect_load_field (struct linearbuffers_reflect *reflect, uint64_t position, struct linearbuffers_reflect_table *table, uint64_t index)
+{
+        int rc;
+        uint64_t type;
+        uint64_t container;
+        uint64_t flags;
+        uint64_t encoding;
+        uint64_t reference;
+        struct linearbuffers_reflect_field *field;
+
+        field = &table->fields[index];
+        field->parent = table;
+        field->index = index;
+
+        type = linearbuffers_reflect_type_none;
+        container = linearbuffers_reflect_container_none;
+        flags = 0;
+        encoding = linearbuffers_reflect_encoding_none;
+        reference = UINT32_MAX;
+        rc  = reflect_string(reflect, position, REFLECT_FIELD_NAME, &field->name);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_TYPE, sizeof(uint8_t), &type);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_CONTAINER, sizeof(uint8_t), &container);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_FLAGS, sizeof(uint8_t), &flags);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_ENCODING, sizeof(uint8_t), &encoding);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_REFERENCE, sizeof(uint32_t), &reference);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_OFFSET, sizeof(uint64_t), &field->offset);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_SIZE, sizeof(uint64_t), &field->size);
+        rc |= reflect_uint(reflect, position, REFLECT_FIELD_LENGTH, sizeof(uint64_t), &field->length);
+        rc |= reflect_string(reflect, position, REFLECT_FIELD_VALUE, &field->value);
+        if (rc != 0 ||
+            field->name == NULL ||
+            type > linearbuffers_reflect_type_union ||
+            container > linearbuffers_reflect_container_map ||
+            encoding > linearbuffers_reflect_encoding_delta) {
+                linearbuffers_errorf("field is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        field->type = type;
+        field->scalar = type;
+        field->container = container;
+        field->flags = flags;
+        field->encoding = encoding;
+
+        switch (field->type) {
+                case linearbuffers_reflect_type_none:
+                        linearbuffers_errorf("field type is invalid: %s", field->name);
+                        return -1;
+                case linearbuffers_reflect_type_string:
+                case linearbuffers_reflect_type_table:
+                        field->element_size = reflect->offset_size;
+                        break;
+                case linearbuffers_reflect_type_union:
+                        field->element_size = sizeof(uint8_t) + reflect->offset_size;
+                        break;
+                case linearbuffers_reflect_type_enum:
+                        if (reference >= reflect->nenums) {
+                                linearbuffers_errorf("field enum is invalid: %s", field->name);
+                                return -1;
+                        }
+                        field->anum = &reflect->enums[reference];
+                        field->scalar = field->anum->type;
+                        field->element_size = reflect_type_size(field->scalar);
+                        break;
+                case linearbuffers_reflect_type_struct:
+                        field->element_size = 0;
+                        break;
+                default:
+                        field->element_size = reflect_type_size(field->type);
+                        break;
+        }
+        if (field->type == linearbuffers_reflect_type_table ||
+            field->type == linearbuffers_reflect_type_struct ||
+            field->type == linearbuffers_reflect_type_union) {
+                if (reference >= reflect->ntables) {
+                        linearbuffers_errorf("field table is invalid: %s", field->name);
+                        return -1;
+                }
+                field->table = &reflect->tables[reference];
+        }
+        return reflect_load_value(field);
+}
+
+static int reflect_load_table (struct linearbuffers_reflect *reflect, uint64_t position, struct linearbuffers_reflect_table *table)
+{
+        int rc;
+        uint64_t i;
+        uint64_t vector;
+        uint64_t element;
+        uint64_t container;
+        uint64_t compact;
+
+        container = linearbuffers_reflect_container_none;
+        compact = 0;
+        rc  = reflect_string(reflect, position, REFLECT_TABLE_NAME, &table->name);
+        rc |= reflect_uint(reflect, position, REFLECT_TABLE_CONTAINER, sizeof(uint8_t), &container);
+        rc |= reflect_uint(reflect, position, REFLECT_TABLE_COMPACT, sizeof(uint8_t), &compact);
+        rc |= reflect_uint(reflect, position, REFLECT_TABLE_SIZE, sizeof(uint64_t), &table->size);
+        rc |= reflect_vector(reflect, position, REFLECT_TABLE_FIELDS, REFLECT_OFFSET_SIZE, &vector, &table->nfields);
+        if (rc != 0 ||
+            table->name == NULL ||
+            (container != linearbuffers_reflect_container_none &&
+             container != linearbuffers_reflect_container_struct &&
+             container != linearbuffers_reflect_container_union)) {
+                linearbuffers_errorf("table is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        table->container = container;
+        table->compact = !!compact;
+        table->fields = calloc(table->nfields + 1, sizeof(struct linearbuffers_reflect_field));
+        if (table->fields == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                return -1;
+        }
+        for (i = 0; i < table->nfields; i++) {
+                rc = reflect_vector_table_at(reflect, vector, i, &element);
+                if (rc != 0) {
+                        linearbuffers_errorf("table: %s fields are invalid", table->name);
+                        return -1;
+                }
+                rc = reflect_load_field(reflect, element, table, i);
+                if (rc != 0) {
+                        linearbuffers_errorf("table: %s field: %" PRIu64 " is invalid", table->name, i);
+                        return -1;
+                }
+        }
+        rc = reflect_hash(reflect, position, REFLECT_TABLE_SEEDS, REFLECT_TABLE_SLOTS, table->nfields, &table->seeds, &table->slots);
+        if (rc != 0) {
+                linearbuffers_errorf("table: %s hash is invalid", table->name);
+                return -1;
+        }
+        return 0;
+}
+
+static int reflect_check_table (struct linearbuffers_reflect_table *table)
+{
+        uint64_t i;
+        struct linearbuffers_reflect_field *field;
+        for (i = 0; i < table->nfields; i++) {
+                field = &table->fields[i];
+                if (field->type == linearbuffers_reflect_type_struct) {
+                        if (field->table->container != linearbuffers_reflect_container_struct ||
+                            field->table->index >= table->index) {
+                                return -1;
+                        }
+                        field->element_size = field->table->size;
+                } else if (field->type == linearbuffers_reflect_type_union) {
+                        if (field->table->container != linearbuffers_reflect_container_union) {
+                                return -1;
+                        }
+                } else if (field->type == linearbuffers_reflect_type_table) {
+                        if (field->table->container != linearbuffers_reflect_container_none) {
+                                return -1;
+                        }
+                }
+                if (field->element_size == 0 ||
+                    field->offset > table->size ||
+                    field->size > table->size - field->offset) {
+                        return -1;
+                }
+                if (field->container == linearbuffers_reflect_container_array &&
+                    field->size != field->element_size * field->length) {
+                        return -1;
+                }
+                if (table->container == linearbuffers_reflect_container_union &&
+                    field->type != linearbuffers_reflect_type_table) {
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+__attribute__ ((__visibility__("default"))) struct linearbuffers_reflect * linearbuffers_reflect_create (const void *buffer, uint64_t length)
+{
+        int rc;
+        uint64_t i;
+        uint64_t root;
+        uint64_t vector;
+        uint64_t element;
+        uint64_t count_size;
+        uint64_t offset_size;
+        uint64_t string_layout;
+        struct linearbuffers_reflect *reflect;
+
+        reflect = NULL;
+        if (buffer == NULL) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        reflect = calloc(1, sizeof(struct linearbuffers_reflect));
+        if (reflect == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        reflect->buffer = malloc((length == 0) ? 1 : length);
+        if (reflect->buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memcpy(reflect->buffer, buffer, length);
+        reflect->length = length;
+
+        root = UINT32_MAX;
+        count_size = 0;
+        offset_size = 0;
+        string_layout = 0;
+        rc  = reflect_string(reflect, 0, REFLECT_SCHEMA_NAMESPACE, &reflect->namespace);
+        rc |= reflect_uint(reflect, 0, REFLECT_SCHEMA_COUNT_SIZE, sizeof(uint8_t), &count_size);
+        rc |= reflect_uint(reflect, 0, REFLECT_SCHEMA_OFFSET_SIZE, sizeof(uint8_t), &offset_size);
+        rc |= reflect_uint(reflect, 0, REFLECT_SCHEMA_STRING_LAYOUT, sizeof(uint8_t), &string_layout);
+        rc |= reflect_uint(reflect, 0, REFLECT_SCHEMA_ROOT, sizeof(uint32_t), &root);
+        if (rc != 0 ||
+            (count_size != 1 && count_size != 2 && count_size != 4 && count_size != 8) ||
+            (offset_size != 1 && offset_size != 2 && offset_size != 4 && offset_size != 8)) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        reflect->count_size = count_size;
+        reflect->offset_size = offset_size;
+        reflect->prefixed = (string_layout != 0);
+
+        rc = reflect_vector(reflect, 0, REFLECT_SCHEMA_ENUMS, REFLECT_OFFSET_SIZE, &vector, &reflect->nenums);
+        if (rc != 0) {
+                linearbuffers_errorf("enums are invalid");
+                goto bail;
+        }
+        reflect->enums = calloc(reflect->nenums + 1, sizeof(struct linearbuffers_reflect_enum));
+        if (reflect->enums == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        for (i = 0; i < reflect->nenums; i++) {
+                rc  = reflect_vector_table_at(reflect, vector, i, &element);
+                rc |= reflect_load_enum(reflect, element, &reflect->enums[i]);
+                if (rc != 0) {
+                        linearbuffers_errorf("enum: %" PRIu64 " is invalid", i);
+                        goto bail;
+                }
+        }
+
+        rc = reflect_vector(reflect, 0, REFLECT_SCHEMA_TABLES, REFLECT_OFFSET_SIZE, &vector, &reflect->ntables);
+        if (rc != 0) {
+                linearbuffers_errorf("tables are invalid");
+                goto bail;
+        }
+        reflect->tables = calloc(reflect->ntables + 1, sizeof(struct linearbuffers_reflect_table));
+        if (reflect->tables == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        for (i = 0; i < reflect->ntables; i++) {
+                reflect->tables[i].reflect = reflect;
+                reflect->tables[i].index = i;
+        }
+        for (i = 0; i < reflect->ntables; i++) {
+                rc  = reflect_vector_table_at(reflect, vector, i, &element);
+                rc |= reflect_load_table(reflect, element, &reflect->tables[i]);
+                if (rc != 0) {
+                        linearbuffers_errorf("table: %" PRIu64 " is invalid", i);
+                        goto bail;
+                }
+        }
+        for (i = 0; i < reflect->ntables; i++) {
+                rc = reflect_check_table(&reflect->tables[i]);
+                if (rc != 0) {
+                        linearbuffers_errorf("table: %s is invalid", reflect->tables[i].name);
+                        goto bail;
+                }
+        }
+        rc = reflect_hash(reflect, 0, REFLECT_SCHEMA_SEEDS, REFLECT_SCHEMA_SLOTS, reflect->ntables, &reflect->seeds, &reflect->slots);
+        if (rc != 0) {
+                linearbuffers_errorf("hash is invalid");
+                goto bail;
+        }
+        if (root != UINT32_MAX) {
+                if (root >= reflect->ntables ||
+                    reflect->tables[root].container != linearbuffers_reflect_container_none) {
+                        linearbuffers_errorf("root is invalid");
+                        goto bail;
+                }
+                reflect->root = &reflect->tables[root];
+        }
+        return reflect;
+bail:   if (reflect != NULL) {
+                linearbuffers_reflect_destroy(reflect);
+        }
+        return NULL;
+}
+
+__attribute__ ((__visibility__("default"))) void linearbuffers_reflect_destroy (struct linearbuffers_reflect *reflect)
+{
+        uint64_t i;
+        if (reflect == NULL) {
+                return;
+        }
+        if (reflect->tables != NULL) {
+                for (i = 0; i < reflect->ntables; i++) {
+                        free(reflect->tables[i].fields);
+                        free(reflect->tables[i].seeds);
+                        free(reflect->tables[i].slots);
+                }
+                free(reflect->tables);
+        }
+        if (reflect->enums != NULL) {
+                for (i = 0; i < reflect->nenums; i++) {
+                        free(reflect->enums[i].fields);
+                }
+                free(reflect->enums);
+        }
+        free(reflect->seeds);
+        free(reflect->slots);
+        free(reflect->buffer);
+        free(reflect);
+}
+
+__attribute__ ((__visibility__("default"))) const char * linearbuffers_reflect_namespace (const struct linearbuffers_reflect *reflect)
+{
+        if (reflect == NULL) {
+                return NULL;
+        }
+        return reflect->namespace;
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_table * linearbuffers_reflect_root (const struct linearbuffers_reflect *reflect)
+{
+        if (reflect == NULL) {
+                return NULL;
+        }
+        return reflect->root;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_reflect_table_count (const struct linearbuffers_reflect *reflect)
+{
+        if (reflect == NULL) {
+                return 0;
+        }
+        return reflect->ntables;
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_table * linearbuffers_reflect_table_at (const struct linearbuffers_reflect *reflect, uint64_t at)
+{
+        if (reflect == NULL ||
+            at >= reflect->ntables) {
+                return NULL;
+        }
+        return &reflect->tables[at];
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_table * linearbuffers_reflect_table_lookup (const struct linearbuffers_reflect *reflect, const char *name)
+{
+        uint64_t at;
+        if (reflect == NULL ||
+            name == NULL) {
+                return NULL;
+        }
+        at = reflect_lookup(reflect->seeds, reflect->slots, reflect->ntables, name);
+        if (at >= reflect->ntables ||
+            strcmp(reflect->tables[at].name, name) != 0) {
+                return NULL;
+        }
+        return &reflect->tables[at];
+}
+
+__attribute__ ((__visibility__("default"))) const char * linearbuffers_reflect_table_name (const struct linearbuffers_reflect_table *table)
+{
+        if (table == NULL) {
+                return NULL;
+        }
+        return table->name;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_reflect_table_index (const struct linearbuffers_reflect_table *table)
+{
+        if (table == NULL) {
+                return UINT64_MAX;
+        }
+        return table->index;
+}
+
+__attribute__ ((__visibility__("default"))) enum linearbuffers_reflect_container linearbuffers_reflect_table_container (const struct linearbuffers_reflect_table *table)
+{
+        if (table == NULL) {
+                return linearbuffers_reflect_container_none;
+        }
+        return table->container;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_table_is_compact (const struct linearbuffers_reflect_table *table)
+{
+        if (table == NULL) {
+                return 0;
+        }
+        return table->compact;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_reflect_table_field_count (const struct linearbuffers_reflect_table *table)
+{
+        if (table == NULL) {
+                return 0;
+        }
+        return table->nfields;
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_field * linearbuffers_reflect_table_field_at (const struct linearbuffers_reflect_table *table, uint64_t at)
+{
+        if (table == NULL ||
+            at >= table->nfields) {
+                return NULL;
+        }
+        return &table->fields[at];
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_field * linearbuffers_reflect_table_field_lookup (const struct linearbuffers_reflect_table *table, const char *name)
+{
+        uint64_t at;
+        if (table == NULL ||
+            name == NULL) {
+                return NULL;
+        }
+        at = reflect_lookup(table->seeds, table->slots, table->nfields, name);
+        if (at >= table->nfields ||
+            strcmp(table->fields[at].name, name) != 0) {
+                return NULL;
+        }
+        return &table->fields[at];
+}
+
+__attribute__ ((__visibility__("default"))) const char * linearbuffers_reflect_field_name (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return NULL;
+        }
+        return field->name;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_reflect_field_index (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return UINT64_MAX;
+        }
+        return field->index;
+}
+
+__attribute__ ((__visibility__("default"))) enum linearbuffers_reflect_type linearbuffers_reflect_field_type (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return linearbuffers_reflect_type_none;
+        }
+        return field->type;
+}
+
+__attribute__ ((__visibility__("default"))) enum linearbuffers_reflect_type linearbuffers_reflect_field_scalar_type (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return linearbuffers_reflect_type_none;
+        }
+        return field->scalar;
+}
+
+__attribute__ ((__visibility__("default"))) enum linearbuffers_reflect_container linearbuffers_reflect_field_container (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return linearbuffers_reflect_container_none;
+        }
+        return field->container;
+}
+
+__attribute__ ((__visibility__("default"))) enum linearbuffers_reflect_encoding linearbuffers_reflect_field_encoding (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return linearbuffers_reflect_encoding_none;
+        }
+        return field->encoding;
+}
+
+__attribute__ ((__visibility__("default"))) uint32_t linearbuffers_reflect_field_flags (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return 0;
+        }
+        return field->flags;
+}
+
+__attribute__ ((__visibility__("default"))) uint64_t linearbuffers_reflect_field_length (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return 0;
+        }
+        return field->length;
+}
+
+__attribute__ ((__visibility__("default"))) const char * linearbuffers_reflect_field_value (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return NULL;
+        }
+        return field->value;
+}
+
+__attribute__ ((__visibility__("default"))) const struct linearbuffers_reflect_table * linearbuffers_reflect_field_table (const struct linearbuffers_reflect_field *field)
+{
+        if (field == NULL) {
+                return NULL;
+        }
+        return field->table;
+}
+
+__attribute__ ((__visibility__("default"))) const char * linearbuffers_reflect_field_enum_name (const struct linearbuffers_reflect_field *field, int64_t value)
+{
+        uint64_t i;
+        if (field == NULL ||
+            field->anum == NULL) {
+                return NULL;
+        }
+        for (i = 0; i < field->anum->nfields; i++) {
+                if (field->anum->fields[i].value == value) {
+                        return field->anum->fields[i].name;
+                }
+        }
+        return NULL;
+}
+
+static int reflect_object_check (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field)
+{
+        if (object == NULL ||
+            object->table == NULL ||
+            object->buffer == NULL) {
+                linearbuffers_errorf("object is invalid");
+                return -1;
+        }
+        if (field == NULL ||
+            field->parent != object->table) {
+                linearbuffers_errorf("field is invalid");
+                return -1;
+        }
+        return 0;
+}
+
+static int reflect_object_slot (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t *slot)
+{
+        uint64_t i;
+        uint64_t count;
+        uint64_t count_size;
+        const uint8_t *present;
+        if (object->table->container == linearbuffers_reflect_container_struct) {
+                *slot = object->position + field->offset;
+                if (reflect_range(object->length, *slot, field->size) != 0) {
+                        linearbuffers_errorf("struct is truncated at: %" PRIu64 "", object->position);
+                        return -1;
+                }
+                return 1;
+        }
+        count_size = object->reflect->count_size;
+        if (reflect_range(object->length, object->position, count_size) != 0) {
+                linearbuffers_errorf("table is truncated at: %" PRIu64 "", object->position);
+                return -1;
+        }
+        count = reflect_read(object->buffer, object->position, count_size);
+        if (field->index >= count) {
+                return 0;
+        }
+        if (reflect_range(object->length, object->position + count_size, (count + 7) / 8) != 0) {
+                linearbuffers_errorf("table is truncated at: %" PRIu64 "", object->position);
+                return -1;
+        }
+        present = object->buffer + object->position + count_size;
+        if (!(present[field->index / 8] & (1 << (field->index % 8)))) {
+                return 0;
+        }
+        *slot = object->position + count_size + (count + 7) / 8;
+        if (object->table->compact) {
+                for (i = 0; i < field->index; i++) {
+                        if (present[i / 8] & (1 << (i % 8))) {
+                                *slot += object->table->fields[i].size;
+                        }
+                }
+        } else {
+                *slot += field->offset;
+        }
+        if (reflect_range(object->length, *slot, field->size) != 0) {
+                linearbuffers_errorf("table is truncated at: %" PRIu64 "", object->position);
+                return -1;
+        }
+        return 1;
+}
+
+static int reflect_object_child (const struct linearbuffers_reflect_object *object, uint64_t slot, uint64_t *child)
+{
+        uint64_t offset;
+        offset = reflect_read(object->buffer, slot, object->reflect->offset_size);
+        if (object->table->compact) {
+                if (offset > object->position) {
+                        linearbuffers_errorf("offset is invalid at: %" PRIu64 "", slot);
+                        return -1;
+                }
+                *child = object->position - offset;
+        } else {
+                if (offset >= object->length - object->position) {
+                        linearbuffers_errorf("offset is invalid at: %" PRIu64 "", slot);
+                        return -1;
+                }
+                *child = object->position + offset;
+        }
+        return 0;
+}
+
+static int reflect_object_string (const struct linearbuffers_reflect_object *object, uint64_t position, const char **value, uint64_t *length)
+{
+        const uint8_t *end;
+        uint64_t count_size;
+        if (position >= object->length) {
+                linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        if (object->reflect->prefixed) {
+                count_size = object->reflect->count_size;
+                if (position < count_size) {
+                        linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+                *length = reflect_read(object->buffer, position - count_size, count_size);
+                if (*length >= object->length - position ||
+                    object->buffer[position + *length] != 0) {
+                        linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+        } else {
+                end = memchr(object->buffer + position, 0, object->length - position);
+                if (end == NULL) {
+                        linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+                *length = end - (object->buffer + position);
+        }
+        *value = (const char *) object->buffer + position;
+        return 0;
+}
+
+static void reflect_object_clear (const struct linearbuffers_reflect_object *object, struct linearbuffers_reflect_object *value)
+{
+        value->reflect = object->reflect;
+        value->table = NULL;
+        value->buffer = NULL;
+        value->length = 0;
+        value->position = 0;
+}
+
+static void reflect_object_set (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_table *table, uint64_t position, struct linearbuffers_reflect_object *value)
+{
+        value->reflect = object->reflect;
+        value->table = table;
+        value->buffer = object->buffer;
+        value->length = object->length;
+        value->position = position;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_root (const struct linearbuffers_reflect *reflect, const struct linearbuffers_reflect_table *table, const void *buffer, uint64_t length, struct linearbuffers_reflect_object *object)
+{
+        if (reflect == NULL) {
+                linearbuffers_errorf("reflect is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                table = reflect->root;
+        }
+        if (table == NULL ||
+            table->reflect != reflect ||
+            table->container != linearbuffers_reflect_container_none) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (buffer == NULL) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        if (object == NULL) {
+                linearbuffers_errorf("object is invalid");
+                goto bail;
+        }
+        object->reflect = reflect;
+        object->table = table;
+        object->buffer = buffer;
+        object->length = length;
+        object->position = 0;
+        if (table->compact) {
+                if (reflect_range(length, 0, reflect->offset_size) != 0) {
+                        linearbuffers_errorf("buffer is truncated");
+                        goto bail;
+                }
+                object->position = reflect_read(buffer, 0, reflect->offset_size);
+        }
+        if (reflect_range(length, object->position, reflect->count_size) != 0) {
+                linearbuffers_errorf("buffer is truncated");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_present (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field)
+{
+        uint64_t slot;
+        if (reflect_object_check(object, field) != 0) {
+                return 0;
+        }
+        return reflect_object_slot(object, field, &slot) > 0;
+}
+
+static int reflect_object_number (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, int64_t *ivalue, uint64_t *uvalue, double *fvalue)
+{
+        int rc;
+        uint64_t slot;
+        if (reflect_object_check(object, field) != 0) {
+                return -1;
+        }
+        if (field->container != linearbuffers_reflect_container_none ||
+            (reflect_type_size(field->scalar) == 0 &&
+             field->type != linearbuffers_reflect_type_union)) {
+                linearbuffers_errorf("field: %s is not a number", field->name);
+                return -1;
+        }
+        rc = reflect_object_slot(object, field, &slot);
+        if (rc < 0) {
+                return -1;
+        }
+        if (rc == 0) {
+                *ivalue = field->ivalue;
+                *uvalue = field->uvalue;
+                *fvalue = field->fvalue;
+                return 0;
+        }
+        if (field->type == linearbuffers_reflect_type_union) {
+                reflect_number(object->buffer, slot, linearbuffers_reflect_type_uint8, ivalue, uvalue, fvalue);
+        } else {
+                reflect_number(object->buffer, slot, field->scalar, ivalue, uvalue, fvalue);
+        }
+        return 0;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_int (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, int64_t *value)
+{
+        uint64_t uvalue;
+        double fvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number(object, field, value, &uvalue, &fvalue);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_uint (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t *value)
+{
+        int64_t ivalue;
+        double fvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number(object, field, &ivalue, value, &fvalue);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_float (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, double *value)
+{
+        int64_t ivalue;
+        uint64_t uvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number(object, field, &ivalue, &uvalue, value);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_string (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, const char **value, uint64_t *length)
+{
+        int rc;
+        uint64_t slot;
+        uint64_t child;
+        uint64_t size;
+        if (reflect_object_check(object, field) != 0) {
+                return -1;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        if (field->container != linearbuffers_reflect_container_none ||
+            field->type != linearbuffers_reflect_type_string) {
+                linearbuffers_errorf("field: %s is not a string", field->name);
+                return -1;
+        }
+        *value = NULL;
+        size = 0;
+        rc = reflect_object_slot(object, field, &slot);
+        if (rc > 0) {
+                rc  = reflect_object_child(object, slot, &child);
+                rc |= reflect_object_string(object, child, value, &size);
+        }
+        if (length != NULL) {
+                *length = size;
+        }
+        return (rc < 0) ? -1 : 0;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_object (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, struct linearbuffers_reflect_object *value)
+{
+        int rc;
+        uint8_t type;
+        uint64_t slot;
+        uint64_t child;
+        struct linearbuffers_reflect_object member;
+        if (reflect_object_check(object, field) != 0) {
+                return -1;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        if (field->container != linearbuffers_reflect_container_none ||
+            field->table == NULL) {
+                linearbuffers_errorf("field: %s is not an object", field->name);
+                return -1;
+        }
+        reflect_object_clear(object, value);
+        rc = reflect_object_slot(object, field, &slot);
+        if (rc <= 0) {
+                return rc;
+        }
+        if (field->type == linearbuffers_reflect_type_struct) {
+                reflect_object_set(object, field->table, slot, value);
+                return 0;
+        }
+        if (field->type == linearbuffers_reflect_type_union) {
+                type = object->buffer[slot];
+                if (type == 0) {
+                        return 0;
+                }
+                if (type > field->table->nfields) {
+                        linearbuffers_errorf("union type is invalid at: %" PRIu64 "", slot);
+                        return -1;
+                }
+                rc = reflect_object_child(object, slot + 1, &child);
+                if (rc != 0) {
+                        return -1;
+                }
+                reflect_object_set(object, field->table->fields[type - 1].table, child, &member);
+        } else {
+                rc = reflect_object_child(object, slot, &child);
+                if (rc != 0) {
+                        return -1;
+                }
+                reflect_object_set(object, field->table, child, &member);
+        }
+        if (reflect_range(member.length, member.position, object->reflect->count_size) != 0) {
+                linearbuffers_errorf("table is truncated at: %" PRIu64 "", member.position);
+                return -1;
+        }
+        *value = member;
+        return 0;
+}
+
+/*
+ * resolves element at of a vector or array field to a position, for
+ * string and table vectors through the offset table.
+ */
+static int reflect_object_element (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, uint64_t *count, uint64_t *position)
+{
+        int rc;
+        uint64_t slot;
+        uint64_t child;
+        uint64_t offset;
+        uint64_t entry;
+        uint64_t mask;
+        uint64_t count_size;
+        uint64_t offset_size;
+        if (reflect_object_check(object, field) != 0) {
+                return -1;
+        }
+        if (field->container == linearbuffers_reflect_container_array) {
+                *count = field->length;
+                rc = reflect_object_slot(object, field, &slot);
+                if (rc <= 0) {
+                        *count = 0;
+                        return rc;
+                }
+                if (at < *count) {
+                        *position = slot + at * field->element_size;
+                }
+                return 1;
+        }
+        if (field->container != linearbuffers_reflect_container_vector) {
+                linearbuffers_errorf("field: %s is not a vector", field->name);
+                return -1;
+        }
+        if (field->encoding != linearbuffers_reflect_encoding_none ||
+            (field->flags & linearbuffers_reflect_flag_dictionary)) {
+                linearbuffers_errorf("field: %s vector encoding is not supported", field->name);
+                return -1;
+        }
+        *count = 0;
+        rc = reflect_object_slot(object, field, &slot);
+        if (rc <= 0) {
+                return rc;
+        }
+        rc = reflect_object_child(object, slot, &child);
+        if (rc != 0) {
+                return -1;
+        }
+        count_size = object->reflect->count_size;
+        offset_size = object->reflect->offset_size;
+        if (reflect_range(object->length, child, count_size) != 0) {
+                linearbuffers_errorf("vector is truncated at: %" PRIu64 "", child);
+                return -1;
+        }
+        *count = reflect_read(object->buffer, child, count_size);
+        if (field->type != linearbuffers_reflect_type_string &&
+            field->type != linearbuffers_reflect_type_table) {
+                if (*count > (object->length - child - count_size) / field->element_size) {
+                        linearbuffers_errorf("vector is truncated at: %" PRIu64 "", child);
+                        return -1;
+                }
+                if (at < *count) {
+                        *position = child + count_size + at * field->element_size;
+                }
+                return 1;
+        }
+        if (at >= *count) {
+                return 1;
+        }
+        if (reflect_range(object->length, child + count_size, offset_size) != 0) {
+                linearbuffers_errorf("vector is truncated at: %" PRIu64 "", child);
+                return -1;
+        }
+        offset = reflect_read(object->buffer, child + count_size, offset_size);
+        if (reflect_range(object->length, child, offset) != 0 ||
+            at >= (object->length - child - offset) / offset_size) {
+                linearbuffers_errorf("vector is invalid at: %" PRIu64 "", child);
+                return -1;
+        }
+        mask = (offset_size < sizeof(uint64_t)) ? ((UINT64_C(1) << (offset_size * 8)) - 1) : UINT64_MAX;
+        entry = (offset + reflect_read(object->buffer, child + offset + at * offset_size, offset_size)) & mask;
+        if (entry >= object->length - child) {
+                linearbuffers_errorf("vector is invalid at: %" PRIu64 "", child);
+                return -1;
+        }
+        *position = child + entry;
+        return 1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_count (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t *count)
+{
+        int rc;
+        uint64_t position;
+        if (count == NULL) {
+                linearbuffers_errorf("count is invalid");
+                return -1;
+        }
+        rc = reflect_object_element(object, field, UINT64_MAX, count, &position);
+        return (rc < 0) ? -1 : 0;
+}
+
+static int reflect_object_number_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, int64_t *ivalue, uint64_t *uvalue, double *fvalue)
+{
+        int rc;
+        uint64_t count;
+        uint64_t position;
+        if (field != NULL &&
+            reflect_type_size(field->scalar) == 0) {
+                linearbuffers_errorf("field: %s is not a number", field->name);
+                return -1;
+        }
+        rc = reflect_object_element(object, field, at, &count, &position);
+        if (rc < 0) {
+                return -1;
+        }
+        if (at >= count) {
+                linearbuffers_errorf("at: %" PRIu64 " is out of range", at);
+                return -1;
+        }
+        reflect_number(object->buffer, position, field->scalar, ivalue, uvalue, fvalue);
+        return 0;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_int_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, int64_t *value)
+{
+        uint64_t uvalue;
+        double fvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number_at(object, field, at, value, &uvalue, &fvalue);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_uint_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, uint64_t *value)
+{
+        int64_t ivalue;
+        double fvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number_at(object, field, at, &ivalue, value, &fvalue);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_float_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, double *value)
+{
+        int64_t ivalue;
+        uint64_t uvalue;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        return reflect_object_number_at(object, field, at, &ivalue, &uvalue, value);
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_string_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, const char **value, uint64_t *length)
+{
+        int rc;
+        uint64_t size;
+        uint64_t count;
+        uint64_t position;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        if (field != NULL &&
+            field->type != linearbuffers_reflect_type_string) {
+                linearbuffers_errorf("field: %s is not a string", field->name);
+                return -1;
+        }
+        rc = reflect_object_element(object, field, at, &count, &position);
+        if (rc < 0) {
+                return -1;
+        }
+        if (at >= count) {
+                linearbuffers_errorf("at: %" PRIu64 " is out of range", at);
+                return -1;
+        }
+        rc = reflect_object_string(object, position, value, &size);
+        if (rc != 0) {
+                return -1;
+        }
+        if (length != NULL) {
+                *length = size;
+        }
+        return 0;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_reflect_object_get_object_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, struct linearbuffers_reflect_object *value)
+{
+        int rc;
+        uint64_t count;
+        uint64_t position;
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                return -1;
+        }
+        if (field != NULL &&
+            field->type != linearbuffers_reflect_type_table &&
+            field->type != linearbuffers_reflect_type_struct) {
+                linearbuffers_errorf("field: %s is not an object", field->name);
+                return -1;
+        }
+        rc = reflect_object_element(object, field, at, &count, &position);
+        if (rc < 0) {
+                return -1;
+        }
+        if (at >= count) {
+                linearbuffers_errorf("at: %" PRIu64 " is out of range", at);
+                return -1;
+        }
+        reflect_object_set(object, field->table, position, value);
+        if (field->type == linearbuffers_reflect_type_table &&
+            reflect_range(value->length, value->position, object->reflect->count_size) != 0) {
+                linearbuffers_errorf("table is truncated at: %" PRIu64 "", position);
+                return -1;
+        }
+        return 0;
+}
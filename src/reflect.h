@@ -0,0 +1,125 @@
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if !defined(LINEARBUFFERS_REFLECT_H)
+#define LINEARBUFFERS_REFLECT_H
+
+struct linearbuffers_reflect;
+struct linearbuffers_reflect_table;
+struct linearbuffers_reflect_field;
+
+enum linearbuffers_reflect_type {
+	linearbuffers_reflect_type_none,
+	linearbuffers_reflect_type_int8,
+	linearbuffers_reflect_type_int16,
+	linearbuffers_reflect_type_int32,
+	linearbuffers_reflect_type_int64,
+	linearbuffers_reflect_type_uint8,
+	linearbuffers_reflect_type_uint16,
+	linearbuffers_reflect_type_uint32,
+	linearbuffers_reflect_type_uint64,
+	linearbuffers_reflect_type_float,
+	linearbuffers_reflect_type_double,
+	linearbuffers_reflect_type_string,
+	linearbuffers_reflect_type_enum,
+	linearbuffers_reflect_type_table,
+	linearbuffers_reflect_type_struct,
+	linearbuffers_reflect_type_union
+};
+
+enum linearbuffers_reflect_container {
+	linearbuffers_reflect_container_none,
+	linearbuffers_reflect_container_vector,
+	linearbuffers_reflect_container_struct,
+	linearbuffers_reflect_container_array,
+	linearbuffers_reflect_container_union,
+	linearbuffers_reflect_container_map
+};
+
+enum linearbuffers_reflect_encoding {
+	linearbuffers_reflect_encoding_none,
+	linearbuffers_reflect_encoding_bitpack,
+	linearbuffers_reflect_encoding_for,
+	linearbuffers_reflect_encoding_delta
+};
+
+enum linearbuffers_reflect_flag {
+	linearbuffers_reflect_flag_deprecated	= 0x01,
+	linearbuffers_reflect_flag_key		= 0x02,
+	linearbuffers_reflect_flag_dictionary	= 0x04
+};
+
+struct linearbuffers_reflect_object {
+	const struct linearbuffers_reflect *reflect;
+	const struct linearbuffers_reflect_table *table;
+	const uint8_t *buffer;
+	uint64_t length;
+	uint64_t position;
+};
+
+static inline uint32_t linearbuffers_reflect_hash (const char *name, uint32_t seed)
+{
+	uint32_t hash;
+	hash = UINT32_C(0x811c9dc5) ^ (seed * UINT32_C(0x9e3779b9));
+	while (*name != '\0') {
+		hash ^= (uint8_t) *name++;
+		hash *= UINT32_C(0x01000193);
+	}
+	hash ^= hash >> 16;
+	hash *= UINT32_C(0x85ebca6b);
+	hash ^= hash >> 13;
+	return hash;
+}
+
+struct linearbuffers_reflect * linearbuffers_reflect_create (const void *buffer, uint64_t length);
+void linearbuffers_reflect_destroy (struct linearbuffers_reflect *reflect);
+
+const char * linearbuffers_reflect_namespace (const struct linearbuffers_reflect *reflect);
+const struct linearbuffers_reflect_table * linearbuffers_reflect_root (const struct linearbuffers_reflect *reflect);
+uint64_t linearbuffers_reflect_table_count (const struct linearbuffers_reflect *reflect);
+const struct linearbuffers_reflect_table * linearbuffers_reflect_table_at (const struct linearbuffers_reflect *reflect, uint64_t at);
+const struct linearbuffers_reflect_table * linearbuffers_reflect_table_lookup (const struct linearbuffers_reflect *reflect, const char *name);
+
+const char * linearbuffers_reflect_table_name (const struct linearbuffers_reflect_table *table);
+uint64_t linearbuffers_reflect_table_index (const struct linearbuffers_reflect_table *table);
+enum linearbuffers_reflect_container linearbuffers_reflect_table_container (const struct linearbuffers_reflect_table *table);
+int linearbuffers_reflect_table_is_compact (const struct linearbuffers_reflect_table *table);
+uint64_t linearbuffers_reflect_table_field_count (const struct linearbuffers_reflect_table *table);
+const struct linearbuffers_reflect_field * linearbuffers_reflect_table_field_at (const struct linearbuffers_reflect_table *table, uint64_t at);
+const struct linearbuffers_reflect_field * linearbuffers_reflect_table_field_lookup (const struct linearbuffers_reflect_table *table, const char *name);
+
+const char * linearbuffers_reflect_field_name (const struct linearbuffers_reflect_field *field);
+uint64_t linearbuffers_reflect_field_index (const struct linearbuffers_reflect_field *field);
+enum linearbuffers_reflect_type linearbuffers_reflect_field_type (const struct linearbuffers_reflect_field *field);
+enum linearbuffers_reflect_type linearbuffers_reflect_field_scalar_type (const struct linearbuffers_reflect_field *field);
+enum linearbuffers_reflect_container linearbuffers_reflect_field_container (const struct linearbuffers_reflect_field *field);
+enum linearbuffers_reflect_encoding linearbuffers_reflect_field_encoding (const struct linearbuffers_reflect_field *field);
+uint32_t linearbuffers_reflect_field_flags (const struct linearbuffers_reflect_field *field);
+uint64_t linearbuffers_reflect_field_length (const struct linearbuffers_reflect_field *field);
+const char * linearbuffers_reflect_field_value (const struct linearbuffers_reflect_field *field);
+const struct linearbuffers_reflect_table * linearbuffers_reflect_field_table (const struct linearbuffers_reflect_field *field);
+const char * linearbuffers_reflect_field_enum_name (const struct linearbuffers_reflect_field *field, int64_t value);
+
+int linearbuffers_reflect_object_root (const struct linearbuffers_reflect *reflect, const struct linearbuffers_reflect_table *table, const void *buffer, uint64_t length, struct linearbuffers_reflect_object *object);
+int linearbuffers_reflect_object_present (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field);
+
+int linearbuffers_reflect_object_get_int (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, int64_t *value);
+int linearbuffers_reflect_object_get_uint (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t *value);
+int linearbuffers_reflect_object_get_float (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, double *value);
+int linearbuffers_reflect_object_get_string (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, const char **value, uint64_t *length);
+int linearbuffers_reflect_object_get_object (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, struct linearbuffers_reflect_object *value);
+
+int linearbuffers_reflect_object_get_count (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t *count);
+int linearbuffers_reflect_object_get_int_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, int64_t *value);
+int linearbuffers_reflect_object_get_uint_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, uint64_t *value);
+int linearbuffers_reflect_object_get_float_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, double *value);
+int linearbuffers_reflect_object_get_string_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, const char **value, uint64_t *length);
+int linearbuffers_reflect_object_get_object_at (const struct linearbuffers_reflect_object *object, const struct linearbuffers_reflect_field *field, uint64_t at, struct linearbuffers_reflect_object *value);
+
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
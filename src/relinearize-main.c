@@ -0,0 +1,374 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+
+#include <getopt.h>
+
+#include "schema.h"
+#include "relinearize.h"
+
+#define OPTION_HELP                     'h'
+#define OPTION_SCHEMA                   's'
+#define OPTION_ROOT                     'r'
+#define OPTION_INPUT                    'i'
+#define OPTION_OUTPUT                   'o'
+#define OPTION_ORDER                    'a'
+#define OPTION_DEDUPLICATE              'd'
+#define OPTION_PROFILE                  'p'
+
+#define DEFAULT_SCHEMA                  NULL
+#define DEFAULT_ROOT                    NULL
+#define DEFAULT_INPUT                   NULL
+#define DEFAULT_OUTPUT                  NULL
+#define DEFAULT_ORDER                   "breadth"
+#define DEFAULT_DEDUPLICATE             1
+#define DEFAULT_PROFILE                 NULL
+
+int schema_relinearize (struct schema *schema, const char *root, struct linearbuffers_relinearize *relinearize, const void *buffer, uint64_t length);
+
+struct order {
+        const char *name;
+        enum linearbuffers_relinearize_order order;
+};
+
+static const struct order *orders[] = {
+        &(struct order) {
+                "depth",
+                linearbuffers_relinearize_order_depth
+        },
+        &(struct order) {
+                "breadth",
+                linearbuffers_relinearize_order_breadth
+        },
+        &(struct order) {
+                "profile",
+                linearbuffers_relinearize_order_profile
+        },
+        NULL,
+};
+
+static struct option options[] = {
+        { "help"                        , no_argument      , 0, OPTION_HELP                     },
+        { "schema"                      , required_argument, 0, OPTION_SCHEMA                   },
+        { "root"                        , required_argument, 0, OPTION_ROOT                     },
+        { "input"                       , required_argument, 0, OPTION_INPUT                    },
+        { "output"                      , required_argument, 0, OPTION_OUTPUT                   },
+        { "order"                       , required_argument, 0, OPTION_ORDER                    },
+        { "deduplicate"                 , required_argument, 0, OPTION_DEDUPLICATE              },
+        { "profile"                     , required_argument, 0, OPTION_PROFILE                  },
+        { 0                             , 0                , 0, 0                               }
+};
+
+static void print_help (const char *name)
+{
+        fprintf(stdout, "%s:\n", name);
+        fprintf(stdout, "\n");
+        fprintf(stdout, "options:\n");
+        fprintf(stdout, "  -s, --schema     : schema file (default: %s)\n", (DEFAULT_SCHEMA == NULL) ? "(null)" : DEFAULT_SCHEMA);
+        fprintf(stdout, "  -r, --root       : root table (default: last table in schema)\n");
+        fprintf(stdout, "  -i, --input      : input buffer file (default: %s)\n", (DEFAULT_INPUT == NULL) ? "(null)" : DEFAULT_INPUT);
+        fprintf(stdout, "  -o, --output     : output buffer file (default: %s)\n", (DEFAULT_OUTPUT == NULL) ? "(null)" : DEFAULT_OUTPUT);
+        fprintf(stdout, "  -a, --order      : object order (values: { depth, breadth, profile }, default: %s)\n", DEFAULT_ORDER);
+        fprintf(stdout, "  -d, --deduplicate: merge identical strings and tables (values: { 0, 1 }, default: %d)\n", DEFAULT_DEDUPLICATE);
+        fprintf(stdout, "  -p, --profile    : file with input offsets in access order, for profile order (default: %s)\n", (DEFAULT_PROFILE == NULL) ? "(null)" : DEFAULT_PROFILE);
+        fprintf(stdout, "  -h, --help       : this text\n");
+}
+
+static void * read_file (const char *filename, uint64_t *length)
+{
+        long size;
+        FILE *fp;
+        void *buffer;
+        fp = NULL;
+        buffer = NULL;
+        fp = fopen(filename, "rb");
+        if (fp == NULL) {
+                goto bail;
+        }
+        if (fseek(fp, 0, SEEK_END) != 0) {
+                goto bail;
+        }
+        size = ftell(fp);
+        if (size < 0 ||
+            fseek(fp, 0, SEEK_SET) != 0) {
+                goto bail;
+        }
+        buffer = malloc((size == 0) ? 1 : size);
+        if (buffer == NULL) {
+                goto bail;
+        }
+        if (fread(buffer, 1, size, fp) != (size_t) size) {
+                goto bail;
+        }
+        fclose(fp);
+        *length = size;
+        return buffer;
+bail:   if (fp != NULL) {
+                fclose(fp);
+        }
+        if (buffer != NULL) {
+                free(buffer);
+        }
+        return NULL;
+}
+
+static uint64_t * read_profile (const char *filename, uint64_t *nprofile)
+{
+        char *end;
+        char *next;
+        char *buffer;
+        void *tmp;
+        uint64_t length;
+        uint64_t sprofile;
+        uint64_t *profile;
+        profile = NULL;
+        buffer = read_file(filename, &length);
+        if (buffer == NULL) {
+                goto bail;
+        }
+        tmp = realloc(buffer, length + 1);
+        if (tmp == NULL) {
+                goto bail;
+        }
+        buffer = tmp;
+        buffer[length] = '\0';
+        sprofile = 0;
+        *nprofile = 0;
+        for (next = buffer; ; next = end) {
+                while (*next != '\0' && strchr(" \t\r\n,", *next) != NULL) {
+                        next++;
+                }
+                if (*next == '\0') {
+                        break;
+                }
+                if (*nprofile + 1 > sprofile) {
+                        sprofile = (sprofile == 0) ? 64 : sprofile * 2;
+                        tmp = realloc(profile, sizeof(uint64_t) * sprofile);
+                        if (tmp == NULL) {
+                                goto bail;
+                        }
+                        profile = tmp;
+                }
+                profile[*nprofile] = strtoull(next, &end, 0);
+                if (end == next) {
+                        goto bail;
+                }
+                *nprofile += 1;
+        }
+        free(buffer);
+        return profile;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        if (profile != NULL) {
+                free(profile);
+        }
+        return NULL;
+}
+
+int main (int argc, char *argv[])
+{
+        int c;
+        int option_index;
+
+        const struct order **order;
+
+        const char *option_schema;
+        const char *option_root;
+        const char *option_input;
+        const char *option_output;
+        const char *option_order;
+        int option_deduplicate;
+        const char *option_profile;
+
+        int rc;
+        FILE *output_file;
+        void *input;
+        uint64_t input_length;
+        const void *output;
+        uint64_t output_length;
+        uint64_t *profile;
+        uint64_t nprofile;
+        struct schema *schema;
+        struct linearbuffers_relinearize *relinearize;
+        struct linearbuffers_relinearize_create_options relinearize_options;
+
+        input = NULL;
+        schema = NULL;
+        profile = NULL;
+        nprofile = 0;
+        relinearize = NULL;
+        output_file = NULL;
+
+        option_schema                   = DEFAULT_SCHEMA;
+        option_root                     = DEFAULT_ROOT;
+        option_input                    = DEFAULT_INPUT;
+        option_output                   = DEFAULT_OUTPUT;
+        option_order                    = DEFAULT_ORDER;
+        option_deduplicate              = DEFAULT_DEDUPLICATE;
+        option_profile                  = DEFAULT_PROFILE;
+
+        while (1) {
+                c = getopt_long(argc, argv, "s:r:i:o:a:d:p:h", options, &option_index);
+                if (c == -1) {
+                        break;
+                }
+                switch (c) {
+                        case OPTION_HELP:
+                                print_help(argv[0]);
+                                goto out;
+                        case OPTION_SCHEMA:
+                                option_schema = optarg;
+                                break;
+                        case OPTION_ROOT:
+                                option_root = optarg;
+                                break;
+                        case OPTION_INPUT:
+                                option_input = optarg;
+                                break;
+                        case OPTION_OUTPUT:
+                                option_output = optarg;
+                                break;
+                        case OPTION_ORDER:
+                                option_order = optarg;
+                                break;
+                        case OPTION_DEDUPLICATE:
+                                if (strcasecmp(optarg, "t") == 0 ||
+                                    strcasecmp(optarg, "true") == 0 ||
+                                    strcasecmp(optarg, "y") == 0 ||
+                                    strcasecmp(optarg, "yes") == 0) {
+                                        option_deduplicate = 1;
+                                } else if (strcasecmp(optarg, "f") == 0 ||
+                                           strcasecmp(optarg, "false") == 0 ||
+                                           strcasecmp(optarg, "n") == 0 ||
+                                           strcasecmp(optarg, "no") == 0) {
+                                        option_deduplicate = 0;
+                                } else {
+                                        option_deduplicate = !!atoi(optarg);
+                                }
+                                break;
+                        case OPTION_PROFILE:
+                                option_profile = optarg;
+                                break;
+                }
+        }
+
+        if (option_schema == NULL) {
+                fprintf(stderr, "schema file is invalid\n");
+                goto bail;
+        }
+        if (option_input == NULL) {
+                fprintf(stderr, "input file is invalid\n");
+                goto bail;
+        }
+        if (option_output == NULL) {
+                fprintf(stderr, "output file is invalid\n");
+                goto bail;
+        }
+        for (order = orders; order && *order; order++) {
+                if (strcmp((*order)->name, option_order) == 0) {
+                        break;
+                }
+        }
+        if (order == NULL ||
+            *order == NULL) {
+                fprintf(stderr, "order: %s is invalid\n", option_order);
+                goto bail;
+        }
+        if ((*order)->order == linearbuffers_relinearize_order_profile &&
+            option_profile == NULL) {
+                fprintf(stderr, "profile file is invalid\n");
+                goto bail;
+        }
+
+        schema = schema_parse_file(option_schema);
+        if (schema == NULL) {
+                fprintf(stderr, "can not read schema file: %s\n", option_schema);
+                goto bail;
+        }
+        input = read_file(option_input, &input_length);
+        if (input == NULL) {
+                fprintf(stderr, "can not read input file: %s\n", option_input);
+                goto bail;
+        }
+        if (option_profile != NULL) {
+                profile = read_profile(option_profile, &nprofile);
+                if (profile == NULL) {
+                        fprintf(stderr, "can not read profile file: %s\n", option_profile);
+                        goto bail;
+                }
+        }
+
+        memset(&relinearize_options, 0, sizeof(struct linearbuffers_relinearize_create_options));
+        relinearize_options.order = (*order)->order;
+        relinearize_options.deduplicate = option_deduplicate;
+        relinearize_options.profile = profile;
+        relinearize_options.nprofile = nprofile;
+        relinearize = linearbuffers_relinearize_create(&relinearize_options);
+        if (relinearize == NULL) {
+                fprintf(stderr, "can not create relinearize\n");
+                goto bail;
+        }
+        rc = schema_relinearize(schema, option_root, relinearize, input, input_length);
+        if (rc != 0) {
+                fprintf(stderr, "can not relinearize input file: %s\n", option_input);
+                goto bail;
+        }
+        output = linearbuffers_relinearize_linearized(relinearize, &output_length);
+        if (output == NULL) {
+                fprintf(stderr, "can not get relinearized buffer\n");
+                goto bail;
+        }
+
+        if (strcmp(option_output, "stdout") == 0) {
+                output_file = stdout;
+        } else {
+                unlink(option_output);
+                output_file = fopen(option_output, "wb");
+        }
+        if (output_file == NULL) {
+                fprintf(stderr, "can not create file: %s\n", option_output);
+                goto bail;
+        }
+        if (fwrite(output, 1, output_length, output_file) != output_length) {
+                fprintf(stderr, "can not write file: %s\n", option_output);
+                goto bail;
+        }
+        fprintf(stderr, "relinearized: %" PRIu64 " -> %" PRIu64 " bytes\n", input_length, output_length);
+
+        if (output_file != stdout) {
+                fclose(output_file);
+        }
+        linearbuffers_relinearize_destroy(relinearize);
+        free(profile);
+        free(input);
+        schema_destroy(schema);
+
+out:    return 0;
+bail:   if (output_file != NULL &&
+            output_file != stdout) {
+                fclose(output_file);
+        }
+        if (option_output != NULL &&
+            output_file != NULL &&
+            output_file != stdout) {
+                unlink(option_output);
+        }
+        if (relinearize != NULL) {
+                linearbuffers_relinearize_destroy(relinearize);
+        }
+        if (profile != NULL) {
+                free(profile);
+        }
+        if (input != NULL) {
+                free(input);
+        }
+        if (schema != NULL) {
+                schema_destroy(schema);
+        }
+        return -1;
+}
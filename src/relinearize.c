@@ -0,0 +1,990 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#define LINEARBUFFERS_DEBUG_NAME "relinearize"
+
+#include "debug.h"
+#include "relinearize.h"
+
+/*
+ * a relinearize session collects objects, byte blocks of the new buffer
+ * keyed by their position in the source buffer, and references, offset
+ * slots inside an object pointing to another object. a forward reference
+ * requires the target to be placed after its holder, a backward reference
+ * before it.
+ *
+ * end() merges identical objects when asked, ranks the remaining ones in
+ * depth first, breadth first or profile order, places them in rank order
+ * as long as reference directions allow it and writes the new buffer
+ * patching every offset slot. the root object is always placed first.
+ */
+
+struct linearbuffers_relinearize_object {
+        uint64_t source;
+        uint64_t buffer;
+        uint64_t length;
+        uint64_t anchor;
+        uint64_t references;
+        uint64_t nreferences;
+        uint64_t constraints;
+        uint64_t nconstraints;
+        uint64_t indegree;
+        uint64_t rank;
+        uint64_t position;
+        int64_t canonical;
+        int state;
+};
+
+struct linearbuffers_relinearize_reference {
+        int64_t object;
+        int64_t target;
+        uint64_t position;
+        uint64_t size;
+        uint64_t base;
+        enum linearbuffers_relinearize_direction direction;
+};
+
+struct linearbuffers_relinearize_map {
+        uint64_t *keys;
+        int64_t *values;
+        uint64_t count;
+        uint64_t capacity;
+};
+
+struct linearbuffers_relinearize {
+        enum linearbuffers_relinearize_order order;
+        int deduplicate;
+        uint64_t *profile;
+        uint64_t nprofile;
+        struct linearbuffers_relinearize_map sources;
+        uint8_t *buffer;
+        uint64_t buffer_length;
+        uint64_t buffer_size;
+        struct linearbuffers_relinearize_object *objects;
+        uint64_t nobjects;
+        uint64_t sobjects;
+        struct linearbuffers_relinearize_reference *references;
+        uint64_t nreferences;
+        uint64_t sreferences;
+        uint64_t *grouped;
+        int64_t *constraints;
+        int64_t *nodes;
+        uint64_t nnodes;
+        uint8_t *output;
+        uint64_t output_length;
+};
+
+static uint64_t linearbuffers_relinearize_mix (uint64_t value)
+{
+        value ^= value >> 33;
+        value *= UINT64_C(0xff51afd7ed558ccd);
+        value ^= value >> 33;
+        value *= UINT64_C(0xc4ceb9fe1a85ec53);
+        value ^= value >> 33;
+        return value;
+}
+
+static uint64_t linearbuffers_relinearize_hash (uint64_t hash, const void *buffer, uint64_t length)
+{
+        uint64_t i;
+        const uint8_t *bytes;
+        bytes = buffer;
+        for (i = 0; i < length; i++) {
+                hash ^= bytes[i];
+                hash *= UINT64_C(0x100000001b3);
+        }
+        return hash;
+}
+
+static void linearbuffers_relinearize_map_uninit (struct linearbuffers_relinearize_map *map)
+{
+        if (map->keys != NULL) {
+                free(map->keys);
+        }
+        if (map->values != NULL) {
+                free(map->values);
+        }
+        memset(map, 0, sizeof(struct linearbuffers_relinearize_map));
+}
+
+static int linearbuffers_relinearize_map_init (struct linearbuffers_relinearize_map *map, uint64_t capacity)
+{
+        uint64_t i;
+        memset(map, 0, sizeof(struct linearbuffers_relinearize_map));
+        map->capacity = 16;
+        while (map->capacity < capacity * 2) {
+                map->capacity *= 2;
+        }
+        map->keys = malloc(sizeof(uint64_t) * map->capacity);
+        map->values = malloc(sizeof(int64_t) * map->capacity);
+        if (map->keys == NULL ||
+            map->values == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        for (i = 0; i < map->capacity; i++) {
+                map->values[i] = -1;
+        }
+        return 0;
+bail:   linearbuffers_relinearize_map_uninit(map);
+        return -1;
+}
+
+static int64_t linearbuffers_relinearize_map_get (struct linearbuffers_relinearize_map *map, uint64_t key)
+{
+        uint64_t i;
+        if (map->capacity == 0) {
+                return -1;
+        }
+        for (i = linearbuffers_relinearize_mix(key) & (map->capacity - 1); map->values[i] >= 0; i = (i + 1) & (map->capacity - 1)) {
+                if (map->keys[i] == key) {
+                        return map->values[i];
+                }
+        }
+        return -1;
+}
+
+static int linearbuffers_relinearize_map_put (struct linearbuffers_relinearize_map *map, uint64_t key, int64_t value)
+{
+        int rc;
+        uint64_t i;
+        struct linearbuffers_relinearize_map grown;
+        if ((map->count + 1) * 2 > map->capacity) {
+                rc = linearbuffers_relinearize_map_init(&grown, map->count + 1);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not init map");
+                        goto bail;
+                }
+                for (i = 0; i < map->capacity; i++) {
+                        if (map->values[i] >= 0) {
+                                linearbuffers_relinearize_map_put(&grown, map->keys[i], map->values[i]);
+                        }
+                }
+                linearbuffers_relinearize_map_uninit(map);
+                *map = grown;
+        }
+        for (i = linearbuffers_relinearize_mix(key) & (map->capacity - 1); map->values[i] >= 0; i = (i + 1) & (map->capacity - 1)) {
+        }
+        map->keys[i] = key;
+        map->values[i] = value;
+        map->count += 1;
+        return 0;
+bail:   return -1;
+}
+
+static int linearbuffers_relinearize_equal (struct linearbuffers_relinearize *relinearize, const struct linearbuffers_relinearize_object *a, const struct linearbuffers_relinearize_object *b)
+{
+        uint64_t i;
+        const struct linearbuffers_relinearize_reference *ar;
+        const struct linearbuffers_relinearize_reference *br;
+        if (a->length != b->length ||
+            a->anchor != b->anchor ||
+            a->nreferences != b->nreferences) {
+                return 0;
+        }
+        if (memcmp(relinearize->buffer + a->buffer, relinearize->buffer + b->buffer, a->length) != 0) {
+                return 0;
+        }
+        for (i = 0; i < a->nreferences; i++) {
+                ar = &relinearize->references[relinearize->grouped[a->references + i]];
+                br = &relinearize->references[relinearize->grouped[b->references + i]];
+                if (ar->position != br->position ||
+                    ar->size != br->size ||
+                    ar->base != br->base ||
+                    ar->direction != br->direction ||
+                    relinearize->objects[ar->target].canonical != relinearize->objects[br->target].canonical) {
+                        return 0;
+                }
+        }
+        return 1;
+}
+
+static int linearbuffers_relinearize_canonicalize (struct linearbuffers_relinearize *relinearize, struct linearbuffers_relinearize_map *canonicals, int64_t object)
+{
+        int rc;
+        uint64_t i;
+        uint64_t hash;
+        uint64_t values[5];
+        struct linearbuffers_relinearize_object *o;
+        const struct linearbuffers_relinearize_reference *reference;
+        o = &relinearize->objects[object];
+        hash = UINT64_C(0xcbf29ce484222325);
+        values[0] = o->length;
+        values[1] = o->anchor;
+        hash = linearbuffers_relinearize_hash(hash, values, sizeof(uint64_t) * 2);
+        hash = linearbuffers_relinearize_hash(hash, relinearize->buffer + o->buffer, o->length);
+        for (i = 0; i < o->nreferences; i++) {
+                reference = &relinearize->references[relinearize->grouped[o->references + i]];
+                values[0] = reference->position;
+                values[1] = reference->size;
+                values[2] = reference->base;
+                values[3] = reference->direction;
+                values[4] = relinearize->objects[reference->target].canonical;
+                hash = linearbuffers_relinearize_hash(hash, values, sizeof(values));
+        }
+        for (i = linearbuffers_relinearize_mix(hash) & (canonicals->capacity - 1); canonicals->values[i] >= 0; i = (i + 1) & (canonicals->capacity - 1)) {
+                if (canonicals->keys[i] == hash &&
+                    linearbuffers_relinearize_equal(relinearize, o, &relinearize->objects[canonicals->values[i]])) {
+                        o->canonical = canonicals->values[i];
+                        return 0;
+                }
+        }
+        o->canonical = object;
+        rc = linearbuffers_relinearize_map_put(canonicals, hash, object);
+        if (rc != 0) {
+                linearbuffers_errorf("can not put canonical object");
+                return -1;
+        }
+        return 0;
+}
+
+static int linearbuffers_relinearize_group (struct linearbuffers_relinearize *relinearize)
+{
+        uint64_t i;
+        struct linearbuffers_relinearize_object *o;
+        if (relinearize->grouped != NULL) {
+                free(relinearize->grouped);
+        }
+        relinearize->grouped = malloc(sizeof(uint64_t) * (relinearize->nreferences + 1));
+        if (relinearize->grouped == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                return -1;
+        }
+        for (i = 0; i < relinearize->nobjects; i++) {
+                relinearize->objects[i].references = 0;
+                relinearize->objects[i].nreferences = 0;
+        }
+        for (i = 0; i < relinearize->nreferences; i++) {
+                relinearize->objects[relinearize->references[i].object].nreferences += 1;
+        }
+        for (i = 1; i < relinearize->nobjects; i++) {
+                relinearize->objects[i].references = relinearize->objects[i - 1].references + relinearize->objects[i - 1].nreferences;
+        }
+        for (i = 0; i < relinearize->nobjects; i++) {
+                relinearize->objects[i].nreferences = 0;
+        }
+        for (i = 0; i < relinearize->nreferences; i++) {
+                o = &relinearize->objects[relinearize->references[i].object];
+                relinearize->grouped[o->references + o->nreferences] = i;
+                o->nreferences += 1;
+        }
+        return 0;
+}
+
+static int64_t linearbuffers_relinearize_target (struct linearbuffers_relinearize *relinearize, int64_t object, uint64_t i)
+{
+        const struct linearbuffers_relinearize_object *o;
+        o = &relinearize->objects[object];
+        return relinearize->objects[relinearize->references[relinearize->grouped[o->references + i]].target].canonical;
+}
+
+static int linearbuffers_relinearize_merge (struct linearbuffers_relinearize *relinearize, int64_t root, int deduplicate)
+{
+        int rc;
+        int64_t t;
+        int64_t *stack;
+        uint64_t *next;
+        uint64_t nstack;
+        struct linearbuffers_relinearize_map canonicals;
+        struct linearbuffers_relinearize_object *o;
+
+        stack = NULL;
+        next = NULL;
+        memset(&canonicals, 0, sizeof(struct linearbuffers_relinearize_map));
+
+        stack = malloc(sizeof(int64_t) * relinearize->nobjects);
+        next = malloc(sizeof(uint64_t) * relinearize->nobjects);
+        if (stack == NULL ||
+            next == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        if (deduplicate) {
+                rc = linearbuffers_relinearize_map_init(&canonicals, relinearize->nobjects);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not init canonical map");
+                        goto bail;
+                }
+        }
+        for (t = 0; t < (int64_t) relinearize->nobjects; t++) {
+                relinearize->objects[t].canonical = -1;
+                relinearize->objects[t].state = 0;
+        }
+
+        nstack = 0;
+        stack[nstack] = root;
+        next[nstack] = 0;
+        nstack += 1;
+        relinearize->objects[root].state = 1;
+        while (nstack > 0) {
+                o = &relinearize->objects[stack[nstack - 1]];
+                if (next[nstack - 1] < o->nreferences) {
+                        t = relinearize->references[relinearize->grouped[o->references + next[nstack - 1]]].target;
+                        next[nstack - 1] += 1;
+                        if (relinearize->objects[t].state == 1) {
+                                linearbuffers_errorf("source buffer has a reference cycle");
+                                goto bail;
+                        }
+                        if (relinearize->objects[t].state == 0) {
+                                relinearize->objects[t].state = 1;
+                                stack[nstack] = t;
+                                next[nstack] = 0;
+                                nstack += 1;
+                        }
+                        continue;
+                }
+                nstack -= 1;
+                o->state = 2;
+                if (deduplicate) {
+                        rc = linearbuffers_relinearize_canonicalize(relinearize, &canonicals, stack[nstack]);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not canonicalize object");
+                                goto bail;
+                        }
+                } else {
+                        o->canonical = stack[nstack];
+                }
+        }
+
+        linearbuffers_relinearize_map_uninit(&canonicals);
+        free(stack);
+        free(next);
+        return 0;
+bail:   linearbuffers_relinearize_map_uninit(&canonicals);
+        if (stack != NULL) {
+                free(stack);
+        }
+        if (next != NULL) {
+                free(next);
+        }
+        return -1;
+}
+
+static int linearbuffers_relinearize_rank (struct linearbuffers_relinearize *relinearize, int64_t root)
+{
+        uint64_t i;
+        uint64_t n;
+        uint64_t head;
+        uint64_t nstack;
+        int64_t c;
+        int64_t t;
+        int64_t *stack;
+        struct linearbuffers_relinearize_object *o;
+
+        stack = NULL;
+
+        for (i = 0; i < relinearize->nobjects; i++) {
+                relinearize->objects[i].rank = UINT64_MAX;
+        }
+        if (relinearize->nodes != NULL) {
+                free(relinearize->nodes);
+        }
+        relinearize->nodes = malloc(sizeof(int64_t) * relinearize->nobjects);
+        if (relinearize->nodes == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        relinearize->nnodes = 0;
+
+        c = relinearize->objects[root].canonical;
+        if (relinearize->order == linearbuffers_relinearize_order_depth) {
+                stack = malloc(sizeof(int64_t) * (relinearize->nreferences + 1));
+                if (stack == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                nstack = 0;
+                stack[nstack++] = c;
+                while (nstack > 0) {
+                        t = stack[--nstack];
+                        o = &relinearize->objects[t];
+                        if (o->rank != UINT64_MAX) {
+                                continue;
+                        }
+                        o->rank = relinearize->nnodes;
+                        relinearize->nodes[relinearize->nnodes++] = t;
+                        for (i = o->nreferences; i > 0; i--) {
+                                stack[nstack++] = linearbuffers_relinearize_target(relinearize, t, i - 1);
+                        }
+                }
+                free(stack);
+                return 0;
+        }
+
+        relinearize->objects[c].rank = 0;
+        relinearize->nodes[relinearize->nnodes++] = c;
+        for (head = 0; head < relinearize->nnodes; head++) {
+                o = &relinearize->objects[relinearize->nodes[head]];
+                for (i = 0; i < o->nreferences; i++) {
+                        t = linearbuffers_relinearize_target(relinearize, relinearize->nodes[head], i);
+                        if (relinearize->objects[t].rank != UINT64_MAX) {
+                                continue;
+                        }
+                        relinearize->objects[t].rank = relinearize->nnodes;
+                        relinearize->nodes[relinearize->nnodes++] = t;
+                }
+        }
+        if (relinearize->order == linearbuffers_relinearize_order_profile) {
+                for (n = 0; n < relinearize->nnodes; n++) {
+                        relinearize->objects[relinearize->nodes[n]].rank += relinearize->nprofile;
+                }
+                for (n = 0; n < relinearize->nprofile; n++) {
+                        t = linearbuffers_relinearize_map_get(&relinearize->sources, relinearize->profile[n]);
+                        if (t < 0) {
+                                continue;
+                        }
+                        o = &relinearize->objects[relinearize->objects[t].canonical];
+                        if (o->canonical < 0 ||
+                            o->rank == UINT64_MAX ||
+                            o->rank <= n) {
+                                continue;
+                        }
+                        o->rank = n + 1;
+                }
+                relinearize->objects[c].rank = 0;
+        }
+        return 0;
+bail:   if (stack != NULL) {
+                free(stack);
+        }
+        return -1;
+}
+
+static void linearbuffers_relinearize_heap_push (struct linearbuffers_relinearize *relinearize, int64_t *heap, uint64_t *nheap, int64_t object)
+{
+        int64_t t;
+        uint64_t i;
+        uint64_t p;
+        i = (*nheap)++;
+        heap[i] = object;
+        while (i > 0) {
+                p = (i - 1) / 2;
+                if (relinearize->objects[heap[p]].rank <= relinearize->objects[heap[i]].rank) {
+                        break;
+                }
+                t = heap[p];
+                heap[p] = heap[i];
+                heap[i] = t;
+                i = p;
+        }
+}
+
+static int64_t linearbuffers_relinearize_heap_pop (struct linearbuffers_relinearize *relinearize, int64_t *heap, uint64_t *nheap)
+{
+        int64_t t;
+        int64_t top;
+        uint64_t i;
+        uint64_t c;
+        top = heap[0];
+        heap[0] = heap[--(*nheap)];
+        i = 0;
+        while (1) {
+                c = i * 2 + 1;
+                if (c >= *nheap) {
+                        break;
+                }
+                if (c + 1 < *nheap &&
+                    relinearize->objects[heap[c + 1]].rank < relinearize->objects[heap[c]].rank) {
+                        c += 1;
+                }
+                if (relinearize->objects[heap[i]].rank <= relinearize->objects[heap[c]].rank) {
+                        break;
+                }
+                t = heap[c];
+                heap[c] = heap[i];
+                heap[i] = t;
+                i = c;
+        }
+        return top;
+}
+
+static int linearbuffers_relinearize_place (struct linearbuffers_relinearize *relinearize, int64_t root, uint64_t *length)
+{
+        uint64_t i;
+        uint64_t n;
+        uint64_t nheap;
+        uint64_t nplaced;
+        uint64_t position;
+        int64_t f;
+        int64_t t;
+        int64_t *heap;
+        const struct linearbuffers_relinearize_reference *reference;
+        struct linearbuffers_relinearize_object *o;
+
+        heap = NULL;
+
+        for (n = 0; n < relinearize->nnodes; n++) {
+                o = &relinearize->objects[relinearize->nodes[n]];
+                o->nconstraints = 0;
+                o->indegree = 0;
+        }
+        for (n = 0; n < relinearize->nnodes; n++) {
+                o = &relinearize->objects[relinearize->nodes[n]];
+                for (i = 0; i < o->nreferences; i++) {
+                        reference = &relinearize->references[relinearize->grouped[o->references + i]];
+                        f = relinearize->nodes[n];
+                        t = relinearize->objects[reference->target].canonical;
+                        if (reference->direction == linearbuffers_relinearize_direction_backward) {
+                                f = t;
+                                t = relinearize->nodes[n];
+                        }
+                        relinearize->objects[f].nconstraints += 1;
+                        relinearize->objects[t].indegree += 1;
+                }
+        }
+        position = 0;
+        for (n = 0; n < relinearize->nnodes; n++) {
+                o = &relinearize->objects[relinearize->nodes[n]];
+                o->constraints = position;
+                position += o->nconstraints;
+                o->nconstraints = 0;
+        }
+        if (relinearize->constraints != NULL) {
+                free(relinearize->constraints);
+        }
+        relinearize->constraints = malloc(sizeof(int64_t) * (position + 1));
+        heap = malloc(sizeof(int64_t) * (relinearize->nnodes + 1));
+        if (relinearize->constraints == NULL ||
+            heap == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        for (n = 0; n < relinearize->nnodes; n++) {
+                o = &relinearize->objects[relinearize->nodes[n]];
+                for (i = 0; i < o->nreferences; i++) {
+                        reference = &relinearize->references[relinearize->grouped[o->references + i]];
+                        f = relinearize->nodes[n];
+                        t = relinearize->objects[reference->target].canonical;
+                        if (reference->direction == linearbuffers_relinearize_direction_backward) {
+                                f = t;
+                                t = relinearize->nodes[n];
+                        }
+                        relinearize->constraints[relinearize->objects[f].constraints + relinearize->objects[f].nconstraints] = t;
+                        relinearize->objects[f].nconstraints += 1;
+                }
+        }
+
+        nheap = 0;
+        for (n = 0; n < relinearize->nnodes; n++) {
+                if (relinearize->objects[relinearize->nodes[n]].indegree == 0) {
+                        linearbuffers_relinearize_heap_push(relinearize, heap, &nheap, relinearize->nodes[n]);
+                }
+        }
+        nplaced = 0;
+        position = 0;
+        while (nheap > 0) {
+                f = linearbuffers_relinearize_heap_pop(relinearize, heap, &nheap);
+                o = &relinearize->objects[f];
+                if (nplaced == 0 &&
+                    f != relinearize->objects[root].canonical) {
+                        linearbuffers_errorf("root can not be placed first");
+                        goto bail;
+                }
+                o->position = position;
+                position += o->length;
+                nplaced += 1;
+                for (i = 0; i < o->nconstraints; i++) {
+                        t = relinearize->constraints[o->constraints + i];
+                        relinearize->objects[t].indegree -= 1;
+                        if (relinearize->objects[t].indegree == 0) {
+                                linearbuffers_relinearize_heap_push(relinearize, heap, &nheap, t);
+                        }
+                }
+        }
+        free(heap);
+        if (nplaced != relinearize->nnodes) {
+                linearbuffers_debugf("objects can not be ordered, placed: %" PRIu64 ", nodes: %" PRIu64 "", nplaced, relinearize->nnodes);
+                return 1;
+        }
+        *length = position;
+        return 0;
+bail:   if (heap != NULL) {
+                free(heap);
+        }
+        return -1;
+}
+
+static int linearbuffers_relinearize_layout (struct linearbuffers_relinearize *relinearize, int64_t root, int deduplicate, uint64_t *length)
+{
+        int rc;
+        rc = linearbuffers_relinearize_merge(relinearize, root, deduplicate);
+        if (rc != 0) {
+                linearbuffers_errorf("can not merge objects");
+                return -1;
+        }
+        rc = linearbuffers_relinearize_rank(relinearize, root);
+        if (rc != 0) {
+                linearbuffers_errorf("can not rank objects");
+                return -1;
+        }
+        return linearbuffers_relinearize_place(relinearize, root, length);
+}
+
+static int linearbuffers_relinearize_emit (struct linearbuffers_relinearize *relinearize)
+{
+        uint64_t i;
+        uint64_t n;
+        uint64_t value;
+        uint64_t holder;
+        uint64_t address;
+        uint8_t value8;
+        uint16_t value16;
+        uint32_t value32;
+        const struct linearbuffers_relinearize_object *o;
+        const struct linearbuffers_relinearize_object *t;
+        const struct linearbuffers_relinearize_reference *reference;
+        for (n = 0; n < relinearize->nnodes; n++) {
+                o = &relinearize->objects[relinearize->nodes[n]];
+                memcpy(relinearize->output + o->position, relinearize->buffer + o->buffer, o->length);
+                for (i = 0; i < o->nreferences; i++) {
+                        reference = &relinearize->references[relinearize->grouped[o->references + i]];
+                        t = &relinearize->objects[relinearize->objects[reference->target].canonical];
+                        holder = o->position + reference->base;
+                        address = t->position + t->anchor;
+                        if (reference->direction == linearbuffers_relinearize_direction_forward) {
+                                if (address < holder) {
+                                        linearbuffers_errorf("logic error: forward reference is behind");
+                                        return -1;
+                                }
+                                value = address - holder;
+                        } else {
+                                if (address > holder) {
+                                        linearbuffers_errorf("logic error: backward reference is ahead");
+                                        return -1;
+                                }
+                                value = holder - address;
+                        }
+                        if (reference->size < sizeof(uint64_t) &&
+                            (value >> (reference->size * 8)) != 0) {
+                                linearbuffers_errorf("offset does not fit: %" PRIu64 ", size: %" PRIu64 "", value, reference->size);
+                                return -1;
+                        }
+                        switch (reference->size) {
+                                case sizeof(uint8_t):
+                                        value8 = value;
+                                        memcpy(relinearize->output + o->position + reference->position, &value8, sizeof(value8));
+                                        break;
+                                case sizeof(uint16_t):
+                                        value16 = value;
+                                        memcpy(relinearize->output + o->position + reference->position, &value16, sizeof(value16));
+                                        break;
+                                case sizeof(uint32_t):
+                                        value32 = value;
+                                        memcpy(relinearize->output + o->position + reference->position, &value32, sizeof(value32));
+                                        break;
+                                default:
+                                        memcpy(relinearize->output + o->position + reference->position, &value, sizeof(value));
+                                        break;
+                        }
+                }
+        }
+        return 0;
+}
+
+__attribute__ ((__visibility__("default"))) struct linearbuffers_relinearize * linearbuffers_relinearize_create (struct linearbuffers_relinearize_create_options *options)
+{
+        int rc;
+        struct linearbuffers_relinearize *relinearize;
+        relinearize = malloc(sizeof(struct linearbuffers_relinearize));
+        if (relinearize == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(relinearize, 0, sizeof(struct linearbuffers_relinearize));
+        relinearize->order = linearbuffers_relinearize_order_breadth;
+        if (options != NULL) {
+                relinearize->order = options->order;
+                relinearize->deduplicate = options->deduplicate;
+                if (options->nprofile > 0) {
+                        if (options->profile == NULL) {
+                                linearbuffers_errorf("profile is invalid");
+                                goto bail;
+                        }
+                        relinearize->profile = malloc(sizeof(uint64_t) * options->nprofile);
+                        if (relinearize->profile == NULL) {
+                                linearbuffers_errorf("can not allocate memory");
+                                goto bail;
+                        }
+                        memcpy(relinearize->profile, options->profile, sizeof(uint64_t) * options->nprofile);
+                        relinearize->nprofile = options->nprofile;
+                }
+        }
+        if (relinearize->order != linearbuffers_relinearize_order_depth &&
+            relinearize->order != linearbuffers_relinearize_order_breadth &&
+            relinearize->order != linearbuffers_relinearize_order_profile) {
+                linearbuffers_errorf("order is invalid");
+                goto bail;
+        }
+        rc = linearbuffers_relinearize_map_init(&relinearize->sources, 0);
+        if (rc != 0) {
+                linearbuffers_errorf("can not init source map");
+                goto bail;
+        }
+        return relinearize;
+bail:   if (relinearize != NULL) {
+                linearbuffers_relinearize_destroy(relinearize);
+        }
+        return NULL;
+}
+
+__attribute__ ((__visibility__("default"))) void linearbuffers_relinearize_destroy (struct linearbuffers_relinearize *relinearize)
+{
+        if (relinearize == NULL) {
+                return;
+        }
+        linearbuffers_relinearize_map_uninit(&relinearize->sources);
+        if (relinearize->profile != NULL) {
+                free(relinearize->profile);
+        }
+        if (relinearize->buffer != NULL) {
+                free(relinearize->buffer);
+        }
+        if (relinearize->objects != NULL) {
+                free(relinearize->objects);
+        }
+        if (relinearize->references != NULL) {
+                free(relinearize->references);
+        }
+        if (relinearize->grouped != NULL) {
+                free(relinearize->grouped);
+        }
+        if (relinearize->constraints != NULL) {
+                free(relinearize->constraints);
+        }
+        if (relinearize->nodes != NULL) {
+                free(relinearize->nodes);
+        }
+        if (relinearize->output != NULL) {
+                free(relinearize->output);
+        }
+        free(relinearize);
+}
+
+__attribute__ ((__visibility__("default"))) int64_t linearbuffers_relinearize_lookup (struct linearbuffers_relinearize *relinearize, uint64_t source)
+{
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                return -1;
+        }
+        return linearbuffers_relinearize_map_get(&relinearize->sources, source);
+}
+
+__attribute__ ((__visibility__("default"))) int64_t linearbuffers_relinearize_object (struct linearbuffers_relinearize *relinearize, uint64_t source, const void *buffer, uint64_t length, uint64_t size, uint64_t anchor)
+{
+        int rc;
+        void *tmp;
+        uint64_t ssize;
+        struct linearbuffers_relinearize_object *object;
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                goto bail;
+        }
+        if (buffer == NULL && length > 0) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        if (length > size ||
+            anchor > size) {
+                linearbuffers_errorf("size is invalid");
+                goto bail;
+        }
+        if (linearbuffers_relinearize_map_get(&relinearize->sources, source) >= 0) {
+                linearbuffers_errorf("logic error: source: %" PRIu64 " already exists", source);
+                goto bail;
+        }
+        if (relinearize->nobjects + 1 > relinearize->sobjects) {
+                ssize = (relinearize->sobjects == 0) ? 64 : relinearize->sobjects * 2;
+                tmp = realloc(relinearize->objects, sizeof(struct linearbuffers_relinearize_object) * ssize);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                relinearize->objects = tmp;
+                relinearize->sobjects = ssize;
+        }
+        if (relinearize->buffer_length + size > relinearize->buffer_size) {
+                ssize = (relinearize->buffer_size == 0) ? 4096 : relinearize->buffer_size;
+                while (ssize < relinearize->buffer_length + size) {
+                        ssize *= 2;
+                }
+                tmp = realloc(relinearize->buffer, ssize);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                relinearize->buffer = tmp;
+                relinearize->buffer_size = ssize;
+        }
+        rc = linearbuffers_relinearize_map_put(&relinearize->sources, source, relinearize->nobjects);
+        if (rc != 0) {
+                linearbuffers_errorf("can not put source");
+                goto bail;
+        }
+        object = &relinearize->objects[relinearize->nobjects];
+        memset(object, 0, sizeof(struct linearbuffers_relinearize_object));
+        object->source = source;
+        object->buffer = relinearize->buffer_length;
+        object->length = size;
+        object->anchor = anchor;
+        if (length > 0) {
+                memcpy(relinearize->buffer + relinearize->buffer_length, buffer, length);
+        }
+        memset(relinearize->buffer + relinearize->buffer_length + length, 0, size - length);
+        relinearize->buffer_length += size;
+        relinearize->nobjects += 1;
+        return relinearize->nobjects - 1;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_relinearize_write (struct linearbuffers_relinearize *relinearize, int64_t object, uint64_t position, const void *buffer, uint64_t length)
+{
+        struct linearbuffers_relinearize_object *o;
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                goto bail;
+        }
+        if (object < 0 || object >= (int64_t) relinearize->nobjects) {
+                linearbuffers_errorf("object is invalid");
+                goto bail;
+        }
+        if (buffer == NULL && length > 0) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+        o = &relinearize->objects[object];
+        if (position > o->length ||
+            length > o->length - position) {
+                linearbuffers_errorf("position is invalid");
+                goto bail;
+        }
+        if (length > 0) {
+                memcpy(relinearize->buffer + o->buffer + position, buffer, length);
+        }
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_relinearize_reference (struct linearbuffers_relinearize *relinearize, int64_t object, uint64_t position, uint64_t size, uint64_t base, enum linearbuffers_relinearize_direction direction, int64_t target)
+{
+        void *tmp;
+        uint64_t ssize;
+        struct linearbuffers_relinearize_object *o;
+        struct linearbuffers_relinearize_reference *reference;
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                goto bail;
+        }
+        if (object < 0 || object >= (int64_t) relinearize->nobjects ||
+            target < 0 || target >= (int64_t) relinearize->nobjects) {
+                linearbuffers_errorf("object is invalid");
+                goto bail;
+        }
+        if (size != sizeof(uint8_t) &&
+            size != sizeof(uint16_t) &&
+            size != sizeof(uint32_t) &&
+            size != sizeof(uint64_t)) {
+                linearbuffers_errorf("size is invalid");
+                goto bail;
+        }
+        if (direction != linearbuffers_relinearize_direction_forward &&
+            direction != linearbuffers_relinearize_direction_backward) {
+                linearbuffers_errorf("direction is invalid");
+                goto bail;
+        }
+        o = &relinearize->objects[object];
+        if (position > o->length ||
+            size > o->length - position ||
+            base > o->length) {
+                linearbuffers_errorf("position is invalid");
+                goto bail;
+        }
+        if (relinearize->nreferences + 1 > relinearize->sreferences) {
+                ssize = (relinearize->sreferences == 0) ? 64 : relinearize->sreferences * 2;
+                tmp = realloc(relinearize->references, sizeof(struct linearbuffers_relinearize_reference) * ssize);
+                if (tmp == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+                relinearize->references = tmp;
+                relinearize->sreferences = ssize;
+        }
+        memset(relinearize->buffer + o->buffer + position, 0, size);
+        reference = &relinearize->references[relinearize->nreferences];
+        reference->object = object;
+        reference->target = target;
+        reference->position = position;
+        reference->size = size;
+        reference->base = base;
+        reference->direction = direction;
+        relinearize->nreferences += 1;
+        return 0;
+bail:   return -1;
+}
+
+__attribute__ ((__visibility__("default"))) int linearbuffers_relinearize_end (struct linearbuffers_relinearize *relinearize, int64_t root)
+{
+        int rc;
+        uint64_t length;
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                goto bail;
+        }
+        if (root < 0 || root >= (int64_t) relinearize->nobjects) {
+                linearbuffers_errorf("root is invalid");
+                goto bail;
+        }
+        if (relinearize->output != NULL) {
+                free(relinearize->output);
+                relinearize->output = NULL;
+                relinearize->output_length = 0;
+        }
+        rc = linearbuffers_relinearize_group(relinearize);
+        if (rc != 0) {
+                linearbuffers_errorf("can not group references");
+                goto bail;
+        }
+        rc = linearbuffers_relinearize_layout(relinearize, root, relinearize->deduplicate, &length);
+        if (rc > 0 && relinearize->deduplicate) {
+                linearbuffers_debugf("deduplicated objects can not be ordered, retrying without deduplication");
+                rc = linearbuffers_relinearize_layout(relinearize, root, 0, &length);
+        }
+        if (rc != 0) {
+                linearbuffers_errorf("can not layout objects");
+                goto bail;
+        }
+        relinearize->output = malloc((length == 0) ? 1 : length);
+        if (relinearize->output == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        relinearize->output_length = length;
+        rc = linearbuffers_relinearize_emit(relinearize);
+        if (rc != 0) {
+                linearbuffers_errorf("can not emit objects");
+                goto bail;
+        }
+        return 0;
+bail:   if (relinearize != NULL &&
+            relinearize->output != NULL) {
+                free(relinearize->output);
+                relinearize->output = NULL;
+                relinearize->output_length = 0;
+        }
+        return -1;
+}
+
+__attribute__ ((__visibility__("default"))) const void * linearbuffers_relinearize_linearized (struct linearbuffers_relinearize *relinearize, uint64_t *length)
+{
+        if (relinearize == NULL) {
+                linearbuffers_debugf("relinearize is invalid");
+                return NULL;
+        }
+        if (length != NULL) {
+                *length = relinearize->output_length;
+        }
+        return relinearize->output;
+}
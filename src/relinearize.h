@@ -0,0 +1,44 @@
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if !defined(LINEARBUFFERS_RELINEARIZE_H)
+#define LINEARBUFFERS_RELINEARIZE_H
+
+struct linearbuffers_relinearize;
+
+enum linearbuffers_relinearize_order {
+	linearbuffers_relinearize_order_depth,
+	linearbuffers_relinearize_order_breadth,
+	linearbuffers_relinearize_order_profile
+};
+
+enum linearbuffers_relinearize_direction {
+	linearbuffers_relinearize_direction_forward,
+	linearbuffers_relinearize_direction_backward
+};
+
+struct linearbuffers_relinearize_create_options {
+	enum linearbuffers_relinearize_order order;
+	int deduplicate;
+	const uint64_t *profile;
+	uint64_t nprofile;
+};
+
+struct linearbuffers_relinearize * linearbuffers_relinearize_create (struct linearbuffers_relinearize_create_options *options);
+void linearbuffers_relinearize_destroy (struct linearbuffers_relinearize *relinearize);
+
+int64_t linearbuffers_relinearize_lookup (struct linearbuffers_relinearize *relinearize, uint64_t source);
+int64_t linearbuffers_relinearize_object (struct linearbuffers_relinearize *relinearize, uint64_t source, const void *buffer, uint64_t length, uint64_t size, uint64_t anchor);
+int linearbuffers_relinearize_write (struct linearbuffers_relinearize *relinearize, int64_t object, uint64_t position, const void *buffer, uint64_t length);
+int linearbuffers_relinearize_reference (struct linearbuffers_relinearize *relinearize, int64_t object, uint64_t position, uint64_t size, uint64_t base, enum linearbuffers_relinearize_direction direction, int64_t target);
+int linearbuffers_relinearize_end (struct linearbuffers_relinearize *relinearize, int64_t root);
+
+const void * linearbuffers_relinearize_linearized (struct linearbuffers_relinearize *relinearize, uint64_t *length);
+
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
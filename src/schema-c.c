@@ -42,6 +42,10 @@ static int schema_table_has_string (struct schema_table *schema_table)
                 if (strcmp(schema_table_field->type, "string") == 0) {
                         return 1;
                 }
+                if (schema_table_field->key != NULL &&
+                    strcmp(schema_table_field->key, "string") == 0) {
+                        return 1;
+                }
         }
         return 0;
 }
@@ -59,6 +63,332 @@ static int schema_has_string (struct schema *schema)
         return 0;
 }
 
+static int schema_table_has_encoded_vector (struct schema_table *schema_table)
+{
+        struct schema_table_field *schema_table_field;
+        TAILQ_FOREACH(schema_table_field, &schema_table->fields, list) {
+                if (schema_table_field_encoding(schema_table_field) != schema_vector_encoding_none) {
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+static int schema_has_encoded_vector (struct schema *schema)
+{
+        int rc;
+        struct schema_table *schema_table;
+        TAILQ_FOREACH(schema_table, &schema->tables, list) {
+                rc = schema_table_has_encoded_vector(schema_table);
+                if (rc != 0) {
+                        return rc;
+                }
+        }
+        return 0;
+}
+
+static int schema_table_has_dictionary_vector (struct schema_table *schema_table)
+{
+        struct schema_table_field *schema_table_field;
+        TAILQ_FOREACH(schema_table_field, &schema_table->fields, list) {
+                if (schema_table_field_is_dictionary(schema_table_field)) {
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+static int schema_has_dictionary_vector (struct schema *schema)
+{
+        int rc;
+        struct schema_table *schema_table;
+        TAILQ_FOREACH(schema_table, &schema->tables, list) {
+                rc = schema_table_has_dictionary_vector(schema_table);
+                if (rc != 0) {
+                        return rc;
+                }
+        }
+        return 0;
+}
+
+static int schema_table_has_map (struct schema_table *schema_table)
+{
+        struct schema_table_field *schema_table_field;
+        TAILQ_FOREACH(schema_table_field, &schema_table->fields, list) {
+                if (schema_table_field->container == schema_container_type_map) {
+                        return 1;
+                }
+        }
+        return 0;
+}
+
+static int schema_has_map (struct schema *schema)
+{
+        int rc;
+        struct schema_table *schema_table;
+        TAILQ_FOREACH(schema_table, &schema->tables, list) {
+                rc = schema_table_has_map(schema_table);
+                if (rc != 0) {
+                        return rc;
+                }
+        }
+        return 0;
+}
+
+static int schema_generate_array_type (struct schema *schema, const char *type, FILE *fp)
+{
+        if (schema_type_is_scalar(type)) {
+                fprintf(fp, "%s_t", type);
+        } else if (schema_type_is_float(type)) {
+                fprintf(fp, "%s", type);
+        } else if (schema_type_is_enum(schema, type)) {
+                fprintf(fp, "%s_%s_t", schema->namespace, type);
+        } else {
+                linearbuffers_errorf("type is invalid: %s", type);
+                return -1;
+        }
+        return 0;
+}
+
+static int schema_generate_map_type (struct schema *schema, const char *type, FILE *fp)
+{
+        if (schema_type_is_scalar(type)) {
+                fprintf(fp, "%s_t", type);
+        } else if (schema_type_is_float(type)) {
+                fprintf(fp, "%s", type);
+        } else if (schema_type_is_string(type)) {
+                fprintf(fp, "const char *");
+        } else if (schema_type_is_table(schema, type)) {
+                fprintf(fp, "const struct %s_%s *", schema->namespace, type);
+        } else {
+                linearbuffers_errorf("type is invalid: %s", type);
+                return -1;
+        }
+        return 0;
+}
+
+static void schema_generate_map_hash (struct schema *schema, FILE *fp)
+{
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_MAP_HASH_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_MAP_HASH_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_map_hash_integer (uint64_t value)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    value ^= value >> 33;\n");
+        fprintf(fp, "    value *= UINT64_C(0xff51afd7ed558ccd);\n");
+        fprintf(fp, "    value ^= value >> 33;\n");
+        fprintf(fp, "    value *= UINT64_C(0xc4ceb9fe1a85ec53);\n");
+        fprintf(fp, "    value ^= value >> 33;\n");
+        fprintf(fp, "    return value;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_map_hash_string (const char *value)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t hash;\n");
+        fprintf(fp, "    hash = UINT64_C(14695981039346656037);\n");
+        fprintf(fp, "    while (*value != '\\0') {\n");
+        fprintf(fp, "        hash ^= (uint8_t) *value++;\n");
+        fprintf(fp, "        hash *= UINT64_C(1099511628211);\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return hash;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+}
+
+static int schema_generate_map_decoder (struct schema *schema, struct schema_table_field *table_field, FILE *fp)
+{
+        int rc;
+        const char *k;
+        const char *v;
+        const char *count_type;
+        const char *offset_type;
+
+        k = table_field->key;
+        v = table_field->type;
+        count_type = schema_count_type_name(schema->count_type);
+        offset_type = schema_offset_type_name(schema->offset_type);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_%s_MAP_DECODER_API)\n", schema->NAMESPACE, k, v);
+        fprintf(fp, "#define %s_%s_%s_MAP_DECODER_API\n", schema->NAMESPACE, k, v);
+        fprintf(fp, "\n");
+        if (schema_type_is_table(schema, v)) {
+                fprintf(fp, "struct %s_%s;\n", schema->namespace, v);
+        }
+        fprintf(fp, "struct %s_%s_%s_map;\n", schema->namespace, k, v);
+        fprintf(fp, "\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_%s_map_get_count (const struct %s_%s_%s_map *map)\n", count_type, schema->namespace, k, v, schema->namespace, k, v);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", count_type);
+        fprintf(fp, "    if (map == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&count, map, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_%s_map_get_capacity (const struct %s_%s_%s_map *map)\n", count_type, schema->namespace, k, v, schema->namespace, k, v);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t capacity;\n", count_type);
+        fprintf(fp, "    if (map == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&capacity, ((const uint8_t *) map) + sizeof(capacity), sizeof(capacity));\n");
+        fprintf(fp, "    return capacity;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_map_present_at (const struct %s_%s_%s_map *map, %s_t at)\n", schema->namespace, k, v, schema->namespace, k, v, count_type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    if (at >= %s_%s_%s_map_get_capacity(map)) {\n", schema->namespace, k, v);
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    present = ((const uint8_t *) map) + sizeof(%s_t) * 2;\n", count_type);
+        fprintf(fp, "    return (present[at / 8] & (1 << (at %% 8))) ? 1 : 0;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline ");
+        rc = schema_generate_map_type(schema, k, fp);
+        if (rc != 0) {
+                goto bail;
+        }
+        fprintf(fp, " %s_%s_%s_map_get_key_at (const struct %s_%s_%s_map *map, %s_t at)\n", schema->namespace, k, v, schema->namespace, k, v, count_type);
+        fprintf(fp, "{\n");
+        if (schema_map_part_is_reference(schema, k)) {
+                fprintf(fp, "    %s_t key;\n", offset_type);
+        } else {
+                fprintf(fp, "    %s_t key;\n", k);
+        }
+        fprintf(fp, "    %s_t capacity;\n", count_type);
+        fprintf(fp, "    capacity = %s_%s_%s_map_get_capacity(map);\n", schema->namespace, k, v);
+        fprintf(fp, "    memcpy(&key, ((const uint8_t *) map) + sizeof(%s_t) * 2 + (capacity + 7) / 8 + at * sizeof(key), sizeof(key));\n", count_type);
+        if (schema_map_part_is_reference(schema, k)) {
+                fprintf(fp, "    return (const char *) (((const uint8_t *) map) - key);\n");
+        } else {
+                fprintf(fp, "    return key;\n");
+        }
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline ");
+        rc = schema_generate_map_type(schema, v, fp);
+        if (rc != 0) {
+                goto bail;
+        }
+        fprintf(fp, " %s_%s_%s_map_get_value_at (const struct %s_%s_%s_map *map, %s_t at)\n", schema->namespace, k, v, schema->namespace, k, v, count_type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    ");
+        if (schema_map_part_is_reference(schema, v)) {
+                fprintf(fp, "%s_t", offset_type);
+        } else {
+                schema_generate_map_type(schema, v, fp);
+        }
+        fprintf(fp, " value;\n");
+        fprintf(fp, "    %s_t capacity;\n", count_type);
+        fprintf(fp, "    capacity = %s_%s_%s_map_get_capacity(map);\n", schema->namespace, k, v);
+        fprintf(fp, "    memcpy(&value, ((const uint8_t *) map) + sizeof(%s_t) * 2 + (capacity + 7) / 8 + capacity * %s_C(%" PRIu64 ") + at * sizeof(value), sizeof(value));\n", count_type, schema_offset_type_NAME(schema->offset_type), schema_map_part_size(schema, k));
+        if (schema_type_is_string(v)) {
+                fprintf(fp, "    return (const char *) (((const uint8_t *) map) - value);\n");
+        } else if (schema_type_is_table(schema, v)) {
+                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) map) - value);\n", schema->namespace, v);
+        } else {
+                fprintf(fp, "    return value;\n");
+        }
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_%s_%s_map_find (const struct %s_%s_%s_map *map, ", schema->namespace, k, v, schema->namespace, k, v);
+        schema_generate_map_type(schema, k, fp);
+        fprintf(fp, " key)\n");
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t mask;\n");
+        fprintf(fp, "    %s_t capacity;\n", count_type);
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    const uint8_t *keys;\n");
+        if (schema_map_part_is_reference(schema, k)) {
+                fprintf(fp, "    %s_t k;\n", offset_type);
+                fprintf(fp, "    if (key == NULL) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        } else {
+                fprintf(fp, "    %s_t k;\n", k);
+        }
+        fprintf(fp, "    capacity = %s_%s_%s_map_get_capacity(map);\n", schema->namespace, k, v);
+        fprintf(fp, "    if (capacity == 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    mask = capacity - 1;\n");
+        fprintf(fp, "    present = ((const uint8_t *) map) + sizeof(%s_t) * 2;\n", count_type);
+        fprintf(fp, "    keys = present + (capacity + 7) / 8;\n");
+        if (schema_map_part_is_reference(schema, k)) {
+                fprintf(fp, "    i = %s_map_hash_string(key) & mask;\n", schema->namespace);
+        } else {
+                fprintf(fp, "    i = %s_map_hash_integer((uint64_t) key) & mask;\n", schema->namespace);
+        }
+        fprintf(fp, "    for (n = 0; n < capacity; n++, i = (i + 1) & mask) {\n");
+        fprintf(fp, "        if (!(present[i / 8] & (1 << (i %% 8)))) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        memcpy(&k, keys + i * sizeof(k), sizeof(k));\n");
+        if (schema_map_part_is_reference(schema, k)) {
+                fprintf(fp, "        if (strcmp((const char *) (((const uint8_t *) map) - k), key) == 0) {\n");
+        } else {
+                fprintf(fp, "        if (k == key) {\n");
+        }
+        fprintf(fp, "            return (int64_t) i;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return -1;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_map_get (const struct %s_%s_%s_map *map, ", schema->namespace, k, v, schema->namespace, k, v);
+        schema_generate_map_type(schema, k, fp);
+        fprintf(fp, " key, ");
+        schema_generate_map_type(schema, v, fp);
+        fprintf(fp, " *value)\n");
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int64_t at;\n");
+        fprintf(fp, "    at = %s_%s_%s_map_find(map, key);\n", schema->namespace, k, v);
+        fprintf(fp, "    if (at < 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (value != NULL) {\n");
+        fprintf(fp, "        *value = %s_%s_%s_map_get_value_at(map, (%s_t) at);\n", schema->namespace, k, v, count_type);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_%s_%s_map_next (const struct %s_%s_%s_map *map, int64_t at)\n", schema->namespace, k, v, schema->namespace, k, v);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    %s_t capacity;\n", count_type);
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    capacity = %s_%s_%s_map_get_capacity(map);\n", schema->namespace, k, v);
+        fprintf(fp, "    if (capacity == 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    present = ((const uint8_t *) map) + sizeof(%s_t) * 2;\n", count_type);
+        fprintf(fp, "    for (i = (uint64_t) (at + 1); i < capacity; i++) {\n");
+        fprintf(fp, "        if ((i %% 8) == 0 && present[i / 8] == 0) {\n");
+        fprintf(fp, "            i += 7;\n");
+        fprintf(fp, "            continue;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (present[i / 8] & (1 << (i %% 8))) {\n");
+        fprintf(fp, "            return (int64_t) i;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return -1;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
 static int schema_generate_enum (struct schema *schema, struct schema_enum *anum, FILE *fp)
 {
         struct schema_enum_field *anum_field;
@@ -118,177 +448,52 @@ static int schema_generate_enum (struct schema *schema, struct schema_enum *anum
 bail:   return -1;
 }
 
-static int schema_generate_vector_decoder (struct schema *schema, const char *type, int decoder_use_memcpy, FILE *fp)
+static int schema_generate_struct (struct schema *schema, struct schema_table *table, FILE *fp)
 {
+        int rc;
+        struct schema_table_field *table_field;
+
         if (schema == NULL) {
                 linearbuffers_errorf("schema is invalid");
                 goto bail;
         }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
         if (fp == NULL) {
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
 
         fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(%s_%s_VECTOR_DECODER_API)\n", schema->NAMESPACE, type);
-        fprintf(fp, "#define %s_%s_VECTOR_DECODER_API\n", schema->NAMESPACE, type);
+        fprintf(fp, "#if !defined(%s_%s_STRUCT_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_STRUCT_API\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "\n");
 
-        if (schema_type_is_scalar(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return 0;\n");
-                fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
-                } else {
-                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
-                }
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s_t);\n", schema->namespace, type, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline const %s_t * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", type, schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const %s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return ((const %s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_float(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return 0;\n");
-                fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
-                } else {
-                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
-                }
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s);\n", schema->namespace, type, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline const %s * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", type, schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const %s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return ((const %s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_enum(schema, type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return 0;\n");
-                fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "struct %s_%s {\n", schema->namespace, table->name);
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "    ");
+                        rc = schema_generate_array_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " %s[%" PRIu64 "];\n", table_field->name, table_field->length);
+                } else if (schema_type_is_scalar(table_field->type)) {
+                        fprintf(fp, "    %s_t %s;\n", table_field->type, table_field->name);
+                } else if (schema_type_is_float(table_field->type)) {
+                        fprintf(fp, "    %s %s;\n", table_field->type, table_field->name);
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        fprintf(fp, "    %s_%s_t %s;\n", schema->namespace, table_field->type, table_field->name);
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "    struct %s_%s %s;\n", schema->namespace, table_field->type, table_field->name);
                 } else {
-                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                        linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        goto bail;
                 }
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s_%s_t);\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline const %s_%s_t * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const %s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_%s_t %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return ((const %s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_string(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return 0;\n");
-                fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
-                } else {
-                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
-                }
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline const char * %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
-                fprintf(fp, "{\n");
-                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
-                }
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    offset  = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                        fprintf(fp, "    offset += *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + offset + (sizeof(offset) * at), sizeof(offset));\n", schema_offset_type_name(schema->offset_type));
-                } else {
-                        fprintf(fp, "    offset  = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                        fprintf(fp, "    offset += ((%s_t *) (((const uint8_t *) decoder) + offset))[at];\n", schema_offset_type_name(schema->offset_type));
-                }
-                        fprintf(fp, "    return (const char *) (((const uint8_t *) decoder) + offset);\n");
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_table(schema, type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    if (decoder == NULL) {\n");
-                fprintf(fp, "        return 0;\n");
-                fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
-                } else {
-                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
-                }
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
-                fprintf(fp, "{\n");
-                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
-                }
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    offset  = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                        fprintf(fp, "    offset += *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + offset + (sizeof(offset) * at), sizeof(offset));\n", schema_offset_type_name(schema->offset_type));
-                } else {
-                        fprintf(fp, "    offset  = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
-                        fprintf(fp, "    offset += ((%s_t *) (((const uint8_t *) decoder) + offset))[at];\n", schema_offset_type_name(schema->offset_type));
-                }
-                        fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, type);
-                fprintf(fp, "}\n");
         }
+        fprintf(fp, "} __attribute__((packed));\n");
 
         fprintf(fp, "\n");
         fprintf(fp, "#endif\n");
@@ -297,566 +502,1613 @@ static int schema_generate_vector_decoder (struct schema *schema, const char *ty
 bail:   return -1;
 }
 
-static int schema_generate_vector_encoder (struct schema *schema, const char *type, FILE *fp)
+static int schema_generate_union (struct schema *schema, struct schema_table *table, FILE *fp)
 {
+        uint64_t table_field_i;
+        struct schema_table_field *table_field;
+
         if (schema == NULL) {
                 linearbuffers_errorf("schema is invalid");
                 goto bail;
         }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
         if (fp == NULL) {
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
 
         fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(%s_%s_VECTOR_ENCODER_API)\n", schema->NAMESPACE, type);
-        fprintf(fp, "#define %s_%s_VECTOR_ENCODER_API\n", schema->NAMESPACE, type);
+        fprintf(fp, "#if !defined(%s_%s_UNION_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_UNION_API\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "\n");
 
-        if (schema_type_is_scalar(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s_t value)\n", schema->namespace, type, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s_t *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_float(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s value)\n", schema->namespace, type, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_enum(schema, type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", schema_type_get_enum(schema, type)->type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", schema_type_get_enum(schema, type)->type);
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", schema_type_get_enum(schema, type)->type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", schema_type_get_enum(schema, type)->type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s_%s_t *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, schema->namespace, schema_type_get_enum(schema, type)->name);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", schema_type_get_enum(schema, type)->type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_string(type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, const struct %s_string *value)\n", schema->namespace, type, schema->namespace);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) value);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, type);
-                fprintf(fp, "    string = %s_%s_create(encoder, value);\n", schema->namespace, type);
-                fprintf(fp, "    if (string == NULL) {\n");
-                fprintf(fp, "        return -1;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) string);\n", type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, type);
-                fprintf(fp, "    string = %s_%s_ncreate(encoder, n, value);\n", schema->namespace, type);
-                fprintf(fp, "    if (string == NULL) {\n");
-                fprintf(fp, "        return -1;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) string);\n", type);
-                fprintf(fp, "}\n");
-        } else if (schema_type_is_table(schema, type)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_%s;\n", schema->namespace, type);
-                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_table(encoder, &offset);\n");
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_table(encoder);\n");
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, type, schema->namespace, type);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    return linearbuffers_encoder_vector_push_table(encoder, (uint64_t) (ptrdiff_t) value);\n");
-                fprintf(fp, "}\n");
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "struct %s_%s;\n", schema->namespace, table_field->type);
         }
-
         fprintf(fp, "\n");
-        fprintf(fp, "#endif\n");
-
-        return 0;
-bail:   return -1;
-}
-
-TAILQ_HEAD(element_entries, element_entry);
-struct element_entry {
-        TAILQ_ENTRY(element_entry) list;
-        struct schema_table *table;
-        uint64_t id;
-        uint64_t offset;
-        int vector;
-};
-
-struct element {
-        struct element_entries entries;
-        uint64_t nentries;
-};
 
-static void element_entry_destroy (struct element_entry *entry)
-{
-        if (entry == NULL) {
-                return;
+        fprintf(fp, "typedef uint8_t %s_%s_type_t;\n", schema->namespace, table->name);
+        fprintf(fp, "#define %s_%s_type_NONE ((%s_%s_type_t) UINT8_C(0))\n", schema->namespace, table->name, schema->namespace, table->name);
+        table_field_i = 1;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "#define %s_%s_type_%s ((%s_%s_type_t) UINT8_C(%" PRIu64 "))\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field_i);
+                table_field_i += 1;
         }
-        free(entry);
-}
 
-static struct element_entry * element_entry_create (struct schema_table *table, uint64_t id, uint64_t offset, int vector)
-{
-        struct element_entry *entry;
-        entry = malloc(sizeof(struct element_entry));
-        if (entry == NULL) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline const char * %s_%s_type_string (%s_%s_type_t value)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    switch (value) {\n");
+        fprintf(fp, "        case %s_%s_type_NONE: return \"NONE\";\n", schema->namespace, table->name);
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "        case %s_%s_type_%s: return \"%s\";\n", schema->namespace, table->name, table_field->name, table_field->name);
         }
-        memset(entry, 0, sizeof(struct element_entry));
-        entry->table = table;
-        entry->id = id;
-        entry->offset = offset;
-        entry->vector = vector;
-        return entry;
-bail:   if (entry != NULL) {
-                element_entry_destroy(entry);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return \"%s\";\n", "");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_type_is_valid (%s_%s_type_t value)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    switch (value) {\n");
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "        case %s_%s_type_%s: return 1;\n", schema->namespace, table->name, table_field->name);
         }
-        return NULL;
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
 }
 
-static int element_push (struct element *element, struct schema_table *table, uint64_t id, uint64_t offset, int vector)
+static int schema_generate_encoded_decoder (struct schema *schema, FILE *fp)
 {
-        struct element_entry *entry;
-        entry = NULL;
-        if (element == NULL) {
-                linearbuffers_errorf("element is invalid");
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
                 goto bail;
         }
-        entry = element_entry_create(table, id, offset, vector);
-        if (entry == NULL) {
-                linearbuffers_errorf("can not create element entry");
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
-        element->nentries += 1;
-        TAILQ_INSERT_TAIL(&element->entries, entry, list);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_ENCODED_DECODER_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_DECODER_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "#define %s_ENCODED_HEADER_SIZE 16\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_BLOCK_SIZE 16\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_BLOCK_LENGTH 128\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_BITPACK 1\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_FOR 2\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_ENCODED_DELTA 3\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_encoded_count (const uint8_t *encoded)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    if (encoded == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&count, encoded, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_encoded_unzigzag (uint64_t value)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return (value >> 1) ^ (UINT64_C(0) - (value & 1));\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_encoded_unpack (const uint8_t *data, uint64_t position, uint8_t width)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t value;\n");
+        fprintf(fp, "    memcpy(&value, data + (position >> 3), sizeof(value));\n");
+        fprintf(fp, "    value >>= (position & 7);\n");
+        fprintf(fp, "    if ((position & 7) + width > 64) {\n");
+        fprintf(fp, "        value |= ((uint64_t) data[(position >> 3) + 8]) << (64 - (position & 7));\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (width < 64) {\n");
+        fprintf(fp, "        value &= (UINT64_C(1) << width) - 1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return value;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline const uint8_t * %s_encoded_block (const uint8_t *encoded, uint64_t block, uint64_t *base, uint8_t *width)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint32_t offset;\n");
+        fprintf(fp, "    uint64_t nblocks;\n");
+        fprintf(fp, "    nblocks = (%s_encoded_count(encoded) + %s_ENCODED_BLOCK_LENGTH - 1) / %s_ENCODED_BLOCK_LENGTH;\n", schema->namespace, schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    memcpy(base, encoded + %s_ENCODED_HEADER_SIZE + block * %s_ENCODED_BLOCK_SIZE, sizeof(*base));\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    memcpy(&offset, encoded + %s_ENCODED_HEADER_SIZE + block * %s_ENCODED_BLOCK_SIZE + 8, sizeof(offset));\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    *width = encoded[%s_ENCODED_HEADER_SIZE + block * %s_ENCODED_BLOCK_SIZE + 12];\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    return encoded + %s_ENCODED_HEADER_SIZE + nblocks * %s_ENCODED_BLOCK_SIZE + offset;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_encoded_get_at (const uint8_t *encoded, uint64_t at)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t base;\n");
+        fprintf(fp, "    uint64_t value;\n");
+        fprintf(fp, "    uint8_t width;\n");
+        fprintf(fp, "    const uint8_t *data;\n");
+        fprintf(fp, "    data = %s_encoded_block(encoded, at / %s_ENCODED_BLOCK_LENGTH, &base, &width);\n", schema->namespace, schema->NAMESPACE);
+        fprintf(fp, "    at = at %% %s_ENCODED_BLOCK_LENGTH;\n", schema->NAMESPACE);
+        fprintf(fp, "    if (encoded[8] == %s_ENCODED_DELTA) {\n", schema->NAMESPACE);
+        fprintf(fp, "        value = base;\n");
+        fprintf(fp, "        for (i = 1; i <= at; i++) {\n");
+        fprintf(fp, "            value += %s_encoded_unzigzag(%s_encoded_unpack(data, i * width, width));\n", schema->namespace, schema->namespace);
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        return value;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    value = %s_encoded_unpack(data, at * width, width);\n", schema->namespace);
+        fprintf(fp, "    if (encoded[8] == %s_ENCODED_FOR) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return base + value;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (encoded[10]) {\n");
+        fprintf(fp, "        return %s_encoded_unzigzag(value);\n", schema->namespace);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return value;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_encoded_decode_block (const uint8_t *encoded, uint64_t block, uint64_t *values)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t base;\n");
+        fprintf(fp, "    uint8_t width;\n");
+        fprintf(fp, "    const uint8_t *data;\n");
+        fprintf(fp, "    n = %s_encoded_count(encoded) - block * %s_ENCODED_BLOCK_LENGTH;\n", schema->namespace, schema->NAMESPACE);
+        fprintf(fp, "    if (n > %s_ENCODED_BLOCK_LENGTH) {\n", schema->NAMESPACE);
+        fprintf(fp, "        n = %s_ENCODED_BLOCK_LENGTH;\n", schema->NAMESPACE);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    data = %s_encoded_block(encoded, block, &base, &width);\n", schema->namespace);
+        fprintf(fp, "    for (i = 0; i < n; i++) {\n");
+        fprintf(fp, "        values[i] = %s_encoded_unpack(data, i * width, width);\n", schema->namespace);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (encoded[8] == %s_ENCODED_DELTA) {\n", schema->NAMESPACE);
+        fprintf(fp, "        values[0] = base;\n");
+        fprintf(fp, "        for (i = 1; i < n; i++) {\n");
+        fprintf(fp, "            values[i] = values[i - 1] + %s_encoded_unzigzag(values[i]);\n", schema->namespace);
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    } else if (encoded[8] == %s_ENCODED_FOR) {\n", schema->NAMESPACE);
+        fprintf(fp, "        for (i = 0; i < n; i++) {\n");
+        fprintf(fp, "            values[i] += base;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    } else if (encoded[10]) {\n");
+        fprintf(fp, "        for (i = 0; i < n; i++) {\n");
+        fprintf(fp, "            values[i] = %s_encoded_unzigzag(values[i]);\n", schema->namespace);
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return n;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_encoded_verify (const uint8_t *encoded, uint64_t length)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t b;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t data;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t nblocks;\n");
+        fprintf(fp, "    uint32_t offset;\n");
+        fprintf(fp, "    uint8_t width;\n");
+        fprintf(fp, "    if (length < %s_ENCODED_HEADER_SIZE) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (encoded[8] != %s_ENCODED_BITPACK &&\n", schema->NAMESPACE);
+        fprintf(fp, "        encoded[8] != %s_ENCODED_FOR &&\n", schema->NAMESPACE);
+        fprintf(fp, "        encoded[8] != %s_ENCODED_DELTA) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    count = %s_encoded_count(encoded);\n", schema->namespace);
+        fprintf(fp, "    nblocks = (count / %s_ENCODED_BLOCK_LENGTH) + ((count %% %s_ENCODED_BLOCK_LENGTH) ? 1 : 0);\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    if (nblocks > (length - %s_ENCODED_HEADER_SIZE) / %s_ENCODED_BLOCK_SIZE) {\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    data = %s_ENCODED_HEADER_SIZE + nblocks * %s_ENCODED_BLOCK_SIZE;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "    for (b = 0; b < nblocks; b++) {\n");
+        fprintf(fp, "        memcpy(&offset, encoded + %s_ENCODED_HEADER_SIZE + b * %s_ENCODED_BLOCK_SIZE + 8, sizeof(offset));\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        width = encoded[%s_ENCODED_HEADER_SIZE + b * %s_ENCODED_BLOCK_SIZE + 12];\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        n = count - b * %s_ENCODED_BLOCK_LENGTH;\n", schema->NAMESPACE);
+        fprintf(fp, "        if (n > %s_ENCODED_BLOCK_LENGTH) {\n", schema->NAMESPACE);
+        fprintf(fp, "            n = %s_ENCODED_BLOCK_LENGTH;\n", schema->NAMESPACE);
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (width > 64) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if ((uint64_t) offset + (n * width + 7) / 8 + 8 > length - data) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
         return 0;
-bail:   if (entry != NULL) {
-                element_entry_destroy(entry);
-        }
-        return -1;
+bail:   return -1;
 }
 
-static int element_pop (struct element *element)
+static int schema_generate_dictionary_decoder (struct schema *schema, FILE *fp)
 {
-        struct element_entry *entry;
-        entry = NULL;
-        if (element == NULL) {
-                linearbuffers_errorf("element is invalid");
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
                 goto bail;
         }
-        if (TAILQ_EMPTY(&element->entries)) {
-                linearbuffers_errorf("element is empty");
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
-        entry = TAILQ_LAST(&element->entries, element_entries);
-        TAILQ_REMOVE(&element->entries, entry, list);
-        element->nentries -= 1;
-        element_entry_destroy(entry);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_DICTIONARY_DECODER_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_DICTIONARY_DECODER_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "#define %s_DICTIONARY_HEADER_SIZE 16\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_dictionary_count (const uint8_t *dictionary)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    if (dictionary == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&count, dictionary, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint32_t %s_dictionary_entries (const uint8_t *dictionary)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint32_t entries;\n");
+        fprintf(fp, "    if (dictionary == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&entries, dictionary + 8, sizeof(entries));\n");
+        fprintf(fp, "    return entries;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint32_t %s_dictionary_index_at (const uint8_t *dictionary, uint64_t at)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint8_t width;\n");
+        fprintf(fp, "    const uint8_t *indices;\n");
+        fprintf(fp, "    width = dictionary[12];\n");
+        fprintf(fp, "    indices = dictionary + %s_DICTIONARY_HEADER_SIZE + %s_dictionary_entries(dictionary) * sizeof(uint32_t);\n", schema->NAMESPACE, schema->namespace);
+        fprintf(fp, "    if (width == sizeof(uint8_t)) {\n");
+        fprintf(fp, "        return indices[at];\n");
+        fprintf(fp, "    } else if (width == sizeof(uint16_t)) {\n");
+        fprintf(fp, "        uint16_t index;\n");
+        fprintf(fp, "        memcpy(&index, indices + at * sizeof(uint16_t), sizeof(index));\n");
+        fprintf(fp, "        return index;\n");
+        fprintf(fp, "    } else {\n");
+        fprintf(fp, "        uint32_t index;\n");
+        fprintf(fp, "        memcpy(&index, indices + at * sizeof(uint32_t), sizeof(index));\n");
+        fprintf(fp, "        return index;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline const char * %s_dictionary_entry_at (const uint8_t *dictionary, uint32_t index)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint32_t offset;\n");
+        fprintf(fp, "    uint32_t entries;\n");
+        fprintf(fp, "    entries = %s_dictionary_entries(dictionary);\n", schema->namespace);
+        fprintf(fp, "    if (index >= entries) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&offset, dictionary + %s_DICTIONARY_HEADER_SIZE + index * sizeof(uint32_t), sizeof(offset));\n", schema->NAMESPACE);
+        fprintf(fp, "    return (const char *) dictionary + %s_DICTIONARY_HEADER_SIZE + entries * sizeof(uint32_t) + %s_dictionary_count(dictionary) * dictionary[12] + offset;\n", schema->NAMESPACE, schema->namespace);
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_dictionary_find (const uint8_t *dictionary, const char *value)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint32_t i;\n");
+        fprintf(fp, "    uint32_t entries;\n");
+        fprintf(fp, "    entries = %s_dictionary_entries(dictionary);\n", schema->namespace);
+        fprintf(fp, "    for (i = 0; i < entries; i++) {\n");
+        fprintf(fp, "        if (strcmp(%s_dictionary_entry_at(dictionary, i), value) == 0) {\n", schema->namespace);
+        fprintf(fp, "            return i;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return -1;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_dictionary_verify (const uint8_t *dictionary, uint64_t length)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t strings;\n");
+        fprintf(fp, "    uint32_t offset;\n");
+        fprintf(fp, "    uint32_t entries;\n");
+        fprintf(fp, "    uint8_t width;\n");
+        fprintf(fp, "    if (length < %s_DICTIONARY_HEADER_SIZE) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    count = %s_dictionary_count(dictionary);\n", schema->namespace);
+        fprintf(fp, "    entries = %s_dictionary_entries(dictionary);\n", schema->namespace);
+        fprintf(fp, "    width = dictionary[12];\n");
+        fprintf(fp, "    if (width != sizeof(uint8_t) &&\n");
+        fprintf(fp, "        width != sizeof(uint16_t) &&\n");
+        fprintf(fp, "        width != sizeof(uint32_t)) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (entries > (length - %s_DICTIONARY_HEADER_SIZE) / sizeof(uint32_t)) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (count > (length - %s_DICTIONARY_HEADER_SIZE - entries * sizeof(uint32_t)) / width) {\n", schema->NAMESPACE);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    strings = %s_DICTIONARY_HEADER_SIZE + entries * sizeof(uint32_t) + count * width;\n", schema->NAMESPACE);
+        fprintf(fp, "    for (i = 0; i < entries; i++) {\n");
+        fprintf(fp, "        memcpy(&offset, dictionary + %s_DICTIONARY_HEADER_SIZE + i * sizeof(uint32_t), sizeof(offset));\n", schema->NAMESPACE);
+        fprintf(fp, "        if (offset >= length - strings) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (memchr(dictionary + strings + offset, 0, length - strings - offset) == NULL) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    for (i = 0; i < count; i++) {\n");
+        fprintf(fp, "        if (%s_dictionary_index_at(dictionary, i) >= entries) {\n", schema->namespace);
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
         return 0;
 bail:   return -1;
 }
 
-static void element_destroy (struct element *element)
+static int schema_generate_vector_kernels (struct schema *schema, const char *type, FILE *fp)
 {
-        struct element_entry *entry;
-        struct element_entry *nentry;
-        if (element == NULL) {
-                return;
-        }
-        TAILQ_FOREACH_SAFE(entry, &element->entries, list, nentry) {
-                TAILQ_REMOVE(&element->entries, entry, list);
-                element_entry_destroy(entry);
+        char ctype[64];
+        const char *sum;
+        const char *lane;
+
+        /* integer sums wrap: lanes accumulate in uint64_t and are cast once at the end */
+        if (schema_type_is_float(type)) {
+                snprintf(ctype, sizeof(ctype), "%s", type);
+                sum = "double";
+                lane = "double";
+        } else {
+                snprintf(ctype, sizeof(ctype), "%s_t", type);
+                sum = (strncmp(type, "int", 3) == 0) ? "int64_t" : "uint64_t";
+                lane = "uint64_t";
         }
-        free(element);
+
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline %s %s_%s_vector_sum (const struct %s_%s_vector *decoder)\n", sum, schema->namespace, type, schema->namespace, type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t k;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    %s sum;\n", lane);
+        fprintf(fp, "    %s lanes[%s_VECTOR_KERNEL_LANES] = { 0 };\n", lane, schema->NAMESPACE);
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        for (j = 0; j + %s_VECTOR_KERNEL_LANES <= n; j += %s_VECTOR_KERNEL_LANES) {\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "            for (k = 0; k < %s_VECTOR_KERNEL_LANES; k++) {\n", schema->NAMESPACE);
+        fprintf(fp, "                lanes[k] += (%s) block[j + k];\n", lane);
+        fprintf(fp, "            }\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        for (; j < n; j++) {\n");
+        fprintf(fp, "            lanes[0] += (%s) block[j];\n", lane);
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    sum = 0;\n");
+        fprintf(fp, "    for (k = 0; k < %s_VECTOR_KERNEL_LANES; k++) {\n", schema->NAMESPACE);
+        fprintf(fp, "        sum += lanes[k];\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return (%s) sum;\n", sum);
+        fprintf(fp, "}\n");
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline int %s_%s_vector_min (const struct %s_%s_vector *decoder, %s *value)\n", schema->namespace, type, schema->namespace, type, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    %s min;\n", ctype);
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    if (count == 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    memcpy(&min, values, sizeof(min));\n");
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            min = (block[j] < min) ? block[j] : min;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    *value = min;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline int %s_%s_vector_max (const struct %s_%s_vector *decoder, %s *value)\n", schema->namespace, type, schema->namespace, type, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    %s max;\n", ctype);
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    if (count == 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    memcpy(&max, values, sizeof(max));\n");
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            max = (block[j] > max) ? block[j] : max;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    *value = max;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline uint64_t %s_%s_vector_count_equal (const struct %s_%s_vector *decoder, %s value)\n", schema->namespace, type, schema->namespace, type, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t equal;\n");
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    equal = 0;\n");
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            equal += (block[j] == value);\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return equal;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline int64_t %s_%s_vector_find_first (const struct %s_%s_vector *decoder, %s value)\n", schema->namespace, type, schema->namespace, type, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int hit;\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        hit = 0;\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            hit |= (block[j] == value);\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (hit == 0) {\n");
+        fprintf(fp, "            continue;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            if (block[j] == value) {\n");
+        fprintf(fp, "                return (int64_t) (i + j);\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return -1;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((unused)) static inline uint64_t %s_%s_vector_filter_range (const struct %s_%s_vector *decoder, %s min, %s max, uint64_t *indices, uint64_t length)\n", schema->namespace, type, schema->namespace, type, ctype, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t j;\n");
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t found;\n");
+        fprintf(fp, "    %s block[%s_VECTOR_KERNEL_BLOCK];\n", ctype, schema->NAMESPACE);
+        fprintf(fp, "    const uint8_t *values;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    values = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    found = 0;\n");
+        fprintf(fp, "    if (length == 0) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    for (i = 0; i < count; i += n) {\n");
+        fprintf(fp, "        n = (count - i < %s_VECTOR_KERNEL_BLOCK) ? count - i : %s_VECTOR_KERNEL_BLOCK;\n", schema->NAMESPACE, schema->NAMESPACE);
+        fprintf(fp, "        memcpy(block, values + i * sizeof(block[0]), n * sizeof(block[0]));\n");
+        fprintf(fp, "        for (j = 0; j < n; j++) {\n");
+        fprintf(fp, "            indices[found] = i + j;\n");
+        fprintf(fp, "            found += (block[j] >= min) & (block[j] <= max);\n");
+        fprintf(fp, "            if (found == length) {\n");
+        fprintf(fp, "                return found;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return found;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_%s_vector_gather (const struct %s_%s_vector *decoder, const uint64_t *indices, uint64_t length, %s *values)\n", schema->namespace, type, schema->namespace, type, ctype);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    const uint8_t *source;\n");
+        fprintf(fp, "    count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    source = (const uint8_t *) %s_%s_vector_get_values(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    for (i = 0; i < length; i++) {\n");
+        fprintf(fp, "        if (indices[i] >= count) {\n");
+        fprintf(fp, "            break;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        memcpy(&values[i], source + indices[i] * sizeof(values[0]), sizeof(values[0]));\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return i;\n");
+        fprintf(fp, "}\n");
+
+        return 0;
 }
 
-static struct element * element_create (void)
+static int schema_generate_vector_iterator (struct schema *schema, const char *type, int decoder_use_memcpy, FILE *fp)
 {
-        struct element *element;
-        element = malloc(sizeof(struct element));
-        if (element == NULL) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        memset(element, 0, sizeof(struct element));
-        TAILQ_INIT(&element->entries);
-        return element;
-bail:   if (element != NULL) {
-                element_destroy(element);
+        char ret[256];
+        char cs[64];
+
+        if (schema_type_is_string(type)) {
+                snprintf(ret, sizeof(ret), "const char *");
+        } else {
+                snprintf(ret, sizeof(ret), "const struct %s_%s *", schema->namespace, type);
         }
-        return NULL;
-}
+        snprintf(cs, sizeof(cs), "%s_C(%" PRIu64 ")", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
 
-TAILQ_HEAD(namespace_entries, namespace_entry);
-struct namespace_entry {
-        TAILQ_ENTRY(namespace_entry) list;
-        char *string;
-        size_t length;
-};
-
-struct namespace {
-        struct namespace_entries entries;
-        int dirty;
-        char *linearized;
-        size_t slinearized;
-};
-
-static void namespace_entry_destroy (struct namespace_entry *entry)
-{
-        if (entry == NULL) {
-                return;
-        }
-        if (entry->string != NULL) {
-                free(entry->string);
-        }
-        free(entry);
-}
-
-static struct namespace_entry * namespace_entry_create (const char *string, va_list ap)
-{
-        va_list aq;
-        int size;
-        struct namespace_entry *entry;
-        entry = malloc(sizeof(struct namespace_entry));
-        if (entry == NULL) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        memset(entry, 0, sizeof(struct namespace_entry));
-        va_copy(aq, ap);
-        size = vsnprintf(NULL, 0, string, aq);
-        va_end(aq);
-        if (size < 0) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        size += 1;
-        entry->string = malloc(size);
-        if (entry->string == NULL) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        va_copy(aq, ap);
-        size = vsnprintf(entry->string, size, string, aq);
-        va_end(aq);
-        if (size < 0) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        entry->length = strlen(entry->string);
-        return entry;
-bail:   if (entry != NULL) {
-                namespace_entry_destroy(entry);
-        }
-        return NULL;
-}
-
-__attribute__((format(printf, 2, 3))) static int namespace_push (struct namespace *namespace, const char *push, ...)
-{
-        va_list ap;
-        struct namespace_entry *entry;
-        entry = NULL;
-        if (namespace == NULL) {
-                linearbuffers_errorf("namespace is invalid");
-                goto bail;
-        }
-        if (push == NULL) {
-                linearbuffers_errorf("push is invalid");
-                goto bail;
-        }
-        va_start(ap, push);
-        entry = namespace_entry_create(push, ap);
-        va_end(ap);
-        if (entry == NULL) {
-                linearbuffers_errorf("can not create namespace entry");
-                goto bail;
+        fprintf(fp, "\n");
+        fprintf(fp, "struct %s_%s_vector_iter {\n", schema->namespace, type);
+        fprintf(fp, "    const uint8_t *base;\n");
+        fprintf(fp, "    const uint8_t *offsets;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t at;\n");
+        fprintf(fp, "    uint64_t distance;\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "};\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_iter_init (struct %s_%s_vector_iter *iter, const struct %s_%s_vector *decoder)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    if (iter == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    iter->base = (const uint8_t *) decoder;\n");
+        fprintf(fp, "    iter->offsets = NULL;\n");
+        fprintf(fp, "    iter->count = %s_%s_vector_get_count(decoder);\n", schema->namespace, type);
+        fprintf(fp, "    iter->at = 0;\n");
+        fprintf(fp, "    iter->distance = %s_VECTOR_ITER_PREFETCH_DISTANCE;\n", schema->NAMESPACE);
+        fprintf(fp, "    iter->offset = 0;\n");
+        fprintf(fp, "    if (iter->count == 0) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    memcpy(&iter->offset, iter->base + %s, sizeof(iter->offset));\n", cs);
+        } else {
+                fprintf(fp, "    iter->offset = *(%s_t *) (iter->base + %s);\n", schema_offset_type_name(schema->offset_type), cs);
         }
-        TAILQ_INSERT_TAIL(&namespace->entries, entry, list);
-        namespace->dirty = 1;
-        return 0;
-bail:   if (entry != NULL) {
-                namespace_entry_destroy(entry);
+        fprintf(fp, "    iter->offsets = iter->base + iter->offset;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_iter_set_distance (struct %s_%s_vector_iter *iter, uint64_t distance)\n", schema->namespace, type, schema->namespace, type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    if (iter == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    iter->distance = distance;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_iter_offset (const struct %s_%s_vector_iter *iter, uint64_t at)\n", schema_offset_type_name(schema->offset_type), schema->namespace, type, schema->namespace, type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    memcpy(&offset, iter->offsets + at * sizeof(offset), sizeof(offset));\n");
+        } else {
+                fprintf(fp, "    offset = *(%s_t *) (iter->offsets + at * sizeof(offset));\n", schema_offset_type_name(schema->offset_type));
         }
-        return -1;
-}
+        fprintf(fp, "    return (%s_t) (iter->offset + offset);\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline %s %s_%s_vector_iter_next (struct %s_%s_vector_iter *iter)\n", ret, schema->namespace, type, schema->namespace, type);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "    if (iter->at >= iter->count) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (iter->distance != 0 &&\n");
+        fprintf(fp, "        iter->at + iter->distance < iter->count) {\n");
+        fprintf(fp, "        __builtin_prefetch(iter->base + %s_%s_vector_iter_offset(iter, iter->at + iter->distance));\n", schema->namespace, type);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    offset = %s_%s_vector_iter_offset(iter, iter->at);\n", schema->namespace, type);
+        fprintf(fp, "    iter->at += 1;\n");
+        fprintf(fp, "    return (%s) (iter->base + offset);\n", ret);
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_for_each_distance (const struct %s_%s_vector *decoder, uint64_t distance, int (*callback) (void *context, uint64_t at, %svalue), void *context)\n", schema->namespace, type, schema->namespace, type, ret);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    %svalue;\n", ret);
+        fprintf(fp, "    struct %s_%s_vector_iter iter;\n", schema->namespace, type);
+        fprintf(fp, "    if (callback == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    %s_%s_vector_iter_init(&iter, decoder);\n", schema->namespace, type);
+        fprintf(fp, "    %s_%s_vector_iter_set_distance(&iter, distance);\n", schema->namespace, type);
+        fprintf(fp, "    while ((value = %s_%s_vector_iter_next(&iter)) != NULL) {\n", schema->namespace, type);
+        fprintf(fp, "        rc = callback(context, iter.at - 1, value);\n");
+        fprintf(fp, "        if (rc != 0) {\n");
+        fprintf(fp, "            return rc;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_for_each (const struct %s_%s_vector *decoder, int (*callback) (void *context, uint64_t at, %svalue), void *context)\n", schema->namespace, type, schema->namespace, type, ret);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return %s_%s_vector_for_each_distance(decoder, %s_VECTOR_ITER_PREFETCH_DISTANCE, callback, context);\n", schema->namespace, type, schema->NAMESPACE);
+        fprintf(fp, "}\n");
 
-static int namespace_pop (struct namespace *namespace)
-{
-        struct namespace_entry *entry;
-        entry = NULL;
-        if (namespace == NULL) {
-                linearbuffers_errorf("namespace is invalid");
-                goto bail;
-        }
-        if (TAILQ_EMPTY(&namespace->entries)) {
-                linearbuffers_errorf("namespace is empty");
-                goto bail;
-        }
-        entry = TAILQ_LAST(&namespace->entries, namespace_entries);
-        TAILQ_REMOVE(&namespace->entries, entry, list);
-        namespace_entry_destroy(entry);
-        namespace->dirty = 1;
         return 0;
-bail:   if (entry != NULL) {
-                namespace_entry_destroy(entry);
-        }
-        return -1;
-}
-
-static const char * namespace_linearized (struct namespace *namespace)
-{
-        size_t slinearized;
-        struct namespace_entry *entry;
-        if (namespace == NULL) {
-                return NULL;
-        }
-        if (namespace->dirty == 0) {
-                return namespace->linearized;
-        }
-        slinearized = 0;
-        TAILQ_FOREACH(entry, &namespace->entries, list) {
-                slinearized += entry->length;
-        }
-        if (slinearized > namespace->slinearized) {
-                if (namespace->linearized != NULL) {
-                        free(namespace->linearized);
-                        namespace->linearized = NULL;
-                }
-                namespace->linearized = malloc(slinearized + 1 + 4);
-                if (namespace->linearized == NULL) {
-                        linearbuffers_errorf("can not allocate memory");
-                        namespace->slinearized = 0;
-                        goto bail;
-                }
-                namespace->slinearized = slinearized;
-        }
-        slinearized = 0;
-        TAILQ_FOREACH(entry, &namespace->entries, list) {
-                slinearized += sprintf(namespace->linearized + slinearized, "%s", entry->string);
-        }
-        namespace->dirty = 0;
-        return namespace->linearized;
-bail:   return NULL;
-}
-
-static void namespace_destroy (struct namespace *namespace)
-{
-        struct namespace_entry *entry;
-        struct namespace_entry *nentry;
-        if (namespace == NULL) {
-                return;
-        }
-        TAILQ_FOREACH_SAFE(entry, &namespace->entries, list, nentry) {
-                TAILQ_REMOVE(&namespace->entries, entry, list);
-                namespace_entry_destroy(entry);
-        }
-        free(namespace);
-}
-
-static struct namespace * namespace_create (void)
-{
-        struct namespace *namespace;
-        namespace = malloc(sizeof(struct namespace));
-        if (namespace == NULL) {
-                linearbuffers_errorf("can not allocate memory");
-                goto bail;
-        }
-        memset(namespace, 0, sizeof(struct namespace));
-        TAILQ_INIT(&namespace->entries);
-        return namespace;
-bail:   if (namespace != NULL) {
-                namespace_destroy(namespace);
-        }
-        return NULL;
 }
 
-static int schema_generate_encoder_table (struct schema *schema, struct schema_table *table, FILE *fp)
+static int schema_generate_vector_decoder (struct schema *schema, const char *type, int decoder_use_memcpy, FILE *fp)
 {
-        uint64_t table_field_i;
-        uint64_t table_field_s;
-        struct schema_table_field *table_field;
-
         if (schema == NULL) {
                 linearbuffers_errorf("schema is invalid");
                 goto bail;
         }
-        if (table == NULL) {
-                linearbuffers_errorf("table is invalid");
-                goto bail;
-        }
         if (fp == NULL) {
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
 
         fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(%s_%s_ENCODER_API)\n", schema->NAMESPACE, table->name);
-        fprintf(fp, "#define %s_%s_ENCODER_API\n", schema->NAMESPACE, table->name);
-
-        fprintf(fp, "\n");
-        fprintf(fp, "struct %s_%s;\n", schema->namespace, table->name);
-        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_VECTOR_DECODER_API)\n", schema->NAMESPACE, type);
+        fprintf(fp, "#define %s_%s_VECTOR_DECODER_API\n", schema->NAMESPACE, type);
 
-        table_field_s = 0;
-        TAILQ_FOREACH(table_field, &table->fields, list) {
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
+        if (schema_type_is_scalar(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
                 } else {
-                        linearbuffers_errorf("type is invalid: %s", table_field->type);
-                        goto bail;
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
                 }
-
-        }
-
-        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
-        fprintf(fp, "{\n");
-        fprintf(fp, "    return linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema_count_type_NAME(schema->count_type), table->nfields, schema_offset_type_NAME(schema->offset_type), table_field_s);
-        fprintf(fp, "}\n");
-
-        table_field_i = 0;
-        table_field_s = 0;
-        TAILQ_FOREACH(table_field, &table->fields, list) {
-                struct schema_attribute *attribute;
-                struct namespace *attribute_string;
-                attribute_string = namespace_create();
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s_t);\n", schema->namespace, type, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const %s_t * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", type, schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const %s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return ((const %s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                schema_generate_vector_kernels(schema, type, fp);
+        } else if (schema_type_is_float(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s);\n", schema->namespace, type, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const %s * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", type, schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const %s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return ((const %s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                schema_generate_vector_kernels(schema, type, fp);
+        } else if (schema_type_is_enum(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(%s_%s_t);\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const %s_%s_t * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const %s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_%s_t %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return ((const %s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ")))[at];\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+        } else if (schema_type_is_string(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const char * %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                }
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    offset  = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "    offset += *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + offset + (sizeof(offset) * at), sizeof(offset));\n", schema_offset_type_name(schema->offset_type));
+                } else {
+                        fprintf(fp, "    offset  = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "    offset += ((%s_t *) (((const uint8_t *) decoder) + offset))[at];\n", schema_offset_type_name(schema->offset_type));
+                }
+                        fprintf(fp, "    return (const char *) (((const uint8_t *) decoder) + offset);\n");
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return %s_string_length((const struct %s_string *) %s_%s_vector_get_at(decoder, at));\n", schema->namespace, schema->namespace, schema->namespace, type);
+                fprintf(fp, "}\n");
+                schema_generate_vector_iterator(schema, type, decoder_use_memcpy, fp);
+        } else if (schema_type_is_table(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                }
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    offset  = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "    offset += *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + offset + (sizeof(offset) * at), sizeof(offset));\n", schema_offset_type_name(schema->offset_type));
+                } else {
+                        fprintf(fp, "    offset  = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "    offset += ((%s_t *) (((const uint8_t *) decoder) + offset))[at];\n", schema_offset_type_name(schema->offset_type));
+                }
+                        fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                schema_generate_vector_iterator(schema, type, decoder_use_memcpy, fp);
+        } else if (schema_type_is_struct(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_count (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&count, ((const uint8_t *) decoder), sizeof(count));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder));\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_vector_get_length (const struct %s_%s_vector *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return %s_%s_vector_get_count(decoder) * sizeof(struct %s_%s);\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_get_values (const struct %s_%s_vector *decoder)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (decoder == NULL) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_get_at (const struct %s_%s_vector *decoder, %s_t at)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type, schema_count_type_name(schema->count_type));
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + sizeof(struct %s_%s) * at);\n", schema->namespace, type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema->namespace, type);
+                fprintf(fp, "}\n");
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_vector_encoder_sorted (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        int compact;
+        char type[128];
+        uint64_t key_i;
+        uint64_t key_s;
+        uint64_t table_field_i;
+        struct schema_table_field *key;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        key = schema_table_get_key(table);
+        if (key == NULL) {
+                return 0;
+        }
+        compact = schema_table_is_compact(schema, table);
+
+        key_i = 0;
+        key_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field == key) {
+                        break;
+                }
+                key_i += 1;
+                key_s += schema_table_field_size(schema, table_field);
+        }
+
+        if (schema_type_is_string(key->type)) {
+                snprintf(type, sizeof(type), "const char *");
+        } else if (schema_type_is_scalar(key->type)) {
+                snprintf(type, sizeof(type), "%s_t ", key->type);
+        } else {
+                snprintf(type, sizeof(type), "%s ", key->type);
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline %s%s_%s_vector_key (const uint8_t *table)\n", type, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    uint64_t slot;\n");
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        } else {
+                fprintf(fp, "    %svalue;\n", type);
+        }
+        fprintf(fp, "    memcpy(&count, table, sizeof(count));\n");
+        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), key_i);
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "        return \"%s\";\n", (key->value) ? key->value : "");
+        } else {
+                fprintf(fp, "        return %s;\n", (key->value) ? key->value : "0");
+        }
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (!(table[%" PRIu64 "] & 0x%02x)) {\n", schema_count_type_size(schema->count_type) + key_i / 8, (1 << (key_i % 8)));
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "        return \"\";\n");
+        } else {
+                fprintf(fp, "        return %s;\n", (key->value) ? key->value : "0");
+        }
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    slot = %s_C(%" PRIu64 ") + (count + 7) / 8;\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                table_field_i = 0;
+                TAILQ_FOREACH(table_field, &table->fields, list) {
+                        if (table_field == key) {
+                                break;
+                        }
+                        fprintf(fp, "    slot += (table[%" PRIu64 "] & 0x%02x) ? %" PRIu64 " : 0;\n", schema_count_type_size(schema->count_type) + table_field_i / 8, (1 << (table_field_i % 8)), schema_table_field_size(schema, table_field));
+                        table_field_i += 1;
+                }
+        } else {
+                fprintf(fp, "    slot = %s_C(%" PRIu64 ") + (count + 7) / 8 + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), key_s);
+        }
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "    memcpy(&offset, table + slot, sizeof(offset));\n");
+                fprintf(fp, "    return (const char *) (table %s offset);\n", (compact) ? "-" : "+");
+        } else {
+                fprintf(fp, "    memcpy(&value, table + slot, sizeof(value));\n");
+                fprintf(fp, "    return value;\n");
+        }
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_compare (void *context, uint64_t a, uint64_t b)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    const uint8_t *buffer;\n");
+        fprintf(fp, "    %sva;\n", type);
+        fprintf(fp, "    %svb;\n", type);
+        fprintf(fp, "    buffer = (const uint8_t *) context;\n");
+        fprintf(fp, "    va = %s_%s_vector_key(buffer + a);\n", schema->namespace, table->name);
+        fprintf(fp, "    vb = %s_%s_vector_key(buffer + b);\n", schema->namespace, table->name);
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "    return strcmp(va, vb);\n");
+        } else {
+                fprintf(fp, "    return (va < vb) ? -1 : (va > vb) ? 1 : 0;\n");
+        }
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end_sorted (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    uint64_t offset;\n");
+        fprintf(fp, "    const void *buffer;\n");
+        fprintf(fp, "    buffer = linearbuffers_encoder_linearized(encoder, NULL);\n");
+        fprintf(fp, "    if (buffer == NULL) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    rc = linearbuffers_encoder_vector_end_table_sorted(encoder, &offset, %s_%s_vector_compare, (void *) buffer);\n", schema->namespace, table->name);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, table->name);
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_vector_encoder (struct schema *schema, const char *type, FILE *fp)
+{
+        int rc;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_VECTOR_ENCODER_API)\n", schema->NAMESPACE, type);
+        fprintf(fp, "#define %s_%s_VECTOR_ENCODER_API\n", schema->NAMESPACE, type);
+
+        if (schema_type_is_scalar(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s_t value)\n", schema->namespace, type, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s_t *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                if (schema_inttype_size(type) == sizeof(uint8_t)) {
+                        fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_reference (struct linearbuffers_encoder *encoder, const %s_t *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, type);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    int rc;\n");
+                        fprintf(fp, "    uint64_t offset;\n");
+                        fprintf(fp, "    rc = linearbuffers_encoder_bytes_reference(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                        fprintf(fp, "    if (rc != 0) {\n");
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                        fprintf(fp, "}\n");
+                }
+        } else if (schema_type_is_float(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s value)\n", schema->namespace, type, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+        } else if (schema_type_is_enum(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", schema_type_get_enum(schema, type)->type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", schema_type_get_enum(schema, type)->type);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", schema_type_get_enum(schema, type)->type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, value);\n", schema_type_get_enum(schema, type)->type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const %s_%s_t *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, schema->namespace, schema_type_get_enum(schema, type)->name);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, count);\n", schema_type_get_enum(schema, type)->type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+        } else if (schema_type_is_string(type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", type, schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_%s(encoder, &offset);\n", type);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_%s(encoder);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, const struct %s_string *value)\n", schema->namespace, type, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) value);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, type);
+                fprintf(fp, "    string = %s_%s_create(encoder, value);\n", schema->namespace, type);
+                fprintf(fp, "    if (string == NULL) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) string);\n", type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, type);
+                fprintf(fp, "    string = %s_%s_ncreate(encoder, n, value);\n", schema->namespace, type);
+                fprintf(fp, "    if (string == NULL) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_%s(encoder, (uint64_t) (ptrdiff_t) string);\n", type);
+                fprintf(fp, "}\n");
+        } else if (schema_type_is_table(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s;\n", schema->namespace, type);
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_table(encoder, &offset);\n");
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_table(encoder);\n");
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_table(encoder, (uint64_t) (ptrdiff_t) value);\n");
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push_linearized (struct linearbuffers_encoder *encoder, const void *buffer, uint64_t length)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                if (schema_table_is_compact(schema, schema_type_get_table(schema, type))) {
+                        fprintf(fp, "    %s_t root;\n", schema_offset_type_name(schema->offset_type));
+                        fprintf(fp, "    if (buffer == NULL || length < sizeof(root)) {\n");
+                        fprintf(fp, "        return -1;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    memcpy(&root, buffer, sizeof(root));\n");
+                        fprintf(fp, "    return linearbuffers_encoder_vector_push_linearized(encoder, buffer, length, root);\n");
+                } else {
+                        fprintf(fp, "    return linearbuffers_encoder_vector_push_linearized(encoder, buffer, length, 0);\n");
+                }
+                fprintf(fp, "}\n");
+                rc = schema_generate_vector_encoder_sorted(schema, schema_type_get_table(schema, type), fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate sorted vector encoder: %s", type);
+                        goto bail;
+                }
+        } else if (schema_type_is_struct(schema, type)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_%s_vector;\n", schema->namespace, type);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_start_struct(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, sizeof(struct %s_%s));\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_end_struct(encoder, &offset);\n");
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_cancel_struct(encoder);\n");
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_vector_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    return linearbuffers_encoder_vector_push_struct(encoder, value);\n");
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s_vector * %s_%s_vector_create (struct linearbuffers_encoder *encoder, const struct %s_%s *value, uint64_t count)\n", schema->namespace, type, schema->namespace, type, schema->namespace, type);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                fprintf(fp, "    rc = linearbuffers_encoder_vector_create_struct(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, value, sizeof(struct %s_%s), count);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema->namespace, type);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_%s_vector *) (ptrdiff_t) offset;\n", schema->namespace, type);
+                fprintf(fp, "}\n");
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+TAILQ_HEAD(element_entries, element_entry);
+struct element_entry {
+        TAILQ_ENTRY(element_entry) list;
+        struct schema_table *table;
+        uint64_t id;
+        uint64_t offset;
+        int vector;
+};
+
+struct element {
+        struct element_entries entries;
+        uint64_t nentries;
+};
+
+static void element_entry_destroy (struct element_entry *entry)
+{
+        if (entry == NULL) {
+                return;
+        }
+        free(entry);
+}
+
+static struct element_entry * element_entry_create (struct schema_table *table, uint64_t id, uint64_t offset, int vector)
+{
+        struct element_entry *entry;
+        entry = malloc(sizeof(struct element_entry));
+        if (entry == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(entry, 0, sizeof(struct element_entry));
+        entry->table = table;
+        entry->id = id;
+        entry->offset = offset;
+        entry->vector = vector;
+        return entry;
+bail:   if (entry != NULL) {
+                element_entry_destroy(entry);
+        }
+        return NULL;
+}
+
+static int element_push (struct element *element, struct schema_table *table, uint64_t id, uint64_t offset, int vector)
+{
+        struct element_entry *entry;
+        entry = NULL;
+        if (element == NULL) {
+                linearbuffers_errorf("element is invalid");
+                goto bail;
+        }
+        entry = element_entry_create(table, id, offset, vector);
+        if (entry == NULL) {
+                linearbuffers_errorf("can not create element entry");
+                goto bail;
+        }
+        element->nentries += 1;
+        TAILQ_INSERT_TAIL(&element->entries, entry, list);
+        return 0;
+bail:   if (entry != NULL) {
+                element_entry_destroy(entry);
+        }
+        return -1;
+}
+
+static int element_pop (struct element *element)
+{
+        struct element_entry *entry;
+        entry = NULL;
+        if (element == NULL) {
+                linearbuffers_errorf("element is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&element->entries)) {
+                linearbuffers_errorf("element is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&element->entries, element_entries);
+        TAILQ_REMOVE(&element->entries, entry, list);
+        element->nentries -= 1;
+        element_entry_destroy(entry);
+        return 0;
+bail:   return -1;
+}
+
+static void element_destroy (struct element *element)
+{
+        struct element_entry *entry;
+        struct element_entry *nentry;
+        if (element == NULL) {
+                return;
+        }
+        TAILQ_FOREACH_SAFE(entry, &element->entries, list, nentry) {
+                TAILQ_REMOVE(&element->entries, entry, list);
+                element_entry_destroy(entry);
+        }
+        free(element);
+}
+
+static struct element * element_create (void)
+{
+        struct element *element;
+        element = malloc(sizeof(struct element));
+        if (element == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(element, 0, sizeof(struct element));
+        TAILQ_INIT(&element->entries);
+        return element;
+bail:   if (element != NULL) {
+                element_destroy(element);
+        }
+        return NULL;
+}
+
+TAILQ_HEAD(namespace_entries, namespace_entry);
+struct namespace_entry {
+        TAILQ_ENTRY(namespace_entry) list;
+        char *string;
+        size_t length;
+};
+
+struct namespace {
+        struct namespace_entries entries;
+        int dirty;
+        char *linearized;
+        size_t slinearized;
+};
+
+static void namespace_entry_destroy (struct namespace_entry *entry)
+{
+        if (entry == NULL) {
+                return;
+        }
+        if (entry->string != NULL) {
+                free(entry->string);
+        }
+        free(entry);
+}
+
+static struct namespace_entry * namespace_entry_create (const char *string, va_list ap)
+{
+        va_list aq;
+        int size;
+        struct namespace_entry *entry;
+        entry = malloc(sizeof(struct namespace_entry));
+        if (entry == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(entry, 0, sizeof(struct namespace_entry));
+        va_copy(aq, ap);
+        size = vsnprintf(NULL, 0, string, aq);
+        va_end(aq);
+        if (size < 0) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        size += 1;
+        entry->string = malloc(size);
+        if (entry->string == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        va_copy(aq, ap);
+        size = vsnprintf(entry->string, size, string, aq);
+        va_end(aq);
+        if (size < 0) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        entry->length = strlen(entry->string);
+        return entry;
+bail:   if (entry != NULL) {
+                namespace_entry_destroy(entry);
+        }
+        return NULL;
+}
+
+__attribute__((format(printf, 2, 3))) static int namespace_push (struct namespace *namespace, const char *push, ...)
+{
+        va_list ap;
+        struct namespace_entry *entry;
+        entry = NULL;
+        if (namespace == NULL) {
+                linearbuffers_errorf("namespace is invalid");
+                goto bail;
+        }
+        if (push == NULL) {
+                linearbuffers_errorf("push is invalid");
+                goto bail;
+        }
+        va_start(ap, push);
+        entry = namespace_entry_create(push, ap);
+        va_end(ap);
+        if (entry == NULL) {
+                linearbuffers_errorf("can not create namespace entry");
+                goto bail;
+        }
+        TAILQ_INSERT_TAIL(&namespace->entries, entry, list);
+        namespace->dirty = 1;
+        return 0;
+bail:   if (entry != NULL) {
+                namespace_entry_destroy(entry);
+        }
+        return -1;
+}
+
+static int namespace_pop (struct namespace *namespace)
+{
+        struct namespace_entry *entry;
+        entry = NULL;
+        if (namespace == NULL) {
+                linearbuffers_errorf("namespace is invalid");
+                goto bail;
+        }
+        if (TAILQ_EMPTY(&namespace->entries)) {
+                linearbuffers_errorf("namespace is empty");
+                goto bail;
+        }
+        entry = TAILQ_LAST(&namespace->entries, namespace_entries);
+        TAILQ_REMOVE(&namespace->entries, entry, list);
+        namespace_entry_destroy(entry);
+        namespace->dirty = 1;
+        return 0;
+bail:   if (entry != NULL) {
+                namespace_entry_destroy(entry);
+        }
+        return -1;
+}
+
+static const char * namespace_linearized (struct namespace *namespace)
+{
+        size_t slinearized;
+        struct namespace_entry *entry;
+        if (namespace == NULL) {
+                return NULL;
+        }
+        if (namespace->dirty == 0) {
+                return namespace->linearized;
+        }
+        slinearized = 0;
+        TAILQ_FOREACH(entry, &namespace->entries, list) {
+                slinearized += entry->length;
+        }
+        if (slinearized > namespace->slinearized) {
+                if (namespace->linearized != NULL) {
+                        free(namespace->linearized);
+                        namespace->linearized = NULL;
+                }
+                namespace->linearized = malloc(slinearized + 1 + 4);
+                if (namespace->linearized == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        namespace->slinearized = 0;
+                        goto bail;
+                }
+                namespace->slinearized = slinearized;
+        }
+        slinearized = 0;
+        TAILQ_FOREACH(entry, &namespace->entries, list) {
+                slinearized += sprintf(namespace->linearized + slinearized, "%s", entry->string);
+        }
+        namespace->dirty = 0;
+        return namespace->linearized;
+bail:   return NULL;
+}
+
+static void namespace_destroy (struct namespace *namespace)
+{
+        struct namespace_entry *entry;
+        struct namespace_entry *nentry;
+        if (namespace == NULL) {
+                return;
+        }
+        TAILQ_FOREACH_SAFE(entry, &namespace->entries, list, nentry) {
+                TAILQ_REMOVE(&namespace->entries, entry, list);
+                namespace_entry_destroy(entry);
+        }
+        free(namespace);
+}
+
+static struct namespace * namespace_create (void)
+{
+        struct namespace *namespace;
+        namespace = malloc(sizeof(struct namespace));
+        if (namespace == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(namespace, 0, sizeof(struct namespace));
+        TAILQ_INIT(&namespace->entries);
+        return namespace;
+bail:   if (namespace != NULL) {
+                namespace_destroy(namespace);
+        }
+        return NULL;
+}
+
+static int schema_generate_encoder_table (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        int rc;
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_ENCODER_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_ENCODER_API\n", schema->NAMESPACE, table->name);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "struct %s_%s;\n", schema->namespace, table->name);
+        fprintf(fp, "\n");
+
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (schema_table_field_size(schema, table_field) == 0) {
+                        linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        goto bail;
+                }
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return linearbuffers_encoder_table_start%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "));\n", (schema_table_is_compact(schema, table)) ? "_compact" : "", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema_count_type_NAME(schema->count_type), table->nfields, schema_offset_type_NAME(schema->offset_type), table_field_s);
+        fprintf(fp, "}\n");
+
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                struct schema_attribute *attribute;
+                struct namespace *attribute_string;
+                attribute_string = namespace_create();
                 namespace_push(attribute_string, "__attribute__ (( unused");
                 TAILQ_FOREACH(attribute, &table_field->attributes, list) {
                         if (strcmp(attribute->name, "deprecated") == 0) {
@@ -864,297 +2116,3131 @@ static int schema_generate_encoder_table (struct schema *schema, struct schema_t
                                     strcmp(attribute->value, "1") == 0 ||
                                     strcmp(attribute->value, "yes") == 0 ||
                                     strcmp(attribute->value, "true") == 0) {
-                                        namespace_push(attribute_string, ", deprecated");
+                                        namespace_push(attribute_string, ", deprecated");
+                                }
+                        }
+                }
+                namespace_push(attribute_string, " )) static inline");
+
+                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none) {
+                        if (table_field->container != schema_container_type_vector ||
+                            !schema_type_is_scalar(table_field->type)) {
+                                linearbuffers_errorf("encoding is only supported for integer vectors: %s", table_field->name);
+                                goto bail;
+                        }
+                        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    int rc;\n");
+                        fprintf(fp, "    uint64_t offset;\n");
+                        fprintf(fp, "    rc = linearbuffers_encoder_vector_create_encoded(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, linearbuffers_encoder_encoding_%s, &offset, values, sizeof(%s_t), %d, count);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema_vector_encoding_name(schema_table_field_encoding(table_field)), table_field->type, (strncmp(table_field->type, "int", 3) == 0) ? 1 : 0);
+                        fprintf(fp, "    if (rc != 0) {\n");
+                        fprintf(fp, "        return -1;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        fprintf(fp, "}\n");
+                } else if (schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const char **values, uint64_t count)\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    int rc;\n");
+                        fprintf(fp, "    uint64_t offset;\n");
+                        fprintf(fp, "    rc = linearbuffers_encoder_vector_create_dictionary(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &offset, values, count);\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+                        fprintf(fp, "    if (rc != 0) {\n");
+                        fprintf(fp, "        return -1;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_vector) {
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                if (schema_inttype_size(table_field->type) == sizeof(uint8_t)) {
+                                        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_reference (struct linearbuffers_encoder *encoder, const %s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                                        fprintf(fp, "{\n");
+                                        fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                        fprintf(fp, "    vector = %s_%s_vector_reference(encoder, values, count);\n", schema->namespace, table_field->type);
+                                        fprintf(fp, "    if (vector == NULL) {\n");
+                                        fprintf(fp, "        return -1;\n");
+                                        fprintf(fp, "    }\n");
+                                        fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                        fprintf(fp, "}\n");
+                                }
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s_t value)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s value)\n", schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s_%s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_string_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const char **values, uint64_t count)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    uint64_t i;\n");
+                                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    rc = %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (rc != 0) {\n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    for (i = 0; i < count; i++) {\n");
+                                fprintf(fp, "        string = %s_%s_create(encoder, values[i]);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "        if (string == NULL) {\n");
+                                fprintf(fp, "            return -1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "        rc = %s_%s_vector_push(encoder, string);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "        if (rc != 0) {\n");
+                                fprintf(fp, "            return rc;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    vector = %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push_create(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push_ncreate(encoder, n, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_table(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push_linearized (struct linearbuffers_encoder *encoder, const void *buffer, uint64_t length)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push_linearized(encoder, buffer, length);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create_linearized (struct linearbuffers_encoder *encoder, const void * const *buffers, const uint64_t *lengths, uint64_t count)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    uint64_t i;\n");
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    rc = %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (rc != 0) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    for (i = 0; i < count; i++) {\n");
+                                fprintf(fp, "        rc = %s_%s_vector_push_linearized(encoder, buffers[i], lengths[i]);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "        if (rc != 0) {\n");
+                                fprintf(fp, "            %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "            return -1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    vector = %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                if (schema_table_get_key(schema_type_get_table(schema, table_field->type)) != NULL) {
+                                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end_sorted (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                        fprintf(fp, "{\n");
+                                        fprintf(fp, "    return %s_%s_vector_end_sorted(encoder);\n", schema->namespace, table_field->type);
+                                        fprintf(fp, "}\n");
+                                }
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const struct %s_%s *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (vector == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else {
+                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                                goto bail;
+                        }
+                } else if (table_field->container == schema_container_type_map) {
+                        const char *count_type;
+                        const char *offset_type;
+                        count_type = schema_count_type_name(schema->count_type);
+                        offset_type = schema_offset_type_name(schema->offset_type);
+                        fprintf(fp, "struct %s_%s_%s_map;\n", schema->namespace, table_field->key, table_field->type);
+                        fprintf(fp, "%s int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return linearbuffers_encoder_map_start(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, %" PRIu64 ", %d, %" PRIu64 ", %d);\n", count_type, offset_type, schema_map_part_size(schema, table_field->key), schema_map_part_is_reference(schema, table_field->key), schema_map_part_size(schema, table_field->type), schema_map_part_is_reference(schema, table_field->type));
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "%s int %s_%s_%s_put (struct linearbuffers_encoder *encoder, ", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                        rc = schema_generate_map_type(schema, table_field->key, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " key, ");
+                        rc = schema_generate_map_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " value)\n");
+                        fprintf(fp, "{\n");
+                        if (schema_type_is_string(table_field->key) ||
+                            schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "    int rc;\n");
+                        }
+                        if (schema_map_part_is_reference(schema, table_field->key)) {
+                                fprintf(fp, "    uint64_t koffset;\n");
+                        }
+                        if (schema_map_part_is_reference(schema, table_field->type)) {
+                                fprintf(fp, "    uint64_t voffset;\n");
+                        }
+                        if (schema_type_is_string(table_field->key)) {
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create_prefixed(encoder, linearbuffers_encoder_count_type_%s, &koffset, key);\n", count_type);
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &koffset, key);\n");
+                                }
+                                fprintf(fp, "    if (rc != 0) {\n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                        }
+                        if (schema_type_is_string(table_field->type)) {
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create_prefixed(encoder, linearbuffers_encoder_count_type_%s, &voffset, value);\n", count_type);
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &voffset, value);\n");
+                                }
+                                fprintf(fp, "    if (rc != 0) {\n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                        } else if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "    if (value == NULL) {\n");
+                                fprintf(fp, "        return -1;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    voffset = (uint64_t) (ptrdiff_t) value;\n");
+                        }
+                        if (schema_type_is_string(table_field->key)) {
+                                fprintf(fp, "    return linearbuffers_encoder_map_put_reference(encoder, %s_map_hash_string(key), &koffset, key, strlen(key), %s);\n",
+                                        schema->namespace,
+                                        (schema_map_part_is_reference(schema, table_field->type)) ? "&voffset" : "&value");
+                        } else {
+                                fprintf(fp, "    return linearbuffers_encoder_map_put(encoder, %s_map_hash_integer((uint64_t) key), &key, %s);\n",
+                                        schema->namespace,
+                                        (schema_map_part_is_reference(schema, table_field->type)) ? "&voffset" : "&value");
+                        }
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "%s const struct %s_%s_%s_map * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", namespace_linearized(attribute_string), schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    int rc;\n");
+                        fprintf(fp, "    uint64_t offset;\n");
+                        fprintf(fp, "    rc = linearbuffers_encoder_map_end(encoder, &offset);\n");
+                        fprintf(fp, "    if (rc != 0) {\n");
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const struct %s_%s_%s_map *) (ptrdiff_t) offset;\n", schema->namespace, table_field->key, table_field->type);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "%s int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return linearbuffers_encoder_map_cancel(encoder);\n");
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_%s_map *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->key, table_field->type);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return linearbuffers_encoder_table_set_map(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const ", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                        rc = schema_generate_array_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " *value)\n");
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return linearbuffers_encoder_table_set_array(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value, %" PRIu64 ");\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s, schema_table_field_size(schema, table_field));
+                        fprintf(fp, "}\n");
+                } else {
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s_t value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                if (schema->elide_defaults && table_field->value != NULL) {
+                                        fprintf(fp, "    if (value == (%s_t) (%s)) {\n", table_field->type, table_field->value);
+                                        fprintf(fp, "        return linearbuffers_encoder_table_unset(encoder, %s_C(%" PRIu64 "));\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                                        fprintf(fp, "    }\n");
+                                }
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, table_field->type);
+                                fprintf(fp, "{\n");
+                                if (schema->elide_defaults && table_field->value != NULL) {
+                                        fprintf(fp, "    if (value == (%s) (%s)) {\n", table_field->type, table_field->value);
+                                        fprintf(fp, "        return linearbuffers_encoder_table_unset(encoder, %s_C(%" PRIu64 "));\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                                        fprintf(fp, "    }\n");
+                                }
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    uint64_t offset;\n");
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, value);\n", schema_count_type_name(schema->count_type));
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &offset, value);\n");
+                                }
+                                fprintf(fp, "    if (rc != 0) { \n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "%s int %s_%s_%s_createf (struct linearbuffers_encoder *encoder, const char *value, ...)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    va_list ap;\n");
+                                fprintf(fp, "    uint64_t offset;\n");
+                                fprintf(fp, "    va_start(ap, value);\n");
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_createv_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, value, ap);\n", schema_count_type_name(schema->count_type));
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_createv(encoder, &offset, value, ap);\n");
+                                }
+                                fprintf(fp, "    va_end(ap);\n");
+                                fprintf(fp, "    if (rc != 0) { \n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "%s int %s_%s_%s_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    uint64_t offset;\n");
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, n, value);\n", schema_count_type_name(schema->count_type));
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate(encoder, &offset, n, value);\n");
+                                }
+                                fprintf(fp, "    if (rc != 0) { \n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "%s int %s_%s_%s_reference (struct linearbuffers_encoder *encoder, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    int rc;\n");
+                                fprintf(fp, "    uint64_t offset;\n");
+                                if (schema_string_is_prefixed(schema)) {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_reference_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, value);\n", schema_count_type_name(schema->count_type));
+                                } else {
+                                        fprintf(fp, "    rc = linearbuffers_encoder_string_reference(encoder, &offset, value);\n");
+                                }
+                                fprintf(fp, "    if (rc != 0) { \n");
+                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_string *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                if (schema->elide_defaults && table_field->value != NULL) {
+                                        fprintf(fp, "    if (value == %s_%s_%s) {\n", schema->namespace, table_field->type, table_field->value);
+                                        fprintf(fp, "        return linearbuffers_encoder_table_unset(encoder, %s_C(%" PRIu64 "));\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                                        fprintf(fp, "    }\n");
+                                }
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", schema_type_get_enum(schema, table_field->type)->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_table(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_struct(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value, sizeof(struct %s_%s));\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s, schema->namespace, table_field->type);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_union(schema, table_field->type)) {
+                                struct schema_table_field *union_field;
+                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s_%s_type_t type, const void *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    return linearbuffers_encoder_table_set_union(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), type, (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "}\n");
+                                TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                        fprintf(fp, "%s int %s_%s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, union_field->name, schema->namespace, union_field->type);
+                                        fprintf(fp, "{\n");
+                                        fprintf(fp, "    return %s_%s_%s_set(encoder, %s_%s_type_%s, value);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type, union_field->name);
+                                        fprintf(fp, "}\n");
+                                }
+                        } else {
+                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                                goto bail;
+                        }
+                }
+                table_field_i += 1;
+                table_field_s += schema_table_field_size(schema, table_field);
+                namespace_destroy(attribute_string);
+        }
+
+        fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s * %s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    uint64_t offset;\n");
+        fprintf(fp, "    rc = linearbuffers_encoder_table_end(encoder, &offset);\n");
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return (const struct %s_%s *) (ptrdiff_t) offset;\n", schema->namespace, table->name);
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return linearbuffers_encoder_table_cancel(encoder);\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_finish (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return linearbuffers_encoder_table_end(encoder, NULL);\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static void schema_generate_relinearize_child (int compact, int indent, FILE *fp)
+{
+        if (compact) {
+                fprintf(fp, "%*schild = position - offset;\n", indent, "");
+        } else {
+                fprintf(fp, "%*schild = position + offset;\n", indent, "");
+        }
+}
+
+static int schema_generate_relinearize_field (struct schema *schema, struct schema_table_field *table_field, FILE *fp)
+{
+        uint64_t size;
+
+        if (table_field->container == schema_container_type_map) {
+                fprintf(fp, "        target = %s_relinearize_map(relinearize, buffer, child, %" PRIu64 ", ", schema->namespace, schema_map_part_size(schema, table_field->key));
+                if (schema_type_is_string(table_field->key)) {
+                        fprintf(fp, "%s_relinearize_string", schema->namespace);
+                } else if (schema_type_is_table(schema, table_field->key)) {
+                        fprintf(fp, "%s_%s_relinearize_at", schema->namespace, table_field->key);
+                } else {
+                        fprintf(fp, "NULL");
+                }
+                fprintf(fp, ", %" PRIu64 ", ", schema_map_part_size(schema, table_field->type));
+                if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "%s_relinearize_string", schema->namespace);
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "%s_%s_relinearize_at", schema->namespace, table_field->type);
+                } else {
+                        fprintf(fp, "NULL");
+                }
+                fprintf(fp, ");\n");
+        } else if (table_field->container == schema_container_type_vector) {
+                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                    schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "        target = %s_relinearize_block(relinearize, buffer, child, %s_C(%" PRIu64 ") + %s_relinearize_count(buffer, child));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema->namespace);
+                } else if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "        target = %s_relinearize_vector(relinearize, buffer, child, %s_relinearize_string);\n", schema->namespace, schema->namespace);
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        target = %s_relinearize_vector(relinearize, buffer, child, %s_%s_relinearize_at);\n", schema->namespace, schema->namespace, table_field->type);
+                } else {
+                        if (schema_type_is_struct(schema, table_field->type)) {
+                                size = schema_struct_size(schema, table_field->type);
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                size = schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
+                        } else {
+                                size = schema_inttype_size(table_field->type);
+                        }
+                        fprintf(fp, "        target = %s_relinearize_block(relinearize, buffer, child, %s_C(%" PRIu64 ") + %s_relinearize_count(buffer, child) * %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema->namespace, schema_offset_type_NAME(schema->offset_type), size);
+                }
+        } else if (schema_type_is_string(table_field->type)) {
+                fprintf(fp, "        target = %s_relinearize_string(relinearize, buffer, child);\n", schema->namespace);
+        } else if (schema_type_is_table(schema, table_field->type)) {
+                fprintf(fp, "        target = %s_%s_relinearize_at(relinearize, buffer, child);\n", schema->namespace, table_field->type);
+        } else {
+                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                return -1;
+        }
+        return 0;
+}
+
+static int schema_generate_relinearize_table (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        int rc;
+        int compact;
+        int need_child;
+        uint64_t size;
+        uint64_t count_size;
+        uint64_t offset_size;
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        const char *direction;
+        struct schema_table_field *table_field;
+        struct schema_table_field *union_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        compact = schema_table_is_compact(schema, table);
+        count_size = schema_count_type_size(schema->count_type);
+        offset_size = schema_offset_type_size(schema->offset_type);
+        direction = (compact) ? "backward" : "forward";
+
+        need_child = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field->container == schema_container_type_array) {
+                        continue;
+                }
+                if (table_field->container == schema_container_type_vector ||
+                    table_field->container == schema_container_type_map ||
+                    schema_type_is_string(table_field->type) ||
+                    schema_type_is_table(schema, table_field->type) ||
+                    schema_type_is_union(schema, table_field->type)) {
+                        need_child = 1;
+                }
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_%s_relinearize_at (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    int64_t object;\n");
+        if (need_child) {
+                fprintf(fp, "    int64_t target;\n");
+                fprintf(fp, "    uint64_t child;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+        }
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t slots;\n");
+        fprintf(fp, "    uint64_t header;\n");
+        fprintf(fp, "    uint64_t size;\n");
+        fprintf(fp, "    uint8_t last;\n");
+        fprintf(fp, "    %s_t ncount;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    object = linearbuffers_relinearize_lookup(relinearize, position);\n");
+        fprintf(fp, "    if (object >= 0) {\n");
+        fprintf(fp, "        return object;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    count = %s_relinearize_count(buffer, position);\n", schema->namespace);
+        fprintf(fp, "    present = buffer + position + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    slots = position + %s_C(%" PRIu64 ") + (count + 7) / 8;\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    ncount = 0;\n");
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                table_field_i += 1;
+        }
+        while (table_field_i-- > 0) {
+                fprintf(fp, "    if (ncount == 0 && count > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                fprintf(fp, "        ncount = %" PRIu64 ";\n", table_field_i + 1);
+                fprintf(fp, "    }\n");
+        }
+        fprintf(fp, "    size = 0;\n");
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (compact) {
+                        fprintf(fp, "    if (ncount > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                } else {
+                        fprintf(fp, "    if (ncount > %" PRIu64 ") {\n", table_field_i);
+                }
+                fprintf(fp, "        size += %" PRIu64 ";\n", schema_table_field_size(schema, table_field));
+                fprintf(fp, "    }\n");
+                table_field_i += 1;
+        }
+        fprintf(fp, "    header = %s_C(%" PRIu64 ") + (ncount + 7) / 8;\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    object = linearbuffers_relinearize_object(relinearize, position, NULL, 0, header + size, 0);\n");
+        fprintf(fp, "    if (object < 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    rc  = linearbuffers_relinearize_write(relinearize, object, 0, &ncount, sizeof(ncount));\n");
+        fprintf(fp, "    rc |= linearbuffers_relinearize_write(relinearize, object, %s_C(%" PRIu64 "), present, ncount / 8);\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    if (ncount %% 8 != 0) {\n");
+        fprintf(fp, "        last = present[ncount / 8] & ((1 << (ncount %% 8)) - 1);\n");
+        fprintf(fp, "        rc |= linearbuffers_relinearize_write(relinearize, object, %s_C(%" PRIu64 ") + ncount / 8, &last, sizeof(last));\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    rc |= linearbuffers_relinearize_write(relinearize, object, header, buffer + slots, size);\n");
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    size = 0;\n");
+        }
+
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                size = schema_table_field_size(schema, table_field);
+                if (table_field->container == schema_container_type_array ||
+                    (table_field->container == schema_container_type_none &&
+                     !schema_type_is_string(table_field->type) &&
+                     !schema_type_is_table(schema, table_field->type) &&
+                     !schema_type_is_union(schema, table_field->type))) {
+                        if (compact) {
+                                fprintf(fp, "    if (ncount > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                                fprintf(fp, "        size += %" PRIu64 ";\n", size);
+                                fprintf(fp, "    }\n");
+                        }
+                        table_field_i += 1;
+                        table_field_s += size;
+                        continue;
+                }
+                fprintf(fp, "    if (ncount > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                if (compact) {
+                        fprintf(fp, "        const uint64_t slot = size;\n");
+                        fprintf(fp, "        size += %" PRIu64 ";\n", size);
+                } else {
+                        fprintf(fp, "        const uint64_t slot = %" PRIu64 ";\n", table_field_s);
+                }
+                if (table_field->container == schema_container_type_none &&
+                    schema_type_is_union(schema, table_field->type)) {
+                        fprintf(fp, "        if (buffer[slots + slot] != %s_%s_type_NONE) {\n", schema->namespace, table_field->type);
+                        fprintf(fp, "            offset = %s_relinearize_offset(buffer, slots + slot + 1);\n", schema->namespace);
+                        schema_generate_relinearize_child(compact, 12, fp);
+                        fprintf(fp, "            switch (buffer[slots + slot]) {\n");
+                        TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                fprintf(fp, "                case %s_%s_type_%s:\n", schema->namespace, table_field->type, union_field->name);
+                                fprintf(fp, "                    target = %s_%s_relinearize_at(relinearize, buffer, child);\n", schema->namespace, union_field->type);
+                                fprintf(fp, "                    break;\n");
+                        }
+                        fprintf(fp, "                default:\n");
+                        fprintf(fp, "                    target = -1;\n");
+                        fprintf(fp, "                    break;\n");
+                        fprintf(fp, "            }\n");
+                        fprintf(fp, "            if (target < 0) {\n");
+                        fprintf(fp, "                return -1;\n");
+                        fprintf(fp, "            }\n");
+                        fprintf(fp, "            rc = linearbuffers_relinearize_reference(relinearize, object, header + slot + 1, %s_C(%" PRIu64 "), 0, linearbuffers_relinearize_direction_%s, target);\n", schema_offset_type_NAME(schema->offset_type), offset_size, direction);
+                        fprintf(fp, "            if (rc != 0) {\n");
+                        fprintf(fp, "                return -1;\n");
+                        fprintf(fp, "            }\n");
+                        fprintf(fp, "        }\n");
+                } else {
+                        fprintf(fp, "        offset = %s_relinearize_offset(buffer, slots + slot);\n", schema->namespace);
+                        schema_generate_relinearize_child(compact, 8, fp);
+                        rc = schema_generate_relinearize_field(schema, table_field, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate relinearize for field: %s", table_field->name);
+                                goto bail;
+                        }
+                        fprintf(fp, "        if (target < 0) {\n");
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        rc = linearbuffers_relinearize_reference(relinearize, object, header + slot, %s_C(%" PRIu64 "), 0, linearbuffers_relinearize_direction_%s, target);\n", schema_offset_type_NAME(schema->offset_type), offset_size, direction);
+                        fprintf(fp, "        if (rc != 0) {\n");
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                }
+                fprintf(fp, "    }\n");
+                table_field_i += 1;
+                table_field_s += size;
+        }
+        fprintf(fp, "    return object;\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_relinearize (struct linearbuffers_relinearize *relinearize, const void *buffer, uint64_t length)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int64_t root;\n");
+        if (compact) {
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    int64_t table;\n");
+        }
+        fprintf(fp, "    if (relinearize == NULL ||\n");
+        fprintf(fp, "        buffer == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    if (length < %s_C(%" PRIu64 ")) {\n", schema_offset_type_NAME(schema->offset_type), offset_size);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    table = %s_%s_relinearize_at(relinearize, (const uint8_t *) buffer, %s_relinearize_offset((const uint8_t *) buffer, 0));\n", schema->namespace, table->name, schema->namespace);
+                fprintf(fp, "    if (table < 0) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    root = linearbuffers_relinearize_object(relinearize, 0, NULL, 0, %s_C(%" PRIu64 "), 0);\n", schema_offset_type_NAME(schema->offset_type), offset_size);
+                fprintf(fp, "    if (root < 0) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    rc = linearbuffers_relinearize_reference(relinearize, root, 0, %s_C(%" PRIu64 "), 0, linearbuffers_relinearize_direction_forward, table);\n", schema_offset_type_NAME(schema->offset_type), offset_size);
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        } else {
+                fprintf(fp, "    if (length < %s_C(%" PRIu64 ")) {\n", schema_offset_type_NAME(schema->offset_type), count_size);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    root = %s_%s_relinearize_at(relinearize, (const uint8_t *) buffer, 0);\n", schema->namespace, table->name);
+                fprintf(fp, "    if (root < 0) {\n");
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        }
+        fprintf(fp, "    return linearbuffers_relinearize_end(relinearize, root);\n");
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_relinearize (struct schema *schema, FILE *fp)
+{
+        int rc;
+        uint64_t count_size;
+        uint64_t offset_size;
+        struct schema_table *table;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        count_size = schema_count_type_size(schema->count_type);
+        offset_size = schema_offset_type_size(schema->offset_type);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_RELINEARIZE_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_RELINEARIZE_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_relinearize_count (const uint8_t *buffer, uint64_t position)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    memcpy(&count, buffer + position, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_relinearize_offset (const uint8_t *buffer, uint64_t position)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "    memcpy(&offset, buffer + position, sizeof(offset));\n");
+        fprintf(fp, "    return offset;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_relinearize_block (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position, uint64_t size)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int64_t object;\n");
+        fprintf(fp, "    object = linearbuffers_relinearize_lookup(relinearize, position);\n");
+        fprintf(fp, "    if (object >= 0) {\n");
+        fprintf(fp, "        return object;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return linearbuffers_relinearize_object(relinearize, position, buffer + position, size, size, 0);\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_relinearize_string (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int64_t object;\n");
+        fprintf(fp, "    uint64_t size;\n");
+        fprintf(fp, "    object = linearbuffers_relinearize_lookup(relinearize, position);\n");
+        fprintf(fp, "    if (object >= 0) {\n");
+        fprintf(fp, "        return object;\n");
+        fprintf(fp, "    }\n");
+        if (schema_string_is_prefixed(schema)) {
+                fprintf(fp, "    size = %s_C(%" PRIu64 ") + %s_relinearize_count(buffer, position - %s_C(%" PRIu64 ")) + 1;\n", schema_offset_type_NAME(schema->offset_type), count_size, schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size);
+                fprintf(fp, "    return linearbuffers_relinearize_object(relinearize, position, buffer + position - %s_C(%" PRIu64 "), size, size, %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), count_size, schema_offset_type_NAME(schema->offset_type), count_size);
+        } else {
+                fprintf(fp, "    size = strlen((const char *) buffer + position) + 1;\n");
+                fprintf(fp, "    return linearbuffers_relinearize_object(relinearize, position, buffer + position, size, size, 0);\n");
+        }
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_relinearize_vector (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position, int64_t (*element) (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position))\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    int64_t object;\n");
+        fprintf(fp, "    int64_t target;\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t offset;\n");
+        fprintf(fp, "    %s_t offsets;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "    object = linearbuffers_relinearize_lookup(relinearize, position);\n");
+        fprintf(fp, "    if (object >= 0) {\n");
+        fprintf(fp, "        return object;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    count = %s_relinearize_count(buffer, position);\n", schema->namespace);
+        fprintf(fp, "    object = linearbuffers_relinearize_object(relinearize, position, buffer + position, %s_C(%" PRIu64 "), %s_C(%" PRIu64 ") + count * %s_C(%" PRIu64 "), 0);\n", schema_offset_type_NAME(schema->offset_type), count_size, schema_offset_type_NAME(schema->offset_type), count_size + offset_size, schema_offset_type_NAME(schema->offset_type), offset_size);
+        fprintf(fp, "    if (object < 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    offsets = %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), count_size + offset_size);
+        fprintf(fp, "    rc = linearbuffers_relinearize_write(relinearize, object, %s_C(%" PRIu64 "), &offsets, sizeof(offsets));\n", schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    offset = (count > 0) ? %s_relinearize_offset(buffer, position + %s_C(%" PRIu64 ")) : 0;\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    for (i = 0; i < count; i++) {\n");
+        fprintf(fp, "        target = element(relinearize, buffer, position + (%s_t) (offset + %s_relinearize_offset(buffer, position + offset + i * %s_C(%" PRIu64 "))));\n", schema_offset_type_name(schema->offset_type), schema->namespace, schema_offset_type_NAME(schema->offset_type), offset_size);
+        fprintf(fp, "        if (target < 0) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        rc = linearbuffers_relinearize_reference(relinearize, object, %s_C(%" PRIu64 ") + i * %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), linearbuffers_relinearize_direction_forward, target);\n", schema_offset_type_NAME(schema->offset_type), count_size + offset_size, schema_offset_type_NAME(schema->offset_type), offset_size, schema_offset_type_NAME(schema->offset_type), offset_size, schema_offset_type_NAME(schema->offset_type), count_size + offset_size);
+        fprintf(fp, "        if (rc != 0) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return object;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int64_t %s_relinearize_map (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position, uint64_t key_size, int64_t (*key) (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position), uint64_t value_size, int64_t (*value) (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position))\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    int64_t object;\n");
+        fprintf(fp, "    int64_t target;\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t size;\n");
+        fprintf(fp, "    uint64_t slot;\n");
+        fprintf(fp, "    uint64_t capacity;\n");
+        fprintf(fp, "    object = linearbuffers_relinearize_lookup(relinearize, position);\n");
+        fprintf(fp, "    if (object >= 0) {\n");
+        fprintf(fp, "        return object;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    capacity = %s_relinearize_count(buffer, position + %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    size = %s_C(%" PRIu64 ") + (capacity + 7) / 8 + capacity * (key_size + value_size);\n", schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "    object = linearbuffers_relinearize_object(relinearize, position, buffer + position, size, size, 0);\n");
+        fprintf(fp, "    if (object < 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    for (i = 0; i < capacity; i++) {\n");
+        fprintf(fp, "        if (!(buffer[position + %s_C(%" PRIu64 ") + i / 8] & (1 << (i %% 8)))) {\n", schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "            continue;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (key != NULL) {\n");
+        fprintf(fp, "            slot = %s_C(%" PRIu64 ") + (capacity + 7) / 8 + i * key_size;\n", schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "            target = key(relinearize, buffer, position - %s_relinearize_offset(buffer, position + slot));\n", schema->namespace);
+        fprintf(fp, "            if (target < 0) {\n");
+        fprintf(fp, "                return -1;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "            rc = linearbuffers_relinearize_reference(relinearize, object, slot, %s_C(%" PRIu64 "), 0, linearbuffers_relinearize_direction_backward, target);\n", schema_offset_type_NAME(schema->offset_type), offset_size);
+        fprintf(fp, "            if (rc != 0) {\n");
+        fprintf(fp, "                return -1;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (value != NULL) {\n");
+        fprintf(fp, "            slot = %s_C(%" PRIu64 ") + (capacity + 7) / 8 + capacity * key_size + i * value_size;\n", schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "            target = value(relinearize, buffer, position - %s_relinearize_offset(buffer, position + slot));\n", schema->namespace);
+        fprintf(fp, "            if (target < 0) {\n");
+        fprintf(fp, "                return -1;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "            rc = linearbuffers_relinearize_reference(relinearize, object, slot, %s_C(%" PRIu64 "), 0, linearbuffers_relinearize_direction_backward, target);\n", schema_offset_type_NAME(schema->offset_type), offset_size);
+        fprintf(fp, "            if (rc != 0) {\n");
+        fprintf(fp, "                return -1;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return object;\n");
+        fprintf(fp, "}\n");
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none) {
+                        continue;
+                }
+                fprintf(fp, "__attribute__((unused)) static inline int64_t %s_%s_relinearize_at (struct linearbuffers_relinearize *relinearize, const uint8_t *buffer, uint64_t position);\n", schema->namespace, table->name);
+        }
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none) {
+                        continue;
+                }
+                rc = schema_generate_relinearize_table(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate relinearize for table: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+int schema_generate_c_encoder (struct schema *schema, FILE *fp, int encoder_include_library)
+{
+        int rc;
+
+        struct schema_enum *anum;
+        struct schema_table *table;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#include <stddef.h>\n");
+        fprintf(fp, "#include <stdint.h>\n");
+        fprintf(fp, "#include <stdarg.h>\n");
+        fprintf(fp, "#include <string.h>\n");
+
+        if (encoder_include_library == 0) {
+                fprintf(fp, "#include <linearbuffers/encoder.h>\n");
+                fprintf(fp, "#include <linearbuffers/relinearize.h>\n");
+        }
+
+        TAILQ_FOREACH(anum, &schema->enums, list) {
+                rc = schema_generate_enum(schema, anum, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate enum");
+                        goto bail;
+                }
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_struct) {
+                        continue;
+                }
+                rc = schema_generate_struct(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate struct: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_union) {
+                        continue;
+                }
+                rc = schema_generate_union(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate union: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        if (schema_has_string(schema)) {
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(%s_STRING_ENCODER_API)\n", schema->NAMESPACE);
+                fprintf(fp, "#define %s_STRING_ENCODER_API\n", schema->NAMESPACE);
+
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_string;\n", schema->namespace);
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_createv (struct linearbuffers_encoder *encoder, const char *value, va_list va)\n", schema->namespace, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                if (schema_string_is_prefixed(schema)) {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_createv_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, value, va);\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_createv(encoder, &offset, value, va);\n");
+                }
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                if (schema_string_is_prefixed(schema)) {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_create_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, value);\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &offset, value);\n");
+                }
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
+                fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+                if (schema_string_is_prefixed(schema)) {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate_prefixed(encoder, linearbuffers_encoder_count_type_%s, &offset, n, value);\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate(encoder, &offset, n, value);\n");
+                }
+                fprintf(fp, "    if (rc != 0) {\n");
+                fprintf(fp, "        return NULL;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
+                fprintf(fp, "}\n");
+
+                fprintf(fp, "\n");
+                fprintf(fp, "#endif\n");
+        }
+
+        rc = 0;
+        if (schema_has_vector(schema, "int8")) {
+                rc |= schema_generate_vector_encoder(schema, "int8", fp);
+        }
+        if (schema_has_vector(schema, "int16")) {
+                rc |= schema_generate_vector_encoder(schema, "int16", fp);
+        }
+        if (schema_has_vector(schema, "int32")) {
+                rc |= schema_generate_vector_encoder(schema, "int32", fp);
+        }
+        if (schema_has_vector(schema, "int64")) {
+                rc |= schema_generate_vector_encoder(schema, "int64", fp);
+        }
+        if (schema_has_vector(schema, "uint8")) {
+                rc |= schema_generate_vector_encoder(schema, "uint8", fp);
+        }
+        if (schema_has_vector(schema, "uint16")) {
+                rc |= schema_generate_vector_encoder(schema, "uint16", fp);
+        }
+        if (schema_has_vector(schema, "uint32")) {
+                rc |= schema_generate_vector_encoder(schema, "uint32", fp);
+        }
+        if (schema_has_vector(schema, "uint64")) {
+                rc |= schema_generate_vector_encoder(schema, "uint64", fp);
+        }
+        if (schema_has_vector(schema, "float")) {
+                rc |= schema_generate_vector_encoder(schema, "float", fp);
+        }
+        if (schema_has_vector(schema, "double")) {
+                rc |= schema_generate_vector_encoder(schema, "double", fp);
+        }
+        if (schema_has_vector(schema, "string")) {
+                rc |= schema_generate_vector_encoder(schema, "string", fp);
+        }
+
+        TAILQ_FOREACH(anum, &schema->enums, list) {
+                if (schema_has_vector(schema, anum->name)) {
+                        rc |= schema_generate_vector_encoder(schema, anum->name, fp);
+                }
+        }
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (schema_has_vector(schema, table->name)) {
+                        rc |= schema_generate_vector_encoder(schema, table->name, fp);
+                }
+        }
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate decoder for vector: %s", table->name);
+                goto bail;
+        }
+
+        if (schema_has_map(schema)) {
+                schema_generate_map_hash(schema, fp);
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct ||
+                    table->type == schema_container_type_union) {
+                        continue;
+                }
+                rc = schema_generate_encoder_table(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate decoder for table: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        rc = schema_generate_relinearize(schema, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate relinearize");
+                goto bail;
+        }
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_decoder_array (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, const char *attribute, int decoder_use_memcpy, FILE *fp)
+{
+        int rc;
+
+        fprintf(fp, "%s %s_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", attribute, schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    (void) decoder;\n");
+        fprintf(fp, "    return %s_C(%" PRIu64 ");\n", schema_count_type_NAME(schema->count_type), table_field->length);
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "%s ", attribute);
+        rc = schema_generate_array_type(schema, table_field->type, fp);
+        if (rc != 0) {
+                goto bail;
+        }
+        fprintf(fp, " %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+        fprintf(fp, "{\n");
+        fprintf(fp, "    const ");
+        schema_generate_array_type(schema, table_field->type, fp);
+        fprintf(fp, " *values;\n");
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    ");
+                schema_generate_array_type(schema, table_field->type, fp);
+                fprintf(fp, " value;\n");
+        }
+        fprintf(fp, "    values = %s_%s_%s_get(decoder);\n", schema->namespace, table->name, table_field->name);
+        fprintf(fp, "    if (values == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    return *(");
+                schema_generate_array_type(schema, table_field->type, fp);
+                fprintf(fp, " *) memcpy(&value, values + at, sizeof(value));\n");
+        } else {
+                fprintf(fp, "    return values[at];\n");
+        }
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_decoder_struct (struct schema *schema, struct schema_table *table, int decoder_use_memcpy, FILE *fp)
+{
+        int rc;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_DECODER_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_DECODER_API\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "\n");
+
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "__attribute__((unused)) static inline const ");
+                        rc = schema_generate_array_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const ");
+                        schema_generate_array_type(schema, table_field->type, fp);
+                        fprintf(fp, " *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        fprintf(fp, "}\n");
+                        rc = schema_generate_decoder_array(schema, table, table_field, "__attribute__((unused)) static inline", decoder_use_memcpy, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                } else if (schema_type_is_scalar(table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_t value;\n", table_field->type);
+                                fprintf(fp, "    return *(%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        } else {
+                                fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        }
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_float(table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline %s %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s value;\n", table_field->type);
+                                fprintf(fp, "    return *(%s *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        } else {
+                                fprintf(fp, "    return *(%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        }
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline %s_%s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_%s_t value;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    return *(%s_%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(value));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        } else {
+                                fprintf(fp, "    return *(%s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        }
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        fprintf(fp, "}\n");
+                } else {
+                        linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        goto bail;
+                }
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_decoder_table_slot_offset (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        uint64_t i;
+        uint64_t k;
+        uint64_t size;
+        uint64_t nsizes;
+        uint64_t *sizes;
+        uint8_t *masks;
+        uint64_t present_bytes;
+        uint64_t table_field_i;
+        struct schema_table_field *table_field;
+
+        sizes = NULL;
+        masks = NULL;
+
+        present_bytes = (table->nfields + 7) / 8;
+        sizes = malloc(sizeof(uint64_t) * (table->nfields + 1));
+        masks = malloc(sizeof(uint8_t) * (table->nfields + 1) * (present_bytes + 1));
+        if (sizes == NULL ||
+            masks == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(masks, 0, sizeof(uint8_t) * (table->nfields + 1) * (present_bytes + 1));
+
+        nsizes = 0;
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                size = schema_table_field_size(schema, table_field);
+                for (k = 0; k < nsizes; k++) {
+                        if (sizes[k] == size) {
+                                break;
+                        }
+                }
+                if (k == nsizes) {
+                        sizes[nsizes++] = size;
+                }
+                masks[k * present_bytes + table_field_i / 8] |= (1 << (table_field_i % 8));
+                table_field_i += 1;
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_%s_slot_offset (const struct %s_%s *decoder, uint64_t field)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    static const uint64_t sizes[%" PRIu64 "] = {", nsizes);
+        for (k = 0; k < nsizes; k++) {
+                fprintf(fp, "%s %" PRIu64 "", (k == 0) ? "" : ",", sizes[k]);
+        }
+        fprintf(fp, " };\n");
+        fprintf(fp, "    static const uint8_t masks[%" PRIu64 "][%" PRIu64 "] = {\n", nsizes, present_bytes);
+        for (k = 0; k < nsizes; k++) {
+                fprintf(fp, "        {");
+                for (i = 0; i < present_bytes; i++) {
+                        fprintf(fp, "%s 0x%02x", (i == 0) ? "" : ",", masks[k * present_bytes + i]);
+                }
+                fprintf(fp, " }%s\n", (k + 1 == nsizes) ? "" : ",");
+        }
+        fprintf(fp, "    };\n");
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    uint64_t offset;\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t k;\n");
+        fprintf(fp, "    present = ((const uint8_t *) decoder) + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "    offset = 0;\n");
+        fprintf(fp, "    for (k = 0; k < %" PRIu64 "; k++) {\n", nsizes);
+        fprintf(fp, "        for (i = 0; i < field / 8; i++) {\n");
+        fprintf(fp, "            offset += sizes[k] * __builtin_popcount(present[i] & masks[k][i]);\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        offset += sizes[k] * __builtin_popcount(present[i] & masks[k][i] & ((1u << (field %% 8)) - 1));\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return offset;\n");
+        fprintf(fp, "}\n");
+
+        free(sizes);
+        free(masks);
+        return 0;
+bail:   if (sizes != NULL) {
+                free(sizes);
+        }
+        if (masks != NULL) {
+                free(masks);
+        }
+        return -1;
+}
+
+static int schema_generate_decoder_table_view (struct schema *schema, struct schema_table *table, int decoder_use_memcpy, FILE *fp)
+{
+        int compact;
+        const char *direction;
+        char slot[128];
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+        struct schema_table_field *union_field;
+
+        compact = schema_table_is_compact(schema, table);
+        direction = (compact) ? "-" : "+";
+
+        fprintf(fp, "\n");
+        fprintf(fp, "struct %s_%s_view {\n", schema->namespace, table->name);
+        fprintf(fp, "    const uint8_t *decoder;\n");
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    const uint8_t *slots;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        if (compact && table->nfields > 0) {
+                fprintf(fp, "    uint64_t offsets[%" PRIu64 "];\n", table->nfields);
+        }
+        fprintf(fp, "};\n");
+        fprintf(fp, "\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_view_init (struct %s_%s_view *view, const struct %s_%s *decoder)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        if (compact && table->nfields > 0) {
+                fprintf(fp, "    uint64_t offset;\n");
+        }
+        fprintf(fp, "    if (view == NULL || decoder == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    memcpy(&count, decoder, sizeof(count));\n");
+        } else {
+                fprintf(fp, "    count = *(%s_t *) decoder;\n", schema_count_type_name(schema->count_type));
+        }
+        fprintf(fp, "    view->decoder = (const uint8_t *) decoder;\n");
+        fprintf(fp, "    view->present = view->decoder + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "    view->slots = view->present + (count + 7) / 8;\n");
+        fprintf(fp, "    view->count = count;\n");
+        if (compact && table->nfields > 0) {
+                fprintf(fp, "    offset = 0;\n");
+                table_field_i = 0;
+                TAILQ_FOREACH(table_field, &table->fields, list) {
+                        fprintf(fp, "    view->offsets[%" PRIu64 "] = offset;\n", table_field_i);
+                        if (table_field_i + 1 < table->nfields) {
+                                fprintf(fp, "    if (count > %" PRIu64 " && (view->present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                                fprintf(fp, "        offset += %" PRIu64 ";\n", schema_table_field_size(schema, table_field));
+                                fprintf(fp, "    }\n");
+                        }
+                        table_field_i += 1;
+                }
+        }
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (compact) {
+                        snprintf(slot, sizeof(slot), "view->slots + view->offsets[%" PRIu64 "]", table_field_i);
+                } else {
+                        snprintf(slot, sizeof(slot), "view->slots + %s_C(%" PRIu64 ")", schema_offset_type_NAME(schema->offset_type), table_field_s);
+                }
+
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_view_%s_present (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (%s_C(%" PRIu64 ") >= view->count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return (view->present[%" PRIu64 "] & 0x%02x) ? 1 : 0;\n", table_field_i / 8, (1 << (table_field_i % 8)));
+                fprintf(fp, "}\n");
+
+                if (table_field->container == schema_container_type_vector ||
+                    table_field->container == schema_container_type_map ||
+                    schema_type_is_string(table_field->type) ||
+                    schema_type_is_table(schema, table_field->type) ||
+                    schema_type_is_union(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const void * %s_%s_view_%s_target (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                        fprintf(fp, "    if (!%s_%s_view_%s_present(view)) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&offset, %s%s, sizeof(offset));\n", slot, (schema_type_is_union(schema, table_field->type)) ? " + 1" : "");
+                        } else {
+                                fprintf(fp, "    offset = *(%s_t *) (%s%s);\n", schema_offset_type_name(schema->offset_type), slot, (schema_type_is_union(schema, table_field->type)) ? " + 1" : "");
+                        }
+                        fprintf(fp, "    return view->decoder %s offset;\n", direction);
+                        fprintf(fp, "}\n");
+                }
+
+                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                    schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const uint8_t * %s_%s_view_%s_get_encoded (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    const uint8_t *target;\n");
+                        fprintf(fp, "    target = (const uint8_t *) %s_%s_view_%s_target(view);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "    if (target == NULL) {\n");
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return target + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_vector) {
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const struct %s_%s_vector *) %s_%s_view_%s_target(view);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_view_%s_get_count (const struct %s_%s_view *view)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_vector_get_count(%s_%s_view_%s_get(view));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_map) {
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_%s_map * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const struct %s_%s_%s_map *) %s_%s_view_%s_target(view);\n", schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_view_%s_get_count (const struct %s_%s_view *view)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_%s_map_get_count(%s_%s_view_%s_get(view));\n", schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "__attribute__((unused)) static inline const ");
+                        schema_generate_array_type(schema, table_field->type, fp);
+                        fprintf(fp, " * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    if (!%s_%s_view_%s_present(view)) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const ");
+                        schema_generate_array_type(schema, table_field->type, fp);
+                        fprintf(fp, " *) (%s);\n", slot);
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_union(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline %s_%s_type_t %s_%s_view_%s_get_type (const struct %s_%s_view *view)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    if (!%s_%s_view_%s_present(view)) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return %s_%s_type_NONE;\n", schema->namespace, table_field->type);
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return *(%s);\n", slot);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "__attribute__((unused)) static inline const void * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_view_%s_target(view);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                        TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_view_%s_%s_get (const struct %s_%s_view *view)\n", schema->namespace, union_field->type, schema->namespace, table->name, table_field->name, union_field->name, schema->namespace, table->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    if (%s_%s_view_%s_get_type(view) != %s_%s_type_%s) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type, union_field->name);
+                                fprintf(fp, "        return NULL;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return (const struct %s_%s *) %s_%s_view_%s_target(view);\n", schema->namespace, union_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "}\n");
+                        }
+                } else if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const char * %s_%s_view_%s_get_value (const struct %s_%s_view *view)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= view->count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        if (table_field->value != NULL) {
+                                fprintf(fp, "        return \"%s\";\n", table_field->value);
+                        } else {
+                                fprintf(fp, "        return NULL;\n");
+                        }
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const char *) %s_%s_view_%s_target(view);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const struct %s_%s *) %s_%s_view_%s_get_value(view);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "__attribute__((unused)) static inline %s_t %s_%s_view_%s_get_length (const struct %s_%s_view *view)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= view->count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        if (table_field->value != NULL) {
+                                fprintf(fp, "        return (%s_t) (sizeof(\"%s\") - 1);\n", schema_count_type_name(schema->count_type), table_field->value);
+                        } else {
+                                fprintf(fp, "        return 0;\n");
+                        }
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return %s_string_length((const struct %s_string *) %s_%s_view_%s_target(view));\n", schema->namespace, schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (const struct %s_%s *) %s_%s_view_%s_target(view);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_view_%s_get (const struct %s_%s_view *view)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    if (!%s_%s_view_%s_present(view)) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const struct %s_%s *) (%s);\n", schema->namespace, table_field->type, slot);
+                        fprintf(fp, "}\n");
+                } else {
+                        char type[128];
+                        if (schema_type_is_scalar(table_field->type)) {
+                                snprintf(type, sizeof(type), "%s_t", table_field->type);
+                        } else if (schema_type_is_float(table_field->type)) {
+                                snprintf(type, sizeof(type), "%s", table_field->type);
+                        } else {
+                                snprintf(type, sizeof(type), "%s_%s_t", schema->namespace, table_field->type);
+                        }
+                        fprintf(fp, "__attribute__((unused)) static inline %s %s_%s_view_%s_get (const struct %s_%s_view *view)\n", type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s value;\n", type);
+                        }
+                        fprintf(fp, "    if (!%s_%s_view_%s_present(view)) {\n", schema->namespace, table->name, table_field->name);
+                        if (schema_type_is_enum(schema, table_field->type) && table_field->value != NULL) {
+                                fprintf(fp, "        return %s_%s_%s;\n", schema->namespace, table_field->type, table_field->value);
+                        } else {
+                                fprintf(fp, "        return %s;\n", (table_field->value) ? table_field->value : "0");
+                        }
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    return *(%s *) memcpy(&value, %s, sizeof(value));\n", type, slot);
+                        } else {
+                                fprintf(fp, "    return *(%s *) (%s);\n", type, slot);
+                        }
+                        fprintf(fp, "}\n");
+                }
+
+                table_field_i += 1;
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        return 0;
+}
+
+static const char * schema_c_member_name (const char *name)
+{
+        static const char *keywords[] = {
+                "auto", "break", "case", "char", "const", "continue", "default", "do",
+                "double", "else", "enum", "extern", "float", "for", "goto", "if",
+                "inline", "int", "long", "register", "restrict", "return", "short", "signed",
+                "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+                "volatile", "while", "present",
+        };
+        static char buffers[4][256];
+        static uint64_t buffer;
+        uint64_t i;
+        char *member;
+        member = buffers[buffer++ % 4];
+        if (name[0] >= '0' && name[0] <= '9') {
+                snprintf(member, sizeof(buffers[0]), "_%s", name);
+                return member;
+        }
+        for (i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+                if (strcmp(name, keywords[i]) == 0) {
+                        snprintf(member, sizeof(buffers[0]), "%s_", name);
+                        return member;
+                }
+        }
+        return name;
+}
+
+static int schema_table_field_is_fixed (struct schema *schema, struct schema_table_field *table_field)
+{
+        if (table_field->container == schema_container_type_vector ||
+            table_field->container == schema_container_type_map) {
+                return 0;
+        }
+        if (table_field->container == schema_container_type_array) {
+                return 1;
+        }
+        if (schema_type_is_scalar(table_field->type) ||
+            schema_type_is_float(table_field->type) ||
+            schema_type_is_enum(schema, table_field->type) ||
+            schema_type_is_struct(schema, table_field->type)) {
+                return 1;
+        }
+        return 0;
+}
+
+static int schema_generate_decoder_table_unpacked (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        int rc;
+        struct schema_table_field *table_field;
+
+        fprintf(fp, "\n");
+        fprintf(fp, "struct %s_%s_unpacked {\n", schema->namespace, table->name);
+        fprintf(fp, "    uint64_t present[%" PRIu64 "];\n", (table->nfields + 63) / 64 + ((table->nfields == 0) ? 1 : 0));
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                    schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "    const uint8_t *%s;\n", schema_c_member_name(table_field->name));
+                        fprintf(fp, "    uint64_t %s_count;\n", schema_c_member_name(table_field->name));
+                } else if (table_field->container == schema_container_type_vector) {
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "    const %s_t *%s;\n", table_field->type, schema_c_member_name(table_field->name));
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "    const %s *%s;\n", table_field->type, schema_c_member_name(table_field->name));
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "    const %s_%s_t *%s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "    const struct %s_%s *%s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                        } else {
+                                fprintf(fp, "    const struct %s_%s_vector *%s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                        }
+                        fprintf(fp, "    uint64_t %s_count;\n", schema_c_member_name(table_field->name));
+                } else if (table_field->container == schema_container_type_map) {
+                        fprintf(fp, "    const struct %s_%s_%s_map *%s;\n", schema->namespace, table_field->key, table_field->type, schema_c_member_name(table_field->name));
+                } else if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "    ");
+                        rc = schema_generate_array_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " %s[%" PRIu64 "];\n", schema_c_member_name(table_field->name), table_field->length);
+                } else if (schema_type_is_scalar(table_field->type)) {
+                        fprintf(fp, "    %s_t %s;\n", table_field->type, schema_c_member_name(table_field->name));
+                } else if (schema_type_is_float(table_field->type)) {
+                        fprintf(fp, "    %s %s;\n", table_field->type, schema_c_member_name(table_field->name));
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        fprintf(fp, "    %s_%s_t %s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "    struct %s_%s %s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                } else if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "    const char *%s;\n", schema_c_member_name(table_field->name));
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "    const struct %s_%s *%s;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                } else if (schema_type_is_union(schema, table_field->type)) {
+                        fprintf(fp, "    %s_%s_type_t %s_type;\n", schema->namespace, table_field->type, schema_c_member_name(table_field->name));
+                        fprintf(fp, "    const void *%s;\n", schema_c_member_name(table_field->name));
+                }
+        }
+        fprintf(fp, "};\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static void schema_generate_decoder_table_unpack_field (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, const char *slot, const char *prefix, FILE *fp)
+{
+        const char *direction;
+
+        direction = (schema_table_is_compact(schema, table)) ? "-" : "+";
+
+        if (schema_table_field_is_fixed(schema, table_field)) {
+                fprintf(fp, "%smemcpy(&unpacked->%s, %s, sizeof(unpacked->%s));\n", prefix, schema_c_member_name(table_field->name), slot, schema_c_member_name(table_field->name));
+                return;
+        }
+        if (schema_type_is_union(schema, table_field->type)) {
+                fprintf(fp, "%sunpacked->%s_type = *(%s);\n", prefix, schema_c_member_name(table_field->name), slot);
+                fprintf(fp, "%smemcpy(&offset, %s + 1, sizeof(offset));\n", prefix, slot);
+        } else {
+                fprintf(fp, "%smemcpy(&offset, %s, sizeof(offset));\n", prefix, slot);
+        }
+        if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+            schema_table_field_is_dictionary(table_field)) {
+                fprintf(fp, "%sunpacked->%s = view.decoder %s offset + %s_C(%" PRIu64 ");\n", prefix, schema_c_member_name(table_field->name), direction, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "%sunpacked->%s_count = %s_%s_count(unpacked->%s);\n", prefix, schema_c_member_name(table_field->name), schema->namespace, (schema_table_field_is_dictionary(table_field)) ? "dictionary" : "encoded", schema_c_member_name(table_field->name));
+        } else if (table_field->container == schema_container_type_vector) {
+                fprintf(fp, "%smemcpy(&count, view.decoder %s offset, sizeof(%s_t));\n", prefix, direction, schema_count_type_name(schema->count_type));
+                fprintf(fp, "%sunpacked->%s_count = count;\n", prefix, schema_c_member_name(table_field->name));
+                if (schema_type_is_string(table_field->type) ||
+                    schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "%sunpacked->%s = (const struct %s_%s_vector *) (view.decoder %s offset);\n", prefix, schema_c_member_name(table_field->name), schema->namespace, table_field->type, direction);
+                } else {
+                        fprintf(fp, "%sunpacked->%s = (const void *) (view.decoder %s offset + %s_C(%" PRIu64 "));\n", prefix, schema_c_member_name(table_field->name), direction, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                }
+        } else if (table_field->container == schema_container_type_map) {
+                fprintf(fp, "%sunpacked->%s = (const struct %s_%s_%s_map *) (view.decoder %s offset);\n", prefix, schema_c_member_name(table_field->name), schema->namespace, table_field->key, table_field->type, direction);
+        } else if (schema_type_is_string(table_field->type)) {
+                fprintf(fp, "%sunpacked->%s = (const char *) (view.decoder %s offset);\n", prefix, schema_c_member_name(table_field->name), direction);
+        } else if (schema_type_is_table(schema, table_field->type)) {
+                fprintf(fp, "%sunpacked->%s = (const struct %s_%s *) (view.decoder %s offset);\n", prefix, schema_c_member_name(table_field->name), schema->namespace, table_field->type, direction);
+        } else if (schema_type_is_union(schema, table_field->type)) {
+                fprintf(fp, "%sunpacked->%s = (const void *) (view.decoder %s offset);\n", prefix, schema_c_member_name(table_field->name), direction);
+        }
+}
+
+static void schema_generate_decoder_table_unpack_default (struct schema *schema, struct schema_table_field *table_field, const char *prefix, FILE *fp)
+{
+        if (table_field->value == NULL) {
+                return;
+        }
+        if (table_field->container != schema_container_type_none) {
+                return;
+        }
+        if (schema_type_is_scalar(table_field->type) ||
+            schema_type_is_float(table_field->type)) {
+                fprintf(fp, "%s} else if (flags & LINEARBUFFERS_UNPACK_FLAG_DEFAULTS) {\n", prefix);
+                fprintf(fp, "%s    unpacked->%s = %s;\n", prefix, schema_c_member_name(table_field->name), table_field->value);
+        } else if (schema_type_is_enum(schema, table_field->type)) {
+                fprintf(fp, "%s} else if (flags & LINEARBUFFERS_UNPACK_FLAG_DEFAULTS) {\n", prefix);
+                fprintf(fp, "%s    unpacked->%s = %s_%s_%s;\n", prefix, schema_c_member_name(table_field->name), schema->namespace, table_field->type, table_field->value);
+        } else if (schema_type_is_string(table_field->type)) {
+                fprintf(fp, "%s} else if (flags & LINEARBUFFERS_UNPACK_FLAG_DEFAULTS) {\n", prefix);
+                fprintf(fp, "%s    unpacked->%s = \"%s\";\n", prefix, schema_c_member_name(table_field->name), table_field->value);
+        }
+}
+
+static int schema_generate_decoder_table_unpack (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        int compact;
+        int need_offset;
+        int need_count;
+        char slot[128];
+        uint64_t i;
+        uint64_t run;
+        uint64_t mask;
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        uint64_t *offsets;
+        struct schema_table_field *table_field;
+        struct schema_table_field **table_fields;
+
+        offsets = NULL;
+        table_fields = NULL;
+
+        compact = schema_table_is_compact(schema, table);
+
+        offsets = malloc(sizeof(uint64_t) * (table->nfields + 1));
+        table_fields = malloc(sizeof(struct schema_table_field *) * (table->nfields + 1));
+        if (offsets == NULL ||
+            table_fields == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+
+        need_offset = 0;
+        need_count = 0;
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                offsets[table_field_i] = table_field_s;
+                table_fields[table_field_i] = table_field;
+                if (!schema_table_field_is_fixed(schema, table_field)) {
+                        need_offset = 1;
+                        if (table_field->container == schema_container_type_vector &&
+                            schema_table_field_encoding(table_field) == schema_vector_encoding_none &&
+                            !schema_table_field_is_dictionary(table_field)) {
+                                need_count = 1;
+                        }
+                }
+                table_field_i += 1;
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_unpack (const struct %s_%s *decoder, struct %s_%s_unpacked *unpacked, uint32_t flags)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        if (table->nfields > 0) {
+                fprintf(fp, "    uint64_t i;\n");
+                fprintf(fp, "    uint64_t n;\n");
+                fprintf(fp, "    const uint64_t *present;\n");
+        }
+        if (need_offset) {
+                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        }
+        if (need_count) {
+                fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        }
+        fprintf(fp, "    struct %s_%s_view view;\n", schema->namespace, table->name);
+        fprintf(fp, "    (void) flags;\n");
+        fprintf(fp, "    if (unpacked == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (%s_%s_view_init(&view, decoder) != 0) {\n", schema->namespace, table->name);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memset(unpacked, 0, sizeof(*unpacked));\n");
+        if (table->nfields > 0) {
+                fprintf(fp, "    n = (view.count < %" PRIu64 ") ? view.count : %" PRIu64 ";\n", table->nfields, table->nfields);
+                fprintf(fp, "    for (i = 0; i < (n + 7) / 8; i++) {\n");
+                fprintf(fp, "        unpacked->present[i / 8] |= ((uint64_t) view.present[i]) << ((i %% 8) * 8);\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    if (n %% 64) {\n");
+                fprintf(fp, "        unpacked->present[n / 64] &= (UINT64_C(1) << (n %% 64)) - 1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    present = unpacked->present;\n");
+        }
+
+        i = 0;
+        while (i < table->nfields) {
+                run = i;
+                mask = 0;
+                if (!compact) {
+                        while (run < table->nfields &&
+                               run / 64 == i / 64 &&
+                               schema_table_field_is_fixed(schema, table_fields[run])) {
+                                mask |= UINT64_C(1) << (run % 64);
+                                run += 1;
+                        }
+                }
+                if (run - i > 1) {
+                        fprintf(fp, "    if ((present[%" PRIu64 "] & UINT64_C(0x%016" PRIx64 ")) == UINT64_C(0x%016" PRIx64 ")) {\n", i / 64, mask, mask);
+                        fprintf(fp, "        memcpy(&unpacked->%s, view.slots + %" PRIu64 ", sizeof(unpacked->%s));\n", schema_c_member_name(table_fields[i]->name), offsets[i], schema_c_member_name(table_fields[i]->name));
+                        for (table_field_i = i + 1; table_field_i < run; table_field_i++) {
+                                fprintf(fp, "        memcpy(&unpacked->%s, view.slots + %" PRIu64 ", sizeof(unpacked->%s));\n", schema_c_member_name(table_fields[table_field_i]->name), offsets[table_field_i], schema_c_member_name(table_fields[table_field_i]->name));
+                        }
+                        fprintf(fp, "    } else {\n");
+                        for (table_field_i = i; table_field_i < run; table_field_i++) {
+                                snprintf(slot, sizeof(slot), "view.slots + %" PRIu64, offsets[table_field_i]);
+                                fprintf(fp, "        if (present[%" PRIu64 "] & UINT64_C(0x%016" PRIx64 ")) {\n", table_field_i / 64, UINT64_C(1) << (table_field_i % 64));
+                                schema_generate_decoder_table_unpack_field(schema, table, table_fields[table_field_i], slot, "            ", fp);
+                                schema_generate_decoder_table_unpack_default(schema, table_fields[table_field_i], "        ", fp);
+                                fprintf(fp, "        }\n");
+                        }
+                        fprintf(fp, "    }\n");
+                        i = run;
+                        continue;
+                }
+                if (compact) {
+                        snprintf(slot, sizeof(slot), "view.slots + view.offsets[%" PRIu64 "]", i);
+                } else {
+                        snprintf(slot, sizeof(slot), "view.slots + %" PRIu64, offsets[i]);
+                }
+                fprintf(fp, "    if (present[%" PRIu64 "] & UINT64_C(0x%016" PRIx64 ")) {\n", i / 64, UINT64_C(1) << (i % 64));
+                schema_generate_decoder_table_unpack_field(schema, table, table_fields[i], slot, "        ", fp);
+                schema_generate_decoder_table_unpack_default(schema, table_fields[i], "    ", fp);
+                fprintf(fp, "    }\n");
+                i += 1;
+        }
+
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+
+        free(offsets);
+        free(table_fields);
+        return 0;
+bail:   if (offsets != NULL) {
+                free(offsets);
+        }
+        if (table_fields != NULL) {
+                free(table_fields);
+        }
+        return -1;
+}
+
+static int schema_generate_decoder_table (struct schema *schema, struct schema_table *table, int decoder_use_memcpy, FILE *fp)
+{
+        int rc;
+        int compact;
+        const char *direction;
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_DECODER_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_DECODER_API\n", schema->NAMESPACE, table->name);
+
+        fprintf(fp, "\n");
+        fprintf(fp, "struct %s_%s;\n", schema->namespace, table->name);
+        fprintf(fp, "\n");
+
+        compact = schema_table_is_compact(schema, table);
+        direction = (compact) ? "-" : "+";
+
+        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_decode (const void *buffer, uint64_t length)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        if (compact) {
+                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                fprintf(fp, "    (void) length;\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    memcpy(&offset, buffer, sizeof(offset));\n");
+                } else {
+                        fprintf(fp, "    offset = *(%s_t *) buffer;\n", schema_offset_type_name(schema->offset_type));
+                }
+                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) buffer) + offset);\n", schema->namespace, table->name);
+        } else {
+                fprintf(fp, "    (void) length;\n");
+                fprintf(fp, "    return (const struct %s_%s *) buffer;\n", schema->namespace, table->name);
+        }
+        fprintf(fp, "}\n");
+
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "#define %s_%s_field_%s UINT64_C(%" PRIu64 ")\n", schema->namespace, table->name, table_field->name, table_field_i);
+                table_field_i += 1;
+        }
+        fprintf(fp, "#define %s_%s_field_COUNT UINT64_C(%" PRIu64 ")\n", schema->namespace, table->name, table->nfields);
+
+        /* present bits of fields [word * 64, word * 64 + 64), fields this
+         * schema does not know are masked out */
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_%s_present_mask (const struct %s_%s *decoder, uint64_t word)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    uint64_t n;\n");
+        fprintf(fp, "    uint64_t bytes;\n");
+        fprintf(fp, "    uint64_t mask;\n");
+        if (decoder_use_memcpy) {
+                fprintf(fp, "    memcpy(&count, decoder, sizeof(count));\n");
+        } else {
+                fprintf(fp, "    count = *(%s_t *) decoder;\n", schema_count_type_name(schema->count_type));
+        }
+        fprintf(fp, "    n = count;\n");
+        fprintf(fp, "    if (n > UINT64_C(%" PRIu64 ")) {\n", table->nfields);
+        fprintf(fp, "        n = UINT64_C(%" PRIu64 ");\n", table->nfields);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (word >= (n + 63) / 64) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    bytes = (n + 7) / 8 - word * 8;\n");
+        fprintf(fp, "    mask = 0;\n");
+        fprintf(fp, "    memcpy(&mask, ((const uint8_t *) decoder) + UINT64_C(%" PRIu64 ") + word * 8, (bytes < 8) ? bytes : 8);\n", schema_count_type_size(schema->count_type));
+        fprintf(fp, "    if (n - word * 64 < 64) {\n");
+        fprintf(fp, "        mask &= (UINT64_C(1) << (n - word * 64)) - 1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return mask;\n");
+        fprintf(fp, "}\n");
+
+        if (compact) {
+                rc = schema_generate_decoder_table_slot_offset(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate decoder for table: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                struct schema_attribute *attribute;
+                struct namespace *attribute_string;
+                struct namespace *slot_string;
+                struct namespace *slot_union_string;
+                slot_string = namespace_create();
+                slot_union_string = namespace_create();
+                if (compact) {
+                        namespace_push(slot_string, "%s_%s_slot_offset(decoder, %s_C(%" PRIu64 "))", schema->namespace, table->name, schema_count_type_NAME(schema->count_type), table_field_i);
+                        namespace_push(slot_union_string, "%s_%s_slot_offset(decoder, %s_C(%" PRIu64 ")) + %s_C(%" PRIu64 ")", schema->namespace, table->name, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), (uint64_t) sizeof(uint8_t));
+                } else {
+                        namespace_push(slot_string, "%s_C(%" PRIu64 ")", schema_offset_type_NAME(schema->offset_type), table_field_s);
+                        namespace_push(slot_union_string, "%s_C(%" PRIu64 ")", schema_offset_type_NAME(schema->offset_type), table_field_s + sizeof(uint8_t));
+                }
+                attribute_string = namespace_create();
+                namespace_push(attribute_string, "__attribute__ ((unused");
+                TAILQ_FOREACH(attribute, &table_field->attributes, list) {
+                        if (strcmp(attribute->name, "deprecated") == 0) {
+                                if (attribute->value == NULL ||
+                                    strcmp(attribute->value, "1") == 0 ||
+                                    strcmp(attribute->value, "yes") == 0 ||
+                                    strcmp(attribute->value, "true") == 0) {
                                 }
                         }
                 }
-                namespace_push(attribute_string, " )) static inline");
+                namespace_push(attribute_string, ")) static inline");
 
-                if (table_field->container == schema_container_type_vector) {
-                        if (schema_type_is_scalar(table_field->type)) {
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    if (vector == NULL) {\n");
-                                fprintf(fp, "        return -1;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s_t value)\n", schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                        } else if (schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    if (vector == NULL) {\n");
-                                fprintf(fp, "        return -1;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s value)\n", schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const %s_%s_t *values, uint64_t count)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    vector = %s_%s_vector_create(encoder, values, count);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    if (vector == NULL) {\n");
-                                fprintf(fp, "        return -1;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                        } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_string_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const char **values, uint64_t count)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    int rc;\n");
-                                fprintf(fp, "    uint64_t i;\n");
-                                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    const struct %s_%s_vector *vector;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    rc = %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    if (rc != 0) {\n");
-                                fprintf(fp, "        return rc;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    for (i = 0; i < count; i++) {\n");
-                                fprintf(fp, "        string = %s_%s_create(encoder, values[i]);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "        if (string == NULL) {\n");
-                                fprintf(fp, "            return -1;\n");
-                                fprintf(fp, "        }\n");
-                                fprintf(fp, "        rc = %s_%s_vector_push(encoder, string);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "        if (rc != 0) {\n");
-                                fprintf(fp, "            return rc;\n");
-                                fprintf(fp, "        }\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    vector = %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    if (vector == NULL) {\n");
-                                fprintf(fp, "        return -1;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    return %s_%s_%s_set(encoder, vector);\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push_create(encoder, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push_ncreate(encoder, n, value);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
+                fprintf(fp, "%s int %s_%s_%s_present (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                fprintf(fp, "    uint8_t present;\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                } else {
+                        fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                }
+                fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (decoder_use_memcpy) {
+                        fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                } else {
+                        fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                }
+                fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    return 1;\n");
+                fprintf(fp, "}\n");
+
+                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                    schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "%s const uint8_t * %s_%s_%s_get_encoded (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                        }
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    if (!%s_%s_%s_present(decoder)) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        }
+                        fprintf(fp, "    return ((const uint8_t *) decoder) %s offset + %s_C(%" PRIu64 ");\n", direction, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "}\n");
+                }
+
+                if (schema_table_field_is_dictionary(table_field)) {
+                        fprintf(fp, "%s uint64_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_dictionary_count(%s_%s_%s_get_encoded(decoder));\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s uint32_t %s_%s_%s_get_index_at (const struct %s_%s *decoder, uint64_t at)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_dictionary_index_at(%s_%s_%s_get_encoded(decoder), at);\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s const char * %s_%s_%s_get_at (const struct %s_%s *decoder, uint64_t at)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    const uint8_t *dictionary;\n");
+                        fprintf(fp, "    dictionary = %s_%s_%s_get_encoded(decoder);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "    return %s_dictionary_entry_at(dictionary, %s_dictionary_index_at(dictionary, at));\n", schema->namespace, schema->namespace);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s uint32_t %s_%s_%s_get_dictionary_count (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_dictionary_entries(%s_%s_%s_get_encoded(decoder));\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s const char * %s_%s_%s_get_dictionary_at (const struct %s_%s *decoder, uint32_t index)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_dictionary_entry_at(%s_%s_%s_get_encoded(decoder), index);\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s int64_t %s_%s_%s_dictionary_find (const struct %s_%s *decoder, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_dictionary_find(%s_%s_%s_get_encoded(decoder), value);\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (schema_table_field_encoding(table_field) != schema_vector_encoding_none) {
+                        fprintf(fp, "%s uint64_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_encoded_count(%s_%s_%s_get_encoded(decoder));\n", schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s %s_t %s_%s_%s_get_at (const struct %s_%s *decoder, uint64_t at)\n", namespace_linearized(attribute_string), table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return (%s_t) %s_encoded_get_at(%s_%s_%s_get_encoded(decoder), at);\n", table_field->type, schema->namespace, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s uint64_t %s_%s_%s_decode_values (const struct %s_%s *decoder, %s_t *values, uint64_t count)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->type);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    uint64_t b;\n");
+                        fprintf(fp, "    uint64_t i;\n");
+                        fprintf(fp, "    uint64_t n;\n");
+                        fprintf(fp, "    uint64_t decoded;\n");
+                        fprintf(fp, "    uint64_t block[%s_ENCODED_BLOCK_LENGTH];\n", schema->NAMESPACE);
+                        fprintf(fp, "    const uint8_t *encoded;\n");
+                        fprintf(fp, "    encoded = %s_%s_%s_get_encoded(decoder);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "    if (count > %s_encoded_count(encoded)) {\n", schema->namespace);
+                        fprintf(fp, "        count = %s_encoded_count(encoded);\n", schema->namespace);
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    for (b = 0, decoded = 0; decoded < count; b++) {\n");
+                        fprintf(fp, "        n = %s_encoded_decode_block(encoded, b, block);\n", schema->namespace);
+                        fprintf(fp, "        if (n > count - decoded) {\n");
+                        fprintf(fp, "            n = count - decoded;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        for (i = 0; i < n; i++) {\n");
+                        fprintf(fp, "            values[decoded + i] = (%s_t) block[i];\n", table_field->type);
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        decoded += n;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return decoded;\n");
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_vector) {
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
                         } else if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s_vector *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_table(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_start (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_start(encoder);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s_vector * %s_%s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        }
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                        }
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        } else {
+                                fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        }
+                        fprintf(fp, "    return (const struct %s_%s_vector *) (((const uint8_t *) decoder) %s offset);\n", schema->namespace, table_field->type, direction);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        fprintf(fp, "%s_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_vector_get_count(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+
+                        if (schema_type_is_scalar(table_field->type) ||
+                            schema_type_is_float(table_field->type) ||
+                            schema_type_is_enum(schema, table_field->type) ||
+                            schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                                fprintf(fp, "%s_t %s_%s_%s_get_length (const struct %s_%s *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_end(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    return %s_%s_vector_get_length(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
                                 fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, table_field->name);
+
+                                fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                                if (schema_type_is_scalar(table_field->type)) {
+                                        fprintf(fp, "const %s_t * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                                } else if (schema_type_is_float(table_field->type)) {
+                                        fprintf(fp, "const %s * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                                } else if (schema_type_is_enum(schema, table_field->type)) {
+                                        fprintf(fp, "const %s_%s_t * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                                } else if (schema_type_is_struct(schema, table_field->type)) {
+                                        fprintf(fp, "const struct %s_%s * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                                }
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_cancel(encoder);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    return %s_%s_vector_get_values(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
                                 fprintf(fp, "}\n");
-                                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_push (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                        }
+
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "%s_t %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "%s %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "%s_%s_t %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "const char * %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+                        } else if (schema_type_is_table(schema, table_field->type) ||
+                                   schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
+                        }
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_vector_get_at(%s_%s_%s_get(decoder), at);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_map) {
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        fprintf(fp, "const struct %s_%s_%s_map * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                        }
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        } else {
+                                fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        }
+                        fprintf(fp, "    return (const struct %s_%s_%s_map *) (((const uint8_t *) decoder) %s offset);\n", schema->namespace, table_field->key, table_field->type, direction);
+                        fprintf(fp, "}\n");
+
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        fprintf(fp, "%s_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    return %s_%s_%s_map_get_count(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->key, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "}\n");
+                } else if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "%s const ", namespace_linearized(attribute_string));
+                        rc = schema_generate_array_type(schema, table_field->type, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                        fprintf(fp, " * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    return (const ");
+                        schema_generate_array_type(schema, table_field->type, fp);
+                        fprintf(fp, " *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        fprintf(fp, "}\n");
+                        rc = schema_generate_decoder_array(schema, table, table_field, namespace_linearized(attribute_string), decoder_use_memcpy, fp);
+                        if (rc != 0) {
+                                goto bail;
+                        }
+                } else if (schema_type_is_union(schema, table_field->type)) {
+                        struct schema_table_field *union_field;
+                        fprintf(fp, "%s %s_%s_type_t %s_%s_%s_get_type (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        fprintf(fp, "        return %s_%s_type_NONE;\n", schema->namespace, table_field->type);
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        fprintf(fp, "        return %s_%s_type_NONE;\n", schema->namespace, table_field->type);
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_%s_type_t type;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    return *(%s_%s_type_t *) memcpy(&type, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(type));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        } else {
+                                fprintf(fp, "    return *(%s_%s_type_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        }
+                        fprintf(fp, "}\n");
+                        fprintf(fp, "%s const void * %s_%s_%s_get (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        fprintf(fp, "        return NULL;\n");
+                        fprintf(fp, "    }\n");
+                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                                fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_union_string));
+                        } else {
+                                fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_union_string));
+                        }
+                        fprintf(fp, "    return (const void *) (((const uint8_t *) decoder) %s offset);\n", direction);
+                        fprintf(fp, "}\n");
+                        TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                fprintf(fp, "%s const struct %s_%s * %s_%s_%s_%s_get (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, union_field->type, schema->namespace, table->name, table_field->name, union_field->name, schema->namespace, table->name);
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_push(encoder, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    if (%s_%s_%s_get_type(decoder) != %s_%s_type_%s) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type, union_field->name);
+                                fprintf(fp, "        return NULL;\n");
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return (const struct %s_%s *) %s_%s_%s_get(decoder);\n", schema->namespace, union_field->type, schema->namespace, table->name, table_field->name);
                                 fprintf(fp, "}\n");
+                        }
+                } else {
+                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                        if (schema_type_is_scalar(table_field->type)) {
+                                fprintf(fp, "%s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "%s %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "%s_%s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else         if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        }
+                        fprintf(fp, "{\n");
+                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    uint8_t present;\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        } else {
+                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                        }
+                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
+                        if (schema_type_is_scalar(table_field->type) ||
+                            schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "        return %s;\n", (table_field->value) ? table_field->value : "0");
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                if (table_field->value != NULL) {
+                                        fprintf(fp, "        return %s_%s_%s;\n", schema->namespace, table_field->type, table_field->value);
+                                } else {
+                                        fprintf(fp, "        return 0;\n");
+                                }
+                        } else if (schema_type_is_string(table_field->type)) {
+                                if (table_field->value != NULL) {
+                                        fprintf(fp, "        return (const struct %s_%s *) \"%s\";\n", schema->namespace, table_field->type, table_field->value);
+                                } else {
+                                        fprintf(fp, "        return NULL;\n");
+                                }
+                        } else {
+                                fprintf(fp, "        return NULL;\n");
+                        }
+                        fprintf(fp, "    }\n");
+                        if (decoder_use_memcpy) {
+                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        } else {
+                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
+                        }
+                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                        if (schema_type_is_scalar(table_field->type) ||
+                            schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "        return %s;\n", (table_field->value) ? table_field->value : "0");
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                if (table_field->value != NULL) {
+                                        fprintf(fp, "        return %s_%s_%s;\n", schema->namespace, table_field->type, table_field->value);
+                                } else {
+                                        fprintf(fp, "        return 0;\n");
+                                }
                         } else {
-                                linearbuffers_errorf("type is invalid: %s", table_field->type);
-                                goto bail;
+                                fprintf(fp, "        return NULL;\n");
                         }
-                } else {
+                        fprintf(fp, "    }\n");
                         if (schema_type_is_scalar(table_field->type)) {
-                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s_t value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    %s_t value;\n", table_field->type);
+                                        fprintf(fp, "    return *(%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                }
                         } else if (schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    %s value;\n", table_field->type);
+                                        fprintf(fp, "    return *(%s *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    return *(%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                }
+                        } else if (schema_type_is_enum(schema, table_field->type)) {
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    %s_%s_t value;\n", schema->namespace, table_field->type);
+                                        fprintf(fp, "    return *(%s_%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(value));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    return *(%s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                }
                         } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "%s int %s_%s_%s_create (struct linearbuffers_encoder *encoder, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                                        fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                }
+                                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) %s offset);\n", schema->namespace, table_field->type, direction);
+                        } else if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
+                                        fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                }
+                                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) %s offset);\n", schema->namespace, table_field->type, direction);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s);\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                        }
+                        fprintf(fp, "}\n");
+
+                        if (schema_type_is_scalar(table_field->type) ||
+                            schema_type_is_float(table_field->type) ||
+                            schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "%s ", namespace_linearized(attribute_string));
+                                if (schema_type_is_scalar(table_field->type)) {
+                                        fprintf(fp, "int %s_%s_%s_mutate (struct %s_%s *decoder, %s_t value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->type);
+                                } else if (schema_type_is_float(table_field->type)) {
+                                        fprintf(fp, "int %s_%s_%s_mutate (struct %s_%s *decoder, %s value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->type);
+                                } else {
+                                        fprintf(fp, "int %s_%s_%s_mutate (struct %s_%s *decoder, %s_%s_t value)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema->namespace, table_field->type);
+                                }
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    int rc;\n");
-                                fprintf(fp, "    uint64_t offset;\n");
-                                fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &offset, value);\n");
-                                fprintf(fp, "    if (rc != 0) { \n");
-                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+                                fprintf(fp, "    if (!%s_%s_%s_present(decoder)) {\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "        return -1;\n");
                                 fprintf(fp, "    }\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                if (decoder_use_memcpy) {
+                                        fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                        fprintf(fp, "    memcpy(((uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s, &value, sizeof(value));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                } else {
+                                        fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                        if (schema_type_is_scalar(table_field->type)) {
+                                                fprintf(fp, "    *(%s_t *) (((uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s) = value;\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                        } else if (schema_type_is_float(table_field->type)) {
+                                                fprintf(fp, "    *(%s *) (((uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s) = value;\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                        } else {
+                                                fprintf(fp, "    *(%s_%s_t *) (((uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s) = value;\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), namespace_linearized(slot_string));
+                                        }
+                                }
+                                fprintf(fp, "    return 0;\n");
                                 fprintf(fp, "}\n");
-                                fprintf(fp, "%s int %s_%s_%s_createf (struct linearbuffers_encoder *encoder, const char *value, ...)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                        }
+
+                        if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "%s const char * %s_%s_%s_get_value (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    int rc;\n");
-                                fprintf(fp, "    va_list ap;\n");
-                                fprintf(fp, "    uint64_t offset;\n");
-                                fprintf(fp, "    va_start(ap, value);\n");
-                                fprintf(fp, "    rc = linearbuffers_encoder_string_createv(encoder, &offset, value, ap);\n");
-                                fprintf(fp, "    va_end(ap);\n");
-                                fprintf(fp, "    if (rc != 0) { \n");
-                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    string = %s_%s_%s_get(decoder);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "    if (string == NULL) {\n");
+                                fprintf(fp, "        return NULL;\n");
                                 fprintf(fp, "    }\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "    return %s_%s_value(string);\n", schema->namespace, table_field->type);
                                 fprintf(fp, "}\n");
-                                fprintf(fp, "%s int %s_%s_%s_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "%s %s_t %s_%s_%s_get_length (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    int rc;\n");
-                                fprintf(fp, "    uint64_t offset;\n");
-                                fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate(encoder, &offset, n, value);\n");
-                                fprintf(fp, "    if (rc != 0) { \n");
-                                fprintf(fp, "        return rc;\n");
+                                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    string = %s_%s_%s_get(decoder);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "    if (string == NULL) {\n");
+                                fprintf(fp, "        return 0;\n");
                                 fprintf(fp, "    }\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), offset);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_string *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", table_field->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                fprintf(fp, "}\n");
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, %s_%s_t value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_%s(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), value);\n", schema_type_get_enum(schema, table_field->type)->type, schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "    if (!%s_%s_%s_present(decoder)) {\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "        return (%s_t) strlen((const char *) string);\n", schema_count_type_name(schema->count_type));
+                                fprintf(fp, "    }\n");
+                                fprintf(fp, "    return %s_%s_length(string);\n", schema->namespace, table_field->type);
                                 fprintf(fp, "}\n");
-                        } else if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "%s int %s_%s_%s_set (struct linearbuffers_encoder *encoder, const struct %s_%s *value)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                                fprintf(fp, "%s struct %s_%s_view %s_%s_%s_get_view (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
                                 fprintf(fp, "{\n");
-                                fprintf(fp, "    return linearbuffers_encoder_table_set_table(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), (uint64_t) (ptrdiff_t) value);\n", schema_count_type_NAME(schema->count_type), table_field_i, schema_offset_type_NAME(schema->offset_type), table_field_s);
+                                fprintf(fp, "    struct %s_%s_view view;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    view.value = %s_%s_%s_get_value(decoder);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "    view.length = %s_%s_%s_get_length(decoder);\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "    return view;\n");
                                 fprintf(fp, "}\n");
-                        } else {
-                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        }
+                }
+                table_field_i += 1;
+                table_field_s += schema_table_field_size(schema, table_field);
+                namespace_destroy(attribute_string);
+                namespace_destroy(slot_string);
+                namespace_destroy(slot_union_string);
+        }
+
+        rc = schema_generate_decoder_table_view(schema, table, decoder_use_memcpy, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate view for table: %s", table->name);
+                goto bail;
+        }
+        rc = schema_generate_decoder_table_unpacked(schema, table, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate unpacked struct for table: %s", table->name);
+                goto bail;
+        }
+        rc = schema_generate_decoder_table_unpack(schema, table, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate unpack for table: %s", table->name);
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static void schema_generate_verifier_child (struct schema *schema, int compact, int indent, FILE *fp)
+{
+        if (compact) {
+                fprintf(fp, "%*sif (offset > position) {\n", indent, "");
+                fprintf(fp, "%*s    return -1;\n", indent, "");
+                fprintf(fp, "%*s}\n", indent, "");
+                fprintf(fp, "%*schild = position - offset;\n", indent, "");
+        } else {
+                fprintf(fp, "%*sif (%s_verify_range(length, position, offset) != 0) {\n", indent, "", schema->namespace);
+                fprintf(fp, "%*s    return -1;\n", indent, "");
+                fprintf(fp, "%*s}\n", indent, "");
+                fprintf(fp, "%*schild = position + offset;\n", indent, "");
+        }
+}
+
+static int schema_generate_vector_lookup (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        struct schema_table_field *key;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        key = schema_table_get_key(table);
+        if (key == NULL) {
+                return 0;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_%s_VECTOR_LOOKUP_API)\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "#define %s_%s_VECTOR_LOOKUP_API\n", schema->NAMESPACE, table->name);
+        fprintf(fp, "\n");
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_lookup_by_%s (const struct %s_%s_vector *decoder, const char *key)\n", schema->namespace, table->name, schema->namespace, table->name, key->name, schema->namespace, table->name);
+        } else if (schema_type_is_scalar(key->type)) {
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_lookup_by_%s (const struct %s_%s_vector *decoder, %s_t key)\n", schema->namespace, table->name, schema->namespace, table->name, key->name, schema->namespace, table->name, key->type);
+        } else {
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_vector_lookup_by_%s (const struct %s_%s_vector *decoder, %s key)\n", schema->namespace, table->name, schema->namespace, table->name, key->name, schema->namespace, table->name, key->type);
+        }
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t lo;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    %s_t hi;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    %s_t mid;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    const struct %s_%s *table;\n", schema->namespace, table->name);
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "    int rc;\n");
+                fprintf(fp, "    const char *value;\n");
+                fprintf(fp, "    if (key == NULL) {\n");
+                fprintf(fp, "        key = \"\";\n");
+                fprintf(fp, "    }\n");
+        }
+        fprintf(fp, "    lo = 0;\n");
+        fprintf(fp, "    hi = %s_%s_vector_get_count(decoder);\n", schema->namespace, table->name);
+        fprintf(fp, "    while (lo < hi) {\n");
+        fprintf(fp, "        mid = lo + (hi - lo) / 2;\n");
+        fprintf(fp, "        table = %s_%s_vector_get_at(decoder, mid);\n", schema->namespace, table->name);
+        if (schema_type_is_string(key->type)) {
+                fprintf(fp, "        value = %s_%s_%s_get_value(table);\n", schema->namespace, table->name, key->name);
+                fprintf(fp, "        rc = strcmp((value == NULL) ? \"\" : value, key);\n");
+                fprintf(fp, "        if (rc < 0) {\n");
+                fprintf(fp, "            lo = mid + 1;\n");
+                fprintf(fp, "        } else if (rc > 0) {\n");
+        } else {
+                fprintf(fp, "        if (%s_%s_%s_get(table) < key) {\n", schema->namespace, table->name, key->name);
+                fprintf(fp, "            lo = mid + 1;\n");
+                fprintf(fp, "        } else if (%s_%s_%s_get(table) > key) {\n", schema->namespace, table->name, key->name);
+        }
+        fprintf(fp, "            hi = mid;\n");
+        fprintf(fp, "        } else {\n");
+        fprintf(fp, "            return table;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return NULL;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_verifier_vector (struct schema *schema, struct schema_table_field *table_field, FILE *fp)
+{
+        uint64_t size;
+
+        fprintf(fp, "    if (%s_verify_range(length, child, %s_C(%" PRIu64 ")) != 0 ||\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "        %s_verify_charge(verify, %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    vcount = %s_verify_count(buffer, child);\n", schema->namespace);
+        if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+            schema_table_field_is_dictionary(table_field)) {
+                fprintf(fp, "    if (%s_verify_range(length, child + %s_C(%" PRIu64 "), vcount) != 0 ||\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "        %s_verify_charge(verify, vcount) != 0) {\n", schema->namespace);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    if (%s_%s_verify(buffer + child + %s_C(%" PRIu64 "), vcount) != 0) {\n", schema->namespace, (schema_table_field_is_dictionary(table_field)) ? "dictionary" : "encoded", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        } else if (schema_type_is_string(table_field->type) ||
+                   schema_type_is_table(schema, table_field->type)) {
+                fprintf(fp, "    if (vcount > 0) {\n");
+                fprintf(fp, "        if (%s_verify_range(length, child + %s_C(%" PRIu64 "), %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_size(schema->offset_type));
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+                fprintf(fp, "        offset = %s_verify_offset(buffer, child + %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                fprintf(fp, "        if (%s_verify_range(length, child, offset) != 0) {\n", schema->namespace);
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+                fprintf(fp, "        if (vcount > (length - child - offset) / %s_C(%" PRIu64 ") ||\n", schema_offset_type_NAME(schema->offset_type), schema_offset_type_size(schema->offset_type));
+                fprintf(fp, "            %s_verify_charge(verify, vcount * %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_offset_type_size(schema->offset_type));
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+                fprintf(fp, "        for (i = 0; i < vcount; i++) {\n");
+                fprintf(fp, "            element = (%s_t) (offset + %s_verify_offset(buffer, child + offset + i * %s_C(%" PRIu64 ")));\n", schema_offset_type_name(schema->offset_type), schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_offset_type_size(schema->offset_type));
+                fprintf(fp, "            if (%s_verify_range(length, child, element) != 0) {\n", schema->namespace);
+                fprintf(fp, "                return -1;\n");
+                fprintf(fp, "            }\n");
+                if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "            if (%s_verify_string(buffer, length, child + element, verify) != 0) {\n", schema->namespace);
+                } else {
+                        fprintf(fp, "            if (%s_%s_verify_at(buffer, length, child + element, depth - 1, verify, &h) != 0) {\n", schema->namespace, table_field->type);
+                }
+                fprintf(fp, "                return -1;\n");
+                fprintf(fp, "            }\n");
+                if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "            if (h > *height) {\n");
+                        fprintf(fp, "                *height = h;\n");
+                        fprintf(fp, "            }\n");
+                }
+                fprintf(fp, "        }\n");
+                fprintf(fp, "    }\n");
+        } else {
+                if (schema_type_is_struct(schema, table_field->type)) {
+                        size = schema_struct_size(schema, table_field->type);
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        size = schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
+                } else {
+                        size = schema_inttype_size(table_field->type);
+                }
+                fprintf(fp, "    if (vcount > (length - child - %s_C(%" PRIu64 ")) / %s_C(%" PRIu64 ") ||\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), size);
+                fprintf(fp, "        %s_verify_charge(verify, vcount * %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), size);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                if (schema_type_is_enum(schema, table_field->type)) {
+                        fprintf(fp, "    for (i = 0; i < vcount; i++) {\n");
+                        fprintf(fp, "        %s_%s_t value;\n", schema->namespace, table_field->type);
+                        fprintf(fp, "        memcpy(&value, buffer + child + %s_C(%" PRIu64 ") + i * sizeof(value), sizeof(value));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+                        fprintf(fp, "        if (!%s_%s_is_valid(value)) {\n", schema->namespace, table_field->type);
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "    }\n");
+                }
+        }
+
+        return 0;
+}
+
+static int schema_generate_verifier_map (struct schema *schema, struct schema_table_field *table_field, FILE *fp)
+{
+        uint64_t count_size;
+        uint64_t key_size;
+        uint64_t value_size;
+
+        count_size = schema_count_type_size(schema->count_type);
+        key_size = schema_map_part_size(schema, table_field->key);
+        value_size = schema_map_part_size(schema, table_field->type);
+
+        fprintf(fp, "    if (%s_verify_range(length, child, %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    vcount = %s_verify_count(buffer, child);\n", schema->namespace);
+        fprintf(fp, "    capacity = %s_verify_count(buffer, child + %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size);
+        fprintf(fp, "    if (vcount > capacity ||\n");
+        fprintf(fp, "        (capacity & (capacity - 1)) != 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (capacity / 8 > length ||\n");
+        fprintf(fp, "        %s_verify_range(length, child + %s_C(%" PRIu64 "), (capacity + 7) / 8) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (capacity > (length - child - %s_C(%" PRIu64 ") - (capacity + 7) / 8) / %s_C(%" PRIu64 ") ||\n", schema_offset_type_NAME(schema->offset_type), count_size * 2, schema_offset_type_NAME(schema->offset_type), key_size + value_size);
+        fprintf(fp, "        %s_verify_charge(verify, %s_C(%" PRIu64 ") + (capacity + 7) / 8 + capacity * %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size * 2, schema_offset_type_NAME(schema->offset_type), key_size + value_size);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (!schema_map_part_is_reference(schema, table_field->key) &&
+            !schema_map_part_is_reference(schema, table_field->type)) {
+                return 0;
+        }
+        fprintf(fp, "    for (i = 0; i < capacity; i++) {\n");
+        fprintf(fp, "        if (!(buffer[child + %s_C(%" PRIu64 ") + i / 8] & (1 << (i %% 8)))) {\n", schema_offset_type_NAME(schema->offset_type), count_size * 2);
+        fprintf(fp, "            continue;\n");
+        fprintf(fp, "        }\n");
+        if (schema_map_part_is_reference(schema, table_field->key)) {
+                fprintf(fp, "        element = %s_verify_offset(buffer, child + %s_C(%" PRIu64 ") + (capacity + 7) / 8 + i * %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size * 2, schema_offset_type_NAME(schema->offset_type), key_size);
+                fprintf(fp, "        if (element > child ||\n");
+                fprintf(fp, "            %s_verify_string(buffer, length, child - element, verify) != 0) {\n", schema->namespace);
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+        }
+        if (schema_map_part_is_reference(schema, table_field->type)) {
+                fprintf(fp, "        element = %s_verify_offset(buffer, child + %s_C(%" PRIu64 ") + (capacity + 7) / 8 + capacity * %s_C(%" PRIu64 ") + i * %s_C(%" PRIu64 "));\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), count_size * 2, schema_offset_type_NAME(schema->offset_type), key_size, schema_offset_type_NAME(schema->offset_type), value_size);
+                fprintf(fp, "        if (element > child) {\n");
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+                if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "        if (%s_verify_string(buffer, length, child - element, verify) != 0) {\n", schema->namespace);
+                } else {
+                        fprintf(fp, "        if (%s_%s_verify_at(buffer, length, child - element, depth - 1, verify, &h) != 0) {\n", schema->namespace, table_field->type);
+                }
+                fprintf(fp, "            return -1;\n");
+                fprintf(fp, "        }\n");
+                if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        if (h > *height) {\n");
+                        fprintf(fp, "            *height = h;\n");
+                        fprintf(fp, "        }\n");
+                }
+        }
+        fprintf(fp, "    }\n");
+
+        return 0;
+}
+
+static int schema_generate_verifier_field (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, uint64_t tag, FILE *fp)
+{
+        int rc;
+        int reference;
+
+        reference = 0;
+        if (table_field->container == schema_container_type_map) {
+                reference = schema_map_part_is_reference(schema, table_field->key) ||
+                            schema_map_part_is_reference(schema, table_field->type);
+        } else if (schema_table_field_encoding(table_field) == schema_vector_encoding_none &&
+                   !schema_table_field_is_dictionary(table_field)) {
+                reference = schema_type_is_string(table_field->type) ||
+                            schema_type_is_table(schema, table_field->type);
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_verify_%s (const uint8_t *buffer, uint64_t length, uint64_t child, uint64_t depth, struct %s_verify *verify, uint64_t *height)\n", schema->namespace, table->name, table_field->name, schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t vcount;\n");
+        if (table_field->container == schema_container_type_map) {
+                fprintf(fp, "    uint64_t capacity;\n");
+        } else if (reference) {
+                fprintf(fp, "    uint64_t offset;\n");
+        }
+        if (reference) {
+                fprintf(fp, "    uint64_t element;\n");
+        }
+        if (reference ||
+            (table_field->container == schema_container_type_vector &&
+             schema_table_field_encoding(table_field) == schema_vector_encoding_none &&
+             !schema_table_field_is_dictionary(table_field) &&
+             schema_type_is_enum(schema, table_field->type))) {
+                fprintf(fp, "    uint64_t i;\n");
+        }
+        if (reference &&
+            schema_type_is_table(schema, table_field->type)) {
+                fprintf(fp, "    uint64_t h;\n");
+        }
+        fprintf(fp, "    const struct %s_verify_entry *entry;\n", schema->namespace);
+        fprintf(fp, "    entry = %s_verify_lookup(verify, child, UINT64_C(0x%016" PRIx64 "));\n", schema->namespace, tag);
+        fprintf(fp, "    if (entry != NULL) {\n");
+        fprintf(fp, "        if (entry->height >= depth) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        *height = entry->height;\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    *height = 0;\n");
+        if (table_field->container == schema_container_type_map) {
+                rc = schema_generate_verifier_map(schema, table_field, fp);
+        } else {
+                rc = schema_generate_verifier_vector(schema, table_field, fp);
+        }
+        if (rc != 0) {
+                goto bail;
+        }
+        fprintf(fp, "    return %s_verify_mark(verify, child, UINT64_C(0x%016" PRIx64 "), *height);\n", schema->namespace, tag);
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_verifier_table (struct schema *schema, struct schema_table *table, uint64_t tag, FILE *fp)
+{
+        int rc;
+        int compact;
+        int need_i;
+        int need_child;
+        int need_height;
+        uint64_t size;
+        uint64_t table_field_i;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+        struct schema_table_field *union_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        compact = schema_table_is_compact(schema, table);
+
+        need_i = 0;
+        need_child = 0;
+        need_height = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field->container == schema_container_type_map ||
+                    table_field->container == schema_container_type_vector) {
+                        need_child = 1;
+                        need_height = 1;
+                } else if (table_field->container == schema_container_type_array) {
+                        if (schema_type_is_enum(schema, table_field->type)) {
+                                need_i = 1;
+                        }
+                } else if (schema_type_is_string(table_field->type)) {
+                        need_child = 1;
+                } else if (schema_type_is_table(schema, table_field->type) ||
+                           schema_type_is_union(schema, table_field->type)) {
+                        need_child = 1;
+                        need_height = 1;
+                }
+        }
+
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (table_field->container == schema_container_type_map ||
+                    table_field->container == schema_container_type_vector) {
+                        rc = schema_generate_verifier_field(schema, table, table_field, tag | (table_field_i + 1), fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate verifier for field: %s", table_field->name);
                                 goto bail;
                         }
                 }
                 table_field_i += 1;
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                }
-                namespace_destroy(attribute_string);
         }
 
-        fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_%s * %s_%s_end (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_verify_at (const uint8_t *buffer, uint64_t length, uint64_t position, uint64_t depth, struct %s_verify *verify, uint64_t *height)\n", schema->namespace, table->name, schema->namespace);
         fprintf(fp, "{\n");
-        fprintf(fp, "    int rc;\n");
-        fprintf(fp, "    uint64_t offset;\n");
-        fprintf(fp, "    rc = linearbuffers_encoder_table_end(encoder, &offset);\n");
-        fprintf(fp, "    if (rc != 0) {\n");
-        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t slots;\n");
+        fprintf(fp, "    uint64_t size;\n");
+        if (need_child) {
+                fprintf(fp, "    uint64_t child;\n");
+                fprintf(fp, "    uint64_t offset;\n");
+        }
+        if (need_height) {
+                fprintf(fp, "    uint64_t h;\n");
+        }
+        if (need_i) {
+                fprintf(fp, "    uint64_t i;\n");
+        }
+        fprintf(fp, "    const uint8_t *present;\n");
+        fprintf(fp, "    const struct %s_verify_entry *entry;\n", schema->namespace);
+        fprintf(fp, "    if (depth == 0) {\n");
+        fprintf(fp, "        return -1;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    return (const struct %s_%s *) (ptrdiff_t) offset;\n", schema->namespace, table->name);
-        fprintf(fp, "}\n");
+        fprintf(fp, "    entry = %s_verify_lookup(verify, position, UINT64_C(0x%016" PRIx64 "));\n", schema->namespace, tag);
+        fprintf(fp, "    if (entry != NULL) {\n");
+        fprintf(fp, "        if (entry->height > depth) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        *height = entry->height;\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    *height = 1;\n");
+        fprintf(fp, "    if (%s_verify_range(length, position, %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    count = %s_verify_count(buffer, position);\n", schema->namespace);
+        fprintf(fp, "    if (count / 8 > length ||\n");
+        fprintf(fp, "        %s_verify_range(length, position + %s_C(%" PRIu64 "), (count + 7) / 8) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    present = buffer + position + %s_C(%" PRIu64 ");\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        fprintf(fp, "    slots = position + %s_C(%" PRIu64 ") + (count + 7) / 8;\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type));
+        if (TAILQ_EMPTY(&table->fields)) {
+                fprintf(fp, "    (void) present;\n");
+        }
+        fprintf(fp, "    size = 0;\n");
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (compact) {
+                        fprintf(fp, "    if (count > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                } else {
+                        fprintf(fp, "    if (count > %" PRIu64 ") {\n", table_field_i);
+                }
+                fprintf(fp, "        size += %" PRIu64 ";\n", schema_table_field_size(schema, table_field));
+                fprintf(fp, "    }\n");
+                table_field_i += 1;
+        }
+        fprintf(fp, "    if (%s_verify_range(length, slots, size) != 0 ||\n", schema->namespace);
+        fprintf(fp, "        %s_verify_charge(verify, slots + size - position) != 0) {\n", schema->namespace);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    size = 0;\n");
+        }
 
-        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_cancel (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
-        fprintf(fp, "{\n");
-        fprintf(fp, "    return linearbuffers_encoder_table_cancel(encoder);\n");
+        table_field_i = 0;
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                size = schema_table_field_size(schema, table_field);
+                fprintf(fp, "    if (count > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)) {\n", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+                if (compact) {
+                        fprintf(fp, "        const uint64_t slot = slots + size;\n");
+                        fprintf(fp, "        size += %" PRIu64 ";\n", size);
+                } else {
+                        fprintf(fp, "        const uint64_t slot = slots + %" PRIu64 ";\n", table_field_s);
+                }
+                if (table_field->container == schema_container_type_array) {
+                        if (schema_type_is_enum(schema, table_field->type)) {
+                                fprintf(fp, "        for (i = 0; i < %" PRIu64 "; i++) {\n", table_field->length);
+                                fprintf(fp, "            %s_%s_t value;\n", schema->namespace, table_field->type);
+                                fprintf(fp, "            memcpy(&value, buffer + slot + i * sizeof(value), sizeof(value));\n");
+                                fprintf(fp, "            if (!%s_%s_is_valid(value)) {\n", schema->namespace, table_field->type);
+                                fprintf(fp, "                return -1;\n");
+                                fprintf(fp, "            }\n");
+                                fprintf(fp, "        }\n");
+                        } else {
+                                fprintf(fp, "        (void) slot;\n");
+                        }
+                } else if (schema_type_is_union(schema, table_field->type)) {
+                        fprintf(fp, "        if (buffer[slot] != %s_%s_type_NONE &&\n", schema->namespace, table_field->type);
+                        fprintf(fp, "            !%s_%s_type_is_valid(buffer[slot])) {\n", schema->namespace, table_field->type);
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        offset = %s_verify_offset(buffer, slot + 1);\n", schema->namespace);
+                        fprintf(fp, "        switch (buffer[slot]) {\n");
+                        TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                fprintf(fp, "            case %s_%s_type_%s:\n", schema->namespace, table_field->type, union_field->name);
+                                schema_generate_verifier_child(schema, compact, 16, fp);
+                                fprintf(fp, "                if (%s_%s_verify_at(buffer, length, child, depth - 1, verify, &h) != 0) {\n", schema->namespace, union_field->type);
+                                fprintf(fp, "                    return -1;\n");
+                                fprintf(fp, "                }\n");
+                                fprintf(fp, "                if (h >= *height) {\n");
+                                fprintf(fp, "                    *height = h + 1;\n");
+                                fprintf(fp, "                }\n");
+                                fprintf(fp, "                break;\n");
+                        }
+                        fprintf(fp, "        }\n");
+                } else if (table_field->container == schema_container_type_vector ||
+                           table_field->container == schema_container_type_map ||
+                           schema_type_is_string(table_field->type) ||
+                           schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        offset = %s_verify_offset(buffer, slot);\n", schema->namespace);
+                        schema_generate_verifier_child(schema, compact, 8, fp);
+                        if (table_field->container == schema_container_type_map ||
+                            table_field->container == schema_container_type_vector) {
+                                fprintf(fp, "        if (%s_%s_verify_%s(buffer, length, child, depth, verify, &h) != 0) {\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "            return -1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "        if (h >= *height) {\n");
+                                fprintf(fp, "            *height = h + 1;\n");
+                                fprintf(fp, "        }\n");
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "        if (%s_verify_string(buffer, length, child, verify) != 0) {\n", schema->namespace);
+                                fprintf(fp, "            return -1;\n");
+                                fprintf(fp, "        }\n");
+                        } else {
+                                fprintf(fp, "        if (%s_%s_verify_at(buffer, length, child, depth - 1, verify, &h) != 0) {\n", schema->namespace, table_field->type);
+                                fprintf(fp, "            return -1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "        if (h >= *height) {\n");
+                                fprintf(fp, "            *height = h + 1;\n");
+                                fprintf(fp, "        }\n");
+                        }
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        fprintf(fp, "        %s_%s_t value;\n", schema->namespace, table_field->type);
+                        fprintf(fp, "        memcpy(&value, buffer + slot, sizeof(value));\n");
+                        fprintf(fp, "        if (!%s_%s_is_valid(value)) {\n", schema->namespace, table_field->type);
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                } else {
+                        fprintf(fp, "        (void) slot;\n");
+                }
+                fprintf(fp, "    }\n");
+                table_field_i += 1;
+                table_field_s += size;
+        }
+        fprintf(fp, "    return %s_verify_mark(verify, position, UINT64_C(0x%016" PRIx64 "), *height);\n", schema->namespace, tag);
         fprintf(fp, "}\n");
 
-        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_finish (struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name);
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_verify (const void *buffer, uint64_t length, uint64_t max_depth)\n", schema->namespace, table->name);
         fprintf(fp, "{\n");
-        fprintf(fp, "    return linearbuffers_encoder_table_end(encoder, NULL);\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    uint64_t height;\n");
+        fprintf(fp, "    struct %s_verify verify;\n", schema->namespace);
+        fprintf(fp, "    if (buffer == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    if (%s_verify_range(length, 0, %s_C(%" PRIu64 ")) != 0) {\n", schema->namespace, schema_offset_type_NAME(schema->offset_type), schema_offset_type_size(schema->offset_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        }
+        fprintf(fp, "    memset(&verify, 0, sizeof(verify));\n");
+        fprintf(fp, "    verify.budget = UINT64_MAX;\n");
+        fprintf(fp, "    if (length <= UINT64_MAX / LINEARBUFFERS_VERIFY_BUDGET_FACTOR) {\n");
+        fprintf(fp, "        verify.budget = length * LINEARBUFFERS_VERIFY_BUDGET_FACTOR;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    rc = %s_%s_verify_at((const uint8_t *) buffer, length, %s_verify_offset((const uint8_t *) buffer, 0), max_depth, &verify, &height);\n", schema->namespace, table->name, schema->namespace);
+        } else {
+                fprintf(fp, "    rc = %s_%s_verify_at((const uint8_t *) buffer, length, 0, max_depth, &verify, &height);\n", schema->namespace, table->name);
+        }
+        fprintf(fp, "    free(verify.entries);\n");
+        fprintf(fp, "    return rc;\n");
         fprintf(fp, "}\n");
 
-        fprintf(fp, "\n");
-        fprintf(fp, "#endif\n");
-
         return 0;
 bail:   return -1;
 }
 
-int schema_generate_c_encoder (struct schema *schema, FILE *fp, int encoder_include_library)
+static int schema_generate_verifier (struct schema *schema, FILE *fp)
 {
         int rc;
-
-        struct schema_enum *anum;
+        uint64_t table_i;
         struct schema_table *table;
 
         if (schema == NULL) {
@@ -1167,417 +5253,638 @@ int schema_generate_c_encoder (struct schema *schema, FILE *fp, int encoder_incl
         }
 
         fprintf(fp, "\n");
-        fprintf(fp, "#include <stddef.h>\n");
-        fprintf(fp, "#include <stdint.h>\n");
-        fprintf(fp, "#include <stdarg.h>\n");
-
-        if (encoder_include_library == 0) {
-                fprintf(fp, "#include <linearbuffers/encoder.h>\n");
+        fprintf(fp, "#if !defined(%s_VERIFY_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_VERIFY_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_VERIFY_BUDGET_FACTOR)\n");
+        fprintf(fp, "#define LINEARBUFFERS_VERIFY_BUDGET_FACTOR UINT64_C(16)\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_verify_range (uint64_t length, uint64_t position, uint64_t size)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    if (position > length || size > length - position) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_verify_count (const uint8_t *buffer, uint64_t position)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    memcpy(&count, buffer + position, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_verify_offset (const uint8_t *buffer, uint64_t position)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "    memcpy(&offset, buffer + position, sizeof(offset));\n");
+        fprintf(fp, "    return offset;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "struct %s_verify_entry {\n", schema->namespace);
+        fprintf(fp, "    uint64_t position;\n");
+        fprintf(fp, "    uint64_t tag;\n");
+        fprintf(fp, "    uint64_t height;\n");
+        fprintf(fp, "};\n");
+        fprintf(fp, "struct %s_verify {\n", schema->namespace);
+        fprintf(fp, "    uint64_t budget;\n");
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t capacity;\n");
+        fprintf(fp, "    struct %s_verify_entry *entries;\n", schema->namespace);
+        fprintf(fp, "};\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_verify_charge (struct %s_verify *verify, uint64_t size)\n", schema->namespace, schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    if (size > verify->budget) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    verify->budget -= size;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_verify_hash (uint64_t position, uint64_t tag)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t hash;\n");
+        fprintf(fp, "    hash = (position ^ (tag * UINT64_C(0x9e3779b97f4a7c15))) * UINT64_C(0xff51afd7ed558ccd);\n");
+        fprintf(fp, "    return hash ^ (hash >> 32);\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline const struct %s_verify_entry * %s_verify_lookup (const struct %s_verify *verify, uint64_t position, uint64_t tag)\n", schema->namespace, schema->namespace, schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t mask;\n");
+        fprintf(fp, "    if (verify->capacity == 0) {\n");
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    mask = verify->capacity - 1;\n");
+        fprintf(fp, "    for (i = %s_verify_hash(position, tag) & mask; verify->entries[i].tag != 0; i = (i + 1) & mask) {\n", schema->namespace);
+        fprintf(fp, "        if (verify->entries[i].position == position &&\n");
+        fprintf(fp, "            verify->entries[i].tag == tag) {\n");
+        fprintf(fp, "            return &verify->entries[i];\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return NULL;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_verify_mark (struct %s_verify *verify, uint64_t position, uint64_t tag, uint64_t height)\n", schema->namespace, schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t i;\n");
+        fprintf(fp, "    uint64_t e;\n");
+        fprintf(fp, "    uint64_t mask;\n");
+        fprintf(fp, "    uint64_t capacity;\n");
+        fprintf(fp, "    struct %s_verify_entry *entries;\n", schema->namespace);
+        fprintf(fp, "    if ((verify->count + 1) * 2 > verify->capacity) {\n");
+        fprintf(fp, "        capacity = (verify->capacity == 0) ? 64 : verify->capacity * 2;\n");
+        fprintf(fp, "        entries = calloc(capacity, sizeof(struct %s_verify_entry));\n", schema->namespace);
+        fprintf(fp, "        if (entries == NULL) {\n");
+        fprintf(fp, "            return -1;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        mask = capacity - 1;\n");
+        fprintf(fp, "        for (e = 0; e < verify->capacity; e++) {\n");
+        fprintf(fp, "            if (verify->entries[e].tag == 0) {\n");
+        fprintf(fp, "                continue;\n");
+        fprintf(fp, "            }\n");
+        fprintf(fp, "            for (i = %s_verify_hash(verify->entries[e].position, verify->entries[e].tag) & mask; entries[i].tag != 0; i = (i + 1) & mask) {\n", schema->namespace);
+        fprintf(fp, "            }\n");
+        fprintf(fp, "            entries[i] = verify->entries[e];\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        free(verify->entries);\n");
+        fprintf(fp, "        verify->entries = entries;\n");
+        fprintf(fp, "        verify->capacity = capacity;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    mask = verify->capacity - 1;\n");
+        fprintf(fp, "    for (i = %s_verify_hash(position, tag) & mask; verify->entries[i].tag != 0; i = (i + 1) & mask) {\n", schema->namespace);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    verify->entries[i].position = position;\n");
+        fprintf(fp, "    verify->entries[i].tag = tag;\n");
+        fprintf(fp, "    verify->entries[i].height = height;\n");
+        fprintf(fp, "    verify->count += 1;\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_verify_string (const uint8_t *buffer, uint64_t length, uint64_t position, struct %s_verify *verify)\n", schema->namespace, schema->namespace);
+        fprintf(fp, "{\n");
+        if (!schema_string_is_prefixed(schema)) {
+                fprintf(fp, "    const uint8_t *end;\n");
+        }
+        fprintf(fp, "    if (position >= length) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (%s_verify_lookup(verify, position, 1) != NULL) {\n", schema->namespace);
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        if (schema_string_is_prefixed(schema)) {
+                fprintf(fp, "    if (position < sizeof(%s_t)) {\n", schema_count_type_name(schema->count_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    if (%s_verify_count(buffer, position - sizeof(%s_t)) >= length - position) {\n", schema->namespace, schema_count_type_name(schema->count_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    if (buffer[position + %s_verify_count(buffer, position - sizeof(%s_t))] != 0) {\n", schema->namespace, schema_count_type_name(schema->count_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    if (%s_verify_charge(verify, sizeof(%s_t) + %s_verify_count(buffer, position - sizeof(%s_t)) + 1) != 0) {\n", schema->namespace, schema_count_type_name(schema->count_type), schema->namespace, schema_count_type_name(schema->count_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+        } else {
+                fprintf(fp, "    end = memchr(buffer + position, 0, length - position);\n");
+                fprintf(fp, "    if (end == NULL ||\n");
+                fprintf(fp, "        %s_verify_charge(verify, end - (buffer + position) + 1) != 0) {\n", schema->namespace);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
         }
+        fprintf(fp, "    return %s_verify_mark(verify, position, 1, 0);\n", schema->namespace);
+        fprintf(fp, "}\n");
 
-        TAILQ_FOREACH(anum, &schema->enums, list) {
-                rc = schema_generate_enum(schema, anum, fp);
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none) {
+                        continue;
+                }
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_verify_at (const uint8_t *buffer, uint64_t length, uint64_t position, uint64_t depth, struct %s_verify *verify, uint64_t *height);\n", schema->namespace, table->name, schema->namespace);
+        }
+        table_i = 0;
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none) {
+                        continue;
+                }
+                table_i += 1;
+                rc = schema_generate_verifier_table(schema, table, table_i << 32, fp);
                 if (rc != 0) {
-                        linearbuffers_errorf("can not generate enum");
+                        linearbuffers_errorf("can not generate verifier for table: %s", table->name);
                         goto bail;
                 }
         }
 
-        if (schema_has_string(schema)) {
-                fprintf(fp, "\n");
-                fprintf(fp, "#if !defined(%s_STRING_ENCODER_API)\n", schema->NAMESPACE);
-                fprintf(fp, "#define %s_STRING_ENCODER_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
 
-                fprintf(fp, "\n");
-                fprintf(fp, "struct %s_string;\n", schema->namespace);
-                fprintf(fp, "\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_createv (struct linearbuffers_encoder *encoder, const char *value, va_list va)\n", schema->namespace, schema->namespace);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_string_createv(encoder, &offset, value, va);\n");
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_create (struct linearbuffers_encoder *encoder, const char *value)\n", schema->namespace, schema->namespace);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_string_create(encoder, &offset, value);\n");
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
-                fprintf(fp, "}\n");
-                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline const struct %s_string * %s_string_ncreate (struct linearbuffers_encoder *encoder, uint64_t n, const char *value)\n", schema->namespace, schema->namespace);
-                fprintf(fp, "{\n");
-                fprintf(fp, "    int rc;\n");
-                fprintf(fp, "    uint64_t offset;\n");
-                fprintf(fp, "    rc = linearbuffers_encoder_string_ncreate(encoder, &offset, n, value);\n");
-                fprintf(fp, "    if (rc != 0) {\n");
-                fprintf(fp, "        return NULL;\n");
-                fprintf(fp, "    }\n");
-                fprintf(fp, "    return (const struct %s_string *) (ptrdiff_t) offset;\n", schema->namespace);
-                fprintf(fp, "}\n");
+        return 0;
+bail:   return -1;
+}
 
-                fprintf(fp, "\n");
-                fprintf(fp, "#endif\n");
-        }
+static int schema_table_is_diffable (struct schema *schema, struct schema_table *table)
+{
+        int rc;
+        int changed;
+        uint64_t i;
+        uint64_t n;
+        uint8_t *reached;
+        struct schema_table *child;
+        struct schema_table *parent;
+        struct schema_table_field *table_field;
 
-        rc = 0;
-        if (schema_has_vector(schema, "int8")) {
-                rc |= schema_generate_vector_encoder(schema, "int8", fp);
-        }
-        if (schema_has_vector(schema, "int16")) {
-                rc |= schema_generate_vector_encoder(schema, "int16", fp);
-        }
-        if (schema_has_vector(schema, "int32")) {
-                rc |= schema_generate_vector_encoder(schema, "int32", fp);
-        }
-        if (schema_has_vector(schema, "int64")) {
-                rc |= schema_generate_vector_encoder(schema, "int64", fp);
-        }
-        if (schema_has_vector(schema, "uint8")) {
-                rc |= schema_generate_vector_encoder(schema, "uint8", fp);
-        }
-        if (schema_has_vector(schema, "uint16")) {
-                rc |= schema_generate_vector_encoder(schema, "uint16", fp);
-        }
-        if (schema_has_vector(schema, "uint32")) {
-                rc |= schema_generate_vector_encoder(schema, "uint32", fp);
-        }
-        if (schema_has_vector(schema, "uint64")) {
-                rc |= schema_generate_vector_encoder(schema, "uint64", fp);
-        }
-        if (schema_has_vector(schema, "float")) {
-                rc |= schema_generate_vector_encoder(schema, "float", fp);
+        n = 0;
+        TAILQ_FOREACH(child, &schema->tables, list) {
+                n += 1;
         }
-        if (schema_has_vector(schema, "double")) {
-                rc |= schema_generate_vector_encoder(schema, "double", fp);
+        reached = calloc(n, sizeof(uint8_t));
+        if (reached == NULL) {
+                return 0;
         }
-        if (schema_has_vector(schema, "string")) {
-                rc |= schema_generate_vector_encoder(schema, "string", fp);
+        i = 0;
+        TAILQ_FOREACH(child, &schema->tables, list) {
+                if (child == table) {
+                        reached[i] = 1;
+                }
+                i += 1;
         }
+        do {
+                changed = 0;
+                n = 0;
+                TAILQ_FOREACH(parent, &schema->tables, list) {
+                        if (reached[n++] == 0) {
+                                continue;
+                        }
+                        TAILQ_FOREACH(table_field, &parent->fields, list) {
+                                if (!schema_type_is_table(schema, table_field->type)) {
+                                        continue;
+                                }
+                                i = 0;
+                                TAILQ_FOREACH(child, &schema->tables, list) {
+                                        if (strcmp(child->name, table_field->type) == 0 &&
+                                            reached[i] == 0) {
+                                                reached[i] = 1;
+                                                changed = 1;
+                                        }
+                                        i += 1;
+                                }
+                        }
+                }
+        } while (changed);
 
-        TAILQ_FOREACH(anum, &schema->enums, list) {
-                if (schema_has_vector(schema, anum->name)) {
-                        rc |= schema_generate_vector_encoder(schema, anum->name, fp);
+        rc = 1;
+        n = 0;
+        TAILQ_FOREACH(parent, &schema->tables, list) {
+                if (reached[n++] == 0) {
+                        continue;
                 }
-        }
-        TAILQ_FOREACH(table, &schema->tables, list) {
-                if (schema_has_vector(schema, table->name)) {
-                        rc |= schema_generate_vector_encoder(schema, table->name, fp);
+                if (parent->nfields == 0) {
+                        rc = 0;
+                }
+                TAILQ_FOREACH(table_field, &parent->fields, list) {
+                        if (table_field->container == schema_container_type_map ||
+                            schema_type_is_union(schema, table_field->type) ||
+                            schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                            schema_table_field_is_dictionary(table_field)) {
+                                rc = 0;
+                        }
                 }
         }
-        if (rc != 0) {
-                linearbuffers_errorf("can not generate decoder for vector: %s", table->name);
-                goto bail;
-        }
+        free(reached);
+        return rc;
+}
 
-        TAILQ_FOREACH(table, &schema->tables, list) {
-                rc = schema_generate_encoder_table(schema, table, fp);
-                if (rc != 0) {
-                        linearbuffers_errorf("can not generate decoder for table: %s", table->name);
-                        goto bail;
-                }
+static uint64_t schema_diff_element_size (struct schema *schema, const char *type)
+{
+        if (schema_type_is_enum(schema, type)) {
+                return schema_inttype_size(schema_type_get_enum(schema, type)->type);
         }
+        if (schema_type_is_struct(schema, type)) {
+                return schema_struct_size(schema, type);
+        }
+        return schema_inttype_size(type);
+}
 
-        return 0;
-bail:   return -1;
+static void schema_generate_diff_field_copy (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, const char *source, const char *indent, FILE *fp)
+{
+        if (table_field->container == schema_container_type_vector) {
+                if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "%src |= %s_%s_%s_start(encoder);\n", indent, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "%sfor (i = 0; i < %s_%s_%s_get_count(%s); i++) {\n", indent, schema->namespace, table->name, table_field->name, source);
+                        fprintf(fp, "%s    rc |= %s_%s_%s_push_ncreate(encoder, %s_string_vector_get_length_at(%s_%s_%s_get(%s), i), %s_%s_%s_get_at(%s, i));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, schema->namespace, table->name, table_field->name, source, schema->namespace, table->name, table_field->name, source);
+                        fprintf(fp, "%s}\n", indent);
+                        fprintf(fp, "%src |= %s_%s_%s_set(encoder, %s_%s_%s_end(encoder));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "%src |= %s_%s_%s_start(encoder);\n", indent, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "%sfor (i = 0; i < %s_%s_%s_get_count(%s); i++) {\n", indent, schema->namespace, table->name, table_field->name, source);
+                        fprintf(fp, "%s    rc |= %s_%s_patch_encode(%s_%s_%s_get_at(%s, i), NULL, encoder, &child);\n", indent, schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, source);
+                        fprintf(fp, "%s    rc |= %s_%s_%s_push(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                        fprintf(fp, "%s}\n", indent);
+                        fprintf(fp, "%src |= %s_%s_%s_set(encoder, %s_%s_%s_end(encoder));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                } else {
+                        fprintf(fp, "%src |= %s_%s_%s_create(encoder, %s_%s_%s_get_values(%s), %s_%s_%s_get_count(%s));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, source, schema->namespace, table->name, table_field->name, source);
+                }
+        } else if (schema_type_is_string(table_field->type)) {
+                fprintf(fp, "%src |= %s_%s_%s_ncreate(encoder, %s_%s_%s_get_length(%s), %s_%s_%s_get_value(%s));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, source, schema->namespace, table->name, table_field->name, source);
+        } else {
+                fprintf(fp, "%src |= %s_%s_%s_set(encoder, %s_%s_%s_get(%s));\n", indent, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, source);
+        }
 }
 
-static int schema_generate_decoder_table (struct schema *schema, struct schema_table *table, int decoder_use_memcpy, FILE *fp)
+static int schema_generate_diff_table (struct schema *schema, struct schema_table *table, FILE *fp)
 {
+        int compact;
+        int need_i;
+        int need_child;
+        int need_unchanged;
+        const char *direction;
         uint64_t table_field_i;
         uint64_t table_field_s;
         struct schema_table_field *table_field;
 
-        if (schema == NULL) {
-                linearbuffers_errorf("schema is invalid");
-                goto bail;
-        }
-        if (table == NULL) {
-                linearbuffers_errorf("table is invalid");
-                goto bail;
-        }
-        if (fp == NULL) {
-                linearbuffers_errorf("fp is invalid");
-                goto bail;
-        }
-
-        fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(%s_%s_DECODER_API)\n", schema->NAMESPACE, table->name);
-        fprintf(fp, "#define %s_%s_DECODER_API\n", schema->NAMESPACE, table->name);
-
-        fprintf(fp, "\n");
-        fprintf(fp, "struct %s_%s;\n", schema->namespace, table->name);
-        fprintf(fp, "\n");
-
-        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_%s_decode (const void *buffer, uint64_t length)\n", schema->namespace, table->name, schema->namespace, table->name);
-        fprintf(fp, "{\n");
-        fprintf(fp, "    (void) length;\n");
-        fprintf(fp, "    return (const struct %s_%s *) buffer;\n", schema->namespace, table->name);
-        fprintf(fp, "}\n");
+        compact = schema_table_is_compact(schema, table);
+        direction = (compact) ? "-" : "+";
 
-        table_field_i = 0;
+        need_i = 0;
+        need_child = 0;
+        need_unchanged = 0;
         table_field_s = 0;
         TAILQ_FOREACH(table_field, &table->fields, list) {
-                struct schema_attribute *attribute;
-                struct namespace *attribute_string;
-                attribute_string = namespace_create();
-                namespace_push(attribute_string, "__attribute__ ((unused");
-                TAILQ_FOREACH(attribute, &table_field->attributes, list) {
-                        if (strcmp(attribute->name, "deprecated") == 0) {
-                                if (attribute->value == NULL ||
-                                    strcmp(attribute->value, "1") == 0 ||
-                                    strcmp(attribute->value, "yes") == 0 ||
-                                    strcmp(attribute->value, "true") == 0) {
-                                }
-                        }
+                if (table_field->container == schema_container_type_vector &&
+                    (schema_type_is_string(table_field->type) ||
+                     schema_type_is_table(schema, table_field->type))) {
+                        need_i = 1;
                 }
-                namespace_push(attribute_string, ")) static inline");
+                if (schema_type_is_table(schema, table_field->type)) {
+                        need_child = 1;
+                }
+                if (table_field->container == schema_container_type_vector &&
+                    schema_type_is_table(schema, table_field->type)) {
+                        need_unchanged = 1;
+                }
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
 
-                fprintf(fp, "%s int %s_%s_%s_present (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+        fprintf(fp, "\n");
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_%s_compare (const struct %s_%s *a, const struct %s_%s *b)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema->namespace, table->name);
                 fprintf(fp, "{\n");
-                fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                fprintf(fp, "    uint8_t present;\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
-                } else {
-                        fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                if (table_field->container == schema_container_type_vector &&
+                    (schema_type_is_string(table_field->type) ||
+                     schema_type_is_table(schema, table_field->type))) {
+                        fprintf(fp, "    uint64_t i;\n");
                 }
-                fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
-                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    if (%s_%s_%s_present(a) != %s_%s_%s_present(b)) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                fprintf(fp, "        return 1;\n");
                 fprintf(fp, "    }\n");
-                if (decoder_use_memcpy) {
-                        fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                } else {
-                        fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                }
-                fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
+                fprintf(fp, "    if (!%s_%s_%s_present(a)) {\n", schema->namespace, table->name, table_field->name);
                 fprintf(fp, "        return 0;\n");
                 fprintf(fp, "    }\n");
-                fprintf(fp, "    return 1;\n");
-                fprintf(fp, "}\n");
-
                 if (table_field->container == schema_container_type_vector) {
-                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                        if (schema_type_is_scalar(table_field->type)) {
-                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
+                        fprintf(fp, "    if (%s_%s_%s_get_count(a) != %s_%s_%s_get_count(b)) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return 1;\n");
+                        fprintf(fp, "    }\n");
+                        if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "    for (i = 0; i < %s_%s_%s_get_count(a); i++) {\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "        if (strcmp(%s_%s_%s_get_at(a, i), %s_%s_%s_get_at(b, i)) != 0) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "            return 1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "    }\n");
                         } else if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "const struct %s_%s_vector * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        }
-                        fprintf(fp, "{\n");
-                        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
-                        }
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    uint8_t present;\n");
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                fprintf(fp, "    for (i = 0; i < %s_%s_%s_get_count(a); i++) {\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "        if (!%s_%s_equal(%s_%s_%s_get_at(a, i), %s_%s_%s_get_at(b, i))) {\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "            return 1;\n");
+                                fprintf(fp, "        }\n");
+                                fprintf(fp, "    }\n");
                         } else {
-                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
+                                fprintf(fp, "    if (%s_%s_%s_get_count(a) != 0 &&\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "        memcmp(%s_%s_%s_get_values(a), %s_%s_%s_get_values(b), %s_%s_%s_get_count(a) * UINT64_C(%" PRIu64 ")) != 0) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, schema_diff_element_size(schema, table_field->type));
+                                fprintf(fp, "        return 1;\n");
+                                fprintf(fp, "    }\n");
                         }
-                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
-                        fprintf(fp, "        return NULL;\n");
+                } else if (table_field->container == schema_container_type_array ||
+                           schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "    if (memcmp(%s_%s_%s_get(a), %s_%s_%s_get(b), UINT64_C(%" PRIu64 ")) != 0) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, schema_table_field_size(schema, table_field));
+                        fprintf(fp, "        return 1;\n");
                         fprintf(fp, "    }\n");
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                        } else {
-                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                        }
-                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
-                        fprintf(fp, "        return NULL;\n");
+                } else if (schema_type_is_string(table_field->type)) {
+                        fprintf(fp, "    if (%s_%s_%s_get_length(a) != %s_%s_%s_get_length(b) ||\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        memcmp(%s_%s_%s_get_value(a), %s_%s_%s_get_value(b), %s_%s_%s_get_length(a)) != 0) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return 1;\n");
                         fprintf(fp, "    }\n");
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                        } else {
-                                fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                        }
-                        fprintf(fp, "    return (const struct %s_%s_vector *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, table_field->type);
-                        fprintf(fp, "}\n");
-
-                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                        fprintf(fp, "%s_t %s_%s_%s_get_count (const struct %s_%s *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        fprintf(fp, "{\n");
-                        fprintf(fp, "    return %s_%s_vector_get_count(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                        fprintf(fp, "}\n");
-
-                        if (schema_type_is_scalar(table_field->type) ||
-                            schema_type_is_float(table_field->type) ||
-                            schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                                fprintf(fp, "%s_t %s_%s_%s_get_length (const struct %s_%s *decoder)\n", schema_count_type_name(schema->count_type), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_get_length(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-
-                                fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                                if (schema_type_is_scalar(table_field->type)) {
-                                        fprintf(fp, "const %s_t * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                                } else if (schema_type_is_float(table_field->type)) {
-                                        fprintf(fp, "const %s * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                                } else if (schema_type_is_enum(schema, table_field->type)) {
-                                        fprintf(fp, "const %s_%s_t * %s_%s_%s_get_values (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                                }
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    return %s_%s_vector_get_values(%s_%s_%s_get(decoder));\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "}\n");
-                        }
-
-                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                        if (schema_type_is_scalar(table_field->type)) {
-                                fprintf(fp, "%s_t %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
-                        } else if (schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "%s %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "%s_%s_t %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
-                        } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "const char * %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
-                        } else if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get_at (const struct %s_%s *decoder, %s_t at)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, schema_count_type_name(schema->count_type));
-                        }
-                        fprintf(fp, "{\n");
-                        fprintf(fp, "    return %s_%s_vector_get_at(%s_%s_%s_get(decoder), at);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
-                        fprintf(fp, "}\n");
-                } else {
-                        fprintf(fp, "%s ", namespace_linearized(attribute_string));
-                        if (schema_type_is_scalar(table_field->type)) {
-                                fprintf(fp, "%s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "%s %s_%s_%s_get (const struct %s_%s *decoder)\n", table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                fprintf(fp, "%s_%s_t %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        } else         if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "const struct %s_%s * %s_%s_%s_get (const struct %s_%s *decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                        }
-                        fprintf(fp, "{\n");
-                        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
-                        fprintf(fp, "    uint8_t present;\n");
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    memcpy(&count, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(count));\n", schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
-                        } else {
-                                fprintf(fp, "    count = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_count_type_name(schema->count_type), schema_offset_type_NAME(schema->offset_type), UINT64_C(0));
-                        }
-                        fprintf(fp, "    if (%s_C(%" PRIu64 ") >= count) {\n", schema_count_type_NAME(schema->count_type), table_field_i);
-                        if (schema_type_is_scalar(table_field->type) ||
-                            schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "        return %s;\n", (table_field->value) ? table_field->value : "0");
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                if (table_field->value != NULL) {
-                                        fprintf(fp, "        return %s_%s_%s;\n", schema->namespace, table_field->type, table_field->value);
-                                } else {
-                                        fprintf(fp, "        return 0;\n");
-                                }
-                        } else if (schema_type_is_string(table_field->type)) {
-                                if (table_field->value != NULL) {
-                                        fprintf(fp, "        return (const struct %s_%s *) \"%s\";\n", schema->namespace, table_field->type, table_field->value);
-                                } else {
-                                        fprintf(fp, "        return NULL;\n");
-                                }
-                        } else {
-                                fprintf(fp, "        return NULL;\n");
-                        }
+                } else if (schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "    if (!%s_%s_equal(%s_%s_%s_get(a), %s_%s_%s_get(b))) {\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return 1;\n");
                         fprintf(fp, "    }\n");
-                        if (decoder_use_memcpy) {
-                                fprintf(fp, "    memcpy(&present, ((const uint8_t *) decoder) + %s_C(%" PRIu64 "), sizeof(present));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                        } else {
-                                fprintf(fp, "    present = *(uint8_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 "));\n", schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type) + sizeof(uint8_t) * (table_field_i / 8));
-                        }
-                        fprintf(fp, "    if (!(present & 0x%02x)) {\n", (1 << (table_field_i % 8)));
-                        if (schema_type_is_scalar(table_field->type) ||
-                            schema_type_is_float(table_field->type)) {
-                                fprintf(fp, "        return %s;\n", (table_field->value) ? table_field->value : "0");
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                if (table_field->value != NULL) {
-                                        fprintf(fp, "        return %s_%s_%s;\n", schema->namespace, table_field->type, table_field->value);
-                                } else {
-                                        fprintf(fp, "        return 0;\n");
-                                }
-                        } else {
-                                fprintf(fp, "        return NULL;\n");
-                        }
+                } else {
+                        fprintf(fp, "    if (%s_%s_%s_get(a) != %s_%s_%s_get(b)) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        return 1;\n");
                         fprintf(fp, "    }\n");
-                        if (schema_type_is_scalar(table_field->type)) {
-                                if (decoder_use_memcpy) {
-                                        fprintf(fp, "    %s_t value;\n", table_field->type);
-                                        fprintf(fp, "    return *(%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                } else {
-                                        fprintf(fp, "    return *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                }
-                        } else if (schema_type_is_float(table_field->type)) {
-                                if (decoder_use_memcpy) {
-                                        fprintf(fp, "    %s value;\n", table_field->type);
-                                        fprintf(fp, "    return *(%s *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(value));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                } else {
-                                        fprintf(fp, "    return *(%s *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                }
-                        } else if (schema_type_is_enum(schema, table_field->type)) {
-                                if (decoder_use_memcpy) {
-                                        fprintf(fp, "    %s_%s_t value;\n", schema->namespace, table_field->type);
-                                        fprintf(fp, "    return *(%s_%s_t *) memcpy(&value, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(value));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                } else {
-                                        fprintf(fp, "    return *(%s_%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", schema->namespace, table_field->type, schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                }
-                        } else if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
-                                if (decoder_use_memcpy) {
-                                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
-                                        fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                } else {
-                                        fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                }
-                                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, table_field->type);
-                        } else if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
-                                if (decoder_use_memcpy) {
-                                        fprintf(fp, "    %s_t toffset;\n", schema_offset_type_name(schema->offset_type));
-                                        fprintf(fp, "    offset = *(%s_t *) memcpy(&toffset, ((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "), sizeof(offset));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                } else {
-                                        fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %s_C(%" PRIu64 ") + %s_C((count + 7) / 8) + %s_C(%" PRIu64 "));\n", schema_offset_type_name(schema->offset_type), schema_offset_type_NAME(schema->offset_type), schema_count_type_size(schema->count_type), schema_offset_type_NAME(schema->offset_type), schema_offset_type_NAME(schema->offset_type), table_field_s);
-                                }
-                                fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, table_field->type);
-                        }
-                        fprintf(fp, "}\n");
+                }
+                fprintf(fp, "    return 0;\n");
+                fprintf(fp, "}\n");
+        }
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_equal (const struct %s_%s *a, const struct %s_%s *b)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        if (table->nfields > 0) {
+                fprintf(fp, "    uint64_t word;\n");
+                fprintf(fp, "    uint64_t mask;\n");
+        }
+        fprintf(fp, "    if (a == b) {\n");
+        fprintf(fp, "        return 1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (a == NULL || b == NULL) {\n");
+        fprintf(fp, "        return 0;\n");
+        fprintf(fp, "    }\n");
+        if (table->nfields > 0) {
+                /* compare presence a word at a time, then visit only the set fields */
+                fprintf(fp, "    for (word = 0; word < UINT64_C(%" PRIu64 "); word++) {\n", (table->nfields + 63) / 64);
+                fprintf(fp, "        mask = %s_%s_present_mask(a, word);\n", schema->namespace, table->name);
+                fprintf(fp, "        if (mask != %s_%s_present_mask(b, word)) {\n", schema->namespace, table->name);
+                fprintf(fp, "            return 0;\n");
+                fprintf(fp, "        }\n");
+                fprintf(fp, "        while (mask != 0) {\n");
+                fprintf(fp, "            switch (word * 64 + __builtin_ctzll(mask)) {\n");
+                TAILQ_FOREACH(table_field, &table->fields, list) {
+                        fprintf(fp, "                case %s_%s_field_%s:\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                    if (%s_%s_%s_compare(a, b) != 0) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                        return 0;\n");
+                        fprintf(fp, "                    }\n");
+                        fprintf(fp, "                    break;\n");
+                }
+                fprintf(fp, "            }\n");
+                fprintf(fp, "            mask &= mask - 1;\n");
+                fprintf(fp, "        }\n");
+                fprintf(fp, "    }\n");
+        }
+        fprintf(fp, "    return 1;\n");
+        fprintf(fp, "}\n");
 
-                        if (schema_type_is_string(table_field->type)) {
-                                fprintf(fp, "%s const char * %s_%s_%s_get_value (const struct %s_%s *decoder)\n", namespace_linearized(attribute_string), schema->namespace, table->name, table_field->name, schema->namespace, table->name);
-                                fprintf(fp, "{\n");
-                                fprintf(fp, "    const struct %s_%s *string;\n", schema->namespace, table_field->type);
-                                fprintf(fp, "    string = %s_%s_%s_get(decoder);\n", schema->namespace, table->name, table_field->name);
-                                fprintf(fp, "    if (string == NULL) {\n");
-                                fprintf(fp, "        return NULL;\n");
-                                fprintf(fp, "    }\n");
-                                fprintf(fp, "    return %s_%s_value(string);\n", schema->namespace, table_field->type);
-                                fprintf(fp, "}\n");
-                        }
+        fprintf(fp, "__attribute__((unused)) static inline const uint8_t * %s_%s_diff_flags (const struct %s_%s *patch, uint64_t *length)\n", schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(schema->count_type));
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "    uint8_t present;\n");
+        fprintf(fp, "    uint64_t position;\n");
+        fprintf(fp, "    const uint8_t *flags;\n");
+        fprintf(fp, "    memcpy(&count, patch, sizeof(count));\n");
+        fprintf(fp, "    if (count <= %s_C(%" PRIu64 ")) {\n", schema_count_type_NAME(schema->count_type), table->nfields);
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memcpy(&present, ((const uint8_t *) patch) + UINT64_C(%" PRIu64 "), sizeof(present));\n", schema_count_type_size(schema->count_type) + table->nfields / 8);
+        fprintf(fp, "    if (!(present & 0x%02x)) {\n", 1 << (table->nfields % 8));
+        fprintf(fp, "        return NULL;\n");
+        fprintf(fp, "    }\n");
+        if (compact) {
+                fprintf(fp, "    position = 0;\n");
+                TAILQ_FOREACH(table_field, &table->fields, list) {
+                        fprintf(fp, "    position += (%s_%s_%s_present(patch)) ? UINT64_C(%" PRIu64 ") : 0;\n", schema->namespace, table->name, table_field->name, schema_table_field_size(schema, table_field));
+                }
+        } else {
+                fprintf(fp, "    position = UINT64_C(%" PRIu64 ");\n", table_field_s);
+        }
+        fprintf(fp, "    memcpy(&offset, ((const uint8_t *) patch) + UINT64_C(%" PRIu64 ") + (count + 7) / 8 + position, sizeof(offset));\n", schema_count_type_size(schema->count_type));
+        fprintf(fp, "    flags = ((const uint8_t *) patch) %s offset;\n", direction);
+        fprintf(fp, "    memcpy(&count, flags, sizeof(count));\n");
+        fprintf(fp, "    *length = count;\n");
+        fprintf(fp, "    return flags + sizeof(count);\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_diff_encode (const struct %s_%s *from, const struct %s_%s *to, struct linearbuffers_encoder *encoder, uint64_t *offset)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        if (need_i) {
+                fprintf(fp, "    uint64_t i;\n");
+        }
+        fprintf(fp, "    uint64_t child;\n");
+        if (need_unchanged) {
+                fprintf(fp, "    uint64_t unchanged;\n");
+        }
+        fprintf(fp, "    uint8_t flags[%" PRIu64 "];\n", ((table->nfields + 7) / 8) * 2);
+        fprintf(fp, "    if (to == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    memset(flags, 0, sizeof(flags));\n");
+        fprintf(fp, "    rc = linearbuffers_encoder_table_start%s(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "));\n", (compact) ? "_compact" : "", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type), schema_count_type_NAME(schema->count_type), table->nfields + 1, schema_offset_type_NAME(schema->offset_type), table_field_s + schema_offset_type_size(schema->offset_type));
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "    if (%s_%s_%s_present(to)) {\n", schema->namespace, table->name, table_field->name);
+                fprintf(fp, "        if (from == NULL || %s_%s_%s_compare(from, to) != 0) {\n", schema->namespace, table->name, table_field->name);
+                if (table_field->container == schema_container_type_none &&
+                    schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "            rc |= %s_%s_diff_encode((from != NULL) ? %s_%s_%s_get(from) : NULL, %s_%s_%s_get(to), encoder, &child);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "            rc |= %s_%s_%s_set(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                } else if (table_field->container == schema_container_type_vector &&
+                           schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "            if (from != NULL && %s_%s_%s_get_count(from) == %s_%s_%s_get_count(to)) {\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                unchanged = UINT64_MAX;\n");
+                        fprintf(fp, "                rc |= %s_%s_%s_start(encoder);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                for (i = 0; i < %s_%s_%s_get_count(to); i++) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                    if (%s_%s_equal(%s_%s_%s_get_at(from, i), %s_%s_%s_get_at(to, i))) {\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                        if (unchanged == UINT64_MAX) {\n");
+                        fprintf(fp, "                            rc |= %s_%s_diff_encode(%s_%s_%s_get_at(to, i), %s_%s_%s_get_at(to, i), encoder, &unchanged);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                        }\n");
+                        fprintf(fp, "                        child = unchanged;\n");
+                        fprintf(fp, "                    } else {\n");
+                        fprintf(fp, "                        rc |= %s_%s_diff_encode(%s_%s_%s_get_at(from, i), %s_%s_%s_get_at(to, i), encoder, &child);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                    }\n");
+                        fprintf(fp, "                    rc |= %s_%s_%s_push(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                        fprintf(fp, "                }\n");
+                        fprintf(fp, "                rc |= %s_%s_%s_set(encoder, %s_%s_%s_end(encoder));\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                flags[%" PRIu64 "] |= 0x%02x;\n", (table->nfields + 7) / 8 + table_field_i / 8, 1 << (table_field_i % 8));
+                        fprintf(fp, "            } else {\n");
+                        schema_generate_diff_field_copy(schema, table, table_field, "to", "                ", fp);
+                        fprintf(fp, "            }\n");
+                } else {
+                        schema_generate_diff_field_copy(schema, table, table_field, "to", "            ", fp);
                 }
+                if (schema->elide_defaults &&
+                    table_field->value != NULL &&
+                    table_field->container == schema_container_type_none &&
+                    (schema_type_is_scalar(table_field->type) ||
+                     schema_type_is_float(table_field->type) ||
+                     schema_type_is_enum(schema, table_field->type))) {
+                        fprintf(fp, "            flags[%" PRIu64 "] |= 0x%02x;\n", table_field_i / 8, 1 << (table_field_i % 8));
+                }
+                fprintf(fp, "        }\n");
+                fprintf(fp, "    } else if (from != NULL && %s_%s_%s_present(from)) {\n", schema->namespace, table->name, table_field->name);
+                fprintf(fp, "        flags[%" PRIu64 "] |= 0x%02x;\n", table_field_i / 8, 1 << (table_field_i % 8));
+                fprintf(fp, "    }\n");
                 table_field_i += 1;
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
+        }
+        fprintf(fp, "    for (child = 0; child < sizeof(flags) && flags[child] == 0; child++) {\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (child < sizeof(flags)) {\n");
+        fprintf(fp, "        rc |= linearbuffers_encoder_vector_create_uint8(encoder, linearbuffers_encoder_count_type_%s, linearbuffers_encoder_offset_type_%s, &child, flags, sizeof(flags));\n", schema_count_type_name(schema->count_type), schema_offset_type_name(schema->offset_type));
+        fprintf(fp, "        rc |= linearbuffers_encoder_table_set_vector(encoder, %s_C(%" PRIu64 "), %s_C(%" PRIu64 "), child);\n", schema_count_type_NAME(schema->count_type), table->nfields, schema_offset_type_NAME(schema->offset_type), table_field_s);
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        linearbuffers_encoder_table_cancel(encoder);\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return linearbuffers_encoder_table_end(encoder, offset);\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_patch_encode (const struct %s_%s *from, const struct %s_%s *patch, struct linearbuffers_encoder *encoder, uint64_t *offset)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        if (need_i) {
+                fprintf(fp, "    uint64_t i;\n");
+        }
+        if (need_child) {
+                fprintf(fp, "    uint64_t child;\n");
+        }
+        fprintf(fp, "    uint64_t nflags;\n");
+        fprintf(fp, "    const uint8_t *flags;\n");
+        fprintf(fp, "    if (from == NULL && patch == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    nflags = 0;\n");
+        fprintf(fp, "    flags = (patch != NULL) ? %s_%s_diff_flags(patch, &nflags) : NULL;\n", schema->namespace, table->name);
+        fprintf(fp, "    rc = %s_%s_start(encoder);\n", schema->namespace, table->name);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        table_field_i = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "    if (patch != NULL && %s_%s_%s_present(patch)) {\n", schema->namespace, table->name, table_field->name);
+                if (table_field->container == schema_container_type_none &&
+                    schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        rc |= %s_%s_patch_encode((from != NULL) ? %s_%s_%s_get(from) : NULL, %s_%s_%s_get(patch), encoder, &child);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        rc |= %s_%s_%s_set(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                } else if (table_field->container == schema_container_type_vector &&
+                           schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        if (nflags > %" PRIu64 " && (flags[%" PRIu64 "] & 0x%02x)) {\n", (table->nfields + 7) / 8 + table_field_i / 8, (table->nfields + 7) / 8 + table_field_i / 8, 1 << (table_field_i % 8));
+                        fprintf(fp, "            rc |= %s_%s_%s_start(encoder);\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "            for (i = 0; i < %s_%s_%s_get_count(patch); i++) {\n", schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                rc |= %s_%s_patch_encode((from != NULL && i < %s_%s_%s_get_count(from)) ? %s_%s_%s_get_at(from, i) : NULL, %s_%s_%s_get_at(patch, i), encoder, &child);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "                rc |= %s_%s_%s_push(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                        fprintf(fp, "            }\n");
+                        fprintf(fp, "            rc |= %s_%s_%s_set(encoder, %s_%s_%s_end(encoder));\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        } else {\n");
+                        schema_generate_diff_field_copy(schema, table, table_field, "patch", "            ", fp);
+                        fprintf(fp, "        }\n");
+                } else {
+                        schema_generate_diff_field_copy(schema, table, table_field, "patch", "        ", fp);
+                }
+                fprintf(fp, "    } else if (from != NULL && %s_%s_%s_present(from) &&\n", schema->namespace, table->name, table_field->name);
+                fprintf(fp, "               !(nflags > %" PRIu64 " && (flags[%" PRIu64 "] & 0x%02x))) {\n", table_field_i / 8, table_field_i / 8, 1 << (table_field_i % 8));
+                if (table_field->container == schema_container_type_none &&
+                    schema_type_is_table(schema, table_field->type)) {
+                        fprintf(fp, "        rc |= %s_%s_patch_encode(%s_%s_%s_get(from), NULL, encoder, &child);\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        fprintf(fp, "        rc |= %s_%s_%s_set(encoder, (const struct %s_%s *) (ptrdiff_t) child);\n", schema->namespace, table->name, table_field->name, schema->namespace, table_field->type);
+                } else {
+                        schema_generate_diff_field_copy(schema, table, table_field, "from", "        ", fp);
+                }
+                fprintf(fp, "    }\n");
+                table_field_i += 1;
+        }
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        %s_%s_cancel(encoder);\n", schema->namespace, table->name);
+        fprintf(fp, "        return -1;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return linearbuffers_encoder_table_end(encoder, offset);\n");
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_diff (const struct %s_%s *from, const struct %s_%s *to, struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return %s_%s_diff_encode(from, to, encoder, NULL);\n", schema->namespace, table->name);
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_%s_patch (const struct %s_%s *from, const struct %s_%s *patch, struct linearbuffers_encoder *encoder)\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return %s_%s_patch_encode(from, patch, encoder, NULL);\n", schema->namespace, table->name);
+        fprintf(fp, "}\n");
+
+        return 0;
+}
+
+static int schema_generate_diff (struct schema *schema, FILE *fp)
+{
+        int rc;
+        struct schema_table *table;
+        struct schema_table *first;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        first = NULL;
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_none &&
+                    schema_table_is_diffable(schema, table)) {
+                        first = table;
+                        break;
+                }
+        }
+        if (first == NULL) {
+                return 0;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_DIFF_API) && defined(%s_%s_ENCODER_API)\n", schema->NAMESPACE, schema->NAMESPACE, first->name);
+        fprintf(fp, "#define %s_DIFF_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none ||
+                    !schema_table_is_diffable(schema, table)) {
+                        continue;
+                }
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_equal (const struct %s_%s *a, const struct %s_%s *b);\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_diff_encode (const struct %s_%s *from, const struct %s_%s *to, struct linearbuffers_encoder *encoder, uint64_t *offset);\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+                fprintf(fp, "__attribute__((unused)) static inline int %s_%s_patch_encode (const struct %s_%s *from, const struct %s_%s *patch, struct linearbuffers_encoder *encoder, uint64_t *offset);\n", schema->namespace, table->name, schema->namespace, table->name, schema->namespace, table->name);
+        }
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_none ||
+                    !schema_table_is_diffable(schema, table)) {
+                        continue;
+                }
+                rc = schema_generate_diff_table(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate diff for table: %s", table->name);
+                        goto bail;
                 }
-                namespace_destroy(attribute_string);
         }
 
         fprintf(fp, "\n");
@@ -1590,9 +5897,11 @@ bail:   return -1;
 int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_memcpy)
 {
         int rc;
+        int has_iterator;
 
         struct schema_enum *anum;
         struct schema_table *table;
+        struct schema_table_field *table_field;
 
         if (schema == NULL) {
                 linearbuffers_errorf("schema is invalid");
@@ -1606,8 +5915,20 @@ int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_
         fprintf(fp, "\n");
         fprintf(fp, "#include <stddef.h>\n");
         fprintf(fp, "#include <stdint.h>\n");
+        fprintf(fp, "#include <stdlib.h>\n");
         fprintf(fp, "#include <string.h>\n");
 
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_UNPACK_FLAG_DEFAULTS)\n");
+        fprintf(fp, "#define LINEARBUFFERS_UNPACK_FLAG_DEFAULTS         0x00000001\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_UNPACK_FLAG_DEFAULT)\n");
+        fprintf(fp, "#define LINEARBUFFERS_UNPACK_FLAG_DEFAULT          LINEARBUFFERS_UNPACK_FLAG_DEFAULTS\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_UNPACK_FLAG_NONE)\n");
+        fprintf(fp, "#define LINEARBUFFERS_UNPACK_FLAG_NONE             0\n");
+        fprintf(fp, "#endif\n");
+
         if (!TAILQ_EMPTY(&schema->enums)) {
                 TAILQ_FOREACH(anum, &schema->enums, list) {
                         rc = schema_generate_enum(schema, anum, fp);
@@ -1618,6 +5939,28 @@ int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_
                 }
         }
 
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_struct) {
+                        continue;
+                }
+                rc = schema_generate_struct(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate struct: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_union) {
+                        continue;
+                }
+                rc = schema_generate_union(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate union: %s", table->name);
+                        goto bail;
+                }
+        }
+
         if (schema_has_string(schema)) {
                 fprintf(fp, "\n");
                 fprintf(fp, "#if !defined(%s_STRING_DECODER_API)\n", schema->NAMESPACE);
@@ -1630,7 +5973,94 @@ int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_
                 fprintf(fp, "{\n");
                 fprintf(fp, "    return (const char *) string;\n");
                 fprintf(fp, "}\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline %s_t %s_string_length (const struct %s_string *string)\n", schema_count_type_name(schema->count_type), schema->namespace, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    if (string == NULL) {\n");
+                fprintf(fp, "        return 0;\n");
+                fprintf(fp, "    }\n");
+                if (schema_string_is_prefixed(schema)) {
+                        fprintf(fp, "    %s_t length;\n", schema_count_type_name(schema->count_type));
+                        fprintf(fp, "    return *(%s_t *) memcpy(&length, ((const uint8_t *) string) - sizeof(length), sizeof(length));\n", schema_count_type_name(schema->count_type));
+                } else {
+                        fprintf(fp, "    return (%s_t) strlen((const char *) string);\n", schema_count_type_name(schema->count_type));
+                }
+                fprintf(fp, "}\n");
+                fprintf(fp, "\n");
+                fprintf(fp, "struct %s_string_view {\n", schema->namespace);
+                fprintf(fp, "    const char *value;\n");
+                fprintf(fp, "    %s_t length;\n", schema_count_type_name(schema->count_type));
+                fprintf(fp, "};\n");
+                fprintf(fp, "\n");
+                fprintf(fp, "__attribute__((unused, warn_unused_result)) static inline struct %s_string_view %s_string_view (const struct %s_string *string)\n", schema->namespace, schema->namespace, schema->namespace);
+                fprintf(fp, "{\n");
+                fprintf(fp, "    struct %s_string_view view;\n", schema->namespace);
+                fprintf(fp, "    view.value = (const char *) string;\n");
+                fprintf(fp, "    view.length = %s_string_length(string);\n", schema->namespace);
+                fprintf(fp, "    return view;\n");
+                fprintf(fp, "}\n");
+
+                fprintf(fp, "\n");
+                fprintf(fp, "#endif\n");
+        }
+
+        if (schema_has_encoded_vector(schema)) {
+                rc = schema_generate_encoded_decoder(schema, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate decoder for encoded vector");
+                        goto bail;
+                }
+        }
+        if (schema_has_dictionary_vector(schema)) {
+                rc = schema_generate_dictionary_decoder(schema, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate decoder for dictionary vector");
+                        goto bail;
+                }
+        }
+
+        if (schema_has_vector(schema, "int8") ||
+            schema_has_vector(schema, "int16") ||
+            schema_has_vector(schema, "int32") ||
+            schema_has_vector(schema, "int64") ||
+            schema_has_vector(schema, "uint8") ||
+            schema_has_vector(schema, "uint16") ||
+            schema_has_vector(schema, "uint32") ||
+            schema_has_vector(schema, "uint64") ||
+            schema_has_vector(schema, "float") ||
+            schema_has_vector(schema, "double")) {
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(%s_VECTOR_KERNEL_API)\n", schema->NAMESPACE);
+                fprintf(fp, "#define %s_VECTOR_KERNEL_API\n", schema->NAMESPACE);
+                fprintf(fp, "\n");
+                fprintf(fp, "#define %s_VECTOR_KERNEL_BLOCK 64\n", schema->NAMESPACE);
+                fprintf(fp, "#define %s_VECTOR_KERNEL_LANES 8\n", schema->NAMESPACE);
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE)\n");
+                fprintf(fp, "#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__GLIBC__)\n");
+                fprintf(fp, "#define LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE __attribute__((target_clones(\"avx2\", \"sse4.2\", \"default\")))\n");
+                fprintf(fp, "#else\n");
+                fprintf(fp, "#define LINEARBUFFERS_VECTOR_KERNEL_ATTRIBUTE\n");
+                fprintf(fp, "#endif\n");
+                fprintf(fp, "#endif\n");
+                fprintf(fp, "\n");
+                fprintf(fp, "#endif\n");
+        }
 
+        has_iterator = schema_has_vector(schema, "string");
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_none &&
+                    schema_has_vector(schema, table->name)) {
+                        has_iterator = 1;
+                }
+        }
+        if (has_iterator) {
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(%s_VECTOR_ITER_API)\n", schema->NAMESPACE);
+                fprintf(fp, "#define %s_VECTOR_ITER_API\n", schema->NAMESPACE);
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(%s_VECTOR_ITER_PREFETCH_DISTANCE)\n", schema->NAMESPACE);
+                fprintf(fp, "#define %s_VECTOR_ITER_PREFETCH_DISTANCE 8\n", schema->NAMESPACE);
+                fprintf(fp, "#endif\n");
                 fprintf(fp, "\n");
                 fprintf(fp, "#endif\n");
         }
@@ -1685,7 +6115,34 @@ int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_
                 goto bail;
         }
 
+        if (schema_has_map(schema)) {
+                schema_generate_map_hash(schema, fp);
+                TAILQ_FOREACH(table, &schema->tables, list) {
+                        TAILQ_FOREACH(table_field, &table->fields, list) {
+                                if (table_field->container != schema_container_type_map) {
+                                        continue;
+                                }
+                                rc = schema_generate_map_decoder(schema, table_field, fp);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate decoder for map: %s", table_field->name);
+                                        goto bail;
+                                }
+                        }
+                }
+        }
+
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct) {
+                        rc = schema_generate_decoder_struct(schema, table, decoder_use_memcpy, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate decoder for struct: %s", table->name);
+                                goto bail;
+                        }
+                        continue;
+                }
+                if (table->type == schema_container_type_union) {
+                        continue;
+                }
                 rc = schema_generate_decoder_table(schema, table, decoder_use_memcpy, fp);
                 if (rc != 0) {
                         linearbuffers_errorf("can not generate decoder for table: %s", table->name);
@@ -1693,8 +6150,180 @@ int schema_generate_c_decoder (struct schema *schema, FILE *fp, int decoder_use_
                 }
         }
 
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (!schema_has_vector(schema, table->name)) {
+                        continue;
+                }
+                rc = schema_generate_vector_lookup(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate lookup for vector: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        rc = schema_generate_verifier(schema, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate verifier");
+                goto bail;
+        }
+
+        rc = schema_generate_diff(schema, fp);
+        if (rc != 0) {
+                linearbuffers_errorf("can not generate diff");
+                goto bail;
+        }
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_jsonify_array (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, struct namespace *namespace, const char *prefix, FILE *fp)
+{
+        const char *type;
+
+        type = table_field->type;
+        if (schema_type_is_enum(schema, table_field->type)) {
+                type = schema_type_get_enum(schema, table_field->type)->type;
+        }
+
+        fprintf(fp, "%s{\n", prefix);
+        fprintf(fp, "%s    %s_t at;\n", prefix, schema_count_type_name(schema->count_type));
+        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":[\");\n", prefix, table_field->name);
+        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+        fprintf(fp, "%s        goto bail;\n", prefix);
+        fprintf(fp, "%s    }\n", prefix);
+        fprintf(fp, "%s    for (at = 0; at < %s_%s_%s_get_count(%s); at++) {\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        if (schema_type_is_float(type)) {
+                fprintf(fp, "%s        rc = emitter(context, \"%%f%%s\", %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        } else if (strncmp(type, "int", 3) == 0) {
+                fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIi64 \"%%s\", (int64_t) %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        } else {
+                fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIu64 \"%%s\", (uint64_t) %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        }
+        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+        fprintf(fp, "%s            goto bail;\n", prefix);
+        fprintf(fp, "%s        }\n", prefix);
+        fprintf(fp, "%s    }\n", prefix);
+        fprintf(fp, "%s    rc = emitter(context, \"]\");\n", prefix);
+        fprintf(fp, "%s}\n", prefix);
+
+        return 0;
+}
+
+static int schema_generate_jsonify_struct (struct schema *schema, struct schema_table *table, struct namespace *namespace, const char *prefix, FILE *fp)
+{
+        int rc;
+        char *nprefix;
+        struct schema_table_field *table_field;
+
+        nprefix = NULL;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        nprefix = malloc(strlen(prefix) + 4 + 1);
+        if (nprefix == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(nprefix, ' ', strlen(prefix) + 4);
+        nprefix[strlen(prefix) + 4] = '\0';
+
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                fprintf(fp, "%s    rc = emitter(context, \"%s\");\n", prefix, prefix);
+                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                fprintf(fp, "%s        goto bail;\n", prefix);
+                fprintf(fp, "%s    }\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+                if (table_field->container == schema_container_type_array) {
+                        rc = schema_generate_jsonify_array(schema, table, table_field, namespace, prefix, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate jsonify for array: %s", table_field->name);
+                                goto bail;
+                        }
+                } else if (schema_type_is_scalar(table_field->type)) {
+                        if (strncmp(table_field->type, "int", 3) == 0) {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIi64 \"\", (int64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        } else {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIu64 \"\", (uint64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        }
+                } else if (schema_type_is_float(table_field->type)) {
+                        fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%f\", %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        if (strncmp(schema_type_get_enum(schema, table_field->type)->type, "int", 3) == 0) {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIi64 \"\", (int64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        } else {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIu64 \"\", (uint64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        }
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "%s{\n", prefix);
+                        fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                        fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        namespace_push(namespace, "_%s", table_field->name);
+                        rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, nprefix, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                goto bail;
+                        }
+                        namespace_pop(namespace);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                        fprintf(fp, "%s}\n", prefix);
+                } else {
+                        linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        goto bail;
+                }
+                fprintf(fp, "%sif (rc < 0) {\n", prefix);
+                fprintf(fp, "%s    goto bail;\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+                if (table_field->list.tqe_next != NULL) {
+                        fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA) {\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \",\");\n", prefix);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s}\n", prefix);
+                }
+                fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                fprintf(fp, "%s    rc = emitter(context, \"\\n\");\n", prefix);
+                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                fprintf(fp, "%s        goto bail;\n", prefix);
+                fprintf(fp, "%s    }\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+        }
+
+        free(nprefix);
         return 0;
-bail:   return -1;
+bail:   if (nprefix != NULL) {
+                free(nprefix);
+        }
+        return -1;
 }
 
 static int schema_generate_jsonify_table (struct schema *schema, struct schema_table *head, struct schema_table *table, struct namespace *namespace, struct element *element, FILE *fp)
@@ -1761,19 +6390,28 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                 if (table_field->container == schema_container_type_vector) {
                         fprintf(fp, "%s    uint64_t at_%" PRIu64 ";\n", prefix, element->nentries);
                         fprintf(fp, "%s    uint64_t count;\n", prefix);
-                        if (schema_type_is_scalar(table_field->type)) {
+                        if (schema_type_is_scalar(table_field->type) &&
+                            schema_table_field_encoding(table_field) == schema_vector_encoding_none) {
                                 fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
                         } else if (schema_type_is_float(table_field->type)) {
                                 fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
                         } else if (schema_type_is_enum(schema, table_field->type)) {
                                 fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
-                        } else if (schema_type_is_string(table_field->type)) {
+                        } else if (schema_type_is_string(table_field->type) &&
+                                   !schema_table_field_is_dictionary(table_field)) {
                                 fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
                         } else if (schema_type_is_table(schema, table_field->type)) {
                                 fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "%s    const struct %s_%s_vector *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                        }
+                        if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+                            schema_table_field_is_dictionary(table_field)) {
+                                fprintf(fp, "%s    count = %s_%s_%s_get_count(%s);\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        } else {
+                                fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                fprintf(fp, "%s    count = %s_%s_vector_get_count(%s_%s);\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
                         }
-                        fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
-                        fprintf(fp, "%s    count = %s_%s_vector_get_count(%s_%s);\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
                         fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
                         fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
                         fprintf(fp, "%s        if (rc < 0) {\n", prefix);
@@ -1802,7 +6440,11 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
 
                         if (schema_type_is_scalar(table_field->type)) {
                                 fprintf(fp, "%s        %s_t value;\n", prefix, table_field->type);
-                                fprintf(fp, "%s        value = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                if (schema_table_field_encoding(table_field) != schema_vector_encoding_none) {
+                                        fprintf(fp, "%s        value = %s_%s_%s_get_at(%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), element->nentries);
+                                } else {
+                                        fprintf(fp, "%s        value = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                }
                                 if (strncmp(table_field->type, "int", 3) == 0) {
                                         fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIi64 \"%%s\", (int64_t) value, ((at_%" PRIu64 " + 1) == count) ? \"\" : \",\");\n", prefix, element->nentries);
                                 } else {
@@ -1856,8 +6498,17 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "%s    }\n", prefix);
                         } else if (schema_type_is_string(table_field->type)) {
                                 fprintf(fp, "%s        const char *value;\n", prefix);
-                                fprintf(fp, "%s        value = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
-                                fprintf(fp, "%s        rc = emitter(context, \"\\\"%%s\\\"%%s\", value, ((at_%" PRIu64 " + 1) == count) ? \"\" : \",\");\n", prefix, element->nentries);
+                                if (schema_table_field_is_dictionary(table_field)) {
+                                        fprintf(fp, "%s        value = %s_%s_%s_get_at(%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), element->nentries);
+                                        fprintf(fp, "%s        rc = %s_jsonify_string_emitter(value, emitter, context);\n", prefix, schema->namespace);
+                                } else {
+                                        fprintf(fp, "%s        value = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                        fprintf(fp, "%s        rc = %s_jsonify_string_nemitter(value, %s_%s_vector_get_length_at(%s_%s, at_%" PRIu64 "), emitter, context);\n", prefix, schema->namespace, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                }
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%%s\", ((at_%" PRIu64 " + 1) == count) ? \"\" : \",\");\n", prefix, element->nentries);
                                 fprintf(fp, "%s        if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s            goto bail;\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
@@ -1907,6 +6558,52 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "%s            }\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                char *sprefix;
+                                fprintf(fp, "%s        const struct %s_%s *%s_%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, table_field->type);
+                                fprintf(fp, "%s        %s_%s_%s = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, namespace_linearized(namespace), table_field->name, table_field->type, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                fprintf(fp, "%s        rc = emitter(context, \"{\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                sprefix = malloc((prefix_count * 4) + 8 + 1);
+                                if (sprefix == NULL) {
+                                        linearbuffers_errorf("can not allocate memory");
+                                        goto bail;
+                                }
+                                memset(sprefix, ' ', (prefix_count * 4) + 8);
+                                sprefix[(prefix_count * 4) + 8] = '\0';
+                                namespace_push(namespace, "_%s_%s", table_field->name, table_field->type);
+                                rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, sprefix, fp);
+                                free(sprefix);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                        goto bail;
+                                }
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"%s    \");\n", prefix, prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"}%%s\", ((at_%" PRIu64 " + 1) == count) ? \"\" : \",\");\n", prefix, element->nentries);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
                         } else {
                                 linearbuffers_errorf("type is invalid: %s", table_field->type);
                                 goto bail;
@@ -1921,6 +6618,144 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                         fprintf(fp, "%s    if (rc < 0) {\n", prefix);
                         fprintf(fp, "%s        goto bail;\n", prefix);
                         fprintf(fp, "%s    }\n", prefix);
+                } else if (table_field->container == schema_container_type_map) {
+                        fprintf(fp, "%s    int64_t at_%" PRIu64 ";\n", prefix, element->nentries);
+                        fprintf(fp, "%s    uint64_t count;\n", prefix);
+                        fprintf(fp, "%s    const struct %s_%s_%s_map *%s_%s;\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name);
+                        fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        fprintf(fp, "%s    count = %s_%s_%s_map_get_count(%s_%s);\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\": {\");\n", prefix, table_field->name);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+
+                        fprintf(fp, "%s    for (at_%" PRIu64 " = %s_%s_%s_map_next(%s_%s, -1); at_%" PRIu64 " >= 0; at_%" PRIu64 " = %s_%s_%s_map_next(%s_%s, at_%" PRIu64 ")) {\n", prefix,
+                                element->nentries, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name,
+                                element->nentries,
+                                element->nentries, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                        fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s            rc = emitter(context, \"%s    \");\n", prefix, prefix);
+                        fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s                goto bail;\n", prefix);
+                        fprintf(fp, "%s            }\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        if (schema_type_is_string(table_field->key)) {
+                                fprintf(fp, "%s        rc = %s_jsonify_string_emitter(%s_%s_%s_map_get_key_at(%s_%s, (%s_t) at_%" PRIu64 "), emitter, context);\n", prefix, schema->namespace, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \": \");\n", prefix);
+                        } else if (strncmp(table_field->key, "int", 3) == 0) {
+                                fprintf(fp, "%s        rc = emitter(context, \"\\\"%%\" PRIi64 \"\\\": \", (int64_t) %s_%s_%s_map_get_key_at(%s_%s, (%s_t) at_%" PRIu64 "));\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                        } else {
+                                fprintf(fp, "%s        rc = emitter(context, \"\\\"%%\" PRIu64 \"\\\": \", (uint64_t) %s_%s_%s_map_get_key_at(%s_%s, (%s_t) at_%" PRIu64 "));\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                        }
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        if (schema_type_is_scalar(table_field->type)) {
+                                if (strncmp(table_field->type, "int", 3) == 0) {
+                                        fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIi64 \"%%s\", (int64_t) %s_%s_%s_map_get_value_at(%s_%s, (%s_t) at_%" PRIu64 "), (--count == 0) ? \"\" : \",\");\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                                } else {
+                                        fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIu64 \"%%s\", (uint64_t) %s_%s_%s_map_get_value_at(%s_%s, (%s_t) at_%" PRIu64 "), (--count == 0) ? \"\" : \",\");\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                                }
+                        } else if (schema_type_is_float(table_field->type)) {
+                                fprintf(fp, "%s        rc = emitter(context, \"%%f%%s\", %s_%s_%s_map_get_value_at(%s_%s, (%s_t) at_%" PRIu64 "), (--count == 0) ? \"\" : \",\");\n", prefix, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                        } else if (schema_type_is_string(table_field->type)) {
+                                fprintf(fp, "%s        rc = %s_jsonify_string_emitter(%s_%s_%s_map_get_value_at(%s_%s, (%s_t) at_%" PRIu64 "), emitter, context);\n", prefix, schema->namespace, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%%s\", (--count == 0) ? \"\" : \",\");\n", prefix);
+                        } else if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "%s        const struct %s_%s *%s_%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, table_field->type);
+                                fprintf(fp, "%s        %s_%s_%s = %s_%s_%s_map_get_value_at(%s_%s, (%s_t) at_%" PRIu64 ");\n", prefix, namespace_linearized(namespace), table_field->name, table_field->type, schema->namespace, table_field->key, table_field->type, namespace_linearized(namespace), table_field->name, schema_count_type_name(schema->count_type), element->nentries);
+                                fprintf(fp, "%s        rc = emitter(context, \"{\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                namespace_push(namespace, "_%s_%s", table_field->name, table_field->type);
+                                element_push(element, table, table_field_i, 0, 1);
+                                rc = schema_generate_jsonify_table(schema, head, schema_type_get_table(schema, table_field->type), namespace, element, fp);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate decoder for table: %s", table->name);
+                                        goto bail;
+                                }
+                                element_pop(element);
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"%s    \");\n", prefix, prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"}%%s\", (--count == 0) ? \"\" : \",\");\n", prefix);
+                        } else {
+                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                                goto bail;
+                        }
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                        fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                        fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s                goto bail;\n", prefix);
+                        fprintf(fp, "%s            }\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                } else if (table_field->container == schema_container_type_array) {
+                        char *aprefix;
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        aprefix = malloc((prefix_count * 4) + 4 + 1);
+                        if (aprefix == NULL) {
+                                linearbuffers_errorf("can not allocate memory");
+                                goto bail;
+                        }
+                        memset(aprefix, ' ', (prefix_count * 4) + 4);
+                        aprefix[(prefix_count * 4) + 4] = '\0';
+                        rc = schema_generate_jsonify_array(schema, table, table_field, namespace, aprefix, fp);
+                        free(aprefix);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate jsonify for array: %s", table_field->name);
+                                goto bail;
+                        }
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
                 } else {
                         if (schema_type_is_scalar(table_field->type) ||
                             schema_type_is_float(table_field->type) ||
@@ -1961,24 +6796,110 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                         }
                                 } else if (schema_type_is_string(table_field->type)) {
                                         fprintf(fp, "%s    rc  = emitter(context, \"\\\"%s\\\":\");\n", prefix, table_field->name);
-                                        fprintf(fp, "%s    rc |= %s_jsonify_string_emitter(value, emitter, context);\n", prefix, schema->namespace);
+                                        fprintf(fp, "%s    rc |= %s_jsonify_string_nemitter(value, %s_%s_%s_get_length(%s), emitter, context);\n", prefix, schema->namespace, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                }
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                        }
+
+                        if (schema_type_is_table(schema, table_field->type)) {
+                                fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                                fprintf(fp, "%s    (void) %s_%s;\n", prefix, namespace_linearized(namespace), table_field->name);
+                                fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                namespace_push(namespace, "_%s", table_field->name);
+                                element_push(element, table, table_field_i, 0, 0);
+                                rc = schema_generate_jsonify_table(schema, head, schema_type_get_table(schema, table_field->type), namespace, element, fp);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate jsonify for table: %s", table->name);
+                                        goto bail;
+                                }
+                                element_pop(element);
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                        }
+
+                        if (schema_type_is_struct(schema, table_field->type)) {
+                                char *sprefix;
+                                fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                                fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                sprefix = malloc((prefix_count * 4) + 4 + 1);
+                                if (sprefix == NULL) {
+                                        linearbuffers_errorf("can not allocate memory");
+                                        goto bail;
+                                }
+                                memset(sprefix, ' ', (prefix_count * 4) + 4);
+                                sprefix[(prefix_count * 4) + 4] = '\0';
+                                namespace_push(namespace, "_%s", table_field->name);
+                                rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, sprefix, fp);
+                                free(sprefix);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                        goto bail;
                                 }
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
                                 fprintf(fp, "%s    if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s        goto bail;\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
                         }
 
-                        if (schema_type_is_table(schema, table_field->type)) {
-                                fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
-                                fprintf(fp, "%s    (void) %s_%s;\n", prefix, namespace_linearized(namespace), table_field->name);
-                                fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        if (schema_type_is_union(schema, table_field->type)) {
+                                struct schema_table_field *union_field;
                                 fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
                                 fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
                                 fprintf(fp, "%s        if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s            goto bail;\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
-                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s_type\\\":\\\"%%s\\\",\", %s_%s_type_string(%s_%s_%s_get_type(%s)));\n", prefix, table_field->name, schema->namespace, table_field->type, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
                                 fprintf(fp, "%s    if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s        goto bail;\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
@@ -1988,22 +6909,51 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "%s            goto bail;\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
-                                namespace_push(namespace, "_%s", table_field->name);
-                                element_push(element, table, table_field_i, 0, 0);
-                                rc = schema_generate_jsonify_table(schema, head, schema_type_get_table(schema, table_field->type), namespace, element, fp);
-                                if (rc != 0) {
-                                        linearbuffers_errorf("can not generate jsonify for table: %s", table->name);
-                                        goto bail;
-                                }
-                                element_pop(element);
-                                namespace_pop(namespace);
                                 fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
                                 fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
                                 fprintf(fp, "%s        if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s            goto bail;\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
-                                fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                                fprintf(fp, "%s    switch (%s_%s_%s_get_type(%s)) {\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                TAILQ_FOREACH(union_field, &schema_type_get_table(schema, table_field->type)->fields, list) {
+                                        fprintf(fp, "%s    case %s_%s_type_%s: {\n", prefix, schema->namespace, table_field->type, union_field->name);
+                                        fprintf(fp, "%s    const struct %s_%s *%s_%s_%s;\n", prefix, schema->namespace, union_field->type, namespace_linearized(namespace), table_field->name, union_field->name);
+                                        fprintf(fp, "%s    (void) %s_%s_%s;\n", prefix, namespace_linearized(namespace), table_field->name, union_field->name);
+                                        fprintf(fp, "%s    %s_%s_%s = %s_%s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, union_field->name, schema->namespace, table->name, table_field->name, union_field->name, namespace_linearized(namespace));
+                                        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                        fprintf(fp, "%s        goto bail;\n", prefix);
+                                        fprintf(fp, "%s    }\n", prefix);
+                                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                        fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                        fprintf(fp, "%s            goto bail;\n", prefix);
+                                        fprintf(fp, "%s        }\n", prefix);
+                                        fprintf(fp, "%s    }\n", prefix);
+                                        namespace_push(namespace, "_%s_%s", table_field->name, union_field->name);
+                                        element_push(element, table, table_field_i, 0, 0);
+                                        rc = schema_generate_jsonify_table(schema, head, schema_type_get_table(schema, union_field->type), namespace, element, fp);
+                                        if (rc != 0) {
+                                                linearbuffers_errorf("can not generate jsonify for table: %s", union_field->type);
+                                                goto bail;
+                                        }
+                                        element_pop(element);
+                                        namespace_pop(namespace);
+                                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                        fprintf(fp, "%s            goto bail;\n", prefix);
+                                        fprintf(fp, "%s        }\n", prefix);
+                                        fprintf(fp, "%s    }\n", prefix);
+                                        fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                                        fprintf(fp, "%s    break;\n", prefix);
+                                        fprintf(fp, "%s    }\n", prefix);
+                                }
+                                fprintf(fp, "%s    default:\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":null\");\n", prefix, table_field->name);
+                                fprintf(fp, "%s    break;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
                                 fprintf(fp, "%s    if (rc < 0) {\n", prefix);
                                 fprintf(fp, "%s        goto bail;\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
@@ -2117,157 +7067,965 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
 
         free(prefix);
         return 0;
-bail:   return -1;
+bail:   return -1;
+}
+
+int schema_generate_c_jsonify (struct schema *schema, FILE *fp)
+{
+        int rc;
+
+        struct element *element;
+        struct namespace *namespace;
+
+        struct schema_table *table;
+
+        element = NULL;
+        namespace = NULL;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#include <stdio.h>\n");
+        fprintf(fp, "#include <stdlib.h>\n");
+        fprintf(fp, "#include <stdarg.h>\n");
+        fprintf(fp, "#include <inttypes.h>\n");
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE    0x00000001\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE     0x00000002\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA    0x00000004\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE  0x00000008\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY          (LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE)\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_DEFAULT)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_DEFAULT         LINEARBUFFERS_JSONIFY_FLAG_PRETTY\n");
+        fprintf(fp, "#endif\n");
+        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_NONE)\n");
+        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_NONE            0\n");
+        fprintf(fp, "#endif\n");
+
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_JSONIFY_STRING_EMITTER)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_JSONIFY_STRING_EMITTER\n", schema->NAMESPACE);
+        fprintf(fp, "static inline int %s_jsonify_string_nemitter (const char *str, uint64_t length, int (*emitter) (void *context, const char *format, ...), void *context)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    const char *ptr;\n");
+        fprintf(fp, "    const char *end;\n");
+        fprintf(fp, "    if (str == NULL) {\n");
+        fprintf(fp, "        return emitter(context, \"\\\"\\\"\");\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    end = str + length;\n");
+        fprintf(fp, "    for (ptr = str; ptr < end; ptr++) {\n");
+        fprintf(fp, "        if ((((unsigned char) *ptr) < 32) ||\n");
+        fprintf(fp, "            (*ptr == '\\\"') ||\n");
+        fprintf(fp, "            (*ptr == '\\\\')) {\n");
+        fprintf(fp, "            break;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    if (ptr == end && length <= INT32_MAX) {\n");
+        fprintf(fp, "        return emitter(context, \"\\\"%%.*s\\\"\", (int) length, str);\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    rc = emitter(context, \"\\\"\");\n");
+        fprintf(fp, "    if (rc < 0) {\n");
+        fprintf(fp, "        return rc;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    for (ptr = str; ptr < end; ptr++) {\n");
+        fprintf(fp, "        if (*ptr == '\\\"') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\\\\"\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\\\') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\\\\\\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\b') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\b\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\f') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\f\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\n') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\n\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\r') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\r\");\n");
+        fprintf(fp, "        } else if (*ptr == '\\t') {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\t\");\n");
+        fprintf(fp, "        } else if (((unsigned char) *ptr) < 32) {\n");
+        fprintf(fp, "            rc = emitter(context, \"\\\\u%%04x\", (unsigned char) *ptr);\n");
+        fprintf(fp, "        } else {\n");
+        fprintf(fp, "            rc = emitter(context, \"%%c\", *ptr);\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "        if (rc < 0) {\n");
+        fprintf(fp, "           return rc;\n");
+        fprintf(fp, "        }\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    rc = emitter(context, \"\\\"\");\n");
+        fprintf(fp, "    if (rc < 0) {\n");
+        fprintf(fp, "       return rc;\n");
+        fprintf(fp, "    }\n");
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "static inline int %s_jsonify_string_emitter (const char *str, int (*emitter) (void *context, const char *format, ...), void *context)\n", schema->namespace);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    return %s_jsonify_string_nemitter(str, (str == NULL) ? 0 : strlen(str), emitter, context);\n", schema->namespace);
+        fprintf(fp, "}\n");
+        fprintf(fp, "#endif\n");
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct ||
+                    table->type == schema_container_type_union) {
+                        continue;
+                }
+                fprintf(fp, "\n");
+                fprintf(fp, "#if !defined(%s_%s_JSONIFY_API)\n", schema->NAMESPACE, table->name);
+                fprintf(fp, "#define %s_%s_JSONIFY_API\n", schema->NAMESPACE, table->name);
+                fprintf(fp, "\n");
+
+                namespace = namespace_create();
+                if (namespace == NULL) {
+                        linearbuffers_errorf("can not create namespace");
+                        goto bail;
+                }
+                rc = namespace_push(namespace, "%s_%s", schema->namespace, table->name);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not build namespace");
+                        goto bail;
+                }
+
+                element = element_create();
+                if (element == NULL) {
+                        linearbuffers_errorf("can not create element");
+                        goto bail;
+                }
+
+                rc = schema_generate_jsonify_table(schema, table, table, namespace, element, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate jsonify for table: %s", table->name);
+                        goto bail;
+                }
+
+                namespace_destroy(namespace);
+                element_destroy(element);
+
+                fprintf(fp, "\n");
+                fprintf(fp, "#endif\n");
+        }
+
+        return 0;
+bail:   if (namespace != NULL) {
+                namespace_destroy(namespace);
+        }
+        if (element != NULL) {
+                element_destroy(element);
+        }
+        return -1;
+}
+
+enum {
+        convert_kind_none,
+        convert_kind_slot,
+        convert_kind_number,
+        convert_kind_string,
+        convert_kind_table,
+        convert_kind_union,
+        convert_kind_vector_values,
+        convert_kind_vector_number,
+        convert_kind_vector_string,
+        convert_kind_vector_table
+};
+
+TAILQ_HEAD(convert_pairs, convert_pair);
+struct convert_pair {
+        TAILQ_ENTRY(convert_pair) list;
+        struct schema_table *from;
+        struct schema_table *to;
+};
+
+static void convert_pairs_destroy (struct convert_pairs *pairs)
+{
+        struct convert_pair *pair;
+        struct convert_pair *npair;
+        TAILQ_FOREACH_SAFE(pair, pairs, list, npair) {
+                TAILQ_REMOVE(pairs, pair, list);
+                free(pair);
+        }
+}
+
+static int convert_pairs_push (struct convert_pairs *pairs, struct schema_table *from, struct schema_table *to)
+{
+        struct convert_pair *pair;
+        if (from == NULL ||
+            to == NULL) {
+                linearbuffers_errorf("table is invalid");
+                return -1;
+        }
+        TAILQ_FOREACH(pair, pairs, list) {
+                if (pair->from == from &&
+                    pair->to == to) {
+                        return 0;
+                }
+        }
+        pair = malloc(sizeof(struct convert_pair));
+        if (pair == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                return -1;
+        }
+        memset(pair, 0, sizeof(struct convert_pair));
+        pair->from = from;
+        pair->to = to;
+        TAILQ_INSERT_TAIL(pairs, pair, list);
+        return 0;
+}
+
+static const char * schema_convert_number_type (struct schema *schema, const char *type)
+{
+        if (schema_type_is_scalar(type) ||
+            schema_type_is_float(type)) {
+                return type;
+        }
+        if (schema_type_is_enum(schema, type)) {
+                return schema_type_get_enum(schema, type)->type;
+        }
+        return NULL;
+}
+
+static void schema_convert_number_ctype (const char *type, FILE *fp)
+{
+        if (schema_type_is_float(type)) {
+                fprintf(fp, "%s", type);
+        } else {
+                fprintf(fp, "%s_t", type);
+        }
+}
+
+static void schema_convert_field_ctype (struct schema *schema, const char *type, FILE *fp)
+{
+        if (schema_type_is_enum(schema, type)) {
+                fprintf(fp, "%s_%s_t", schema->namespace, type);
+        } else {
+                schema_convert_number_ctype(type, fp);
+        }
+}
+
+static int schema_convert_slot_is_same (struct schema *from, struct schema_table_field *from_field, struct schema *to, struct schema_table_field *to_field);
+
+static int schema_convert_struct_is_same (struct schema *from, const char *from_type, struct schema *to, const char *to_type)
+{
+        struct schema_table *from_struct;
+        struct schema_table *to_struct;
+        struct schema_table_field *from_field;
+        struct schema_table_field *to_field;
+        from_struct = schema_type_get_table(from, from_type);
+        to_struct = schema_type_get_table(to, to_type);
+        if (from_struct == NULL ||
+            to_struct == NULL ||
+            from_struct->nfields != to_struct->nfields) {
+                return 0;
+        }
+        to_field = TAILQ_FIRST(&to_struct->fields);
+        TAILQ_FOREACH(from_field, &from_struct->fields, list) {
+                if (!schema_convert_slot_is_same(from, from_field, to, to_field)) {
+                        return 0;
+                }
+                to_field = TAILQ_NEXT(to_field, list);
+        }
+        return 1;
+}
+
+static int schema_convert_slot_is_same (struct schema *from, struct schema_table_field *from_field, struct schema *to, struct schema_table_field *to_field)
+{
+        const char *from_number;
+        const char *to_number;
+        if (from_field->container != to_field->container) {
+                return 0;
+        }
+        if (from_field->container != schema_container_type_none &&
+            from_field->container != schema_container_type_array) {
+                return 0;
+        }
+        if (from_field->container == schema_container_type_array &&
+            from_field->length != to_field->length) {
+                return 0;
+        }
+        from_number = schema_convert_number_type(from, from_field->type);
+        to_number = schema_convert_number_type(to, to_field->type);
+        if (from_number != NULL &&
+            to_number != NULL) {
+                return strcmp(from_number, to_number) == 0;
+        }
+        if (schema_type_is_struct(from, from_field->type) &&
+            schema_type_is_struct(to, to_field->type)) {
+                return schema_convert_struct_is_same(from, from_field->type, to, to_field->type);
+        }
+        return 0;
+}
+
+static int schema_convert_field_is_deprecated (struct schema_table_field *table_field)
+{
+        struct schema_attribute *attribute;
+        TAILQ_FOREACH(attribute, &table_field->attributes, list) {
+                if (strcmp(attribute->name, "deprecated") == 0) {
+                        if (attribute->value == NULL ||
+                            strcmp(attribute->value, "1") == 0 ||
+                            strcmp(attribute->value, "yes") == 0 ||
+                            strcmp(attribute->value, "true") == 0) {
+                                return 1;
+                        }
+                }
+        }
+        return 0;
+}
+
+static int schema_convert_field_kind (struct schema *from, struct schema_table_field *from_field, struct schema *to, struct schema_table_field *to_field)
+{
+        const char *from_number;
+        const char *to_number;
+        if (from_field == NULL ||
+            to_field == NULL) {
+                return convert_kind_none;
+        }
+        if (schema_convert_field_is_deprecated(to_field)) {
+                return convert_kind_none;
+        }
+        if (schema_convert_slot_is_same(from, from_field, to, to_field)) {
+                return convert_kind_slot;
+        }
+        if (from_field->container != to_field->container) {
+                return convert_kind_none;
+        }
+        from_number = schema_convert_number_type(from, from_field->type);
+        to_number = schema_convert_number_type(to, to_field->type);
+        if (from_field->container == schema_container_type_vector) {
+                if (schema_table_field_encoding(from_field) != schema_vector_encoding_none ||
+                    schema_table_field_encoding(to_field) != schema_vector_encoding_none ||
+                    schema_table_field_is_dictionary(from_field) ||
+                    schema_table_field_is_dictionary(to_field)) {
+                        return convert_kind_none;
+                }
+                if (from_number != NULL &&
+                    to_number != NULL) {
+                        return (strcmp(from_number, to_number) == 0) ? convert_kind_vector_values : convert_kind_vector_number;
+                }
+                if (schema_type_is_struct(from, from_field->type) &&
+                    schema_type_is_struct(to, to_field->type) &&
+                    schema_convert_struct_is_same(from, from_field->type, to, to_field->type)) {
+                        return convert_kind_vector_values;
+                }
+                if (schema_type_is_string(from_field->type) &&
+                    schema_type_is_string(to_field->type)) {
+                        return convert_kind_vector_string;
+                }
+                if (schema_type_is_table(from, from_field->type) &&
+                    schema_type_is_table(to, to_field->type)) {
+                        return convert_kind_vector_table;
+                }
+                return convert_kind_none;
+        }
+        if (from_field->container != schema_container_type_none) {
+                return convert_kind_none;
+        }
+        if (from_number != NULL &&
+            to_number != NULL) {
+                return convert_kind_number;
+        }
+        if (schema_type_is_string(from_field->type) &&
+            schema_type_is_string(to_field->type)) {
+                return convert_kind_string;
+        }
+        if (schema_type_is_table(from, from_field->type) &&
+            schema_type_is_table(to, to_field->type)) {
+                return convert_kind_table;
+        }
+        if (schema_type_is_union(from, from_field->type) &&
+            schema_type_is_union(to, to_field->type)) {
+                return convert_kind_union;
+        }
+        return convert_kind_none;
+}
+
+static int schema_convert_pairs_close (struct schema *schema, struct schema *from, struct convert_pairs *pairs)
+{
+        int rc;
+        int kind;
+        struct convert_pair *pair;
+        struct schema_table_field *from_field;
+        struct schema_table_field *to_field;
+        struct schema_table_field *from_member;
+        struct schema_table_field *to_member;
+        TAILQ_FOREACH(pair, pairs, list) {
+                to_field = TAILQ_FIRST(&pair->to->fields);
+                TAILQ_FOREACH(from_field, &pair->from->fields, list) {
+                        if (to_field == NULL) {
+                                break;
+                        }
+                        kind = schema_convert_field_kind(from, from_field, schema, to_field);
+                        if (kind == convert_kind_table ||
+                            kind == convert_kind_vector_table) {
+                                rc = convert_pairs_push(pairs, schema_type_get_table(from, from_field->type), schema_type_get_table(schema, to_field->type));
+                                if (rc != 0) {
+                                        return -1;
+                                }
+                        } else if (kind == convert_kind_union) {
+                                to_member = TAILQ_FIRST(&schema_type_get_table(schema, to_field->type)->fields);
+                                TAILQ_FOREACH(from_member, &schema_type_get_table(from, from_field->type)->fields, list) {
+                                        if (to_member == NULL) {
+                                                break;
+                                        }
+                                        rc = convert_pairs_push(pairs, schema_type_get_table(from, from_member->type), schema_type_get_table(schema, to_member->type));
+                                        if (rc != 0) {
+                                                return -1;
+                                        }
+                                        to_member = TAILQ_NEXT(to_member, list);
+                                }
+                        }
+                        to_field = TAILQ_NEXT(to_field, list);
+                }
+        }
+        return 0;
 }
 
-int schema_generate_c_jsonify (struct schema *schema, FILE *fp)
+static void schema_generate_convert_presence (uint64_t table_field_i, FILE *fp)
 {
-        int rc;
+        fprintf(fp, "count > %" PRIu64 " && (present[%" PRIu64 "] & 0x%02x)", table_field_i, table_field_i / 8, (1 << (table_field_i % 8)));
+}
 
-        struct element *element;
-        struct namespace *namespace;
+static void schema_generate_convert_child (struct schema *from, struct schema_table *table, const char *prefix, uint64_t skip, int indent, FILE *fp)
+{
+        if (skip == 0) {
+                fprintf(fp, "%*schild = position %s %s_offset(buffer, slots + slot);\n", indent, "", (schema_table_is_compact(from, table)) ? "-" : "+", prefix);
+        } else {
+                fprintf(fp, "%*schild = position %s %s_offset(buffer, slots + slot + %" PRIu64 ");\n", indent, "", (schema_table_is_compact(from, table)) ? "-" : "+", prefix, skip);
+        }
+}
 
-        struct schema_table *table;
+static int schema_generate_convert_table (struct schema *schema, struct schema *from, struct convert_pair *pair, FILE *fp)
+{
+        int kind;
+        int compact;
+        int need_i;
+        int need_child;
+        int need_value;
+        int need_element;
+        int need_sizes;
+        int indent;
+        uint8_t mask;
+        uint64_t b;
+        uint64_t i;
+        uint64_t j;
+        uint64_t k;
+        uint64_t last;
+        uint64_t nfields;
+        uint64_t from_s;
+        uint64_t to_s;
+        uint64_t run_s;
+        uint64_t count_size;
+        char prefix[256];
+        struct schema_table_field *from_field;
+        struct schema_table_field *to_field;
+        struct schema_table_field *from_member;
+        struct schema_table_field *to_member;
+        struct schema_table_field **from_fields;
+        struct schema_table_field **to_fields;
+        uint64_t *from_offsets;
+        uint64_t *to_offsets;
+        int *kinds;
 
-        element = NULL;
-        namespace = NULL;
+        from_fields = NULL;
+        to_fields = NULL;
+        from_offsets = NULL;
+        to_offsets = NULL;
+        kinds = NULL;
 
-        if (schema == NULL) {
-                linearbuffers_errorf("schema is invalid");
+        snprintf(prefix, sizeof(prefix), "%s_convert_%s", schema->namespace, from->namespace);
+        compact = schema_table_is_compact(from, pair->from);
+        count_size = schema_count_type_size(from->count_type);
+
+        nfields = (pair->from->nfields < pair->to->nfields) ? pair->from->nfields : pair->to->nfields;
+        from_fields = calloc(nfields + 1, sizeof(struct schema_table_field *));
+        to_fields = calloc(nfields + 1, sizeof(struct schema_table_field *));
+        from_offsets = calloc(nfields + 1, sizeof(uint64_t));
+        to_offsets = calloc(nfields + 1, sizeof(uint64_t));
+        kinds = calloc(nfields + 1, sizeof(int));
+        if (from_fields == NULL ||
+            to_fields == NULL ||
+            from_offsets == NULL ||
+            to_offsets == NULL ||
+            kinds == NULL) {
+                linearbuffers_errorf("can not allocate memory");
                 goto bail;
         }
-        if (fp == NULL) {
-                linearbuffers_errorf("fp is invalid");
-                goto bail;
+
+        need_i = 0;
+        need_child = 0;
+        need_value = 0;
+        need_element = 0;
+        need_sizes = 0;
+        last = 0;
+        from_s = 0;
+        to_s = 0;
+        from_field = TAILQ_FIRST(&pair->from->fields);
+        to_field = TAILQ_FIRST(&pair->to->fields);
+        for (i = 0; i < nfields; i++) {
+                from_fields[i] = from_field;
+                to_fields[i] = to_field;
+                from_offsets[i] = from_s;
+                to_offsets[i] = to_s;
+                kinds[i] = schema_convert_field_kind(from, from_field, schema, to_field);
+                if (kinds[i] != convert_kind_none) {
+                        last = i + 1;
+                }
+                if (kinds[i] == convert_kind_slot) {
+                        need_sizes = 1;
+                }
+                if (kinds[i] != convert_kind_none &&
+                    kinds[i] != convert_kind_slot &&
+                    kinds[i] != convert_kind_number) {
+                        need_child = 1;
+                }
+                if (kinds[i] == convert_kind_table ||
+                    kinds[i] == convert_kind_union ||
+                    kinds[i] >= convert_kind_vector_number) {
+                        need_value = 1;
+                }
+                if (kinds[i] >= convert_kind_vector_number) {
+                        need_i = 1;
+                }
+                if (kinds[i] == convert_kind_vector_string ||
+                    kinds[i] == convert_kind_vector_table) {
+                        need_element = 1;
+                }
+                from_s += schema_table_field_size(from, from_field);
+                to_s += schema_table_field_size(schema, to_field);
+                from_field = TAILQ_NEXT(from_field, list);
+                to_field = TAILQ_NEXT(to_field, list);
         }
 
-        fprintf(fp, "\n");
-        fprintf(fp, "#include <stdio.h>\n");
-        fprintf(fp, "#include <stdlib.h>\n");
-        fprintf(fp, "#include <stdarg.h>\n");
-        fprintf(fp, "#include <inttypes.h>\n");
+        fprintf(fp, "__attribute__((unused)) static inline int %s_convert_%s_to_%s_fields (struct linearbuffers_encoder *encoder, const uint8_t *buffer, uint64_t position)\n", schema->namespace, pair->from->name, pair->to->name);
+        fprintf(fp, "{\n");
+        if (last == 0) {
+                fprintf(fp, "    (void) encoder;\n");
+                fprintf(fp, "    (void) buffer;\n");
+                fprintf(fp, "    (void) position;\n");
+                fprintf(fp, "    return 0;\n");
+                fprintf(fp, "}\n");
+                goto out;
+        }
+        fprintf(fp, "    int rc;\n");
+        if (need_i) {
+                fprintf(fp, "    uint64_t i;\n");
+                fprintf(fp, "    uint64_t n;\n");
+        }
+        if (need_element) {
+                fprintf(fp, "    uint64_t element;\n");
+        }
+        if (need_child) {
+                fprintf(fp, "    uint64_t child;\n");
+        }
+        if (need_value) {
+                fprintf(fp, "    const void *value;\n");
+        }
+        if (compact) {
+                fprintf(fp, "    uint64_t size;\n");
+        }
+        fprintf(fp, "    uint64_t count;\n");
+        fprintf(fp, "    uint64_t slots;\n");
+        fprintf(fp, "    const uint8_t *present;\n");
+        if (need_sizes) {
+                fprintf(fp, "    static const uint64_t sizes[] = {");
+                for (i = 0; i < last; i++) {
+                        fprintf(fp, "%s UINT64_C(%" PRIu64 ")", (i == 0) ? "" : ",", schema_table_field_size(schema, to_fields[i]));
+                }
+                fprintf(fp, " };\n");
+        }
+        fprintf(fp, "    count = %s_count(buffer, position);\n", prefix);
+        fprintf(fp, "    present = buffer + position + UINT64_C(%" PRIu64 ");\n", count_size);
+        fprintf(fp, "    slots = position + UINT64_C(%" PRIu64 ") + (count + 7) / 8;\n", count_size);
+        if (compact) {
+                fprintf(fp, "    size = 0;\n");
+        }
+        fprintf(fp, "    rc = 0;\n");
 
-        fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE    0x00000001\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE     0x00000002\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA    0x00000004\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE  0x00000008\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_PRETTY)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_PRETTY          (LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA | LINEARBUFFERS_JSONIFY_FLAG_PRETTY_ENDLINE)\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_DEFAULT)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_DEFAULT         LINEARBUFFERS_JSONIFY_FLAG_PRETTY\n");
-        fprintf(fp, "#endif\n");
-        fprintf(fp, "#if !defined(LINEARBUFFERS_JSONIFY_FLAG_NONE)\n");
-        fprintf(fp, "#define LINEARBUFFERS_JSONIFY_FLAG_NONE            0\n");
-        fprintf(fp, "#endif\n");
+        for (i = 0; i < last; ) {
+                kind = kinds[i];
+                if (kind == convert_kind_slot) {
+                        for (j = i; j < last && kinds[j] == convert_kind_slot; j++) {
+                        }
+                        indent = 4;
+                        if (j - i > 1) {
+                                run_s = from_offsets[j - 1] + schema_table_field_size(from, from_fields[j - 1]) - from_offsets[i];
+                                fprintf(fp, "    if (count >= %" PRIu64, j);
+                                for (k = i / 8; k <= (j - 1) / 8; k++) {
+                                        mask = 0;
+                                        for (b = i; b < j; b++) {
+                                                if (b / 8 == k) {
+                                                        mask |= 1 << (b % 8);
+                                                }
+                                        }
+                                        fprintf(fp, " &&\n        (present[%" PRIu64 "] & 0x%02x) == 0x%02x", k, mask, mask);
+                                }
+                                fprintf(fp, ") {\n");
+                                if (compact) {
+                                        fprintf(fp, "        rc |= linearbuffers_encoder_table_set_slots(encoder, UINT64_C(%" PRIu64 "), UINT64_C(%" PRIu64 "), UINT64_C(%" PRIu64 "), buffer + slots + size, sizes + %" PRIu64 ");\n", i, j - i, to_offsets[i], i);
+                                        fprintf(fp, "        size += %" PRIu64 ";\n", run_s);
+                                } else {
+                                        fprintf(fp, "        rc |= linearbuffers_encoder_table_set_slots(encoder, UINT64_C(%" PRIu64 "), UINT64_C(%" PRIu64 "), UINT64_C(%" PRIu64 "), buffer + slots + UINT64_C(%" PRIu64 "), sizes + %" PRIu64 ");\n", i, j - i, to_offsets[i], from_offsets[i], i);
+                                }
+                                fprintf(fp, "    } else {\n");
+                                indent = 8;
+                        }
+                        for (k = i; k < j; k++) {
+                                fprintf(fp, "%*sif (", indent, "");
+                                schema_generate_convert_presence(k, fp);
+                                fprintf(fp, ") {\n");
+                                if (compact) {
+                                        fprintf(fp, "%*s    rc |= linearbuffers_encoder_table_set_slots(encoder, UINT64_C(%" PRIu64 "), UINT64_C(1), UINT64_C(%" PRIu64 "), buffer + slots + size, sizes + %" PRIu64 ");\n", indent, "", k, to_offsets[k], k);
+                                        fprintf(fp, "%*s    size += %" PRIu64 ";\n", indent, "", schema_table_field_size(from, from_fields[k]));
+                                } else {
+                                        fprintf(fp, "%*s    rc |= linearbuffers_encoder_table_set_slots(encoder, UINT64_C(%" PRIu64 "), UINT64_C(1), UINT64_C(%" PRIu64 "), buffer + slots + UINT64_C(%" PRIu64 "), sizes + %" PRIu64 ");\n", indent, "", k, to_offsets[k], from_offsets[k], k);
+                                }
+                                fprintf(fp, "%*s}\n", indent, "");
+                        }
+                        if (j - i > 1) {
+                                fprintf(fp, "    }\n");
+                        }
+                        i = j;
+                        continue;
+                }
+                fprintf(fp, "    if (");
+                schema_generate_convert_presence(i, fp);
+                fprintf(fp, ") {\n");
+                if (kind == convert_kind_none) {
+                        if (compact) {
+                                fprintf(fp, "        size += %" PRIu64 ";\n", schema_table_field_size(from, from_fields[i]));
+                        }
+                        fprintf(fp, "    }\n");
+                        i += 1;
+                        continue;
+                }
+                if (compact) {
+                        fprintf(fp, "        const uint64_t slot = size;\n");
+                } else {
+                        fprintf(fp, "        const uint64_t slot = UINT64_C(%" PRIu64 ");\n", from_offsets[i]);
+                }
+                if (kind == convert_kind_number) {
+                        fprintf(fp, "        ");
+                        schema_convert_number_ctype(schema_convert_number_type(from, from_fields[i]->type), fp);
+                        fprintf(fp, " number;\n");
+                }
+                if (compact) {
+                        fprintf(fp, "        size += %" PRIu64 ";\n", schema_table_field_size(from, from_fields[i]));
+                }
+                from_field = from_fields[i];
+                to_field = to_fields[i];
+                if (kind == convert_kind_number) {
+                        fprintf(fp, "        memcpy(&number, buffer + slots + slot, sizeof(number));\n");
+                        fprintf(fp, "        rc |= %s_%s_%s_set(encoder, (", schema->namespace, pair->to->name, to_field->name);
+                        schema_convert_field_ctype(schema, to_field->type, fp);
+                        fprintf(fp, ") number);\n");
+                } else if (kind == convert_kind_string) {
+                        schema_generate_convert_child(from, pair->from, prefix, 0, 8, fp);
+                        fprintf(fp, "        rc |= %s_%s_%s_ncreate(encoder, %s_string_length(buffer, child), (const char *) buffer + child);\n", schema->namespace, pair->to->name, to_field->name, prefix);
+                } else if (kind == convert_kind_table) {
+                        schema_generate_convert_child(from, pair->from, prefix, 0, 8, fp);
+                        fprintf(fp, "        value = %s_convert_%s_to_%s_at(encoder, buffer, child);\n", schema->namespace, from_field->type, to_field->type);
+                        fprintf(fp, "        if (value == NULL) {\n");
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        rc |= %s_%s_%s_set(encoder, value);\n", schema->namespace, pair->to->name, to_field->name);
+                } else if (kind == convert_kind_union) {
+                        schema_generate_convert_child(from, pair->from, prefix, 1, 8, fp);
+                        fprintf(fp, "        switch (buffer[slots + slot]) {\n");
+                        b = 0;
+                        to_member = TAILQ_FIRST(&schema_type_get_table(schema, to_field->type)->fields);
+                        TAILQ_FOREACH(from_member, &schema_type_get_table(from, from_field->type)->fields, list) {
+                                if (to_member == NULL) {
+                                        break;
+                                }
+                                b += 1;
+                                fprintf(fp, "            case %" PRIu64 ":\n", b);
+                                fprintf(fp, "                value = %s_convert_%s_to_%s_at(encoder, buffer, child);\n", schema->namespace, from_member->type, to_member->type);
+                                fprintf(fp, "                if (value == NULL) {\n");
+                                fprintf(fp, "                    return -1;\n");
+                                fprintf(fp, "                }\n");
+                                fprintf(fp, "                rc |= %s_%s_%s_set(encoder, %s_%s_type_%s, value);\n", schema->namespace, pair->to->name, to_field->name, schema->namespace, to_field->type, to_member->name);
+                                fprintf(fp, "                break;\n");
+                                to_member = TAILQ_NEXT(to_member, list);
+                        }
+                        fprintf(fp, "            default:\n");
+                        fprintf(fp, "                break;\n");
+                        fprintf(fp, "        }\n");
+                } else if (kind == convert_kind_vector_values) {
+                        schema_generate_convert_child(from, pair->from, prefix, 0, 8, fp);
+                        fprintf(fp, "        rc |= %s_%s_%s_create(encoder, (const void *) (buffer + child + UINT64_C(%" PRIu64 ")), %s_count(buffer, child));\n", schema->namespace, pair->to->name, to_field->name, count_size, prefix);
+                } else {
+                        schema_generate_convert_child(from, pair->from, prefix, 0, 8, fp);
+                        fprintf(fp, "        n = %s_count(buffer, child);\n", prefix);
+                        fprintf(fp, "        rc |= %s_%s_%s_start(encoder);\n", schema->namespace, pair->to->name, to_field->name);
+                        fprintf(fp, "        for (i = 0; i < n; i++) {\n");
+                        if (kind == convert_kind_vector_number) {
+                                fprintf(fp, "            ");
+                                schema_convert_number_ctype(schema_convert_number_type(from, from_field->type), fp);
+                                fprintf(fp, " number;\n");
+                                fprintf(fp, "            memcpy(&number, buffer + child + UINT64_C(%" PRIu64 ") + i * sizeof(number), sizeof(number));\n", count_size);
+                                fprintf(fp, "            rc |= %s_%s_%s_push(encoder, (", schema->namespace, pair->to->name, to_field->name);
+                                schema_convert_field_ctype(schema, to_field->type, fp);
+                                fprintf(fp, ") number);\n");
+                        } else if (kind == convert_kind_vector_string) {
+                                fprintf(fp, "            element = %s_vector_at(buffer, child, i);\n", prefix);
+                                fprintf(fp, "            rc |= %s_%s_%s_push_ncreate(encoder, %s_string_length(buffer, element), (const char *) buffer + element);\n", schema->namespace, pair->to->name, to_field->name, prefix);
+                        } else {
+                                fprintf(fp, "            element = %s_vector_at(buffer, child, i);\n", prefix);
+                                fprintf(fp, "            value = %s_convert_%s_to_%s_at(encoder, buffer, element);\n", schema->namespace, from_field->type, to_field->type);
+                                fprintf(fp, "            if (value == NULL) {\n");
+                                fprintf(fp, "                return -1;\n");
+                                fprintf(fp, "            }\n");
+                                fprintf(fp, "            rc |= %s_%s_%s_push(encoder, value);\n", schema->namespace, pair->to->name, to_field->name);
+                        }
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        value = %s_%s_%s_end(encoder);\n", schema->namespace, pair->to->name, to_field->name);
+                        fprintf(fp, "        if (value == NULL) {\n");
+                        fprintf(fp, "            return -1;\n");
+                        fprintf(fp, "        }\n");
+                        fprintf(fp, "        rc |= %s_%s_%s_set(encoder, value);\n", schema->namespace, pair->to->name, to_field->name);
+                }
+                fprintf(fp, "    }\n");
+                i += 1;
+        }
+        fprintf(fp, "    return rc;\n");
+        fprintf(fp, "}\n");
 
-        fprintf(fp, "\n");
-        fprintf(fp, "#if !defined(%s_JSONIFY_STRING_EMITTER)\n", schema->NAMESPACE);
-        fprintf(fp, "#define %s_JSONIFY_STRING_EMITTER\n", schema->NAMESPACE);
-        fprintf(fp, "static inline int %s_jsonify_string_emitter (const char *str, int (*emitter) (void *context, const char *format, ...), void *context)\n", schema->namespace);
+out:
+        fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_convert_%s_to_%s_at (struct linearbuffers_encoder *encoder, const uint8_t *buffer, uint64_t position)\n", schema->namespace, pair->to->name, schema->namespace, pair->from->name, pair->to->name);
         fprintf(fp, "{\n");
         fprintf(fp, "    int rc;\n");
-        fprintf(fp, "    const char *ptr;\n");
-        fprintf(fp, "    if (str == NULL) {\n");
-        fprintf(fp, "        return emitter(context, \"\\\"\\\"\");\n");
+        fprintf(fp, "    rc = %s_%s_start(encoder);\n", schema->namespace, pair->to->name);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return NULL;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    for (ptr = str; *ptr; ptr++) {\n");
-        fprintf(fp, "        if (((*ptr > 0) && (*ptr < 32)) ||\n");
-        fprintf(fp, "            (*ptr == '\\\"') ||\n");
-        fprintf(fp, "            (*ptr == '\\\\')) {\n");
-        fprintf(fp, "            break;\n");
-        fprintf(fp, "        }\n");
+        fprintf(fp, "    rc = %s_convert_%s_to_%s_fields(encoder, buffer, position);\n", schema->namespace, pair->from->name, pair->to->name);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return NULL;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    if (*ptr == '\\0') {\n");
-        fprintf(fp, "        return emitter(context, \"\\\"%%s\\\"\", str);\n");
+        fprintf(fp, "    return %s_%s_end(encoder);\n", schema->namespace, pair->to->name);
+        fprintf(fp, "}\n");
+
+        fprintf(fp, "__attribute__((unused)) static inline int %s_convert_%s_to_%s (struct linearbuffers_encoder *encoder, const void *buffer, uint64_t length)\n", schema->namespace, pair->from->name, pair->to->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    int rc;\n");
+        fprintf(fp, "    uint64_t position;\n");
+        fprintf(fp, "    if (encoder == NULL ||\n");
+        fprintf(fp, "        buffer == NULL) {\n");
+        fprintf(fp, "        return -1;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    rc = emitter(context, \"\\\"\");\n");
-        fprintf(fp, "    if (rc < 0) {\n");
+        if (compact) {
+                fprintf(fp, "    if (length < UINT64_C(%" PRIu64 ")) {\n", schema_offset_type_size(from->offset_type));
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    position = %s_offset((const uint8_t *) buffer, 0);\n", prefix);
+        } else {
+                fprintf(fp, "    if (length < UINT64_C(%" PRIu64 ")) {\n", count_size);
+                fprintf(fp, "        return -1;\n");
+                fprintf(fp, "    }\n");
+                fprintf(fp, "    position = 0;\n");
+        }
+        fprintf(fp, "    rc = %s_%s_start(encoder);\n", schema->namespace, pair->to->name);
+        fprintf(fp, "    if (rc != 0) {\n");
         fprintf(fp, "        return rc;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    for (ptr = str; *ptr; ptr++) {\n");
-        fprintf(fp, "        if (*ptr == '\\\"') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\\\\"\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\\\') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\\\\\\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\b') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\b\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\f') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\f\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\n') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\n\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\r') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\r\");\n");
-        fprintf(fp, "        } else if (*ptr == '\\t') {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\t\");\n");
-        fprintf(fp, "        } else if (*ptr < 32) {\n");
-        fprintf(fp, "            rc = emitter(context, \"\\\\u%%04x\", *ptr);\n");
-        fprintf(fp, "        } else {\n");
-        fprintf(fp, "            rc = emitter(context, \"%%c\", *ptr);\n");
-        fprintf(fp, "        }\n");
-        fprintf(fp, "        if (rc < 0) {\n");
-        fprintf(fp, "           return rc;\n");
-        fprintf(fp, "        }\n");
-        fprintf(fp, "    }\n");
-        fprintf(fp, "    rc = emitter(context, \"\\\"\");\n");
-        fprintf(fp, "    if (rc < 0) {\n");
-        fprintf(fp, "       return rc;\n");
+        fprintf(fp, "    rc = %s_convert_%s_to_%s_fields(encoder, (const uint8_t *) buffer, position);\n", schema->namespace, pair->from->name, pair->to->name);
+        fprintf(fp, "    if (rc != 0) {\n");
+        fprintf(fp, "        return rc;\n");
         fprintf(fp, "    }\n");
-        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "    return %s_%s_finish(encoder);\n", schema->namespace, pair->to->name);
         fprintf(fp, "}\n");
-        fprintf(fp, "#endif\n");
 
-        TAILQ_FOREACH(table, &schema->tables, list) {
-                fprintf(fp, "\n");
-                fprintf(fp, "#if !defined(%s_%s_JSONIFY_API)\n", schema->NAMESPACE, table->name);
-                fprintf(fp, "#define %s_%s_JSONIFY_API\n", schema->NAMESPACE, table->name);
-                fprintf(fp, "\n");
+        free(from_fields);
+        free(to_fields);
+        free(from_offsets);
+        free(to_offsets);
+        free(kinds);
+        return 0;
+bail:   free(from_fields);
+        free(to_fields);
+        free(from_offsets);
+        free(to_offsets);
+        free(kinds);
+        return -1;
+}
 
-                namespace = namespace_create();
-                if (namespace == NULL) {
-                        linearbuffers_errorf("can not create namespace");
-                        goto bail;
+int schema_generate_c_convert (struct schema *schema, struct schema *from, FILE *fp)
+{
+        int rc;
+        char prefix[256];
+        struct convert_pair *pair;
+        struct convert_pairs pairs;
+        struct schema_table *table;
+        struct schema_table *from_root;
+        struct schema_table *to_root;
+
+        TAILQ_INIT(&pairs);
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (from == NULL) {
+                linearbuffers_errorf("from is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        from_root = NULL;
+        TAILQ_FOREACH(table, &from->tables, list) {
+                if (table->type == schema_container_type_none) {
+                        from_root = table;
                 }
-                rc = namespace_push(namespace, "%s_%s", schema->namespace, table->name);
+        }
+        to_root = NULL;
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_none) {
+                        to_root = table;
+                }
+        }
+        if (from_root == NULL ||
+            to_root == NULL) {
+                linearbuffers_errorf("schema has no tables");
+                goto bail;
+        }
+        rc = convert_pairs_push(&pairs, from_root, to_root);
+        if (rc != 0) {
+                goto bail;
+        }
+        TAILQ_FOREACH(table, &from->tables, list) {
+                if (table->type != schema_container_type_none ||
+                    !schema_type_is_table(schema, table->name)) {
+                        continue;
+                }
+                rc = convert_pairs_push(&pairs, table, schema_type_get_table(schema, table->name));
                 if (rc != 0) {
-                        linearbuffers_errorf("can not build namespace");
                         goto bail;
                 }
+        }
+        rc = schema_convert_pairs_close(schema, from, &pairs);
+        if (rc != 0) {
+                linearbuffers_errorf("can not match tables");
+                goto bail;
+        }
 
-                element = element_create();
-                if (element == NULL) {
-                        linearbuffers_errorf("can not create element");
-                        goto bail;
-                }
+        snprintf(prefix, sizeof(prefix), "%s_convert_%s", schema->namespace, from->namespace);
 
-                rc = schema_generate_jsonify_table(schema, table, table, namespace, element, fp);
+        fprintf(fp, "\n");
+        fprintf(fp, "#include <stddef.h>\n");
+        fprintf(fp, "#include <stdint.h>\n");
+        fprintf(fp, "#include <string.h>\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_CONVERT_%s_API)\n", schema->NAMESPACE, from->NAMESPACE);
+        fprintf(fp, "#define %s_CONVERT_%s_API\n", schema->NAMESPACE, from->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_count (const uint8_t *buffer, uint64_t position)\n", prefix);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t count;\n", schema_count_type_name(from->count_type));
+        fprintf(fp, "    memcpy(&count, buffer + position, sizeof(count));\n");
+        fprintf(fp, "    return count;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_offset (const uint8_t *buffer, uint64_t position)\n", prefix);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(from->offset_type));
+        fprintf(fp, "    memcpy(&offset, buffer + position, sizeof(offset));\n");
+        fprintf(fp, "    return offset;\n");
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_string_length (const uint8_t *buffer, uint64_t position)\n", prefix);
+        fprintf(fp, "{\n");
+        if (schema_string_is_prefixed(from)) {
+                fprintf(fp, "    return %s_count(buffer, position - UINT64_C(%" PRIu64 "));\n", prefix, schema_count_type_size(from->count_type));
+        } else {
+                fprintf(fp, "    return strlen((const char *) buffer + position);\n");
+        }
+        fprintf(fp, "}\n");
+        fprintf(fp, "__attribute__((unused)) static inline uint64_t %s_vector_at (const uint8_t *buffer, uint64_t position, uint64_t i)\n", prefix);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    uint64_t offset;\n");
+        fprintf(fp, "    offset = %s_offset(buffer, position + UINT64_C(%" PRIu64 "));\n", prefix, schema_count_type_size(from->count_type));
+        fprintf(fp, "    return position + (%s_t) (offset + %s_offset(buffer, position + offset + i * UINT64_C(%" PRIu64 ")));\n", schema_offset_type_name(from->offset_type), prefix, schema_offset_type_size(from->offset_type));
+        fprintf(fp, "}\n");
+
+        TAILQ_FOREACH(pair, &pairs, list) {
+                fprintf(fp, "__attribute__((unused)) static inline const struct %s_%s * %s_convert_%s_to_%s_at (struct linearbuffers_encoder *encoder, const uint8_t *buffer, uint64_t position);\n", schema->namespace, pair->to->name, schema->namespace, pair->from->name, pair->to->name);
+        }
+        TAILQ_FOREACH(pair, &pairs, list) {
+                rc = schema_generate_convert_table(schema, from, pair, fp);
                 if (rc != 0) {
-                        linearbuffers_errorf("can not generate jsonify for table: %s", table->name);
+                        linearbuffers_errorf("can not generate convert for table: %s", pair->from->name);
                         goto bail;
                 }
+        }
 
-                namespace_destroy(namespace);
-                element_destroy(element);
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
 
-                fprintf(fp, "\n");
-                fprintf(fp, "#endif\n");
+        convert_pairs_destroy(&pairs);
+        return 0;
+bail:   convert_pairs_destroy(&pairs);
+        return -1;
+}
+
+void * schema_reflect (struct schema *schema, uint64_t *length);
+
+int schema_generate_c_reflect (struct schema *schema, FILE *fp)
+{
+        uint64_t i;
+        uint64_t length;
+        uint8_t *buffer;
+
+        buffer = NULL;
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+        buffer = schema_reflect(schema, &length);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not reflect schema");
+                goto bail;
         }
 
-        return 0;
-bail:   if (namespace != NULL) {
-                namespace_destroy(namespace);
+        fprintf(fp, "\n");
+        fprintf(fp, "#include <stdint.h>\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#if !defined(%s_REFLECT_API)\n", schema->NAMESPACE);
+        fprintf(fp, "#define %s_REFLECT_API\n", schema->NAMESPACE);
+        fprintf(fp, "\n");
+        fprintf(fp, "__attribute__((unused)) static const uint64_t %s_reflect_length = UINT64_C(%" PRIu64 ");\n", schema->namespace, length);
+        fprintf(fp, "__attribute__((unused)) static const uint8_t %s_reflect[] __attribute__((aligned(8))) = {", schema->namespace);
+        for (i = 0; i < length; i++) {
+                fprintf(fp, "%s0x%02x,", (i % 16) ? " " : "\n    ", buffer[i]);
         }
-        if (element != NULL) {
-                element_destroy(element);
+        fprintf(fp, "\n");
+        fprintf(fp, "};\n");
+        fprintf(fp, "\n");
+        fprintf(fp, "#endif\n");
+
+        free(buffer);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
         }
         return -1;
 }
@@ -168,6 +168,165 @@ static int schema_generate_vector_encoder (struct schema *schema, const char *ty
 bail:   return -1;
 }
 
+static const char * schema_js_array_type (const char *type)
+{
+        if (strcmp(type, "int8") == 0) {                return "Int8Array";
+        } else if (strcmp(type, "int16") == 0) {        return "Int16Array";
+        } else if (strcmp(type, "int32") == 0) {        return "Int32Array";
+        } else if (strcmp(type, "int64") == 0) {        return "BigInt64Array";
+        } else if (strcmp(type, "uint8") == 0) {        return "Uint8Array";
+        } else if (strcmp(type, "uint16") == 0) {       return "Uint16Array";
+        } else if (strcmp(type, "uint32") == 0) {       return "Uint32Array";
+        } else if (strcmp(type, "uint64") == 0) {       return "BigUint64Array";
+        } else if (strcmp(type, "float") == 0) {        return "Float32Array";
+        } else if (strcmp(type, "double") == 0) {       return "Float64Array";
+        }
+        return NULL;
+}
+
+static int schema_generate_encoder_struct (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        uint64_t size;
+        const char *type;
+        const char *array;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "function %s_%s_encode (buffer, offset, value)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    var at;\n");
+
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                type = table_field->type;
+                if (schema_type_is_enum(schema, table_field->type)) {
+                        type = schema_type_get_enum(schema, table_field->type)->type;
+                }
+                if (schema_type_is_struct(schema, type)) {
+                        size = schema_struct_size(schema, type);
+                        array = NULL;
+                } else {
+                        size = schema_inttype_size(type);
+                        array = schema_js_array_type(type);
+                        if (array == NULL) {
+                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                                goto bail;
+                        }
+                }
+                if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "    for (at = 0; at < %" PRIu64 "; at++) {\n", table_field->length);
+                        if (array == NULL) {
+                                fprintf(fp, "        %s_%s_encode(buffer, offset + %" PRIu64 " + at * %" PRIu64 ", value.%s[at]);\n", schema->namespace, type, table_field_s, size, table_field->name);
+                        } else if (size == 8 && !schema_type_is_float(type)) {
+                                fprintf(fp, "        buffer.set(new Uint8Array(new %s([BigInt(value.%s[at])]).buffer), offset + %" PRIu64 " + at * %" PRIu64 ");\n", array, table_field->name, table_field_s, size);
+                        } else {
+                                fprintf(fp, "        buffer.set(new Uint8Array(new %s([value.%s[at]]).buffer), offset + %" PRIu64 " + at * %" PRIu64 ");\n", array, table_field->name, table_field_s, size);
+                        }
+                        fprintf(fp, "    }\n");
+                } else {
+                        if (array == NULL) {
+                                fprintf(fp, "    %s_%s_encode(buffer, offset + %" PRIu64 ", value.%s);\n", schema->namespace, type, table_field_s, table_field->name);
+                        } else if (size == 8 && !schema_type_is_float(type)) {
+                                fprintf(fp, "    buffer.set(new Uint8Array(new %s([BigInt(value.%s)]).buffer), offset + %" PRIu64 ");\n", array, table_field->name, table_field_s);
+                        } else {
+                                fprintf(fp, "    buffer.set(new Uint8Array(new %s([value.%s]).buffer), offset + %" PRIu64 ");\n", array, table_field->name, table_field_s);
+                        }
+                }
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        fprintf(fp, "    return 0;\n");
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
+static int schema_generate_decoder_struct (struct schema *schema, struct schema_table *table, FILE *fp)
+{
+        uint64_t size;
+        const char *type;
+        const char *array;
+        uint64_t table_field_s;
+        struct schema_table_field *table_field;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        fprintf(fp, "\n");
+        fprintf(fp, "function %s_%s_decode (buffer, offset)\n", schema->namespace, table->name);
+        fprintf(fp, "{\n");
+        fprintf(fp, "    var at;\n");
+        fprintf(fp, "    var value;\n");
+        fprintf(fp, "    value = new Object();\n");
+
+        table_field_s = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                type = table_field->type;
+                if (schema_type_is_enum(schema, table_field->type)) {
+                        type = schema_type_get_enum(schema, table_field->type)->type;
+                }
+                if (schema_type_is_struct(schema, type)) {
+                        size = schema_struct_size(schema, type);
+                        array = NULL;
+                } else {
+                        size = schema_inttype_size(type);
+                        array = schema_js_array_type(type);
+                        if (array == NULL) {
+                                linearbuffers_errorf("type is invalid: %s", table_field->type);
+                                goto bail;
+                        }
+                }
+                if (table_field->container == schema_container_type_array) {
+                        fprintf(fp, "    value.%s = new Array(%" PRIu64 ");\n", table_field->name, table_field->length);
+                        fprintf(fp, "    for (at = 0; at < %" PRIu64 "; at++) {\n", table_field->length);
+                        if (array == NULL) {
+                                fprintf(fp, "        value.%s[at] = %s_%s_decode(buffer, offset + %" PRIu64 " + at * %" PRIu64 ");\n", table_field->name, schema->namespace, type, table_field_s, size);
+                        } else {
+                                fprintf(fp, "        value.%s[at] = new %s(buffer.slice(offset + %" PRIu64 " + at * %" PRIu64 ", offset + %" PRIu64 " + at * %" PRIu64 " + %" PRIu64 "))[0];\n", table_field->name, array, table_field_s, size, table_field_s, size, size);
+                        }
+                        fprintf(fp, "    }\n");
+                } else {
+                        if (array == NULL) {
+                                fprintf(fp, "    value.%s = %s_%s_decode(buffer, offset + %" PRIu64 ");\n", table_field->name, schema->namespace, type, table_field_s);
+                        } else {
+                                fprintf(fp, "    value.%s = new %s(buffer.slice(offset + %" PRIu64 ", offset + %" PRIu64 " + %" PRIu64 "))[0];\n", table_field->name, array, table_field_s, table_field_s, size);
+                        }
+                }
+                table_field_s += schema_table_field_size(schema, table_field);
+        }
+
+        fprintf(fp, "    return value;\n");
+        fprintf(fp, "}\n");
+
+        return 0;
+bail:   return -1;
+}
+
 TAILQ_HEAD(element_entries, element_entry);
 struct element_entry {
         TAILQ_ENTRY(element_entry) list;
@@ -522,10 +681,18 @@ static int schema_generate_encoder_table_exports (struct schema *schema, struct
                                 fprintf(fp, "    %s_%s_%s_end : %s_%s_%s_end,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
                                 fprintf(fp, "    %s_%s_%s_cancel : %s_%s_%s_cancel,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
                                 fprintf(fp, "    %s_%s_%s_push : %s_%s_%s_push,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                linearbuffers_errorf("struct is not supported");
+                        } else if (schema_type_is_union(schema, table_field->type)) {
+                                linearbuffers_errorf("union is not supported");
                         } else {
                                 linearbuffers_errorf("type is invalid: %s", table_field->type);
                                 goto bail;
                         }
+                } else if (table_field->container == schema_container_type_array) {
+                        linearbuffers_errorf("array container is not supported");
+                } else if (table_field->container == schema_container_type_map) {
+                        linearbuffers_errorf("map container is not supported");
                 } else {
                         if (schema_type_is_scalar(table_field->type)) {
                                 fprintf(fp, "    %s_%s_%s_set : %s_%s_%s_set,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
@@ -538,6 +705,10 @@ static int schema_generate_encoder_table_exports (struct schema *schema, struct
                                 fprintf(fp, "    %s_%s_%s_set : %s_%s_%s_set,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
                         } else if (schema_type_is_table(schema, table_field->type)) {
                                 fprintf(fp, "    %s_%s_%s_set : %s_%s_%s_set.\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "    %s_%s_%s_set : %s_%s_%s_set,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                        } else if (schema_type_is_union(schema, table_field->type)) {
+                                linearbuffers_errorf("union is not supported");
                         } else {
                                 linearbuffers_errorf("type is invalid: %s", table_field->type);
                                 goto bail;
@@ -571,26 +742,18 @@ static int schema_generate_encoder_table (struct schema *schema, struct schema_t
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
+        if (schema_table_is_compact(schema, table)) {
+                linearbuffers_errorf("compact table layout is not supported: %s", table->name);
+                goto bail;
+        }
 
         table_field_s = 0;
         TAILQ_FOREACH(table_field, &table->fields, list) {
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else {
+                if (schema_table_field_size(schema, table_field) == 0) {
                         linearbuffers_errorf("type is invalid: %s", table_field->type);
                         goto bail;
                 }
-
+                table_field_s += schema_table_field_size(schema, table_field);
         }
 
         fprintf(fp, "\n");
@@ -616,6 +779,10 @@ static int schema_generate_encoder_table (struct schema *schema, struct schema_t
 
                 if (table_field->container == schema_container_type_vector) {
                         linearbuffers_errorf("vector container is not supported");
+                } else if (table_field->container == schema_container_type_array) {
+                        linearbuffers_errorf("array container is not supported");
+                } else if (table_field->container == schema_container_type_map) {
+                        linearbuffers_errorf("map container is not supported");
                 } else {
                         if (schema_type_is_scalar(table_field->type)) {
                                 fprintf(fp, "function %s_%s_%s_set (encoder, value)\n", schema->namespace, table->name, table_field->name);
@@ -651,25 +818,23 @@ static int schema_generate_encoder_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "{\n");
                                 fprintf(fp, "    return encoder.tableSetTable(%" PRIu64 ", %" PRIu64 ", (uint64_t) (ptrdiff_t) value);\n", table_field_i, table_field_s);
                                 fprintf(fp, "}\n");
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "function %s_%s_%s_set (encoder, value)\n", schema->namespace, table->name, table_field->name);
+                                fprintf(fp, "{\n");
+                                fprintf(fp, "    var buffer;\n");
+                                fprintf(fp, "    buffer = new Uint8Array(%" PRIu64 ");\n", schema_struct_size(schema, table_field->type));
+                                fprintf(fp, "    %s_%s_encode(buffer, 0, value);\n", schema->namespace, table_field->type);
+                                fprintf(fp, "    return encoder.tableSetStruct(%" PRIu64 ", %" PRIu64 ", buffer);\n", table_field_i, table_field_s);
+                                fprintf(fp, "}\n");
+                        } else if (schema_type_is_union(schema, table_field->type)) {
+                                linearbuffers_errorf("union is not supported");
                         } else {
                                 linearbuffers_errorf("type is invalid: %s", table_field->type);
                                 goto bail;
                         }
                 }
                 table_field_i += 1;
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                }
+                table_field_s += schema_table_field_size(schema, table_field);
         }
 
         fprintf(fp, "function %s_%s_end (encoder)\n", schema->namespace, table->name);
@@ -719,6 +884,10 @@ int schema_generate_js_encoder (struct schema *schema, FILE *fp, int encoder_inc
 
         if (encoder_include_library == 0) {
         }
+        if (schema_string_is_prefixed(schema)) {
+                linearbuffers_errorf("prefixed string layout is not supported");
+                goto bail;
+        }
 
         TAILQ_FOREACH(anum, &schema->enums, list) {
                 rc = schema_generate_enum(schema, anum, fp);
@@ -792,6 +961,21 @@ int schema_generate_js_encoder (struct schema *schema, FILE *fp, int encoder_inc
         }
 
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_struct) {
+                        continue;
+                }
+                rc = schema_generate_encoder_struct(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate encoder for struct: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct ||
+                    table->type == schema_container_type_union) {
+                        continue;
+                }
                 rc = schema_generate_encoder_table(schema, table, fp);
                 if (rc != 0) {
                         linearbuffers_errorf("can not generate decoder for table: %s", table->name);
@@ -809,6 +993,13 @@ int schema_generate_js_encoder (struct schema *schema, FILE *fp, int encoder_inc
                 }
         }
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct) {
+                        fprintf(fp, "    %s_%s_encode : %s_%s_encode,\n", schema->namespace, table->name, schema->namespace, table->name);
+                        continue;
+                }
+                if (table->type == schema_container_type_union) {
+                        continue;
+                }
                 rc = schema_generate_encoder_table_exports(schema, table, fp);
                 if (rc != 0) {
                         linearbuffers_errorf("can not generate decoder for table: %s", table->name);
@@ -856,6 +1047,10 @@ static int schema_generate_decoder_table_exports (struct schema *schema, struct
                         }
 
                         fprintf(fp, "    %s_%s_%s_get_at : %s_%s_%s_get_at,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
+                } else if (table_field->container == schema_container_type_array) {
+                        linearbuffers_errorf("array container is not supported");
+                } else if (table_field->container == schema_container_type_map) {
+                        linearbuffers_errorf("map container is not supported");
                 } else {
                         if (schema_type_is_string(table_field->type)) {
                                 fprintf(fp, "    %s_%s_%s_get_value : %s_%s_%s_get_value,\n", schema->namespace, table->name, table_field->name, schema->namespace, table->name, table_field->name);
@@ -885,6 +1080,10 @@ static int schema_generate_decoder_table (struct schema *schema, struct schema_t
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
+        if (schema_table_is_compact(schema, table)) {
+                linearbuffers_errorf("compact table layout is not supported: %s", table->name);
+                goto bail;
+        }
 
         fprintf(fp, "\n");
 
@@ -925,6 +1124,10 @@ static int schema_generate_decoder_table (struct schema *schema, struct schema_t
 
                 if (table_field->container == schema_container_type_vector) {
                         linearbuffers_errorf("container vector is not supported");
+                } else if (table_field->container == schema_container_type_array) {
+                        linearbuffers_errorf("array container is not supported");
+                } else if (table_field->container == schema_container_type_map) {
+                        linearbuffers_errorf("map container is not supported");
                 } else {
                         if (schema_type_is_scalar(table_field->type) ||
                             schema_type_is_float(table_field->type)) {
@@ -935,6 +1138,8 @@ static int schema_generate_decoder_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "function %s_%s_%s_get (decoder)\n", schema->namespace, table->name, table_field->name);
                         } else if (schema_type_is_table(schema, table_field->type)) {
                                 fprintf(fp, "const struct %s_%s * %s_%s_%s_get (decoder)\n", schema->namespace, table_field->type, schema->namespace, table->name, table_field->name);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "function %s_%s_%s_get (decoder)\n", schema->namespace, table->name, table_field->name);
                         }
                         fprintf(fp, "{\n");
                         fprintf(fp, "    var count;\n");
@@ -1023,6 +1228,8 @@ static int schema_generate_decoder_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "    %s_t offset;\n", schema_offset_type_name(schema->offset_type));
                                 fprintf(fp, "    offset = *(%s_t *) (((const uint8_t *) decoder) + %" PRIu64 " + Math.floor((count + 7) / 8) + %" PRIu64 ");\n", schema_offset_type_name(schema->offset_type), schema_count_type_size(schema->count_type), table_field_s);
                                 fprintf(fp, "    return (const struct %s_%s *) (((const uint8_t *) decoder) + offset);\n", schema->namespace, table_field->type);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                fprintf(fp, "    return %s_%s_decode(decoder.buffer, %" PRIu64 " + Math.floor((count + 7) / 8) + %" PRIu64 ");\n", schema->namespace, table_field->type, schema_count_type_size(schema->count_type), table_field_s);
                         }
                         fprintf(fp, "}\n");
 
@@ -1039,19 +1246,7 @@ static int schema_generate_decoder_table (struct schema *schema, struct schema_t
                         }
                 }
                 table_field_i += 1;
-                if (table_field->container == schema_container_type_vector) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_scalar(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_float(table_field->type)) {
-                        table_field_s += schema_inttype_size(table_field->type);
-                } else if (schema_type_is_string(table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                } else if (schema_type_is_enum(schema, table_field->type)) {
-                        table_field_s += schema_inttype_size(schema_type_get_enum(schema, table_field->type)->type);
-                } else if (schema_type_is_table(schema, table_field->type)) {
-                        table_field_s += schema_offset_type_size(schema->offset_type);
-                }
+                table_field_s += schema_table_field_size(schema, table_field);
         }
 
         return 0;
@@ -1075,6 +1270,10 @@ int schema_generate_js_decoder (struct schema *schema, FILE *fp, int decoder_use
                 linearbuffers_errorf("fp is invalid");
                 goto bail;
         }
+        if (schema_string_is_prefixed(schema)) {
+                linearbuffers_errorf("prefixed string layout is not supported");
+                goto bail;
+        }
 
         if (!TAILQ_EMPTY(&schema->enums)) {
                 TAILQ_FOREACH(anum, &schema->enums, list) {
@@ -1171,6 +1370,21 @@ int schema_generate_js_decoder (struct schema *schema, FILE *fp, int decoder_use
         }
 
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type != schema_container_type_struct) {
+                        continue;
+                }
+                rc = schema_generate_decoder_struct(schema, table, fp);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not generate decoder for struct: %s", table->name);
+                        goto bail;
+                }
+        }
+
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct ||
+                    table->type == schema_container_type_union) {
+                        continue;
+                }
                 rc = schema_generate_decoder_table(schema, table, fp);
                 if (rc != 0) {
                         linearbuffers_errorf("can not generate decoder for table: %s", table->name);
@@ -1188,6 +1402,13 @@ int schema_generate_js_decoder (struct schema *schema, FILE *fp, int decoder_use
                 }
         }
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct) {
+                        fprintf(fp, "    %s_%s_decode : %s_%s_decode,\n", schema->namespace, table->name, schema->namespace, table->name);
+                        continue;
+                }
+                if (table->type == schema_container_type_union) {
+                        continue;
+                }
                 rc = schema_generate_decoder_table_exports(schema, table, fp);
                 if (rc != 0) {
                         linearbuffers_errorf("can not generate decoder exports for table: %s", table->name);
@@ -1201,6 +1422,155 @@ int schema_generate_js_decoder (struct schema *schema, FILE *fp, int decoder_use
 bail:   return -1;
 }
 
+static int schema_generate_jsonify_array (struct schema *schema, struct schema_table *table, struct schema_table_field *table_field, struct namespace *namespace, const char *prefix, FILE *fp)
+{
+        const char *type;
+
+        type = table_field->type;
+        if (schema_type_is_enum(schema, table_field->type)) {
+                type = schema_type_get_enum(schema, table_field->type)->type;
+        }
+
+        fprintf(fp, "%s{\n", prefix);
+        fprintf(fp, "%s    %s_t at;\n", prefix, schema_count_type_name(schema->count_type));
+        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":[\");\n", prefix, table_field->name);
+        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+        fprintf(fp, "%s        goto bail;\n", prefix);
+        fprintf(fp, "%s    }\n", prefix);
+        fprintf(fp, "%s    for (at = 0; at < %s_%s_%s_get_count(%s); at++) {\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        if (schema_type_is_float(type)) {
+                fprintf(fp, "%s        rc = emitter(context, \"%%f%%s\", %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        } else if (strncmp(type, "int", 3) == 0) {
+                fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIi64 \"%%s\", (int64_t) %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        } else {
+                fprintf(fp, "%s        rc = emitter(context, \"%%\" PRIu64 \"%%s\", (uint64_t) %s_%s_%s_get_at(%s, at), ((at + 1) == %s_%s_%s_get_count(%s)) ? \"\" : \",\");\n", prefix, schema->namespace, table->name, table_field->name, namespace_linearized(namespace), schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+        }
+        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+        fprintf(fp, "%s            goto bail;\n", prefix);
+        fprintf(fp, "%s        }\n", prefix);
+        fprintf(fp, "%s    }\n", prefix);
+        fprintf(fp, "%s    rc = emitter(context, \"]\");\n", prefix);
+        fprintf(fp, "%s}\n", prefix);
+
+        return 0;
+}
+
+static int schema_generate_jsonify_struct (struct schema *schema, struct schema_table *table, struct namespace *namespace, const char *prefix, FILE *fp)
+{
+        int rc;
+        char *nprefix;
+        struct schema_table_field *table_field;
+
+        nprefix = NULL;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        if (fp == NULL) {
+                linearbuffers_errorf("fp is invalid");
+                goto bail;
+        }
+
+        nprefix = malloc(strlen(prefix) + 4 + 1);
+        if (nprefix == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memset(nprefix, ' ', strlen(prefix) + 4);
+        nprefix[strlen(prefix) + 4] = '\0';
+
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                fprintf(fp, "%s    rc = emitter(context, \"%s\");\n", prefix, prefix);
+                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                fprintf(fp, "%s        goto bail;\n", prefix);
+                fprintf(fp, "%s    }\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+                if (table_field->container == schema_container_type_array) {
+                        rc = schema_generate_jsonify_array(schema, table, table_field, namespace, prefix, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate jsonify for array: %s", table_field->name);
+                                goto bail;
+                        }
+                } else if (schema_type_is_scalar(table_field->type)) {
+                        if (strncmp(table_field->type, "int", 3) == 0) {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIi64 \"\", (int64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        } else {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIu64 \"\", (uint64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        }
+                } else if (schema_type_is_float(table_field->type)) {
+                        fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%f\", %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                } else if (schema_type_is_enum(schema, table_field->type)) {
+                        if (strncmp(schema_type_get_enum(schema, table_field->type)->type, "int", 3) == 0) {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIi64 \"\", (int64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        } else {
+                                fprintf(fp, "%src = emitter(context, \"\\\"%s\\\":%%\" PRIu64 \"\", (uint64_t) %s_%s_%s_get(%s));\n", prefix, table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        }
+                } else if (schema_type_is_struct(schema, table_field->type)) {
+                        fprintf(fp, "%s{\n", prefix);
+                        fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                        fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                        fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        namespace_push(namespace, "_%s", table_field->name);
+                        rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, nprefix, fp);
+                        if (rc != 0) {
+                                linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                goto bail;
+                        }
+                        namespace_pop(namespace);
+                        fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                        fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                        fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s            goto bail;\n", prefix);
+                        fprintf(fp, "%s        }\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                        fprintf(fp, "%s}\n", prefix);
+                } else {
+                        linearbuffers_errorf("type is invalid: %s", table_field->type);
+                        goto bail;
+                }
+                fprintf(fp, "%sif (rc < 0) {\n", prefix);
+                fprintf(fp, "%s    goto bail;\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+                if (table_field->list.tqe_next != NULL) {
+                        fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA) {\n", prefix);
+                        fprintf(fp, "%s    rc = emitter(context, \",\");\n", prefix);
+                        fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                        fprintf(fp, "%s        goto bail;\n", prefix);
+                        fprintf(fp, "%s    }\n", prefix);
+                        fprintf(fp, "%s}\n", prefix);
+                }
+                fprintf(fp, "%sif (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                fprintf(fp, "%s    rc = emitter(context, \"\\n\");\n", prefix);
+                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                fprintf(fp, "%s        goto bail;\n", prefix);
+                fprintf(fp, "%s    }\n", prefix);
+                fprintf(fp, "%s}\n", prefix);
+        }
+
+        free(nprefix);
+        return 0;
+bail:   if (nprefix != NULL) {
+                free(nprefix);
+        }
+        return -1;
+}
+
 static int schema_generate_jsonify_table (struct schema *schema, struct schema_table *head, struct schema_table *table, struct namespace *namespace, struct element *element, FILE *fp)
 {
         int rc;
@@ -1411,6 +1781,52 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "%s            }\n", prefix);
                                 fprintf(fp, "%s        }\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
+                        } else if (schema_type_is_struct(schema, table_field->type)) {
+                                char *sprefix;
+                                fprintf(fp, "%s        const struct %s_%s *%s_%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, table_field->type);
+                                fprintf(fp, "%s        %s_%s_%s = %s_%s_vector_get_at(%s_%s, at_%" PRIu64 ");\n", prefix, namespace_linearized(namespace), table_field->name, table_field->type, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name, element->nentries);
+                                fprintf(fp, "%s        rc = emitter(context, \"{\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                sprefix = malloc((prefix_count * 4) + 8 + 1);
+                                if (sprefix == NULL) {
+                                        linearbuffers_errorf("can not allocate memory");
+                                        goto bail;
+                                }
+                                memset(sprefix, ' ', (prefix_count * 4) + 8);
+                                sprefix[(prefix_count * 4) + 8] = '\0';
+                                namespace_push(namespace, "_%s_%s", table_field->name, table_field->type);
+                                rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, sprefix, fp);
+                                free(sprefix);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                        goto bail;
+                                }
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"%s    \");\n", prefix, prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"}%%s\", ((at_%" PRIu64 " + 1) == count) ? \"\" : \",\");\n", prefix, element->nentries);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s        if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s            rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s            if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s                goto bail;\n", prefix);
+                                fprintf(fp, "%s            }\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
                         } else {
                                 linearbuffers_errorf("type is invalid: %s", table_field->type);
                                 goto bail;
@@ -1425,6 +1841,10 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                         fprintf(fp, "%s    if (rc < 0) {\n", prefix);
                         fprintf(fp, "%s        goto bail;\n", prefix);
                         fprintf(fp, "%s    }\n", prefix);
+                } else if (table_field->container == schema_container_type_array) {
+                        linearbuffers_errorf("array container is not supported");
+                } else if (table_field->container == schema_container_type_map) {
+                        linearbuffers_errorf("map container is not supported");
                 } else {
                         if (schema_type_is_scalar(table_field->type) ||
                             schema_type_is_float(table_field->type) ||
@@ -1512,6 +1932,53 @@ static int schema_generate_jsonify_table (struct schema *schema, struct schema_t
                                 fprintf(fp, "%s        goto bail;\n", prefix);
                                 fprintf(fp, "%s    }\n", prefix);
                         }
+
+                        if (schema_type_is_struct(schema, table_field->type)) {
+                                char *sprefix;
+                                fprintf(fp, "%s    const struct %s_%s *%s_%s;\n", prefix, schema->namespace, table_field->type, namespace_linearized(namespace), table_field->name);
+                                fprintf(fp, "%s    %s_%s = %s_%s_%s_get(%s);\n", prefix, namespace_linearized(namespace), table_field->name, schema->namespace, table->name, table_field->name, namespace_linearized(namespace));
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"\\\"%s\\\":{\");\n", prefix, table_field->name);
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_LINE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"\\n\");\n", prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                sprefix = malloc((prefix_count * 4) + 4 + 1);
+                                if (sprefix == NULL) {
+                                        linearbuffers_errorf("can not allocate memory");
+                                        goto bail;
+                                }
+                                memset(sprefix, ' ', (prefix_count * 4) + 4);
+                                sprefix[(prefix_count * 4) + 4] = '\0';
+                                namespace_push(namespace, "_%s", table_field->name);
+                                rc = schema_generate_jsonify_struct(schema, schema_type_get_table(schema, table_field->type), namespace, sprefix, fp);
+                                free(sprefix);
+                                if (rc != 0) {
+                                        linearbuffers_errorf("can not generate jsonify for struct: %s", table_field->type);
+                                        goto bail;
+                                }
+                                namespace_pop(namespace);
+                                fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_SPACE) {\n", prefix);
+                                fprintf(fp, "%s        rc = emitter(context, \"%s\");\n", prefix, prefix);
+                                fprintf(fp, "%s        if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s            goto bail;\n", prefix);
+                                fprintf(fp, "%s        }\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                                fprintf(fp, "%s    rc = emitter(context, \"}\");\n", prefix);
+                                fprintf(fp, "%s    if (rc < 0) {\n", prefix);
+                                fprintf(fp, "%s        goto bail;\n", prefix);
+                                fprintf(fp, "%s    }\n", prefix);
+                        }
                 }
                 if (table_field->list.tqe_next != NULL) {
                         fprintf(fp, "%s    if (flags & LINEARBUFFERS_JSONIFY_FLAG_PRETTY_COMMA) {\n", prefix);
@@ -1731,6 +2198,10 @@ int schema_generate_js_jsonify (struct schema *schema, FILE *fp)
         fprintf(fp, "#endif\n");
 
         TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_struct ||
+                    table->type == schema_container_type_union) {
+                        continue;
+                }
                 fprintf(fp, "\n");
                 fprintf(fp, "#if !defined(%s_%s_JSONIFY_API)\n", schema->NAMESPACE, table->name);
                 fprintf(fp, "#define %s_%s_JSONIFY_API\n", schema->NAMESPACE, table->name);
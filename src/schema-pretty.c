@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <unistd.h>
 
 #include "debug.h"
@@ -56,14 +57,41 @@ int schema_generate_pretty (struct schema *schema, FILE *fp)
 
         TAILQ_FOREACH(table, &schema->tables, list) {
                 fprintf(fp, "\n");
+                if (table->type == schema_container_type_union) {
+                        fprintf(fp, "union %s {\n", table->name);
+                        TAILQ_FOREACH(table_field, &table->fields, list) {
+                                if (table_field->list.tqe_next != NULL) {
+                                        fprintf(fp, "\t%s,\n", table_field->name);
+                                } else {
+                                        fprintf(fp, "\t%s\n", table_field->name);
+                                }
+                        }
+                        fprintf(fp, "}\n");
+                        continue;
+                }
                 if (table->type == schema_container_type_struct) {
                         fprintf(fp, "struct %s {\n", table->name);
                 } else {
-                        fprintf(fp, "table %s {\n", table->name);
+                        fprintf(fp, "table %s", table->name);
+                        if (!TAILQ_EMPTY(&table->attributes)) {
+                                fprintf(fp, " (");
+                                TAILQ_FOREACH(attribute, &table->attributes, list) {
+                                        fprintf(fp, "%s%s", (TAILQ_FIRST(&table->attributes) == attribute) ? " " : ", ", attribute->name);
+                                        if (attribute->value != NULL) {
+                                                fprintf(fp, " = %s", attribute->value);
+                                        }
+                                }
+                                fprintf(fp, " )");
+                        }
+                        fprintf(fp, " {\n");
                 }
                 TAILQ_FOREACH(table_field, &table->fields, list) {
                         if (table_field->container == schema_container_type_none)  {
                                 fprintf(fp, "\t%s: %s", table_field->name, table_field->type);
+                        } else if (table_field->container == schema_container_type_array)  {
+                                fprintf(fp, "\t%s: [ %s: %" PRIu64 " ]", table_field->name, table_field->type, table_field->length);
+                        } else if (table_field->container == schema_container_type_map)  {
+                                fprintf(fp, "\t%s: { %s: %s }", table_field->name, table_field->key, table_field->type);
                         } else {
                                 fprintf(fp, "\t%s: [ %s ]", table_field->name, table_field->type);
                         }
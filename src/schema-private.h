@@ -35,7 +35,9 @@ struct schema_table_field {
         char *type;
         char *Type;
         char *value;
+        char *key;
         uint32_t container;
+        uint64_t length;
         struct schema_attributes attributes;
 };
 
@@ -53,6 +55,9 @@ struct schema {
         char *namespace;
         uint32_t count_type;
         uint32_t offset_type;
+        int elide_defaults;
+        uint32_t table_layout;
+        uint32_t string_layout;
         char *NAMESPACE;
         struct schema_enums enums;
         struct schema_tables tables;
@@ -0,0 +1,506 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <inttypes.h>
+
+#include "debug.h"
+#include "schema.h"
+#include "schema-private.h"
+#include "encoder.h"
+#include "reflect.h"
+#include "reflect-private.h"
+
+/*
+ * encodes the parsed schema as a reflect_schema message, see reflect.lbs.
+ * slot offsets and sizes are computed here once, so readers do not need
+ * to know the layout rules.
+ */
+
+#define SCHEMA_REFLECT_MAX_SEED         (UINT32_C(1) << 24)
+
+static int schema_reflect_type (struct schema *schema, const char *type, uint8_t *value, uint32_t *reference)
+{
+        uint32_t i;
+        struct schema_enum *anum;
+        struct schema_table *table;
+        static const char *scalars[] = {
+                [linearbuffers_reflect_type_int8]   = "int8",
+                [linearbuffers_reflect_type_int16]  = "int16",
+                [linearbuffers_reflect_type_int32]  = "int32",
+                [linearbuffers_reflect_type_int64]  = "int64",
+                [linearbuffers_reflect_type_uint8]  = "uint8",
+                [linearbuffers_reflect_type_uint16] = "uint16",
+                [linearbuffers_reflect_type_uint32] = "uint32",
+                [linearbuffers_reflect_type_uint64] = "uint64",
+                [linearbuffers_reflect_type_float]  = "float",
+                [linearbuffers_reflect_type_double] = "double",
+                [linearbuffers_reflect_type_string] = "string"
+        };
+        *value = linearbuffers_reflect_type_none;
+        *reference = UINT32_MAX;
+        if (type == NULL) {
+                return 0;
+        }
+        for (i = linearbuffers_reflect_type_int8; i <= linearbuffers_reflect_type_string; i++) {
+                if (strcmp(scalars[i], type) == 0) {
+                        *value = i;
+                        return 0;
+                }
+        }
+        i = 0;
+        TAILQ_FOREACH(anum, &schema->enums, list) {
+                if (strcmp(anum->name, type) == 0) {
+                        *value = linearbuffers_reflect_type_enum;
+                        *reference = i;
+                        return 0;
+                }
+                i += 1;
+        }
+        i = 0;
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (strcmp(table->name, type) == 0) {
+                        if (table->type == schema_container_type_struct) {
+                                *value = linearbuffers_reflect_type_struct;
+                        } else if (table->type == schema_container_type_union) {
+                                *value = linearbuffers_reflect_type_union;
+                        } else {
+                                *value = linearbuffers_reflect_type_table;
+                        }
+                        *reference = i;
+                        return 0;
+                }
+                i += 1;
+        }
+        linearbuffers_errorf("type is invalid: %s", type);
+        return -1;
+}
+
+static int schema_reflect_attribute (struct schema_attributes *attributes, const char *name)
+{
+        struct schema_attribute *attribute;
+        TAILQ_FOREACH(attribute, attributes, list) {
+                if (strcmp(attribute->name, name) == 0) {
+                        return (attribute->value == NULL ||
+                                strcmp(attribute->value, "1") == 0 ||
+                                strcmp(attribute->value, "yes") == 0 ||
+                                strcmp(attribute->value, "true") == 0);
+                }
+        }
+        return 0;
+}
+
+static int schema_reflect_hash (struct linearbuffers_encoder *encoder, const char **names, uint64_t nnames, uint64_t *seeds_offset, uint64_t *slots_offset)
+{
+        int rc;
+        uint64_t i;
+        uint64_t j;
+        uint64_t k;
+        uint64_t size;
+        uint32_t seed;
+        uint32_t *seeds;
+        uint32_t *slots;
+        uint32_t *counts;
+        uint32_t *buckets;
+        uint32_t *positions;
+        uint64_t *order;
+        uint8_t *taken;
+
+        seeds = NULL;
+        slots = NULL;
+        counts = NULL;
+        buckets = NULL;
+        positions = NULL;
+        order = NULL;
+        taken = NULL;
+
+        size = (nnames == 0) ? 1 : nnames;
+        seeds = calloc(size, sizeof(uint32_t));
+        slots = calloc(size, sizeof(uint32_t));
+        counts = calloc(size, sizeof(uint32_t));
+        buckets = calloc(size, sizeof(uint32_t));
+        positions = calloc(size, sizeof(uint32_t));
+        order = calloc(size, sizeof(uint64_t));
+        taken = calloc(size, sizeof(uint8_t));
+        if (seeds == NULL ||
+            slots == NULL ||
+            counts == NULL ||
+            buckets == NULL ||
+            positions == NULL ||
+            order == NULL ||
+            taken == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+
+        /* hash and displace: place the most crowded buckets first, each
+         * with the first seed moving all of its names to free slots */
+        for (i = 0; i < nnames; i++) {
+                buckets[i] = linearbuffers_reflect_hash(names[i], 0) % nnames;
+                counts[buckets[i]] += 1;
+                order[i] = i;
+        }
+        for (i = 1; i < nnames; i++) {
+                for (j = i; j > 0; j--) {
+                        if (counts[buckets[order[j - 1]]] > counts[buckets[order[j]]] ||
+                            (counts[buckets[order[j - 1]]] == counts[buckets[order[j]]] &&
+                             buckets[order[j - 1]] <= buckets[order[j]])) {
+                                break;
+                        }
+                        k = order[j - 1];
+                        order[j - 1] = order[j];
+                        order[j] = k;
+                }
+        }
+        for (i = 0; i < nnames; i += k) {
+                k = counts[buckets[order[i]]];
+                for (seed = 1; seed < SCHEMA_REFLECT_MAX_SEED; seed++) {
+                        for (j = 0; j < k; j++) {
+                                positions[j] = linearbuffers_reflect_hash(names[order[i + j]], seed) % nnames;
+                                if (taken[positions[j]]) {
+                                        break;
+                                }
+                                taken[positions[j]] = 1;
+                        }
+                        if (j == k) {
+                                break;
+                        }
+                        while (j-- > 0) {
+                                taken[positions[j]] = 0;
+                        }
+                }
+                if (seed == SCHEMA_REFLECT_MAX_SEED) {
+                        linearbuffers_errorf("can not find perfect hash for: %s", names[order[i]]);
+                        goto bail;
+                }
+                seeds[buckets[order[i]]] = seed;
+                for (j = 0; j < k; j++) {
+                        slots[positions[j]] = order[i + j];
+                }
+        }
+
+        rc = linearbuffers_encoder_vector_create_uint32(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, seeds_offset, seeds, nnames);
+        if (rc != 0) {
+                linearbuffers_errorf("can not create seeds");
+                goto bail;
+        }
+        rc = linearbuffers_encoder_vector_create_uint32(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, slots_offset, slots, nnames);
+        if (rc != 0) {
+                linearbuffers_errorf("can not create slots");
+                goto bail;
+        }
+
+        free(seeds);
+        free(slots);
+        free(counts);
+        free(buckets);
+        free(positions);
+        free(order);
+        free(taken);
+        return 0;
+bail:   free(seeds);
+        free(slots);
+        free(counts);
+        free(buckets);
+        free(positions);
+        free(order);
+        free(taken);
+        return -1;
+}
+
+static int schema_reflect_string (struct linearbuffers_encoder *encoder, uint64_t element, uint64_t offset, const char *value)
+{
+        int rc;
+        uint64_t string;
+        if (value == NULL) {
+                return 0;
+        }
+        rc = linearbuffers_encoder_string_create(encoder, &string, value);
+        if (rc != 0) {
+                return rc;
+        }
+        return linearbuffers_encoder_table_set_string(encoder, element, offset, string);
+}
+
+static int schema_reflect_enum (struct schema *schema, struct schema_enum *anum, struct linearbuffers_encoder *encoder, uint64_t *offset)
+{
+        int rc;
+        uint8_t type;
+        uint32_t reference;
+        uint64_t value;
+        struct schema_enum_field *anum_field;
+
+        rc = schema_reflect_type(schema, anum->type, &type, &reference);
+        if (rc != 0) {
+                return -1;
+        }
+        rc  = linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, REFLECT_ENUM);
+        rc |= schema_reflect_string(encoder, REFLECT_ENUM_NAME, anum->name);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_ENUM_TYPE, type);
+        rc |= linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32);
+        TAILQ_FOREACH(anum_field, &anum->fields, list) {
+                rc |= linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, REFLECT_ENUM_FIELD);
+                rc |= schema_reflect_string(encoder, REFLECT_ENUM_FIELD_NAME, anum_field->name);
+                rc |= linearbuffers_encoder_table_set_int64(encoder, REFLECT_ENUM_FIELD_VALUE, (*anum_field->value == '-') ? strtoll(anum_field->value, NULL, 0) : (int64_t) strtoull(anum_field->value, NULL, 0));
+                rc |= linearbuffers_encoder_table_end(encoder, &value);
+                rc |= linearbuffers_encoder_vector_push_table(encoder, value);
+        }
+        rc |= linearbuffers_encoder_vector_end_table(encoder, &value);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_ENUM_FIELDS, value);
+        rc |= linearbuffers_encoder_table_end(encoder, offset);
+        if (rc != 0) {
+                linearbuffers_errorf("can not encode enum: %s", anum->name);
+                return -1;
+        }
+        return 0;
+}
+
+static int schema_reflect_field (struct schema *schema, struct schema_table_field *table_field, uint64_t slot, struct linearbuffers_encoder *encoder, uint64_t *offset)
+{
+        int rc;
+        uint8_t type;
+        uint8_t key_type;
+        uint8_t flags;
+        uint32_t reference;
+        uint32_t key_reference;
+
+        rc  = schema_reflect_type(schema, table_field->type, &type, &reference);
+        rc |= schema_reflect_type(schema, table_field->key, &key_type, &key_reference);
+        if (rc != 0) {
+                linearbuffers_errorf("can not reflect field: %s", table_field->name);
+                return -1;
+        }
+        flags = 0;
+        if (schema_reflect_attribute(&table_field->attributes, "deprecated")) {
+                flags |= linearbuffers_reflect_flag_deprecated;
+        }
+        if (schema_table_field_is_key(table_field)) {
+                flags |= linearbuffers_reflect_flag_key;
+        }
+        if (schema_table_field_is_dictionary(table_field)) {
+                flags |= linearbuffers_reflect_flag_dictionary;
+        }
+
+        rc  = linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, REFLECT_FIELD);
+        rc |= schema_reflect_string(encoder, REFLECT_FIELD_NAME, table_field->name);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_FIELD_TYPE, type);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_FIELD_CONTAINER, table_field->container);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_FIELD_FLAGS, flags);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_FIELD_ENCODING, schema_table_field_encoding(table_field));
+        rc |= linearbuffers_encoder_table_set_uint32(encoder, REFLECT_FIELD_REFERENCE, reference);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_FIELD_KEY_TYPE, key_type);
+        rc |= linearbuffers_encoder_table_set_uint32(encoder, REFLECT_FIELD_KEY_REFERENCE, key_reference);
+        rc |= linearbuffers_encoder_table_set_uint64(encoder, REFLECT_FIELD_OFFSET, slot);
+        rc |= linearbuffers_encoder_table_set_uint64(encoder, REFLECT_FIELD_SIZE, schema_table_field_size(schema, table_field));
+        rc |= linearbuffers_encoder_table_set_uint64(encoder, REFLECT_FIELD_LENGTH, table_field->length);
+        rc |= schema_reflect_string(encoder, REFLECT_FIELD_VALUE, table_field->value);
+        rc |= linearbuffers_encoder_table_end(encoder, offset);
+        if (rc != 0) {
+                linearbuffers_errorf("can not encode field: %s", table_field->name);
+                return -1;
+        }
+        return 0;
+}
+
+static int schema_reflect_table (struct schema *schema, struct schema_table *table, struct linearbuffers_encoder *encoder, uint64_t *offset)
+{
+        int rc;
+        uint64_t i;
+        uint64_t slot;
+        uint64_t value;
+        uint64_t seeds;
+        uint64_t slots;
+        const char **names;
+        struct schema_table_field *table_field;
+
+        names = malloc(sizeof(const char *) * (table->nfields + 1));
+        if (names == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+
+        rc  = linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, REFLECT_TABLE);
+        rc |= schema_reflect_string(encoder, REFLECT_TABLE_NAME, table->name);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_TABLE_CONTAINER, table->type);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_TABLE_COMPACT, schema_table_is_compact(schema, table));
+        rc |= linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32);
+        if (rc != 0) {
+                goto bail;
+        }
+        i = 0;
+        slot = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                rc = schema_reflect_field(schema, table_field, slot, encoder, &value);
+                if (rc != 0) {
+                        goto bail;
+                }
+                rc = linearbuffers_encoder_vector_push_table(encoder, value);
+                if (rc != 0) {
+                        goto bail;
+                }
+                slot += schema_table_field_size(schema, table_field);
+                names[i++] = table_field->name;
+        }
+        rc  = linearbuffers_encoder_vector_end_table(encoder, &value);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_TABLE_FIELDS, value);
+        rc |= linearbuffers_encoder_table_set_uint64(encoder, REFLECT_TABLE_SIZE, slot);
+        rc |= schema_reflect_hash(encoder, names, i, &seeds, &slots);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_TABLE_SEEDS, seeds);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_TABLE_SLOTS, slots);
+        rc |= linearbuffers_encoder_table_end(encoder, offset);
+        if (rc != 0) {
+                goto bail;
+        }
+
+        free(names);
+        return 0;
+bail:   linearbuffers_errorf("can not encode table: %s", table->name);
+        free(names);
+        return -1;
+}
+
+void * schema_reflect (struct schema *schema, uint64_t *length)
+{
+        int rc;
+        uint64_t i;
+        uint64_t root;
+        uint64_t value;
+        uint64_t seeds;
+        uint64_t slots;
+        uint64_t ntables;
+        void *buffer;
+        const void *linearized;
+        const char **names;
+        struct schema_enum *anum;
+        struct schema_table *table;
+        struct linearbuffers_encoder *encoder;
+        enum linearbuffers_debug_level level;
+
+        names = NULL;
+        buffer = NULL;
+        encoder = NULL;
+
+        /* the encoder traces every emit at debug level */
+        level = linearbuffers_debug_level;
+        if (linearbuffers_debug_level > linearbuffers_debug_level_error) {
+                linearbuffers_debug_level = linearbuffers_debug_level_error;
+        }
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (length == NULL) {
+                linearbuffers_errorf("length is invalid");
+                goto bail;
+        }
+
+        root = UINT32_MAX;
+        ntables = 0;
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (table->type == schema_container_type_none) {
+                        root = ntables;
+                }
+                ntables += 1;
+        }
+        names = malloc(sizeof(const char *) * (ntables + 1));
+        if (names == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                linearbuffers_errorf("can not create encoder");
+                goto bail;
+        }
+
+        rc  = linearbuffers_encoder_table_start(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32, REFLECT_SCHEMA);
+        rc |= schema_reflect_string(encoder, REFLECT_SCHEMA_NAMESPACE, schema->namespace);
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_SCHEMA_COUNT_SIZE, schema_count_type_size(schema->count_type));
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_SCHEMA_OFFSET_SIZE, schema_offset_type_size(schema->offset_type));
+        rc |= linearbuffers_encoder_table_set_uint8(encoder, REFLECT_SCHEMA_STRING_LAYOUT, schema->string_layout);
+        rc |= linearbuffers_encoder_table_set_uint32(encoder, REFLECT_SCHEMA_ROOT, root);
+        if (rc != 0) {
+                linearbuffers_errorf("can not encode schema");
+                goto bail;
+        }
+
+        rc = linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32);
+        TAILQ_FOREACH(anum, &schema->enums, list) {
+                rc |= schema_reflect_enum(schema, anum, encoder, &value);
+                rc |= linearbuffers_encoder_vector_push_table(encoder, value);
+        }
+        rc |= linearbuffers_encoder_vector_end_table(encoder, &value);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_SCHEMA_ENUMS, value);
+        if (rc != 0) {
+                linearbuffers_errorf("can not encode enums");
+                goto bail;
+        }
+
+        i = 0;
+        rc = linearbuffers_encoder_vector_start_table(encoder, linearbuffers_encoder_count_type_uint32, linearbuffers_encoder_offset_type_uint32);
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                rc |= schema_reflect_table(schema, table, encoder, &value);
+                rc |= linearbuffers_encoder_vector_push_table(encoder, value);
+                names[i++] = table->name;
+        }
+        rc |= linearbuffers_encoder_vector_end_table(encoder, &value);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_SCHEMA_TABLES, value);
+        rc |= schema_reflect_hash(encoder, names, ntables, &seeds, &slots);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_SCHEMA_SEEDS, seeds);
+        rc |= linearbuffers_encoder_table_set_vector(encoder, REFLECT_SCHEMA_SLOTS, slots);
+        rc |= linearbuffers_encoder_table_end(encoder, NULL);
+        if (rc != 0) {
+                linearbuffers_errorf("can not encode tables");
+                goto bail;
+        }
+
+        linearized = linearbuffers_encoder_linearized(encoder, length);
+        if (linearized == NULL) {
+                linearbuffers_errorf("can not get linearized buffer");
+                goto bail;
+        }
+        buffer = malloc(*length);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not allocate memory");
+                goto bail;
+        }
+        memcpy(buffer, linearized, *length);
+
+        linearbuffers_encoder_destroy(encoder);
+        free(names);
+        linearbuffers_debug_level = level;
+        return buffer;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        if (names != NULL) {
+                free(names);
+        }
+        linearbuffers_debug_level = level;
+        return NULL;
+}
+
+int schema_generate_binary_reflect (struct schema *schema, FILE *fp)
+{
+        void *buffer;
+        uint64_t length;
+        buffer = schema_reflect(schema, &length);
+        if (buffer == NULL) {
+                linearbuffers_errorf("can not reflect schema");
+                goto bail;
+        }
+        if (fwrite(buffer, 1, length, fp) != length) {
+                linearbuffers_errorf("can not write reflection");
+                goto bail;
+        }
+        free(buffer);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
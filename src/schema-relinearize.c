@@ -0,0 +1,537 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "debug.h"
+#include "schema.h"
+#include "schema-private.h"
+#include "relinearize.h"
+
+/*
+ * runtime counterpart of the generated <namespace>_<table>_relinearize
+ * functions, walks a buffer using the parsed schema. unlike the generated
+ * walker the input is not assumed to be verified, every read is range
+ * checked.
+ */
+
+#define SCHEMA_RELINEARIZE_MAX_DEPTH    1024
+
+struct schema_relinearize {
+        struct schema *schema;
+        struct linearbuffers_relinearize *relinearize;
+        const uint8_t *buffer;
+        uint64_t length;
+        uint64_t count_size;
+        uint64_t offset_size;
+};
+
+static int64_t schema_relinearize_table (struct schema_relinearize *context, struct schema_table *table, uint64_t position, uint64_t depth);
+
+static int schema_relinearize_range (struct schema_relinearize *context, uint64_t position, uint64_t size)
+{
+        if (position > context->length || size > context->length - position) {
+                linearbuffers_errorf("buffer is truncated at: %" PRIu64 ", size: %" PRIu64 "", position, size);
+                return -1;
+        }
+        return 0;
+}
+
+static uint64_t schema_relinearize_read (struct schema_relinearize *context, uint64_t position, uint64_t size)
+{
+        uint8_t value8;
+        uint16_t value16;
+        uint32_t value32;
+        uint64_t value64;
+        switch (size) {
+                case sizeof(uint8_t):
+                        memcpy(&value8, context->buffer + position, sizeof(value8));
+                        return value8;
+                case sizeof(uint16_t):
+                        memcpy(&value16, context->buffer + position, sizeof(value16));
+                        return value16;
+                case sizeof(uint32_t):
+                        memcpy(&value32, context->buffer + position, sizeof(value32));
+                        return value32;
+        }
+        memcpy(&value64, context->buffer + position, sizeof(value64));
+        return value64;
+}
+
+static int schema_relinearize_write (struct schema_relinearize *context, int64_t object, uint64_t position, uint64_t value, uint64_t size)
+{
+        uint8_t value8;
+        uint16_t value16;
+        uint32_t value32;
+        switch (size) {
+                case sizeof(uint8_t):
+                        value8 = value;
+                        return linearbuffers_relinearize_write(context->relinearize, object, position, &value8, sizeof(value8));
+                case sizeof(uint16_t):
+                        value16 = value;
+                        return linearbuffers_relinearize_write(context->relinearize, object, position, &value16, sizeof(value16));
+                case sizeof(uint32_t):
+                        value32 = value;
+                        return linearbuffers_relinearize_write(context->relinearize, object, position, &value32, sizeof(value32));
+        }
+        return linearbuffers_relinearize_write(context->relinearize, object, position, &value, sizeof(value));
+}
+
+static int64_t schema_relinearize_block (struct schema_relinearize *context, uint64_t position, uint64_t size)
+{
+        int64_t object;
+        object = linearbuffers_relinearize_lookup(context->relinearize, position);
+        if (object >= 0) {
+                return object;
+        }
+        if (schema_relinearize_range(context, position, size) != 0) {
+                return -1;
+        }
+        return linearbuffers_relinearize_object(context->relinearize, position, context->buffer + position, size, size, 0);
+}
+
+static int64_t schema_relinearize_string (struct schema_relinearize *context, uint64_t position)
+{
+        int64_t object;
+        uint64_t size;
+        const uint8_t *end;
+        object = linearbuffers_relinearize_lookup(context->relinearize, position);
+        if (object >= 0) {
+                return object;
+        }
+        if (position >= context->length) {
+                linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        if (schema_string_is_prefixed(context->schema)) {
+                if (position < context->count_size) {
+                        linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+                size = schema_relinearize_read(context, position - context->count_size, context->count_size);
+                if (size >= context->length - position ||
+                    context->buffer[position + size] != 0) {
+                        linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+                size += context->count_size + 1;
+                return linearbuffers_relinearize_object(context->relinearize, position, context->buffer + position - context->count_size, size, size, context->count_size);
+        }
+        end = memchr(context->buffer + position, 0, context->length - position);
+        if (end == NULL) {
+                linearbuffers_errorf("string is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        size = end - (context->buffer + position) + 1;
+        return linearbuffers_relinearize_object(context->relinearize, position, context->buffer + position, size, size, 0);
+}
+
+static int64_t schema_relinearize_element (struct schema_relinearize *context, const char *type, uint64_t position, uint64_t depth)
+{
+        if (schema_type_is_string(type)) {
+                return schema_relinearize_string(context, position);
+        }
+        return schema_relinearize_table(context, schema_type_get_table(context->schema, type), position, depth);
+}
+
+static int64_t schema_relinearize_vector (struct schema_relinearize *context, const char *type, uint64_t position, uint64_t depth)
+{
+        int rc;
+        int64_t object;
+        int64_t target;
+        uint64_t i;
+        uint64_t mask;
+        uint64_t count;
+        uint64_t offset;
+        uint64_t element;
+        object = linearbuffers_relinearize_lookup(context->relinearize, position);
+        if (object >= 0) {
+                return object;
+        }
+        if (schema_relinearize_range(context, position, context->count_size) != 0) {
+                return -1;
+        }
+        count = schema_relinearize_read(context, position, context->count_size);
+        offset = 0;
+        if (count > 0) {
+                if (schema_relinearize_range(context, position + context->count_size, context->offset_size) != 0) {
+                        return -1;
+                }
+                offset = schema_relinearize_read(context, position + context->count_size, context->offset_size);
+                if (schema_relinearize_range(context, position, offset) != 0 ||
+                    count > (context->length - position - offset) / context->offset_size) {
+                        linearbuffers_errorf("vector is invalid at: %" PRIu64 "", position);
+                        return -1;
+                }
+        }
+        object = linearbuffers_relinearize_object(context->relinearize, position, context->buffer + position, context->count_size, context->count_size + context->offset_size + count * context->offset_size, 0);
+        if (object < 0) {
+                return -1;
+        }
+        rc = schema_relinearize_write(context, object, context->count_size, context->count_size + context->offset_size, context->offset_size);
+        if (rc != 0) {
+                return -1;
+        }
+        mask = (context->offset_size < sizeof(uint64_t)) ? ((UINT64_C(1) << (context->offset_size * 8)) - 1) : UINT64_MAX;
+        for (i = 0; i < count; i++) {
+                element = (offset + schema_relinearize_read(context, position + offset + i * context->offset_size, context->offset_size)) & mask;
+                if (schema_relinearize_range(context, position, element) != 0) {
+                        return -1;
+                }
+                target = schema_relinearize_element(context, type, position + element, depth);
+                if (target < 0) {
+                        return -1;
+                }
+                rc = linearbuffers_relinearize_reference(context->relinearize, object, context->count_size + context->offset_size + i * context->offset_size, context->offset_size, context->count_size + context->offset_size, linearbuffers_relinearize_direction_forward, target);
+                if (rc != 0) {
+                        return -1;
+                }
+        }
+        return object;
+}
+
+static int64_t schema_relinearize_map (struct schema_relinearize *context, struct schema_table_field *table_field, uint64_t position, uint64_t depth)
+{
+        int rc;
+        int64_t object;
+        int64_t target;
+        uint64_t i;
+        uint64_t size;
+        uint64_t slot;
+        uint64_t offset;
+        uint64_t count;
+        uint64_t capacity;
+        uint64_t key_size;
+        uint64_t value_size;
+        object = linearbuffers_relinearize_lookup(context->relinearize, position);
+        if (object >= 0) {
+                return object;
+        }
+        if (schema_relinearize_range(context, position, context->count_size * 2) != 0) {
+                return -1;
+        }
+        count = schema_relinearize_read(context, position, context->count_size);
+        capacity = schema_relinearize_read(context, position + context->count_size, context->count_size);
+        key_size = schema_map_part_size(context->schema, table_field->key);
+        value_size = schema_map_part_size(context->schema, table_field->type);
+        if (count > capacity ||
+            (capacity & (capacity - 1)) != 0 ||
+            capacity > context->length / (key_size + value_size)) {
+                linearbuffers_errorf("map is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        size = context->count_size * 2 + (capacity + 7) / 8 + capacity * (key_size + value_size);
+        object = schema_relinearize_block(context, position, size);
+        if (object < 0) {
+                return -1;
+        }
+        for (i = 0; i < capacity; i++) {
+                if (!(context->buffer[position + context->count_size * 2 + i / 8] & (1 << (i % 8)))) {
+                        continue;
+                }
+                if (schema_map_part_is_reference(context->schema, table_field->key)) {
+                        slot = context->count_size * 2 + (capacity + 7) / 8 + i * key_size;
+                        offset = schema_relinearize_read(context, position + slot, context->offset_size);
+                        if (offset > position) {
+                                linearbuffers_errorf("map is invalid at: %" PRIu64 "", position);
+                                return -1;
+                        }
+                        target = schema_relinearize_element(context, table_field->key, position - offset, depth);
+                        if (target < 0) {
+                                return -1;
+                        }
+                        rc = linearbuffers_relinearize_reference(context->relinearize, object, slot, context->offset_size, 0, linearbuffers_relinearize_direction_backward, target);
+                        if (rc != 0) {
+                                return -1;
+                        }
+                }
+                if (schema_map_part_is_reference(context->schema, table_field->type)) {
+                        slot = context->count_size * 2 + (capacity + 7) / 8 + capacity * key_size + i * value_size;
+                        offset = schema_relinearize_read(context, position + slot, context->offset_size);
+                        if (offset > position) {
+                                linearbuffers_errorf("map is invalid at: %" PRIu64 "", position);
+                                return -1;
+                        }
+                        target = schema_relinearize_element(context, table_field->type, position - offset, depth);
+                        if (target < 0) {
+                                return -1;
+                        }
+                        rc = linearbuffers_relinearize_reference(context->relinearize, object, slot, context->offset_size, 0, linearbuffers_relinearize_direction_backward, target);
+                        if (rc != 0) {
+                                return -1;
+                        }
+                }
+        }
+        return object;
+}
+
+static int64_t schema_relinearize_child (struct schema_relinearize *context, struct schema_table_field *table_field, uint64_t position, uint64_t depth)
+{
+        uint64_t size;
+        if (table_field->container == schema_container_type_map) {
+                return schema_relinearize_map(context, table_field, position, depth);
+        }
+        if (table_field->container != schema_container_type_vector) {
+                return schema_relinearize_element(context, table_field->type, position, depth);
+        }
+        if (schema_type_is_string(table_field->type) ||
+            (schema_type_is_table(context->schema, table_field->type) &&
+             schema_table_field_encoding(table_field) == schema_vector_encoding_none &&
+             !schema_table_field_is_dictionary(table_field))) {
+                return schema_relinearize_vector(context, table_field->type, position, depth);
+        }
+        if (schema_relinearize_range(context, position, context->count_size) != 0) {
+                return -1;
+        }
+        if (schema_table_field_encoding(table_field) != schema_vector_encoding_none ||
+            schema_table_field_is_dictionary(table_field)) {
+                size = 1;
+        } else if (schema_type_is_struct(context->schema, table_field->type)) {
+                size = schema_struct_size(context->schema, table_field->type);
+        } else if (schema_type_is_enum(context->schema, table_field->type)) {
+                size = schema_inttype_size(schema_type_get_enum(context->schema, table_field->type)->type);
+        } else {
+                size = schema_inttype_size(table_field->type);
+        }
+        if (schema_relinearize_read(context, position, context->count_size) > context->length / size) {
+                linearbuffers_errorf("vector is invalid at: %" PRIu64 "", position);
+                return -1;
+        }
+        return schema_relinearize_block(context, position, context->count_size + schema_relinearize_read(context, position, context->count_size) * size);
+}
+
+static uint64_t schema_relinearize_child_position (struct schema_relinearize *context, int compact, uint64_t position, uint64_t offset)
+{
+        if (compact) {
+                return (offset > position) ? context->length : position - offset;
+        }
+        return (offset > context->length - position) ? context->length : position + offset;
+}
+
+static int64_t schema_relinearize_table (struct schema_relinearize *context, struct schema_table *table, uint64_t position, uint64_t depth)
+{
+        int rc;
+        int compact;
+        int64_t object;
+        int64_t target;
+        uint64_t i;
+        uint64_t size;
+        uint64_t slot;
+        uint64_t slots;
+        uint64_t count;
+        uint64_t ncount;
+        uint64_t header;
+        uint64_t n;
+        uint64_t offset;
+        uint8_t last;
+        const uint8_t *present;
+        struct schema_table_field *table_field;
+        struct schema_table_field *union_field;
+        enum linearbuffers_relinearize_direction direction;
+
+        object = linearbuffers_relinearize_lookup(context->relinearize, position);
+        if (object >= 0) {
+                return object;
+        }
+        if (depth == 0) {
+                linearbuffers_errorf("table is too deep at: %" PRIu64 "", position);
+                return -1;
+        }
+        if (schema_relinearize_range(context, position, context->count_size) != 0) {
+                return -1;
+        }
+        count = schema_relinearize_read(context, position, context->count_size);
+        if (count / 8 > context->length ||
+            schema_relinearize_range(context, position + context->count_size, (count + 7) / 8) != 0) {
+                return -1;
+        }
+        compact = schema_table_is_compact(context->schema, table);
+        direction = (compact) ? linearbuffers_relinearize_direction_backward : linearbuffers_relinearize_direction_forward;
+        present = context->buffer + position + context->count_size;
+        slots = position + context->count_size + (count + 7) / 8;
+
+        i = 0;
+        ncount = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (i < count && (present[i / 8] & (1 << (i % 8)))) {
+                        ncount = i + 1;
+                }
+                i += 1;
+        }
+        i = 0;
+        size = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                if (i < ncount && (!compact || (present[i / 8] & (1 << (i % 8))))) {
+                        size += schema_table_field_size(context->schema, table_field);
+                }
+                i += 1;
+        }
+        if (schema_relinearize_range(context, slots, size) != 0) {
+                return -1;
+        }
+
+        header = context->count_size + (ncount + 7) / 8;
+        object = linearbuffers_relinearize_object(context->relinearize, position, NULL, 0, header + size, 0);
+        if (object < 0) {
+                return -1;
+        }
+        rc  = schema_relinearize_write(context, object, 0, ncount, context->count_size);
+        rc |= linearbuffers_relinearize_write(context->relinearize, object, context->count_size, present, ncount / 8);
+        if (ncount % 8 != 0) {
+                last = present[ncount / 8] & ((1 << (ncount % 8)) - 1);
+                rc |= linearbuffers_relinearize_write(context->relinearize, object, context->count_size + ncount / 8, &last, sizeof(last));
+        }
+        rc |= linearbuffers_relinearize_write(context->relinearize, object, header, context->buffer + slots, size);
+        if (rc != 0) {
+                return -1;
+        }
+
+        i = 0;
+        slot = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                size = schema_table_field_size(context->schema, table_field);
+                if (i >= ncount) {
+                        break;
+                }
+                if (!(present[i / 8] & (1 << (i % 8)))) {
+                        if (!compact) {
+                                slot += size;
+                        }
+                        i += 1;
+                        continue;
+                }
+                if (table_field->container == schema_container_type_array ||
+                    (table_field->container == schema_container_type_none &&
+                     !schema_type_is_string(table_field->type) &&
+                     !schema_type_is_table(context->schema, table_field->type) &&
+                     !schema_type_is_union(context->schema, table_field->type))) {
+                        slot += size;
+                        i += 1;
+                        continue;
+                }
+                if (table_field->container == schema_container_type_none &&
+                    schema_type_is_union(context->schema, table_field->type)) {
+                        union_field = NULL;
+                        if (context->buffer[slots + slot] != 0) {
+                                n = 1;
+                                TAILQ_FOREACH(union_field, &schema_type_get_table(context->schema, table_field->type)->fields, list) {
+                                        if (n++ == context->buffer[slots + slot]) {
+                                                break;
+                                        }
+                                }
+                                if (union_field == NULL) {
+                                        linearbuffers_errorf("union type is invalid at: %" PRIu64 "", slots + slot);
+                                        return -1;
+                                }
+                        }
+                        if (union_field != NULL) {
+                                offset = schema_relinearize_read(context, slots + slot + 1, context->offset_size);
+                                target = schema_relinearize_table(context, schema_type_get_table(context->schema, union_field->type), schema_relinearize_child_position(context, compact, position, offset), depth - 1);
+                                if (target < 0) {
+                                        return -1;
+                                }
+                                rc = linearbuffers_relinearize_reference(context->relinearize, object, header + slot + 1, context->offset_size, 0, direction, target);
+                                if (rc != 0) {
+                                        return -1;
+                                }
+                        }
+                } else {
+                        offset = schema_relinearize_read(context, slots + slot, context->offset_size);
+                        target = schema_relinearize_child(context, table_field, schema_relinearize_child_position(context, compact, position, offset), depth - 1);
+                        if (target < 0) {
+                                return -1;
+                        }
+                        rc = linearbuffers_relinearize_reference(context->relinearize, object, header + slot, context->offset_size, 0, direction, target);
+                        if (rc != 0) {
+                                return -1;
+                        }
+                }
+                slot += size;
+                i += 1;
+        }
+        return object;
+}
+
+int schema_relinearize (struct schema *schema, const char *root, struct linearbuffers_relinearize *relinearize, const void *buffer, uint64_t length)
+{
+        int rc;
+        int64_t table;
+        int64_t object;
+        struct schema_table *schema_table;
+        struct schema_relinearize context;
+
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (relinearize == NULL) {
+                linearbuffers_errorf("relinearize is invalid");
+                goto bail;
+        }
+        if (buffer == NULL) {
+                linearbuffers_errorf("buffer is invalid");
+                goto bail;
+        }
+
+        schema_table = NULL;
+        if (root != NULL) {
+                schema_table = schema_type_get_table(schema, root);
+        } else {
+                TAILQ_FOREACH(schema_table, &schema->tables, list) {
+                        if (schema_table->type == schema_container_type_none) {
+                                root = schema_table->name;
+                        }
+                }
+                schema_table = (root != NULL) ? schema_type_get_table(schema, root) : NULL;
+        }
+        if (schema_table == NULL ||
+            schema_table->type != schema_container_type_none) {
+                linearbuffers_errorf("root table is invalid: %s", (root == NULL) ? "(null)" : root);
+                goto bail;
+        }
+
+        memset(&context, 0, sizeof(struct schema_relinearize));
+        context.schema = schema;
+        context.relinearize = relinearize;
+        context.buffer = buffer;
+        context.length = length;
+        context.count_size = schema_count_type_size(schema->count_type);
+        context.offset_size = schema_offset_type_size(schema->offset_type);
+
+        if (schema_table_is_compact(schema, schema_table)) {
+                if (schema_relinearize_range(&context, 0, context.offset_size) != 0) {
+                        goto bail;
+                }
+                table = schema_relinearize_table(&context, schema_table, schema_relinearize_read(&context, 0, context.offset_size), SCHEMA_RELINEARIZE_MAX_DEPTH);
+                if (table < 0) {
+                        linearbuffers_errorf("can not relinearize table: %s", schema_table->name);
+                        goto bail;
+                }
+                object = linearbuffers_relinearize_object(relinearize, 0, NULL, 0, context.offset_size, 0);
+                if (object < 0) {
+                        linearbuffers_errorf("can not create root object");
+                        goto bail;
+                }
+                rc = linearbuffers_relinearize_reference(relinearize, object, 0, context.offset_size, 0, linearbuffers_relinearize_direction_forward, table);
+                if (rc != 0) {
+                        linearbuffers_errorf("can not create root reference");
+                        goto bail;
+                }
+        } else {
+                object = schema_relinearize_table(&context, schema_table, 0, SCHEMA_RELINEARIZE_MAX_DEPTH);
+                if (object < 0) {
+                        linearbuffers_errorf("can not relinearize table: %s", schema_table->name);
+                        goto bail;
+                }
+        }
+
+        rc = linearbuffers_relinearize_end(relinearize, object);
+        if (rc != 0) {
+                linearbuffers_errorf("can not end relinearize");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
@@ -134,6 +134,38 @@ uint64_t schema_offset_type_size (uint32_t type)
         return schema_offset_types[type].size;
 }
 
+static const struct {
+        const char *name;
+        uint32_t value;
+} schema_vector_encodings[] = {
+        [schema_vector_encoding_none]    = { "none"   , schema_vector_encoding_none    },
+        [schema_vector_encoding_bitpack] = { "bitpack", schema_vector_encoding_bitpack },
+        [schema_vector_encoding_for]     = { "for"    , schema_vector_encoding_for     },
+        [schema_vector_encoding_delta]   = { "delta"  , schema_vector_encoding_delta   }
+};
+
+const char * schema_vector_encoding_name (uint32_t encoding)
+{
+        if (encoding >= (sizeof(schema_vector_encodings) / sizeof(schema_vector_encodings[0]))) {
+                return "none";
+        }
+        return schema_vector_encodings[encoding].name;
+}
+
+uint32_t schema_vector_encoding_value (const char *encoding)
+{
+        uint64_t i;
+        if (encoding == NULL) {
+                return schema_vector_encoding_none;
+        }
+        for (i = 0; i < sizeof(schema_vector_encodings) / sizeof(schema_vector_encodings[0]); i++) {
+                if (strcmp(encoding, schema_vector_encodings[i].name) == 0) {
+                        return schema_vector_encodings[i].value;
+                }
+        }
+        return schema_vector_encoding_none;
+}
+
 uint64_t schema_inttype_size (const char *type)
 {
         if (type == NULL) {
@@ -291,12 +323,114 @@ int schema_type_is_table (struct schema *schema, const char *type)
         }
         TAILQ_FOREACH(table, &schema->tables, list) {
                 if (strcmp(table->name, type) == 0) {
-                        return 1;
+                        return (table->type == schema_container_type_none);
+                }
+        }
+        return 0;
+}
+
+int schema_type_is_struct (struct schema *schema, const char *type)
+{
+        struct schema_table *table;
+        if (schema == NULL) {
+                return 0;
+        }
+        if (type == NULL) {
+                return 0;
+        }
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (strcmp(table->name, type) == 0) {
+                        return (table->type == schema_container_type_struct);
+                }
+        }
+        return 0;
+}
+
+int schema_type_is_union (struct schema *schema, const char *type)
+{
+        struct schema_table *table;
+        if (schema == NULL) {
+                return 0;
+        }
+        if (type == NULL) {
+                return 0;
+        }
+        TAILQ_FOREACH(table, &schema->tables, list) {
+                if (strcmp(table->name, type) == 0) {
+                        return (table->type == schema_container_type_union);
                 }
         }
         return 0;
 }
 
+uint64_t schema_struct_size (struct schema *schema, const char *type)
+{
+        uint64_t size;
+        struct schema_table *table;
+        struct schema_table_field *table_field;
+        table = schema_type_get_table(schema, type);
+        if (table == NULL) {
+                return 0;
+        }
+        if (table->type != schema_container_type_struct) {
+                return 0;
+        }
+        size = 0;
+        TAILQ_FOREACH(table_field, &table->fields, list) {
+                size += schema_table_field_size(schema, table_field);
+        }
+        return size;
+}
+
+uint64_t schema_table_field_size (struct schema *schema, struct schema_table_field *field)
+{
+        uint64_t size;
+        if (schema == NULL) {
+                return 0;
+        }
+        if (field == NULL) {
+                return 0;
+        }
+        if (field->container == schema_container_type_vector ||
+            field->container == schema_container_type_map) {
+                return schema_offset_type_size(schema->offset_type);
+        } else if (schema_type_is_scalar(field->type)) {
+                size = schema_inttype_size(field->type);
+        } else if (schema_type_is_float(field->type)) {
+                size = schema_inttype_size(field->type);
+        } else if (schema_type_is_string(field->type)) {
+                size = schema_offset_type_size(schema->offset_type);
+        } else if (schema_type_is_enum(schema, field->type)) {
+                size = schema_inttype_size(schema_type_get_enum(schema, field->type)->type);
+        } else if (schema_type_is_table(schema, field->type)) {
+                size = schema_offset_type_size(schema->offset_type);
+        } else if (schema_type_is_struct(schema, field->type)) {
+                size = schema_struct_size(schema, field->type);
+        } else if (schema_type_is_union(schema, field->type)) {
+                size = sizeof(uint8_t) + schema_offset_type_size(schema->offset_type);
+        } else {
+                return 0;
+        }
+        if (field->container == schema_container_type_array) {
+                size *= field->length;
+        }
+        return size;
+}
+
+uint64_t schema_map_part_size (struct schema *schema, const char *type)
+{
+        if (schema_type_is_scalar(type) ||
+            schema_type_is_float(type)) {
+                return schema_inttype_size(type);
+        }
+        return schema_offset_type_size(schema->offset_type);
+}
+
+int schema_map_part_is_reference (struct schema *schema, const char *type)
+{
+        return schema_type_is_string(type) || schema_type_is_table(schema, type);
+}
+
 int schema_type_is_valid (struct schema *schema, const char *type)
 {
         int rc;
@@ -326,9 +460,122 @@ int schema_type_is_valid (struct schema *schema, const char *type)
         if (rc == 1) {
                 return 1;
         }
+        rc = schema_type_is_struct(schema, type);
+        if (rc == 1) {
+                return 1;
+        }
+        rc = schema_type_is_union(schema, type);
+        if (rc == 1) {
+                return 1;
+        }
         return 0;
 }
 
+int schema_table_is_compact (struct schema *schema, struct schema_table *table)
+{
+        struct schema_attribute *attribute;
+        if (schema == NULL) {
+                return 0;
+        }
+        if (table == NULL) {
+                return 0;
+        }
+        if (table->type != schema_container_type_none) {
+                return 0;
+        }
+        TAILQ_FOREACH(attribute, &table->attributes, list) {
+                if (strcmp(attribute->name, "compact") == 0) {
+                        if (attribute->value == NULL ||
+                            strcmp(attribute->value, "1") == 0 ||
+                            strcmp(attribute->value, "yes") == 0 ||
+                            strcmp(attribute->value, "true") == 0) {
+                                return 1;
+                        }
+                        return 0;
+                }
+        }
+        return (schema->table_layout == schema_table_layout_compact) ? 1 : 0;
+}
+
+int schema_string_is_prefixed (struct schema *schema)
+{
+        if (schema == NULL) {
+                return 0;
+        }
+        return (schema->string_layout == schema_string_layout_prefixed) ? 1 : 0;
+}
+
+uint32_t schema_table_field_encoding (struct schema_table_field *field)
+{
+        struct schema_attribute *attribute;
+        if (field == NULL) {
+                return schema_vector_encoding_none;
+        }
+        TAILQ_FOREACH(attribute, &field->attributes, list) {
+                if (strcmp(attribute->name, "encoding") == 0) {
+                        return schema_vector_encoding_value(attribute->value);
+                }
+        }
+        return schema_vector_encoding_none;
+}
+
+int schema_table_field_is_dictionary (struct schema_table_field *field)
+{
+        struct schema_attribute *attribute;
+        if (field == NULL) {
+                return 0;
+        }
+        TAILQ_FOREACH(attribute, &field->attributes, list) {
+                if (strcmp(attribute->name, "dictionary") == 0) {
+                        if (attribute->value == NULL ||
+                            strcmp(attribute->value, "1") == 0 ||
+                            strcmp(attribute->value, "yes") == 0 ||
+                            strcmp(attribute->value, "true") == 0) {
+                                return 1;
+                        }
+                        return 0;
+                }
+        }
+        return 0;
+}
+
+int schema_table_field_is_key (struct schema_table_field *field)
+{
+        struct schema_attribute *attribute;
+        if (field == NULL) {
+                return 0;
+        }
+        TAILQ_FOREACH(attribute, &field->attributes, list) {
+                if (strcmp(attribute->name, "key") == 0) {
+                        if (attribute->value == NULL ||
+                            strcmp(attribute->value, "1") == 0 ||
+                            strcmp(attribute->value, "yes") == 0 ||
+                            strcmp(attribute->value, "true") == 0) {
+                                return 1;
+                        }
+                        return 0;
+                }
+        }
+        return 0;
+}
+
+struct schema_table_field * schema_table_get_key (struct schema_table *table)
+{
+        struct schema_table_field *field;
+        if (table == NULL) {
+                return NULL;
+        }
+        if (table->type != schema_container_type_none) {
+                return NULL;
+        }
+        TAILQ_FOREACH(field, &table->fields, list) {
+                if (schema_table_field_is_key(field)) {
+                        return field;
+                }
+        }
+        return NULL;
+}
+
 int schema_value_is_scalar (const char *value)
 {
         int rc;
@@ -627,6 +874,46 @@ int schema_table_field_set_type (struct schema_table_field *field, uint32_t cont
 bail:   return -1;
 }
 
+int schema_table_field_set_length (struct schema_table_field *field, const char *length)
+{
+        if (field == NULL) {
+                linearbuffers_errorf("field is invalid");
+                goto bail;
+        }
+        if (length == NULL) {
+                linearbuffers_errorf("length is invalid");
+                goto bail;
+        }
+        if (!schema_value_is_scalar(length) || *length == '-') {
+                linearbuffers_errorf("length: %s is invalid", length);
+                goto bail;
+        }
+        field->length = strtoull(length, NULL, 0);
+        return 0;
+bail:   return -1;
+}
+
+int schema_table_field_set_key (struct schema_table_field *field, const char *key)
+{
+        if (field == NULL) {
+                linearbuffers_errorf("field is invalid");
+                goto bail;
+        }
+        if (field->key != NULL) {
+                free(field->key);
+                field->key = NULL;
+        }
+        if (key != NULL) {
+                field->key = strdup(key);
+                if (field->key == NULL) {
+                        linearbuffers_errorf("can not allocate memory");
+                        goto bail;
+                }
+        }
+        return 0;
+bail:   return -1;
+}
+
 int schema_table_field_set_name (struct schema_table_field *field, const char *name)
 {
         if (field == NULL) {
@@ -656,6 +943,37 @@ int schema_table_field_add_attribute (struct schema_table_field *field, const ch
                 linearbuffers_errorf("field is invalid");
                 goto bail;
         }
+        if (name != NULL &&
+            strcmp(name, "encoding") == 0) {
+                if (value == NULL ||
+                    (strcmp(value, "none") != 0 && schema_vector_encoding_value(value) == schema_vector_encoding_none)) {
+                        linearbuffers_errorf("encoding is invalid: %s", (value) ? value : "(null)");
+                        goto bail;
+                }
+                if (field->container != schema_container_type_vector ||
+                    !schema_type_is_scalar(field->type)) {
+                        linearbuffers_errorf("encoding is only supported for integer vectors: %s", field->name);
+                        goto bail;
+                }
+        }
+        if (name != NULL &&
+            strcmp(name, "dictionary") == 0) {
+                if (field->container != schema_container_type_vector ||
+                    !schema_type_is_string(field->type)) {
+                        linearbuffers_errorf("dictionary is only supported for string vectors: %s", field->name);
+                        goto bail;
+                }
+        }
+        if (name != NULL &&
+            strcmp(name, "key") == 0) {
+                if (field->container != schema_container_type_none ||
+                    !(schema_type_is_scalar(field->type) ||
+                      schema_type_is_float(field->type) ||
+                      schema_type_is_string(field->type))) {
+                        linearbuffers_errorf("key is only supported for scalar, float and string fields: %s", field->name);
+                        goto bail;
+                }
+        }
         attribute = schema_attribute_create(name, value);
         if (attribute == NULL) {
                 linearbuffers_errorf("can not create attribute");
@@ -688,6 +1006,9 @@ void schema_table_field_destroy (struct schema_table_field *field)
         if (field->value != NULL) {
                 free(field->value);
         }
+        if (field->key != NULL) {
+                free(field->key);
+        }
         TAILQ_FOREACH_SAFE(attribute, &field->attributes, list, nattribute) {
                 TAILQ_REMOVE(&field->attributes, attribute, list);
                 schema_attribute_destroy(attribute);
@@ -768,6 +1089,27 @@ int schema_table_add_field (struct schema_table *table, struct schema_table_fiel
 bail:   return -1;
 }
 
+int schema_table_add_attribute (struct schema_table *table, const char *name, const char *value)
+{
+        struct schema_attribute *attribute;
+        attribute = NULL;
+        if (table == NULL) {
+                linearbuffers_errorf("table is invalid");
+                goto bail;
+        }
+        attribute = schema_attribute_create(name, value);
+        if (attribute == NULL) {
+                linearbuffers_errorf("can not create attribute");
+                goto bail;
+        }
+        TAILQ_INSERT_TAIL(&table->attributes, attribute, list);
+        return 0;
+bail:   if (attribute != NULL) {
+                schema_attribute_destroy(attribute);
+        }
+        return -1;
+}
+
 void schema_table_destroy (struct schema_table *table)
 {
         struct schema_table_field *field;
@@ -883,6 +1225,76 @@ int schema_set_offset_type (struct schema *schema, const char *type)
 bail:   return -1;
 }
 
+int schema_set_elide_defaults (struct schema *schema, const char *value)
+{
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (value == NULL) {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        if (strcmp(value, "true") == 0 ||
+            strcmp(value, "yes") == 0 ||
+            strcmp(value, "1") == 0) {
+                schema->elide_defaults = 1;
+        } else if (strcmp(value, "false") == 0 ||
+                   strcmp(value, "no") == 0 ||
+                   strcmp(value, "0") == 0) {
+                schema->elide_defaults = 0;
+        } else {
+                linearbuffers_errorf("value is invalid");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
+
+int schema_set_table_layout (struct schema *schema, const char *layout)
+{
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (layout == NULL) {
+                linearbuffers_errorf("layout is invalid");
+                goto bail;
+        }
+        if (strcmp(layout, "default") == 0) {
+                schema->table_layout = schema_table_layout_default;
+        } else if (strcmp(layout, "compact") == 0) {
+                schema->table_layout = schema_table_layout_compact;
+        } else {
+                linearbuffers_errorf("layout is invalid");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
+
+int schema_set_string_layout (struct schema *schema, const char *layout)
+{
+        if (schema == NULL) {
+                linearbuffers_errorf("schema is invalid");
+                goto bail;
+        }
+        if (layout == NULL) {
+                linearbuffers_errorf("layout is invalid");
+                goto bail;
+        }
+        if (strcmp(layout, "terminated") == 0) {
+                schema->string_layout = schema_string_layout_terminated;
+        } else if (strcmp(layout, "prefixed") == 0) {
+                schema->string_layout = schema_string_layout_prefixed;
+        } else {
+                linearbuffers_errorf("layout is invalid");
+                goto bail;
+        }
+        return 0;
+bail:   return -1;
+}
+
 int schema_add_table (struct schema *schema, struct schema_table *table)
 {
         if (schema == NULL) {
@@ -1029,6 +1441,102 @@ static int schema_check (struct schema *schema)
                                 linearbuffers_errorf("schema table field type: %s is invalid", table_field->type);
                                 goto bail;
                         }
+                        if (schema_type_is_union(schema, table_field->type)) {
+                                if (table_field->container != schema_container_type_none) {
+                                        linearbuffers_errorf("schema table field: %s container is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (table_field->value != NULL) {
+                                        linearbuffers_errorf("schema table field: %s value is invalid", table_field->name);
+                                        goto bail;
+                                }
+                        }
+                        if (table_field->container == schema_container_type_array) {
+                                if (table_field->length == 0) {
+                                        linearbuffers_errorf("schema table field: %s length is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (table_field->value != NULL) {
+                                        linearbuffers_errorf("schema table field: %s value is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (!schema_type_is_scalar(table_field->type) &&
+                                    !schema_type_is_float(table_field->type) &&
+                                    !schema_type_is_enum(schema, table_field->type)) {
+                                        linearbuffers_errorf("schema table field: %s array type: %s is invalid", table_field->name, table_field->type);
+                                        goto bail;
+                                }
+                        }
+                        if (table_field->container == schema_container_type_map) {
+                                if (table_field->value != NULL) {
+                                        linearbuffers_errorf("schema table field: %s value is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (table_field->key == NULL ||
+                                    (!schema_type_is_scalar(table_field->key) &&
+                                     !schema_type_is_string(table_field->key))) {
+                                        linearbuffers_errorf("schema table field: %s map key type: %s is invalid", table_field->name, (table_field->key) ? table_field->key : "(null)");
+                                        goto bail;
+                                }
+                                if (!schema_type_is_scalar(table_field->type) &&
+                                    !schema_type_is_float(table_field->type) &&
+                                    !schema_type_is_string(table_field->type) &&
+                                    !schema_type_is_table(schema, table_field->type)) {
+                                        linearbuffers_errorf("schema table field: %s map value type: %s is invalid", table_field->name, table_field->type);
+                                        goto bail;
+                                }
+                        }
+                }
+                if (table->type == schema_container_type_union) {
+                        if (TAILQ_EMPTY(&table->fields)) {
+                                linearbuffers_errorf("schema union: %s is empty", table->name);
+                                goto bail;
+                        }
+                        if (table->nfields > UINT8_MAX) {
+                                linearbuffers_errorf("schema union: %s has too many fields", table->name);
+                                goto bail;
+                        }
+                        TAILQ_FOREACH(table_field, &table->fields, list) {
+                                if (!schema_type_is_table(schema, table_field->type)) {
+                                        linearbuffers_errorf("schema union field type: %s is invalid", table_field->type);
+                                        goto bail;
+                                }
+                        }
+                }
+                if (table->type == schema_container_type_struct) {
+                        if (TAILQ_EMPTY(&table->fields)) {
+                                linearbuffers_errorf("schema struct: %s is empty", table->name);
+                                goto bail;
+                        }
+                        TAILQ_FOREACH(table_field, &table->fields, list) {
+                                if (table_field->container == schema_container_type_vector ||
+                                    table_field->container == schema_container_type_map) {
+                                        linearbuffers_errorf("schema struct field: %s container is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (table_field->value != NULL) {
+                                        linearbuffers_errorf("schema struct field: %s value is invalid", table_field->name);
+                                        goto bail;
+                                }
+                                if (!schema_type_is_scalar(table_field->type) &&
+                                    !schema_type_is_float(table_field->type) &&
+                                    !schema_type_is_enum(schema, table_field->type) &&
+                                    !schema_type_is_struct(schema, table_field->type)) {
+                                        linearbuffers_errorf("schema struct field type: %s is invalid", table_field->type);
+                                        goto bail;
+                                }
+                                if (schema_type_is_struct(schema, table_field->type)) {
+                                        for (ntable = TAILQ_FIRST(&schema->tables); ntable && ntable != table; ntable = ntable->list.tqe_next) {
+                                                if (strcmp(ntable->name, table_field->type) == 0) {
+                                                        break;
+                                                }
+                                        }
+                                        if (ntable == NULL || ntable == table) {
+                                                linearbuffers_errorf("schema struct field type: %s must be declared before %s", table_field->type, table->name);
+                                                goto bail;
+                                        }
+                                }
+                        }
                 }
                 TAILQ_FOREACH(table_field, &table->fields, list) {
                         for (ntable_field = table_field->list.tqe_next; ntable_field; ntable_field = ntable_field->list.tqe_next) {
@@ -27,7 +27,27 @@ enum {
 enum {
         schema_container_type_none,
         schema_container_type_vector,
-        schema_container_type_struct
+        schema_container_type_struct,
+        schema_container_type_array,
+        schema_container_type_union,
+        schema_container_type_map
+};
+
+enum {
+        schema_table_layout_default,
+        schema_table_layout_compact
+};
+
+enum {
+        schema_string_layout_terminated,
+        schema_string_layout_prefixed
+};
+
+enum {
+        schema_vector_encoding_none,
+        schema_vector_encoding_bitpack,
+        schema_vector_encoding_for,
+        schema_vector_encoding_delta
 };
 
 int schema_enum_field_set_name (struct schema_enum_field *field, const char *name);
@@ -44,6 +64,8 @@ struct schema_enum * schema_enum_create (void);
 int schema_table_field_set_name (struct schema_table_field *field, const char *name);
 int schema_table_field_set_type (struct schema_table_field *field, uint32_t container, const char *type);
 int schema_table_field_set_value (struct schema_table_field *field, const char *value);
+int schema_table_field_set_length (struct schema_table_field *field, const char *length);
+int schema_table_field_set_key (struct schema_table_field *field, const char *key);
 int schema_table_field_add_attribute (struct schema_table_field *field, const char *name, const char *value);
 void schema_table_field_destroy (struct schema_table_field *field);
 struct schema_table_field * schema_table_field_create (void);
@@ -51,12 +73,16 @@ struct schema_table_field * schema_table_field_create (void);
 int schema_table_set_type (struct schema_table *table, uint32_t container);
 int schema_table_set_name (struct schema_table *table, const char *name);
 int schema_table_add_field (struct schema_table *table, struct schema_table_field *field);
+int schema_table_add_attribute (struct schema_table *table, const char *name, const char *value);
 void schema_table_destroy (struct schema_table *table);
 struct schema_table * schema_table_create (void);
 
 int schema_set_namespace (struct schema *schema, const char *name);
 int schema_set_count_type (struct schema *schema, const char *type);
 int schema_set_offset_type (struct schema *schema, const char *type);
+int schema_set_elide_defaults (struct schema *schema, const char *value);
+int schema_set_table_layout (struct schema *schema, const char *layout);
+int schema_set_string_layout (struct schema *schema, const char *layout);
 int schema_add_enum (struct schema *schema, struct schema_enum *anum);
 int schema_add_table (struct schema *schema, struct schema_table *table);
 void schema_destroy (struct schema *schema);
@@ -73,14 +99,30 @@ int schema_type_is_float (const char *type);
 int schema_type_is_string (const char *type);
 int schema_type_is_enum (struct schema *schema, const char *type);
 int schema_type_is_table (struct schema *schema, const char *type);
+int schema_type_is_struct (struct schema *schema, const char *type);
+int schema_type_is_union (struct schema *schema, const char *type);
 int schema_type_is_valid (struct schema *schema, const char *type);
+int schema_table_is_compact (struct schema *schema, struct schema_table *table);
+int schema_string_is_prefixed (struct schema *schema);
+uint32_t schema_table_field_encoding (struct schema_table_field *field);
+int schema_table_field_is_dictionary (struct schema_table_field *field);
+int schema_table_field_is_key (struct schema_table_field *field);
+struct schema_table_field * schema_table_get_key (struct schema_table *table);
 int schema_value_is_scalar (const char *value);
 
+uint64_t schema_struct_size (struct schema *schema, const char *type);
+uint64_t schema_table_field_size (struct schema *schema, struct schema_table_field *field);
+uint64_t schema_map_part_size (struct schema *schema, const char *type);
+int schema_map_part_is_reference (struct schema *schema, const char *type);
+
 const char * schema_count_type_name (uint32_t type);
 const char * schema_count_type_NAME (uint32_t type);
 uint32_t schema_count_type_value (const char *type);
 uint64_t schema_count_type_size (uint32_t type);
 
+const char * schema_vector_encoding_name (uint32_t encoding);
+uint32_t schema_vector_encoding_value (const char *encoding);
+
 const char * schema_offset_type_name (uint32_t type);
 const char * schema_offset_type_NAME (uint32_t type);
 uint32_t schema_offset_type_value (const char *type);
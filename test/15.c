@@ -9,6 +9,8 @@ int main (int argc, char *argv[])
 
         size_t i;
         uint8_t data[10];
+        struct linearbuffers_timeval timeval;
+        struct linearbuffers_timeval history[4];
 
         uint64_t linearized_length;
         const char *linearized_buffer;
@@ -23,6 +25,10 @@ int main (int argc, char *argv[])
         for (i = 0; i < sizeof(data) / sizeof(data[0]); i++) {
                 data[i] = rand();
         }
+        for (i = 0; i < sizeof(history) / sizeof(history[0]); i++) {
+                history[i].seconds = rand();
+                history[i].useconds = rand();
+        }
 
         encoder = linearbuffers_encoder_create(NULL);
         if (encoder == NULL) {
@@ -31,12 +37,12 @@ int main (int argc, char *argv[])
         }
 
         rc  = linearbuffers_output_start(encoder);
-        rc |= linearbuffers_timeval_start(encoder);
-        rc |= linearbuffers_timeval_seconds_set(encoder, 2);
-        rc |= linearbuffers_timeval_useconds_set(encoder, 3);
-        rc |= linearbuffers_output_timeval_set(encoder, linearbuffers_timeval_end(encoder));
+        timeval.seconds = 2;
+        timeval.useconds = 3;
+        rc |= linearbuffers_output_timeval_set(encoder, &timeval);
         rc |= linearbuffers_output_length_set(encoder, sizeof(data) / sizeof(data[0]));
         rc |= linearbuffers_output_data_set(encoder, (uintptr_t) data);
+        rc |= linearbuffers_output_history_create(encoder, history, sizeof(history) / sizeof(history[0]));
         rc |= linearbuffers_output_finish(encoder);
         if (rc != 0) {
                 fprintf(stderr, "can not encode output\n");
@@ -85,6 +91,25 @@ int main (int argc, char *argv[])
                 }
         }
 
+        if (linearbuffers_output_history_get_count(output) != sizeof(history) / sizeof(history[0])) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_history_get_count\n");
+                goto bail;
+        }
+        if (linearbuffers_output_history_get_length(output) != sizeof(history)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_history_get_length\n");
+                goto bail;
+        }
+        for (i = 0; i < linearbuffers_output_history_get_count(output); i++) {
+                if (linearbuffers_timeval_seconds_get(linearbuffers_output_history_get_at(output, i)) != history[i].seconds) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_history_get_at\n");
+                        goto bail;
+                }
+                if (linearbuffers_timeval_useconds_get(linearbuffers_output_history_get_at(output, i)) != history[i].useconds) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_history_get_at\n");
+                        goto bail;
+                }
+        }
+
         linearbuffers_encoder_destroy(encoder);
 
         return 0;
@@ -0,0 +1,130 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        size_t i;
+        uint8_t mac[6];
+        float matrix[16];
+        linearbuffers_kind_t kinds[3];
+        int16_t offsets[4];
+        struct linearbuffers_address address;
+
+        uint64_t linearized_length;
+        const char *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        srand(time(NULL));
+        for (i = 0; i < sizeof(mac) / sizeof(mac[0]); i++) {
+                mac[i] = rand();
+        }
+        for (i = 0; i < sizeof(matrix) / sizeof(matrix[0]); i++) {
+                matrix[i] = rand() / 1000.0f;
+        }
+        kinds[0] = linearbuffers_kind_ipv4;
+        kinds[1] = linearbuffers_kind_ipv6;
+        kinds[2] = linearbuffers_kind_none;
+        for (i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+                offsets[i] = -((int16_t) i * 100);
+        }
+        address.kind = linearbuffers_kind_ipv6;
+        for (i = 0; i < sizeof(address.value) / sizeof(address.value[0]); i++) {
+                address.value[i] = rand();
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_mac_set(encoder, mac);
+        rc |= linearbuffers_output_matrix_set(encoder, matrix);
+        rc |= linearbuffers_output_kinds_set(encoder, kinds);
+        rc |= linearbuffers_output_offsets_set(encoder, offsets);
+        rc |= linearbuffers_output_address_set(encoder, &address);
+        rc |= linearbuffers_output_length_set(encoder, sizeof(mac));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearbuffers_output_mac_get_count(output) != sizeof(mac) / sizeof(mac[0])) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_mac_get_count\n");
+                goto bail;
+        }
+        if (memcmp(linearbuffers_output_mac_get(output), mac, sizeof(mac)) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_mac_get\n");
+                goto bail;
+        }
+        for (i = 0; i < linearbuffers_output_matrix_get_count(output); i++) {
+                if (linearbuffers_output_matrix_get_at(output, i) != matrix[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_matrix_get_at\n");
+                        goto bail;
+                }
+        }
+        for (i = 0; i < linearbuffers_output_kinds_get_count(output); i++) {
+                if (linearbuffers_output_kinds_get_at(output, i) != kinds[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_kinds_get_at\n");
+                        goto bail;
+                }
+        }
+        for (i = 0; i < linearbuffers_output_offsets_get_count(output); i++) {
+                if (linearbuffers_output_offsets_get_at(output, i) != offsets[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_offsets_get_at\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_address_kind_get(linearbuffers_output_address_get(output)) != linearbuffers_kind_ipv6) {
+                fprintf(stderr, "decoder failed: linearbuffers_address_kind_get\n");
+                goto bail;
+        }
+        for (i = 0; i < linearbuffers_address_value_get_count(linearbuffers_output_address_get(output)); i++) {
+                if (linearbuffers_address_value_get_at(linearbuffers_output_address_get(output), i) != address.value[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_address_value_get_at\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_output_length_get(output) != sizeof(mac)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_length_get\n");
+                goto bail;
+        }
+        if (linearized_length != sizeof(uint32_t) + 1 + sizeof(mac) + sizeof(matrix) + sizeof(kinds) + sizeof(offsets) + sizeof(address) + sizeof(uint64_t)) {
+                fprintf(stderr, "encoder failed: linearized_length: %" PRIu64 "\n", linearized_length);
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
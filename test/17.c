@@ -0,0 +1,129 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        uint64_t linearized_length;
+        const char *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_record *record;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_key_start(encoder);
+        rc |= linearbuffers_key_code_set(encoder, 13);
+        rc |= linearbuffers_key_name_create(encoder, "enter");
+        rc |= linearbuffers_output_event_key_set(encoder, linearbuffers_key_end(encoder));
+        rc |= linearbuffers_output_records_start(encoder);
+        rc |= linearbuffers_record_start(encoder);
+        rc |= linearbuffers_record_timestamp_set(encoder, 2);
+        rc |= linearbuffers_click_start(encoder);
+        rc |= linearbuffers_click_x_set(encoder, 10);
+        rc |= linearbuffers_click_y_set(encoder, -20);
+        rc |= linearbuffers_record_event_click_set(encoder, linearbuffers_click_end(encoder));
+        rc |= linearbuffers_output_records_push(encoder, linearbuffers_record_end(encoder));
+        rc |= linearbuffers_record_start(encoder);
+        rc |= linearbuffers_record_timestamp_set(encoder, 3);
+        rc |= linearbuffers_scroll_start(encoder);
+        rc |= linearbuffers_scroll_delta_set(encoder, -3);
+        rc |= linearbuffers_record_event_set(encoder, linearbuffers_event_type_scroll, linearbuffers_scroll_end(encoder));
+        rc |= linearbuffers_output_records_push(encoder, linearbuffers_record_end(encoder));
+        rc |= linearbuffers_record_start(encoder);
+        rc |= linearbuffers_record_timestamp_set(encoder, 4);
+        rc |= linearbuffers_output_records_push(encoder, linearbuffers_record_end(encoder));
+        rc |= linearbuffers_output_records_set(encoder, linearbuffers_output_records_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearbuffers_output_event_get_type(output) != linearbuffers_event_type_key) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_event_get_type\n");
+                goto bail;
+        }
+        if (linearbuffers_output_event_click_get(output) != NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_event_click_get\n");
+                goto bail;
+        }
+        if (linearbuffers_key_code_get(linearbuffers_output_event_key_get(output)) != 13) {
+                fprintf(stderr, "decoder failed: linearbuffers_key_code_get\n");
+                goto bail;
+        }
+        if (strcmp(linearbuffers_key_name_get_value(linearbuffers_output_event_key_get(output)), "enter") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_key_name_get_value\n");
+                goto bail;
+        }
+        if (linearbuffers_output_records_get_count(output) != 3) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_records_get_count\n");
+                goto bail;
+        }
+
+        record = linearbuffers_output_records_get_at(output, 0);
+        switch (linearbuffers_record_event_get_type(record)) {
+                case linearbuffers_event_type_click:
+                        if (linearbuffers_click_x_get(linearbuffers_record_event_click_get(record)) != 10 ||
+                            linearbuffers_click_y_get(linearbuffers_record_event_click_get(record)) != -20) {
+                                fprintf(stderr, "decoder failed: linearbuffers_click_get\n");
+                                goto bail;
+                        }
+                        break;
+                default:
+                        fprintf(stderr, "decoder failed: linearbuffers_output_event_get_type\n");
+                        goto bail;
+        }
+
+        record = linearbuffers_output_records_get_at(output, 1);
+        if (linearbuffers_record_event_get_type(record) != linearbuffers_event_type_scroll) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_event_get_type\n");
+                goto bail;
+        }
+        if (linearbuffers_scroll_delta_get(linearbuffers_record_event_get(record)) != -3) {
+                fprintf(stderr, "decoder failed: linearbuffers_scroll_delta_get\n");
+                goto bail;
+        }
+
+        record = linearbuffers_output_records_get_at(output, 2);
+        if (linearbuffers_record_event_present(record) ||
+            linearbuffers_record_event_get_type(record) != linearbuffers_event_type_NONE ||
+            linearbuffers_record_event_get(record) != NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_event_present\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
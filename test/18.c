@@ -0,0 +1,184 @@
+
+#include <stdio.h>
+
+static int encode (struct linearbuffers_encoder *encoder, int8_t int8, uint16_t uint16, uint64_t uint64, float afloat, linearbuffers_anum_t anum, int32_t int32)
+{
+        int rc;
+        rc  = linearbuffers_encoder_reset(encoder, NULL);
+        rc |= linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_int8_set(encoder, int8);
+        rc |= linearbuffers_output_uint16_set(encoder, uint16);
+        rc |= linearbuffers_output_uint64_set(encoder, uint64);
+        rc |= linearbuffers_output_float_set(encoder, afloat);
+        rc |= linearbuffers_output_anum_set(encoder, anum);
+        rc |= linearbuffers_output_int32_set(encoder, int32);
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static int encode_reset (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        rc  = linearbuffers_encoder_reset(encoder, NULL);
+        rc |= linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_int8_set(encoder, -8);
+        rc |= linearbuffers_output_uint16_set(encoder, 1);
+        rc |= linearbuffers_output_uint64_set(encoder, 2);
+        rc |= linearbuffers_output_float_set(encoder, 2.5);
+        rc |= linearbuffers_output_anum_set(encoder, linearbuffers_anum_a);
+        rc |= linearbuffers_output_int32_set(encoder, 3);
+        rc |= linearbuffers_output_int8_set(encoder, -80);
+        rc |= linearbuffers_output_uint16_set(encoder, 16);
+        rc |= linearbuffers_output_uint64_set(encoder, 64);
+        rc |= linearbuffers_output_float_set(encoder, 1.5);
+        rc |= linearbuffers_output_anum_set(encoder, linearbuffers_anum_b);
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc = encode(encoder, -80, 16, 64, 1.5, linearbuffers_anum_b, 0);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearbuffers_output_int8_present(output) ||
+            linearbuffers_output_uint16_present(output) ||
+            linearbuffers_output_uint64_present(output) ||
+            linearbuffers_output_float_present(output) ||
+            linearbuffers_output_anum_present(output)) {
+                fprintf(stderr, "encoder failed: default value is present\n");
+                goto bail;
+        }
+        if (!linearbuffers_output_int32_present(output)) {
+                fprintf(stderr, "encoder failed: linearbuffers_output_int32_present\n");
+                goto bail;
+        }
+        if (linearbuffers_output_int8_get(output) != -80 ||
+            linearbuffers_output_uint16_get(output) != 16 ||
+            linearbuffers_output_uint64_get(output) != 64 ||
+            linearbuffers_output_float_get(output) != 1.5 ||
+            linearbuffers_output_anum_get(output) != linearbuffers_anum_b ||
+            linearbuffers_output_int32_get(output) != 0) {
+                fprintf(stderr, "decoder failed: default value mismatch\n");
+                goto bail;
+        }
+
+        rc = encode(encoder, -8, 1, 2, 2.5, linearbuffers_anum_a, 3);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (!linearbuffers_output_int8_present(output) ||
+            !linearbuffers_output_uint16_present(output) ||
+            !linearbuffers_output_uint64_present(output) ||
+            !linearbuffers_output_float_present(output) ||
+            !linearbuffers_output_anum_present(output) ||
+            !linearbuffers_output_int32_present(output)) {
+                fprintf(stderr, "encoder failed: value is not present\n");
+                goto bail;
+        }
+        if (linearbuffers_output_int8_get(output) != -8 ||
+            linearbuffers_output_uint16_get(output) != 1 ||
+            linearbuffers_output_uint64_get(output) != 2 ||
+            linearbuffers_output_float_get(output) != 2.5 ||
+            linearbuffers_output_anum_get(output) != linearbuffers_anum_a ||
+            linearbuffers_output_int32_get(output) != 3) {
+                fprintf(stderr, "decoder failed: value mismatch\n");
+                goto bail;
+        }
+
+        rc = encode_reset(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearbuffers_output_int8_present(output) ||
+            linearbuffers_output_uint16_present(output) ||
+            linearbuffers_output_uint64_present(output) ||
+            linearbuffers_output_float_present(output) ||
+            linearbuffers_output_anum_present(output)) {
+                fprintf(stderr, "encoder failed: reset value is present\n");
+                goto bail;
+        }
+        if (linearbuffers_output_int8_get(output) != -80 ||
+            linearbuffers_output_uint16_get(output) != 16 ||
+            linearbuffers_output_uint64_get(output) != 64 ||
+            linearbuffers_output_float_get(output) != 1.5 ||
+            linearbuffers_output_anum_get(output) != linearbuffers_anum_b ||
+            linearbuffers_output_int32_get(output) != 3) {
+                fprintf(stderr, "decoder failed: reset value mismatch\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
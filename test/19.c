@@ -0,0 +1,182 @@
+
+#include <stdio.h>
+#include <string.h>
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_sample *sample;
+
+        struct linearbuffers_point origin = { -1, 2 };
+        uint8_t mac[6] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+        uint32_t ids[3] = { 7, 8, 9 };
+
+        (void) argc;
+        (void) argv;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f00_set(encoder, 1);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+        if (linearized_length != sizeof(uint32_t) + sizeof(uint32_t) + (18 + 7) / 8 + sizeof(uint8_t)) {
+                fprintf(stderr, "encoder failed: compact table length: %" PRIu64 "\n", linearized_length);
+                goto bail;
+        }
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        if (linearbuffers_output_f00_get(output) != 1 ||
+            linearbuffers_output_f02_present(output) ||
+            linearbuffers_output_f17_get(output) != 17) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f00_get\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_encoder_reset(encoder, NULL);
+        rc |= linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f09_set(encoder, 0.9);
+        rc |= linearbuffers_output_f02_set(encoder, 2);
+        rc |= linearbuffers_output_name_create(encoder, "compact");
+        rc |= linearbuffers_output_origin_set(encoder, &origin);
+        rc |= linearbuffers_output_mac_set(encoder, mac);
+        rc |= linearbuffers_tag_start(encoder);
+        rc |= linearbuffers_tag_name_create(encoder, "tag");
+        rc |= linearbuffers_tag_value_set(encoder, 42);
+        rc |= linearbuffers_output_tag_set(encoder, linearbuffers_tag_end(encoder));
+        rc |= linearbuffers_output_samples_start(encoder);
+        for (i = 0; i < 2; i++) {
+                rc |= linearbuffers_sample_start(encoder);
+                rc |= linearbuffers_sample_value_set(encoder, i + 0.5);
+                rc |= linearbuffers_sample_id_set(encoder, i + 100);
+                rc |= linearbuffers_output_samples_push(encoder, linearbuffers_sample_end(encoder));
+        }
+        rc |= linearbuffers_output_samples_set(encoder, linearbuffers_output_samples_end(encoder));
+        rc |= linearbuffers_sample_start(encoder);
+        rc |= linearbuffers_sample_id_set(encoder, 200);
+        rc |= linearbuffers_output_payload_sample_set(encoder, linearbuffers_sample_end(encoder));
+        rc |= linearbuffers_output_ids_create(encoder, ids, 3);
+        rc |= linearbuffers_output_f07_set(encoder, -7);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearbuffers_output_f00_present(output) ||
+            linearbuffers_output_f01_present(output) ||
+            linearbuffers_output_f03_present(output)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f00_present\n");
+                goto bail;
+        }
+        if (linearbuffers_output_f02_get(output) != 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f02_get\n");
+                goto bail;
+        }
+        if (linearbuffers_output_f07_get(output) != -7) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f07_get\n");
+                goto bail;
+        }
+        if (linearbuffers_output_f09_get(output) != 0.9) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f09_get\n");
+                goto bail;
+        }
+        if (strcmp(linearbuffers_output_name_get_value(output), "compact") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_name_get_value\n");
+                goto bail;
+        }
+        if (linearbuffers_point_x_get(linearbuffers_output_origin_get(output)) != -1 ||
+            linearbuffers_point_y_get(linearbuffers_output_origin_get(output)) != 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_origin_get\n");
+                goto bail;
+        }
+        if (memcmp(linearbuffers_output_mac_get(output), mac, sizeof(mac)) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_mac_get\n");
+                goto bail;
+        }
+        if (strcmp(linearbuffers_tag_name_get_value(linearbuffers_output_tag_get(output)), "tag") != 0 ||
+            linearbuffers_tag_value_get(linearbuffers_output_tag_get(output)) != 42) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_tag_get\n");
+                goto bail;
+        }
+        if (linearbuffers_output_samples_get_count(output) != 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_samples_get_count\n");
+                goto bail;
+        }
+        for (i = 0; i < 2; i++) {
+                sample = linearbuffers_output_samples_get_at(output, i);
+                if (linearbuffers_sample_id_get(sample) != i + 100 ||
+                    linearbuffers_sample_value_get(sample) != i + 0.5) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_samples_get_at\n");
+                        goto bail;
+                }
+        }
+        sample = linearbuffers_output_payload_sample_get(output);
+        if (sample == NULL ||
+            linearbuffers_sample_id_get(sample) != 200 ||
+            linearbuffers_sample_value_present(sample)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_payload_sample_get\n");
+                goto bail;
+        }
+        if (linearbuffers_output_ids_get_count(output) != 3) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_ids_get_count\n");
+                goto bail;
+        }
+        for (i = 0; i < 3; i++) {
+                if (linearbuffers_output_ids_get_at(output, i) != ids[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_ids_get_at\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_output_f17_get(output) != 17) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_f17_get\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,222 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct sink_reference {
+        uint64_t offset;
+        const void *buffer;
+        int64_t length;
+};
+
+struct sink {
+        uint8_t *buffer;
+        uint64_t length;
+        uint64_t size;
+        uint64_t nreferences;
+        struct sink_reference references[8];
+};
+
+static int sink_reserve (struct sink *sink, uint64_t length)
+{
+        void *tmp;
+        if (sink->size >= length) {
+                return 0;
+        }
+        tmp = realloc(sink->buffer, length);
+        if (tmp == NULL) {
+                return -1;
+        }
+        memset(((uint8_t *) tmp) + sink->size, 0, length - sink->size);
+        sink->buffer = tmp;
+        sink->size = length;
+        return 0;
+}
+
+static int sink_function (void *context, uint64_t offset, const void *buffer, int64_t length)
+{
+        struct sink *sink = context;
+        if (length < 0) {
+                sink->length = offset + length;
+                return 0;
+        }
+        if (sink_reserve(sink, offset + length) != 0) {
+                return -1;
+        }
+        if (buffer == NULL) {
+                memset(sink->buffer + offset, 0, length);
+        } else {
+                memcpy(sink->buffer + offset, buffer, length);
+        }
+        if (sink->length < offset + length) {
+                sink->length = offset + length;
+        }
+        return 0;
+}
+
+static int sink_reference (void *context, uint64_t offset, const void *buffer, int64_t length)
+{
+        struct sink *sink = context;
+        if (sink->nreferences >= sizeof(sink->references) / sizeof(sink->references[0])) {
+                return -1;
+        }
+        if (sink_reserve(sink, offset + length) != 0) {
+                return -1;
+        }
+        if (sink->length < offset + length) {
+                sink->length = offset + length;
+        }
+        sink->references[sink->nreferences].offset = offset;
+        sink->references[sink->nreferences].buffer = buffer;
+        sink->references[sink->nreferences].length = length;
+        sink->nreferences += 1;
+        return 0;
+}
+
+static int encode (struct linearbuffers_encoder *encoder, const char *name, const uint8_t *payload, uint64_t npayload, const int8_t *small, uint64_t nsmall)
+{
+        int rc;
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_id_set(encoder, 42);
+        rc |= linearbuffers_output_name_reference(encoder, name);
+        rc |= linearbuffers_output_payload_reference(encoder, payload, npayload);
+        rc |= linearbuffers_output_small_reference(encoder, small, nsmall);
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static int check (const void *buffer, uint64_t length, const char *name, const uint8_t *payload, uint64_t npayload, const int8_t *small, uint64_t nsmall)
+{
+        uint64_t i;
+        const struct linearbuffers_output *output;
+        output = linearbuffers_output_decode(buffer, length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                return -1;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+        if (linearbuffers_output_id_get(output) != 42) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_id_get\n");
+                return -1;
+        }
+        if (strcmp(linearbuffers_output_name_get_value(output), name) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_name_get_value\n");
+                return -1;
+        }
+        if (linearbuffers_output_payload_get_count(output) != npayload) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_payload_get_count\n");
+                return -1;
+        }
+        for (i = 0; i < npayload; i++) {
+                if (linearbuffers_output_payload_get_at(output, i) != payload[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_payload_get_at\n");
+                        return -1;
+                }
+        }
+        if (linearbuffers_output_small_get_count(output) != nsmall) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_small_get_count\n");
+                return -1;
+        }
+        for (i = 0; i < nsmall; i++) {
+                if (linearbuffers_output_small_get_at(output, i) != small[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_small_get_at\n");
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct sink sink;
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_encoder_create_options options;
+
+        const char *name = "zero copy";
+        uint8_t payload[1024];
+        int8_t small[3] = { -1, 0, 1 };
+
+        (void) argc;
+        (void) argv;
+
+        for (i = 0; i < sizeof(payload); i++) {
+                payload[i] = i * 7;
+        }
+
+        memset(&sink, 0, sizeof(struct sink));
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder, name, payload, sizeof(payload), small, sizeof(small));
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+        rc = check(linearized_buffer, linearized_length, name, payload, sizeof(payload), small, sizeof(small));
+        if (rc != 0) {
+                goto bail;
+        }
+        linearbuffers_encoder_destroy(encoder);
+
+        memset(&options, 0, sizeof(struct linearbuffers_encoder_create_options));
+        options.emitter.function = sink_function;
+        options.emitter.reference = sink_reference;
+        options.emitter.context = &sink;
+        encoder = linearbuffers_encoder_create(&options);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder, name, payload, sizeof(payload), small, sizeof(small));
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        if (sink.nreferences != 3 ||
+            sink.references[0].buffer != name ||
+            sink.references[1].buffer != payload ||
+            sink.references[1].length != sizeof(payload) ||
+            sink.references[2].buffer != small) {
+                fprintf(stderr, "encoder failed: references are not recorded\n");
+                goto bail;
+        }
+        if (sink.length != linearized_length) {
+                fprintf(stderr, "encoder failed: length mismatch\n");
+                goto bail;
+        }
+        for (i = 0; i < sink.nreferences; i++) {
+                memcpy(sink.buffer + sink.references[i].offset, sink.references[i].buffer, sink.references[i].length);
+        }
+        rc = check(sink.buffer, sink.length, name, payload, sizeof(payload), small, sizeof(small));
+        if (rc != 0) {
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        free(sink.buffer);
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        if (sink.buffer != NULL) {
+                free(sink.buffer);
+        }
+        return -1;
+}
@@ -0,0 +1,189 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <linearbuffers/compress.h>
+
+#define NSAMPLES        256
+
+static int check (const void *buffer, uint64_t length)
+{
+        uint64_t i;
+        char name[64];
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_sample *sample;
+        output = linearbuffers_output_decode(buffer, length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                return -1;
+        }
+        if (linearbuffers_output_samples_get_count(output) != NSAMPLES) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_samples_get_count\n");
+                return -1;
+        }
+        for (i = 0; i < NSAMPLES; i++) {
+                sample = linearbuffers_output_samples_get_at(output, i);
+                snprintf(name, sizeof(name), "sample-%" PRIu64 "", i);
+                if (linearbuffers_sample_id_get(sample) != i ||
+                    strcmp(linearbuffers_sample_name_get_value(sample), name) != 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_samples_get_at\n");
+                        return -1;
+                }
+        }
+        if (linearbuffers_output_values_get_count(output) != NSAMPLES) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_values_get_count\n");
+                return -1;
+        }
+        for (i = 0; i < NSAMPLES; i++) {
+                if (linearbuffers_output_values_get_at(output, i) != i % 7) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_values_get_at\n");
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t l;
+        char name[64];
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        void *compressed_buffer;
+        uint64_t compressed_length;
+
+        uint8_t *decompressed_buffer;
+        uint64_t decompressed_length;
+
+        const uint8_t *range;
+
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_compress_options compress_options;
+        struct linearbuffers_decompressor *decompressor;
+        struct linearbuffers_decompressor_create_options decompressor_options;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+        decompressor = NULL;
+        compressed_buffer = NULL;
+        decompressed_buffer = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_samples_start(encoder);
+        for (i = 0; i < NSAMPLES; i++) {
+                snprintf(name, sizeof(name), "sample-%" PRIu64 "", i);
+                rc |= linearbuffers_sample_start(encoder);
+                rc |= linearbuffers_sample_id_set(encoder, i);
+                rc |= linearbuffers_sample_name_create(encoder, name);
+                rc |= linearbuffers_output_samples_push(encoder, linearbuffers_sample_end(encoder));
+        }
+        rc |= linearbuffers_output_samples_set(encoder, linearbuffers_output_samples_end(encoder));
+        rc |= linearbuffers_output_values_start(encoder);
+        for (i = 0; i < NSAMPLES; i++) {
+                rc |= linearbuffers_output_values_push(encoder, i % 7);
+        }
+        rc |= linearbuffers_output_values_set(encoder, linearbuffers_output_values_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        memset(&compress_options, 0, sizeof(struct linearbuffers_compress_options));
+        compress_options.block_size = 256;
+        rc = linearbuffers_compress(linearized_buffer, linearized_length, &compress_options, &compressed_buffer, &compressed_length);
+        if (rc != 0) {
+                fprintf(stderr, "can not compress linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "compressed: %p, length: %" PRIu64 "\n", compressed_buffer, compressed_length);
+        if (compressed_length >= linearized_length) {
+                fprintf(stderr, "compress failed: length is not reduced\n");
+                goto bail;
+        }
+
+        memset(&decompressor_options, 0, sizeof(struct linearbuffers_decompressor_create_options));
+        decompressor_options.cache = 2;
+        decompressor = linearbuffers_decompressor_create(compressed_buffer, compressed_length, &decompressor_options);
+        if (decompressor == NULL) {
+                fprintf(stderr, "can not create decompressor\n");
+                goto bail;
+        }
+        if (linearbuffers_decompressor_length(decompressor) != linearized_length ||
+            linearbuffers_decompressor_block_count(decompressor) != (linearized_length + 255) / 256) {
+                fprintf(stderr, "decompressor failed: header mismatch\n");
+                goto bail;
+        }
+        for (i = 0; i < linearized_length; i += 97) {
+                l = (linearized_length - i < 300) ? linearized_length - i : 300;
+                range = linearbuffers_decompressor_range(decompressor, i, l);
+                if (range == NULL ||
+                    memcmp(range, linearized_buffer + i, l) != 0) {
+                        fprintf(stderr, "decompressor failed: linearbuffers_decompressor_range\n");
+                        goto bail;
+                }
+        }
+        range = linearbuffers_decompressor_range(decompressor, 0, linearized_length);
+        if (range == NULL) {
+                fprintf(stderr, "decompressor failed: linearbuffers_decompressor_range\n");
+                goto bail;
+        }
+        rc = check(range, linearized_length);
+        if (rc != 0) {
+                goto bail;
+        }
+
+        decompressed_buffer = linearbuffers_decompress(compressed_buffer, compressed_length, &decompressed_length);
+        if (decompressed_buffer == NULL) {
+                fprintf(stderr, "can not decompress buffer\n");
+                goto bail;
+        }
+        if (decompressed_length != linearized_length ||
+            memcmp(decompressed_buffer, linearized_buffer, linearized_length) != 0) {
+                fprintf(stderr, "decompress failed: buffer mismatch\n");
+                goto bail;
+        }
+        rc = check(decompressed_buffer, decompressed_length);
+        if (rc != 0) {
+                goto bail;
+        }
+
+        free(decompressed_buffer);
+        linearbuffers_decompressor_destroy(decompressor);
+        free(compressed_buffer);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (decompressed_buffer != NULL) {
+                free(decompressed_buffer);
+        }
+        if (decompressor != NULL) {
+                linearbuffers_decompressor_destroy(decompressor);
+        }
+        if (compressed_buffer != NULL) {
+                free(compressed_buffer);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
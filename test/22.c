@@ -0,0 +1,135 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NVALUES         1000
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        uint64_t timestamps[NVALUES];
+        int16_t levels[NVALUES];
+        uint32_t flags[NVALUES];
+        int32_t offsets[NVALUES];
+
+        uint64_t dtimestamps[NVALUES];
+        int16_t dlevels[NVALUES];
+        uint32_t dflags[NVALUES];
+        int32_t doffsets[NVALUES];
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        for (i = 0; i < NVALUES; i++) {
+                timestamps[i] = UINT64_C(1600000000000) + i * 1000 + (i % 3);
+                levels[i] = -300 + (int16_t) ((i * 37) % 600);
+                flags[i] = (i * 13) % 5;
+                offsets[i] = (i & 1) ? -((int32_t) i) : (int32_t) i;
+        }
+        offsets[7] = INT32_MIN;
+        offsets[8] = INT32_MAX;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_timestamps_create(encoder, timestamps, NVALUES);
+        rc |= linearbuffers_output_levels_create(encoder, levels, NVALUES);
+        rc |= linearbuffers_output_flags_create(encoder, flags, NVALUES);
+        rc |= linearbuffers_output_offsets_create(encoder, offsets, NVALUES);
+        rc |= linearbuffers_output_plain_create(encoder, timestamps, NVALUES);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearized_length >= 2 * sizeof(timestamps)) {
+                fprintf(stderr, "encoder failed: encoded vectors are not smaller\n");
+                goto bail;
+        }
+        if (linearbuffers_output_timestamps_get_count(output) != NVALUES ||
+            linearbuffers_output_levels_get_count(output) != NVALUES ||
+            linearbuffers_output_flags_get_count(output) != NVALUES ||
+            linearbuffers_output_offsets_get_count(output) != NVALUES) {
+                fprintf(stderr, "decoder failed: get_count\n");
+                goto bail;
+        }
+        for (i = 0; i < NVALUES; i++) {
+                if (linearbuffers_output_timestamps_get_at(output, i) != timestamps[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_timestamps_get_at\n");
+                        goto bail;
+                }
+                if (linearbuffers_output_levels_get_at(output, i) != levels[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_levels_get_at\n");
+                        goto bail;
+                }
+                if (linearbuffers_output_flags_get_at(output, i) != flags[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_flags_get_at\n");
+                        goto bail;
+                }
+                if (linearbuffers_output_offsets_get_at(output, i) != offsets[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_offsets_get_at\n");
+                        goto bail;
+                }
+                if (linearbuffers_output_plain_get_at(output, i) != timestamps[i]) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_plain_get_at\n");
+                        goto bail;
+                }
+        }
+
+        if (linearbuffers_output_timestamps_decode_values(output, dtimestamps, NVALUES) != NVALUES ||
+            linearbuffers_output_levels_decode_values(output, dlevels, NVALUES) != NVALUES ||
+            linearbuffers_output_flags_decode_values(output, dflags, NVALUES) != NVALUES ||
+            linearbuffers_output_offsets_decode_values(output, doffsets, NVALUES) != NVALUES) {
+                fprintf(stderr, "decoder failed: decode_values\n");
+                goto bail;
+        }
+        if (memcmp(dtimestamps, timestamps, sizeof(timestamps)) != 0 ||
+            memcmp(dlevels, levels, sizeof(levels)) != 0 ||
+            memcmp(dflags, flags, sizeof(flags)) != 0 ||
+            memcmp(doffsets, offsets, sizeof(offsets)) != 0) {
+                fprintf(stderr, "decoder failed: decode_values mismatch\n");
+                goto bail;
+        }
+        if (linearbuffers_output_timestamps_decode_values(output, dtimestamps, 130) != 130 ||
+            dtimestamps[129] != timestamps[129]) {
+                fprintf(stderr, "decoder failed: partial decode_values\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
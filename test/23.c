@@ -0,0 +1,131 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NVALUES         600
+
+static const char *statuses[] = {
+        "ok",
+        "not-found",
+        "error",
+};
+
+static const char *regions[] = {
+        "eu-west",
+        "eu-central",
+        "us-east",
+        "us-west",
+        "ap-south",
+};
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        int64_t found;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        const char *svalues[NVALUES];
+        const char *rvalues[NVALUES];
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        for (i = 0; i < NVALUES; i++) {
+                svalues[i] = statuses[(i * 7) % 3];
+                rvalues[i] = regions[(i * 3) % 5];
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_statuses_create(encoder, svalues, NVALUES);
+        rc |= linearbuffers_output_regions_create(encoder, rvalues, NVALUES);
+        rc |= linearbuffers_output_names_start(encoder);
+        for (i = 0; i < 5; i++) {
+                rc |= linearbuffers_output_names_push_create(encoder, regions[i]);
+        }
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_empty_create(encoder, NULL, 0);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (linearized_length >= 2 * NVALUES + 512) {
+                fprintf(stderr, "encoder failed: dictionary vectors are not smaller\n");
+                goto bail;
+        }
+        if (linearbuffers_output_statuses_get_count(output) != NVALUES ||
+            linearbuffers_output_regions_get_count(output) != NVALUES ||
+            linearbuffers_output_empty_get_count(output) != 0) {
+                fprintf(stderr, "decoder failed: get_count\n");
+                goto bail;
+        }
+        if (linearbuffers_output_statuses_get_dictionary_count(output) != 3 ||
+            linearbuffers_output_regions_get_dictionary_count(output) != 5 ||
+            linearbuffers_output_empty_get_dictionary_count(output) != 0) {
+                fprintf(stderr, "decoder failed: get_dictionary_count\n");
+                goto bail;
+        }
+        for (i = 0; i < NVALUES; i++) {
+                if (strcmp(linearbuffers_output_statuses_get_at(output, i), svalues[i]) != 0 ||
+                    strcmp(linearbuffers_output_regions_get_at(output, i), rvalues[i]) != 0) {
+                        fprintf(stderr, "decoder failed: get_at\n");
+                        goto bail;
+                }
+                if (strcmp(linearbuffers_output_regions_get_dictionary_at(output, linearbuffers_output_regions_get_index_at(output, i)), rvalues[i]) != 0) {
+                        fprintf(stderr, "decoder failed: get_index_at\n");
+                        goto bail;
+                }
+        }
+        found = linearbuffers_output_statuses_dictionary_find(output, "error");
+        if (found < 0) {
+                fprintf(stderr, "decoder failed: dictionary_find\n");
+                goto bail;
+        }
+        for (i = 0; i < NVALUES; i++) {
+                if ((linearbuffers_output_statuses_get_index_at(output, i) == found) != (strcmp(svalues[i], "error") == 0)) {
+                        fprintf(stderr, "decoder failed: index compare\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_output_statuses_dictionary_find(output, "unknown") != -1) {
+                fprintf(stderr, "decoder failed: dictionary_find\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,211 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NVALUES         300
+#define NKIDS           100
+
+static const char *statuses[] = {
+        "ok",
+        "not-found",
+        "error",
+};
+
+static int discard (void *context, const char *fmt, ...)
+{
+        (void) context;
+        (void) fmt;
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t l;
+        uint64_t invalid;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+        uint8_t *corrupted;
+
+        uint64_t timestamps[NVALUES];
+        const char *svalues[NVALUES];
+        linearbuffers_level_t levels[4] = { linearbuffers_level_debug, linearbuffers_level_info, linearbuffers_level_warning, linearbuffers_level_error };
+        struct linearbuffers_point point = { 1, -1 };
+
+        const struct linearbuffers_dag1 *dag1;
+        const struct linearbuffers_dag2 *dag2;
+        const struct linearbuffers_dag3 *dag3;
+        const struct linearbuffers_dag4 *dag4;
+
+        struct linearbuffers_encoder *encoder;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+        corrupted = NULL;
+
+        for (i = 0; i < NVALUES; i++) {
+                timestamps[i] = 1000000 + i * 3;
+                svalues[i] = statuses[(i * 7) % 3];
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_level_set(encoder, linearbuffers_level_warning);
+        rc |= linearbuffers_output_levels_create(encoder, levels, 4);
+        rc |= linearbuffers_output_name_create(encoder, "output");
+        rc |= linearbuffers_output_names_start(encoder);
+        for (i = 0; i < 3; i++) {
+                rc |= linearbuffers_output_names_push_create(encoder, statuses[i]);
+        }
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_children_start(encoder);
+        for (i = 0; i < 2; i++) {
+                rc |= linearbuffers_child_start(encoder);
+                rc |= linearbuffers_child_name_create(encoder, statuses[i]);
+                rc |= linearbuffers_child_origin_set(encoder, &point);
+                rc |= linearbuffers_meta_start(encoder);
+                rc |= linearbuffers_meta_level_set(encoder, linearbuffers_level_error);
+                rc |= linearbuffers_meta_note_create(encoder, "note");
+                rc |= linearbuffers_meta_tags_start(encoder);
+                rc |= linearbuffers_meta_tags_push_create(encoder, "a");
+                rc |= linearbuffers_meta_tags_push_create(encoder, "b");
+                rc |= linearbuffers_meta_tags_set(encoder, linearbuffers_meta_tags_end(encoder));
+                rc |= linearbuffers_child_meta_set(encoder, linearbuffers_meta_end(encoder));
+                rc |= linearbuffers_output_children_push(encoder, linearbuffers_child_end(encoder));
+        }
+        rc |= linearbuffers_output_children_set(encoder, linearbuffers_output_children_end(encoder));
+        rc |= linearbuffers_child_start(encoder);
+        rc |= linearbuffers_child_name_create(encoder, "payload");
+        rc |= linearbuffers_output_payload_child_set(encoder, linearbuffers_child_end(encoder));
+        rc |= linearbuffers_output_timestamps_create(encoder, timestamps, NVALUES);
+        rc |= linearbuffers_output_statuses_create(encoder, svalues, NVALUES);
+        rc |= linearbuffers_output_points_create(encoder, &point, 1);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        if (linearbuffers_output_verify(linearized_buffer, linearized_length, 8) != 0) {
+                fprintf(stderr, "verifier failed: valid buffer\n");
+                goto bail;
+        }
+        if (linearbuffers_output_verify(NULL, linearized_length, 8) == 0) {
+                fprintf(stderr, "verifier failed: null buffer\n");
+                goto bail;
+        }
+        if (linearbuffers_output_verify(linearized_buffer, linearized_length, 1) == 0) {
+                fprintf(stderr, "verifier failed: max depth\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(linearbuffers_output_decode(linearized_buffer, linearized_length), LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        corrupted = malloc(linearized_length);
+        if (corrupted == NULL) {
+                fprintf(stderr, "can not allocate memory\n");
+                goto bail;
+        }
+
+        for (l = 0; l < linearized_length; l++) {
+                memcpy(corrupted, linearized_buffer, l);
+                if (linearbuffers_output_verify(corrupted, l, 8) == 0) {
+                        fprintf(stderr, "verifier failed: truncated buffer, length: %" PRIu64 "\n", l);
+                        goto bail;
+                }
+        }
+
+        invalid = 0;
+        for (i = 0; i < linearized_length; i++) {
+                memcpy(corrupted, linearized_buffer, linearized_length);
+                corrupted[i] ^= 0xff;
+                if (linearbuffers_output_verify(corrupted, linearized_length, 8) != 0) {
+                        invalid += 1;
+                        continue;
+                }
+                linearbuffers_output_jsonify(linearbuffers_output_decode(corrupted, linearized_length), LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, discard, NULL);
+        }
+        fprintf(stderr, "corrupted: %" PRIu64 ", invalid: %" PRIu64 "\n", linearized_length, invalid);
+        if (invalid == 0) {
+                fprintf(stderr, "verifier failed: corrupted buffer\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc  = linearbuffers_dag0_start(encoder);
+        rc |= linearbuffers_dag0_kids_start(encoder);
+        rc |= linearbuffers_dag1_start(encoder);
+        rc |= linearbuffers_dag1_kids_start(encoder);
+        rc |= linearbuffers_dag2_start(encoder);
+        rc |= linearbuffers_dag2_kids_start(encoder);
+        rc |= linearbuffers_dag3_start(encoder);
+        rc |= linearbuffers_dag3_kids_start(encoder);
+        rc |= linearbuffers_dag4_start(encoder);
+        rc |= linearbuffers_dag4_value_set(encoder, 4);
+        dag4 = linearbuffers_dag4_end(encoder);
+        for (i = 0; i < NKIDS; i++) {
+                rc |= linearbuffers_dag3_kids_push(encoder, dag4);
+        }
+        rc |= linearbuffers_dag3_kids_set(encoder, linearbuffers_dag3_kids_end(encoder));
+        dag3 = linearbuffers_dag3_end(encoder);
+        for (i = 0; i < NKIDS; i++) {
+                rc |= linearbuffers_dag2_kids_push(encoder, dag3);
+        }
+        rc |= linearbuffers_dag2_kids_set(encoder, linearbuffers_dag2_kids_end(encoder));
+        dag2 = linearbuffers_dag2_end(encoder);
+        for (i = 0; i < NKIDS; i++) {
+                rc |= linearbuffers_dag1_kids_push(encoder, dag2);
+        }
+        rc |= linearbuffers_dag1_kids_set(encoder, linearbuffers_dag1_kids_end(encoder));
+        dag1 = linearbuffers_dag1_end(encoder);
+        for (i = 0; i < NKIDS; i++) {
+                rc |= linearbuffers_dag0_kids_push(encoder, dag1);
+        }
+        rc |= linearbuffers_dag0_kids_set(encoder, linearbuffers_dag0_kids_end(encoder));
+        rc |= linearbuffers_dag0_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode dag\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "dag: %" PRIu64 "\n", linearized_length);
+        if (linearbuffers_dag0_verify(linearized_buffer, linearized_length, 5) != 0) {
+                fprintf(stderr, "verifier failed: shared children\n");
+                goto bail;
+        }
+        if (linearbuffers_dag0_verify(linearized_buffer, linearized_length, 4) == 0) {
+                fprintf(stderr, "verifier failed: shared children depth\n");
+                goto bail;
+        }
+
+        free(corrupted);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (corrupted != NULL) {
+                free(corrupted);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
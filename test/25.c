@@ -0,0 +1,167 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int check_packed (const struct linearbuffers_packed *packed)
+{
+        struct linearbuffers_packed_view view;
+
+        if (linearbuffers_packed_view_init(&view, packed) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_packed_view_init\n");
+                return -1;
+        }
+        if (linearbuffers_packed_view_a_present(&view) != linearbuffers_packed_a_present(packed) ||
+            linearbuffers_packed_view_b_present(&view) != linearbuffers_packed_b_present(packed) ||
+            linearbuffers_packed_view_name_present(&view) != linearbuffers_packed_name_present(packed) ||
+            linearbuffers_packed_view_level_present(&view) != linearbuffers_packed_level_present(packed) ||
+            linearbuffers_packed_view_c_present(&view) != linearbuffers_packed_c_present(packed)) {
+                fprintf(stderr, "decoder failed: linearbuffers_packed_view_present\n");
+                return -1;
+        }
+        if (linearbuffers_packed_view_a_get(&view) != linearbuffers_packed_a_get(packed) ||
+            linearbuffers_packed_view_b_get(&view) != linearbuffers_packed_b_get(packed) ||
+            linearbuffers_packed_view_name_get_value(&view) != linearbuffers_packed_name_get_value(packed) ||
+            linearbuffers_packed_view_level_get(&view) != linearbuffers_packed_level_get(packed) ||
+            linearbuffers_packed_view_c_get(&view) != linearbuffers_packed_c_get(packed)) {
+                fprintf(stderr, "decoder failed: linearbuffers_packed_view_get\n");
+                return -1;
+        }
+        return 0;
+}
+
+static int check_output (const struct linearbuffers_output *output)
+{
+        struct linearbuffers_output_view view;
+
+        if (linearbuffers_output_view_init(&view, output) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_view_init\n");
+                return -1;
+        }
+        if (linearbuffers_output_view_f00_get(&view) != linearbuffers_output_f00_get(output) ||
+            linearbuffers_output_view_f01_get(&view) != linearbuffers_output_f01_get(output) ||
+            linearbuffers_output_view_f02_get(&view) != linearbuffers_output_f02_get(output) ||
+            linearbuffers_output_view_f03_get(&view) != linearbuffers_output_f03_get(output) ||
+            linearbuffers_output_view_f04_get(&view) != linearbuffers_output_f04_get(output) ||
+            linearbuffers_output_view_f05_get(&view) != linearbuffers_output_f05_get(output) ||
+            linearbuffers_output_view_level_get(&view) != linearbuffers_output_level_get(output)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_view_get\n");
+                return -1;
+        }
+        if (linearbuffers_output_view_name_get(&view) != linearbuffers_output_name_get(output) ||
+            linearbuffers_output_view_origin_get(&view) != linearbuffers_output_origin_get(output) ||
+            linearbuffers_output_view_mac_get(&view) != linearbuffers_output_mac_get(output) ||
+            linearbuffers_output_view_leaf_get(&view) != linearbuffers_output_leaf_get(output) ||
+            linearbuffers_output_view_ids_get(&view) != linearbuffers_output_ids_get(output) ||
+            linearbuffers_output_view_ids_get_count(&view) != linearbuffers_output_ids_get_count(output) ||
+            linearbuffers_output_view_payload_get_type(&view) != linearbuffers_output_payload_get_type(output) ||
+            linearbuffers_output_view_payload_leaf_get(&view) != linearbuffers_output_payload_leaf_get(output) ||
+            linearbuffers_output_view_packed_get(&view) != linearbuffers_output_packed_get(output)) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_view_get\n");
+                return -1;
+        }
+        if (linearbuffers_output_view_packed_present(&view) &&
+            check_packed(linearbuffers_output_view_packed_get(&view)) != 0) {
+                return -1;
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        uint32_t ids[] = { 1, 2, 3 };
+        uint8_t mac[6] = { 0, 1, 2, 3, 4, 5 };
+        struct linearbuffers_point origin = { -1, 2 };
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f00_set(encoder, 1);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        if (check_output(output) != 0) {
+                goto bail;
+        }
+
+        rc  = linearbuffers_encoder_reset(encoder, NULL);
+        rc |= linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f01_set(encoder, 1);
+        rc |= linearbuffers_output_f03_set(encoder, 3);
+        rc |= linearbuffers_output_f04_set(encoder, 4.5);
+        rc |= linearbuffers_output_f05_set(encoder, 5.5);
+        rc |= linearbuffers_output_level_set(encoder, linearbuffers_level_info);
+        rc |= linearbuffers_output_name_create(encoder, "view");
+        rc |= linearbuffers_output_origin_set(encoder, &origin);
+        rc |= linearbuffers_output_mac_set(encoder, mac);
+        rc |= linearbuffers_leaf_start(encoder);
+        rc |= linearbuffers_leaf_value_set(encoder, 42);
+        rc |= linearbuffers_output_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+        rc |= linearbuffers_output_ids_create(encoder, ids, 3);
+        rc |= linearbuffers_leaf_start(encoder);
+        rc |= linearbuffers_leaf_value_set(encoder, 43);
+        rc |= linearbuffers_output_payload_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+        rc |= linearbuffers_packed_start(encoder);
+        rc |= linearbuffers_packed_a_set(encoder, 1);
+        rc |= linearbuffers_packed_name_create(encoder, "packed");
+        rc |= linearbuffers_packed_c_set(encoder, -3);
+        rc |= linearbuffers_output_packed_set(encoder, linearbuffers_packed_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        if (check_output(output) != 0) {
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,167 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        uint32_t ids[] = { 1, 2, 3 };
+        uint8_t mac[6] = { 0, 1, 2, 3, 4, 5 };
+        struct linearbuffers_point origin = { -1, 2 };
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        struct linearbuffers_output_unpacked unpacked;
+        struct linearbuffers_packed_unpacked packed;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f00_set(encoder, 1);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_output_unpack(output, &unpacked, LINEARBUFFERS_UNPACK_FLAG_NONE);
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack\n");
+                goto bail;
+        }
+        if (unpacked.present[0] != 0x01 ||
+            unpacked.f00 != 1 ||
+            unpacked.f02 != 0 ||
+            unpacked.level != 0 ||
+            unpacked.name != NULL ||
+            unpacked.ids != NULL ||
+            unpacked.ids_count != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack none\n");
+                goto bail;
+        }
+        rc = linearbuffers_output_unpack(output, &unpacked, LINEARBUFFERS_UNPACK_FLAG_DEFAULT);
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack\n");
+                goto bail;
+        }
+        if (unpacked.f02 != linearbuffers_output_f02_get(output) ||
+            unpacked.level != linearbuffers_output_level_get(output) ||
+            strcmp(unpacked.name, "none") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack defaults\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_encoder_reset(encoder, NULL);
+        rc |= linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_f00_set(encoder, 10);
+        rc |= linearbuffers_output_f01_set(encoder, 11);
+        rc |= linearbuffers_output_f02_set(encoder, 12);
+        rc |= linearbuffers_output_float_set(encoder, 1.5);
+        rc |= linearbuffers_output_level_set(encoder, linearbuffers_level_info);
+        rc |= linearbuffers_output_name_create(encoder, "unpack");
+        rc |= linearbuffers_output_origin_set(encoder, &origin);
+        rc |= linearbuffers_output_mac_set(encoder, mac);
+        rc |= linearbuffers_leaf_start(encoder);
+        rc |= linearbuffers_leaf_value_set(encoder, 42);
+        rc |= linearbuffers_output_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+        rc |= linearbuffers_output_ids_create(encoder, ids, 3);
+        rc |= linearbuffers_output_names_start(encoder);
+        rc |= linearbuffers_output_names_push_create(encoder, "a");
+        rc |= linearbuffers_output_names_push_create(encoder, "b");
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_packed_start(encoder);
+        rc |= linearbuffers_packed_a_set(encoder, 1);
+        rc |= linearbuffers_packed_name_create(encoder, "packed");
+        rc |= linearbuffers_packed_c_set(encoder, -3);
+        rc |= linearbuffers_output_packed_set(encoder, linearbuffers_packed_end(encoder));
+        rc |= linearbuffers_output_points_create(encoder, &origin, 1);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        rc = linearbuffers_output_unpack(output, &unpacked, LINEARBUFFERS_UNPACK_FLAG_DEFAULT);
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack\n");
+                goto bail;
+        }
+        if (unpacked.present[0] != 0x1fff ||
+            unpacked.f00 != 10 ||
+            unpacked.f01 != 11 ||
+            unpacked.f02 != 12 ||
+            unpacked.float_ != 1.5 ||
+            unpacked.level != linearbuffers_level_info ||
+            strcmp(unpacked.name, "unpack") != 0 ||
+            unpacked.origin.x != -1 ||
+            unpacked.origin.y != 2 ||
+            memcmp(unpacked.mac, mac, sizeof(mac)) != 0 ||
+            linearbuffers_leaf_value_get(unpacked.leaf) != 42 ||
+            unpacked.ids_count != 3 ||
+            unpacked.ids[2] != 3 ||
+            unpacked.names_count != 2 ||
+            strcmp(linearbuffers_string_vector_get_at(unpacked.names, 1), "b") != 0 ||
+            unpacked.points_count != 1 ||
+            unpacked.points[0].y != 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_unpack values\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_packed_unpack(unpacked.packed, &packed, LINEARBUFFERS_UNPACK_FLAG_DEFAULT);
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_packed_unpack\n");
+                goto bail;
+        }
+        if (packed.present[0] != 0x0d ||
+            packed.a != 1 ||
+            packed.b != 7 ||
+            strcmp(packed.name, "packed") != 0 ||
+            packed.c != -3) {
+                fprintf(stderr, "decoder failed: linearbuffers_packed_unpack values\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,203 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NVALUES         100003
+#define NINDICES        1024
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t n;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        float *floats;
+        int32_t *int32s;
+        uint8_t *uint8s;
+        double *doubles;
+        int64_t *int64s;
+
+        double fsum;
+        int64_t isum;
+        uint64_t usum;
+        uint64_t lsum;
+        uint64_t equal;
+        float fmin;
+        float fmax;
+        int32_t imin;
+        int32_t imax;
+        int64_t lvalue;
+        int64_t first;
+        uint64_t indices[NINDICES];
+        int32_t gathered[NINDICES];
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+        floats = malloc(sizeof(float) * NVALUES);
+        int32s = malloc(sizeof(int32_t) * NVALUES);
+        uint8s = malloc(sizeof(uint8_t) * NVALUES);
+        doubles = malloc(sizeof(double) * NVALUES);
+        int64s = malloc(sizeof(int64_t) * NVALUES);
+        if (floats == NULL ||
+            int32s == NULL ||
+            uint8s == NULL ||
+            doubles == NULL ||
+            int64s == NULL) {
+                fprintf(stderr, "can not allocate memory\n");
+                goto bail;
+        }
+        for (i = 0; i < NVALUES; i++) {
+                floats[i] = (float) ((i * 37) % 1000) / 8.0f;
+                int32s[i] = (int32_t) ((i * 7919) % 20001) - 10000;
+                uint8s[i] = (uint8_t) (i * 13);
+                doubles[i] = (double) i / 4.0;
+                int64s[i] = (i % 3 == 2) ? INT64_MIN + (int64_t) i : INT64_MAX - (int64_t) i;
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_floats_create(encoder, floats, NVALUES);
+        rc |= linearbuffers_output_int32s_create(encoder, int32s, NVALUES);
+        rc |= linearbuffers_output_uint8s_create(encoder, uint8s, NVALUES);
+        rc |= linearbuffers_output_doubles_create(encoder, doubles, NVALUES);
+        rc |= linearbuffers_output_empty_create(encoder, NULL, 0);
+        rc |= linearbuffers_output_int64s_create(encoder, int64s, NVALUES);
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        fsum = 0;
+        isum = 0;
+        usum = 0;
+        lsum = 0;
+        fmin = floats[0];
+        fmax = floats[0];
+        imin = int32s[0];
+        imax = int32s[0];
+        equal = 0;
+        first = -1;
+        for (i = 0; i < NVALUES; i++) {
+                if (first < 0 && int32s[i] == int32s[NVALUES - 1]) {
+                        first = i;
+                }
+                fsum += doubles[i];
+                isum += int32s[i];
+                usum += uint8s[i];
+                lsum += (uint64_t) int64s[i];
+                fmin = (floats[i] < fmin) ? floats[i] : fmin;
+                fmax = (floats[i] > fmax) ? floats[i] : fmax;
+                imin = (int32s[i] < imin) ? int32s[i] : imin;
+                imax = (int32s[i] > imax) ? int32s[i] : imax;
+                equal += (int32s[i] == 42);
+        }
+
+        if (linearbuffers_double_vector_sum(linearbuffers_output_doubles_get(output)) != fsum ||
+            linearbuffers_int32_vector_sum(linearbuffers_output_int32s_get(output)) != isum ||
+            linearbuffers_uint8_vector_sum(linearbuffers_output_uint8s_get(output)) != usum ||
+            linearbuffers_int64_vector_sum(linearbuffers_output_empty_get(output)) != 0 ||
+            linearbuffers_int64_vector_sum(linearbuffers_output_int64s_get(output)) != (int64_t) lsum) {
+                fprintf(stderr, "decoder failed: vector_sum\n");
+                goto bail;
+        }
+        if (linearbuffers_float_vector_min(linearbuffers_output_floats_get(output), &fmin) != 0 ||
+            linearbuffers_float_vector_max(linearbuffers_output_floats_get(output), &fmax) != 0 ||
+            fmin != 0.0f ||
+            fmax != 999.0f / 8.0f) {
+                fprintf(stderr, "decoder failed: float vector_min/max\n");
+                goto bail;
+        }
+        if (linearbuffers_int32_vector_min(linearbuffers_output_int32s_get(output), &imin) != 0 ||
+            linearbuffers_int32_vector_max(linearbuffers_output_int32s_get(output), &imax) != 0 ||
+            imin != -10000 ||
+            imax != 10000) {
+                fprintf(stderr, "decoder failed: int32 vector_min/max\n");
+                goto bail;
+        }
+        if (linearbuffers_int64_vector_min(linearbuffers_output_empty_get(output), &lvalue) == 0) {
+                fprintf(stderr, "decoder failed: empty vector_min\n");
+                goto bail;
+        }
+        if (linearbuffers_int32_vector_count_equal(linearbuffers_output_int32s_get(output), 42) != equal) {
+                fprintf(stderr, "decoder failed: vector_count_equal\n");
+                goto bail;
+        }
+        if (linearbuffers_int32_vector_find_first(linearbuffers_output_int32s_get(output), int32s[NVALUES - 1]) != first ||
+            linearbuffers_int32_vector_find_first(linearbuffers_output_int32s_get(output), 20000) != -1) {
+                fprintf(stderr, "decoder failed: vector_find_first\n");
+                goto bail;
+        }
+
+        n = linearbuffers_int32_vector_filter_range(linearbuffers_output_int32s_get(output), -10, 10, indices, NINDICES);
+        if (n == 0) {
+                fprintf(stderr, "decoder failed: vector_filter_range\n");
+                goto bail;
+        }
+        for (i = 0; i < n; i++) {
+                if (int32s[indices[i]] < -10 ||
+                    int32s[indices[i]] > 10 ||
+                    (i > 0 && indices[i] <= indices[i - 1])) {
+                        fprintf(stderr, "decoder failed: vector_filter_range\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_int32_vector_gather(linearbuffers_output_int32s_get(output), indices, n, gathered) != n) {
+                fprintf(stderr, "decoder failed: vector_gather\n");
+                goto bail;
+        }
+        for (i = 0; i < n; i++) {
+                if (gathered[i] != int32s[indices[i]]) {
+                        fprintf(stderr, "decoder failed: vector_gather\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_int32_vector_filter_range(linearbuffers_output_int32s_get(output), -10000, 10000, indices, NINDICES) != NINDICES) {
+                fprintf(stderr, "decoder failed: vector_filter_range limit\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        free(floats);
+        free(int32s);
+        free(uint8s);
+        free(doubles);
+        free(int64s);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        free(floats);
+        free(int32s);
+        free(uint8s);
+        free(doubles);
+        free(int64s);
+        return -1;
+}
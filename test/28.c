@@ -0,0 +1,121 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NITEMS          1000
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        char name[32];
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_item *item;
+        const char *string;
+        struct linearbuffers_item_vector_iter iter;
+        struct linearbuffers_string_vector_iter siter;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_items_start(encoder);
+        for (i = 0; i < NITEMS; i++) {
+                snprintf(name, sizeof(name), "item-%" PRIu64, i);
+                rc |= linearbuffers_item_start(encoder);
+                rc |= linearbuffers_item_id_set(encoder, i * 3);
+                rc |= linearbuffers_item_name_create(encoder, name);
+                rc |= linearbuffers_output_items_push(encoder, linearbuffers_item_end(encoder));
+        }
+        rc |= linearbuffers_output_items_set(encoder, linearbuffers_output_items_end(encoder));
+        rc |= linearbuffers_output_names_start(encoder);
+        for (i = 0; i < NITEMS; i++) {
+                snprintf(name, sizeof(name), "name-%" PRIu64, i);
+                rc |= linearbuffers_output_names_push_create(encoder, name);
+        }
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_empty_start(encoder);
+        rc |= linearbuffers_output_empty_set(encoder, linearbuffers_output_empty_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_item_vector_iter_init(&iter, linearbuffers_output_items_get(output));
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_item_vector_iter_init\n");
+                goto bail;
+        }
+        for (i = 0; (item = linearbuffers_item_vector_iter_next(&iter)) != NULL; i++) {
+                snprintf(name, sizeof(name), "item-%" PRIu64, i);
+                if (item != linearbuffers_output_items_get_at(output, i) ||
+                    linearbuffers_item_id_get(item) != i * 3 ||
+                    strcmp(linearbuffers_item_name_get_value(item), name) != 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_item_vector_iter_next\n");
+                        goto bail;
+                }
+        }
+        if (i != NITEMS) {
+                fprintf(stderr, "decoder failed: linearbuffers_item_vector_iter_next count\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_string_vector_iter_init(&siter, linearbuffers_output_names_get(output));
+        if (rc != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_vector_iter_init\n");
+                goto bail;
+        }
+        for (i = 0; (string = linearbuffers_string_vector_iter_next(&siter)) != NULL; i++) {
+                snprintf(name, sizeof(name), "name-%" PRIu64, i);
+                if (strcmp(string, name) != 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_string_vector_iter_next\n");
+                        goto bail;
+                }
+        }
+        if (i != NITEMS) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_vector_iter_next count\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_item_vector_iter_init(&iter, linearbuffers_output_empty_get(output));
+        if (rc != 0 ||
+            linearbuffers_item_vector_iter_next(&iter) != NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_item_vector_iter empty\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
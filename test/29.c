@@ -0,0 +1,123 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char blob[] = { 'a', 0, 'b', '"', 0, 'c' };
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        char *json;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_item *item;
+        struct linearbuffers_string_view view;
+
+        (void) argc;
+        (void) argv;
+
+        json = NULL;
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_name_create(encoder, "output");
+        rc |= linearbuffers_output_blob_ncreate(encoder, sizeof(blob), blob);
+        rc |= linearbuffers_output_names_start(encoder);
+        rc |= linearbuffers_output_names_push_create(encoder, "");
+        rc |= linearbuffers_output_names_push_create(encoder, "name-1");
+        rc |= linearbuffers_output_names_push(encoder, linearbuffers_string_ncreate(encoder, 3, "x\0y"));
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_items_start(encoder);
+        rc |= linearbuffers_item_start(encoder);
+        rc |= linearbuffers_item_name_createf(encoder, "item-%d", 1);
+        rc |= linearbuffers_output_items_push(encoder, linearbuffers_item_end(encoder));
+        rc |= linearbuffers_output_items_set(encoder, linearbuffers_output_items_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        if (linearbuffers_output_verify(linearized_buffer, linearized_length, 8) != 0) {
+                fprintf(stderr, "verifier failed\n");
+                goto bail;
+        }
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        if (linearbuffers_output_name_get_length(output) != 6 ||
+            strcmp(linearbuffers_output_name_get_value(output), "output") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_name_get_length\n");
+                goto bail;
+        }
+        view = linearbuffers_output_blob_get_view(output);
+        if (view.length != sizeof(blob) ||
+            memcmp(view.value, blob, sizeof(blob)) != 0 ||
+            view.value[view.length] != '\0') {
+                fprintf(stderr, "decoder failed: linearbuffers_output_blob_get_view\n");
+                goto bail;
+        }
+        view = linearbuffers_output_missing_get_view(output);
+        if (view.value != NULL ||
+            view.length != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_missing_get_view\n");
+                goto bail;
+        }
+        if (linearbuffers_string_vector_get_length_at(linearbuffers_output_names_get(output), 0) != 0 ||
+            linearbuffers_string_vector_get_length_at(linearbuffers_output_names_get(output), 1) != 6 ||
+            linearbuffers_string_vector_get_length_at(linearbuffers_output_names_get(output), 2) != 3) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_vector_get_length_at\n");
+                goto bail;
+        }
+        item = linearbuffers_item_vector_get_at(linearbuffers_output_items_get(output), 0);
+        if (linearbuffers_item_name_get_length(item) != 6 ||
+            linearbuffers_string_length(linearbuffers_item_name_get(item)) != 6) {
+                fprintf(stderr, "decoder failed: linearbuffers_item_name_get_length\n");
+                goto bail;
+        }
+
+        json = linearbuffers_output_jsonify_string(output, LINEARBUFFERS_JSONIFY_FLAG_NONE);
+        if (json == NULL) {
+                fprintf(stderr, "jsonify failed\n");
+                goto bail;
+        }
+        fprintf(stderr, "%s\n", json);
+        if (strstr(json, "\"blob\":\"a\\u0000b\\\"\\u0000c\"") == NULL ||
+            strstr(json, "\"x\\u0000y\"") == NULL) {
+                fprintf(stderr, "jsonify failed: embedded nul\n");
+                goto bail;
+        }
+
+        free(json);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (json != NULL) {
+                free(json);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
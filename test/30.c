@@ -0,0 +1,123 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NITEMS          1000
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t j;
+        char name[32];
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_entry *entry;
+        const struct linearbuffers_route *route;
+        const struct linearbuffers_entry_vector *entries;
+        const struct linearbuffers_route_vector *routes;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_entries_start(encoder);
+        for (i = 0; i < NITEMS; i++) {
+                j = (i * 7919) % NITEMS;
+                snprintf(name, sizeof(name), "name-%04" PRIu64, j);
+                rc |= linearbuffers_entry_start(encoder);
+                rc |= linearbuffers_entry_value_set(encoder, j);
+                rc |= linearbuffers_entry_name_create(encoder, name);
+                rc |= linearbuffers_output_entries_push(encoder, linearbuffers_entry_end(encoder));
+        }
+        rc |= linearbuffers_output_entries_set(encoder, linearbuffers_output_entries_end_sorted(encoder));
+        rc |= linearbuffers_output_routes_start(encoder);
+        for (i = 0; i < NITEMS; i++) {
+                j = (i * 7919) % NITEMS;
+                rc |= linearbuffers_route_start(encoder);
+                if (j % 3 == 0) {
+                        rc |= linearbuffers_route_note_create(encoder, "note");
+                }
+                if (j % 2 == 0) {
+                        rc |= linearbuffers_route_weight_set(encoder, j);
+                }
+                rc |= linearbuffers_route_id_set(encoder, (int64_t) j * 2 - NITEMS);
+                rc |= linearbuffers_output_routes_push(encoder, linearbuffers_route_end(encoder));
+        }
+        rc |= linearbuffers_output_routes_set(encoder, linearbuffers_output_routes_end_sorted(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        entries = linearbuffers_output_entries_get(output);
+        for (i = 0; i < NITEMS; i++) {
+                snprintf(name, sizeof(name), "name-%04" PRIu64, i);
+                entry = linearbuffers_entry_vector_get_at(entries, i);
+                if (linearbuffers_entry_value_get(entry) != i ||
+                    strcmp(linearbuffers_entry_name_get_value(entry), name) != 0) {
+                        fprintf(stderr, "decoder failed: entries are not sorted\n");
+                        goto bail;
+                }
+                if (linearbuffers_entry_vector_lookup_by_name(entries, name) != entry) {
+                        fprintf(stderr, "decoder failed: linearbuffers_entry_vector_lookup_by_name\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_entry_vector_lookup_by_name(entries, "name-") != NULL ||
+            linearbuffers_entry_vector_lookup_by_name(entries, "name-9999") != NULL ||
+            linearbuffers_entry_vector_lookup_by_name(entries, "") != NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_entry_vector_lookup_by_name miss\n");
+                goto bail;
+        }
+
+        routes = linearbuffers_output_routes_get(output);
+        for (i = 0; i < NITEMS; i++) {
+                route = linearbuffers_route_vector_lookup_by_id(routes, (int64_t) i * 2 - NITEMS);
+                if (route == NULL ||
+                    route != linearbuffers_route_vector_get_at(routes, i) ||
+                    linearbuffers_route_weight_get(route) != ((i % 2 == 0) ? (uint8_t) i : 0) ||
+                    linearbuffers_route_note_present(route) != (i % 3 == 0)) {
+                        fprintf(stderr, "decoder failed: linearbuffers_route_vector_lookup_by_id\n");
+                        goto bail;
+                }
+                if (linearbuffers_route_vector_lookup_by_id(routes, (int64_t) i * 2 - NITEMS + 1) != NULL) {
+                        fprintf(stderr, "decoder failed: linearbuffers_route_vector_lookup_by_id miss\n");
+                        goto bail;
+                }
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
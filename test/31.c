@@ -0,0 +1,207 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NITEMS          100000
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t n;
+        int64_t at;
+        char name[32];
+        uint64_t value;
+        double score;
+        const char *string;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_route *route;
+        const struct linearbuffers_host *host;
+        const struct linearbuffers_uint32_uint64_map *ports;
+        const struct linearbuffers_string_string_map *names;
+        const struct linearbuffers_uint64_host_map *hosts;
+        const struct linearbuffers_string_double_map *scores;
+        const struct linearbuffers_int32_uint8_map *weights;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_ports_start(encoder);
+        for (i = 0; i < NITEMS; i++) {
+                rc |= linearbuffers_output_ports_put(encoder, i * 7919, i);
+        }
+        rc |= linearbuffers_output_ports_put(encoder, 0, 42);
+        rc |= linearbuffers_output_ports_set(encoder, linearbuffers_output_ports_end(encoder));
+        rc |= linearbuffers_output_names_start(encoder);
+        for (i = 0; i < 64; i++) {
+                snprintf(name, sizeof(name), "name-%02" PRIu64, i);
+                rc |= linearbuffers_output_names_put(encoder, name, name + 5);
+        }
+        rc |= linearbuffers_output_names_put(encoder, "a", "first");
+        rc |= linearbuffers_output_names_put(encoder, "a", "last");
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_hosts_start(encoder);
+        for (i = 0; i < 16; i++) {
+                snprintf(name, sizeof(name), "host-%02" PRIu64, i);
+                rc |= linearbuffers_host_start(encoder);
+                rc |= linearbuffers_host_name_create(encoder, name);
+                rc |= linearbuffers_host_port_set(encoder, 8000 + i);
+                rc |= linearbuffers_output_hosts_put(encoder, UINT64_C(1) << (i * 4), linearbuffers_host_end(encoder));
+        }
+        rc |= linearbuffers_output_hosts_set(encoder, linearbuffers_output_hosts_end(encoder));
+        rc |= linearbuffers_output_scores_start(encoder);
+        rc |= linearbuffers_output_scores_put(encoder, "pi", 3.25);
+        rc |= linearbuffers_output_scores_put(encoder, "e", 2.5);
+        rc |= linearbuffers_output_scores_set(encoder, linearbuffers_output_scores_end(encoder));
+        rc |= linearbuffers_output_empty_start(encoder);
+        rc |= linearbuffers_output_empty_set(encoder, linearbuffers_output_empty_end(encoder));
+        rc |= linearbuffers_route_start(encoder);
+        rc |= linearbuffers_route_note_create(encoder, "route");
+        rc |= linearbuffers_route_weights_start(encoder);
+        for (i = 0; i < 20; i++) {
+                rc |= linearbuffers_route_weights_put(encoder, (int32_t) i - 10, i);
+        }
+        rc |= linearbuffers_route_weights_set(encoder, linearbuffers_route_weights_end(encoder));
+        rc |= linearbuffers_output_route_set(encoder, linearbuffers_route_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        if (linearbuffers_output_verify(linearized_buffer, linearized_length, 8) != 0) {
+                fprintf(stderr, "verifier failed: linearbuffers_output_verify\n");
+                goto bail;
+        }
+        if (linearbuffers_output_verify(linearized_buffer, linearized_length - 1, 8) == 0) {
+                fprintf(stderr, "verifier failed: truncated buffer\n");
+                goto bail;
+        }
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        ports = linearbuffers_output_ports_get(output);
+        if (linearbuffers_output_ports_get_count(output) != NITEMS ||
+            linearbuffers_uint32_uint64_map_get_capacity(ports) < NITEMS * 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_ports_get_count\n");
+                goto bail;
+        }
+        for (i = 0; i < NITEMS; i++) {
+                if (linearbuffers_uint32_uint64_map_get(ports, i * 7919, &value) != 0 ||
+                    value != ((i == 0) ? 42 : i)) {
+                        fprintf(stderr, "decoder failed: linearbuffers_uint32_uint64_map_get\n");
+                        goto bail;
+                }
+                if (linearbuffers_uint32_uint64_map_find(ports, i * 7919 + 1) >= 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_uint32_uint64_map_find miss\n");
+                        goto bail;
+                }
+        }
+        for (n = 0, value = 0, at = linearbuffers_uint32_uint64_map_next(ports, -1); at >= 0; at = linearbuffers_uint32_uint64_map_next(ports, at)) {
+                value += linearbuffers_uint32_uint64_map_get_key_at(ports, at) / 7919;
+                n += 1;
+        }
+        if (n != NITEMS ||
+            value != (uint64_t) NITEMS * (NITEMS - 1) / 2) {
+                fprintf(stderr, "decoder failed: linearbuffers_uint32_uint64_map_next\n");
+                goto bail;
+        }
+
+        names = linearbuffers_output_names_get(output);
+        for (i = 0; i < 64; i++) {
+                snprintf(name, sizeof(name), "name-%02" PRIu64, i);
+                if (linearbuffers_string_string_map_get(names, name, &string) != 0 ||
+                    strcmp(string, name + 5) != 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_string_string_map_get\n");
+                        goto bail;
+                }
+        }
+        if (linearbuffers_output_names_get_count(output) != 65 ||
+            linearbuffers_string_string_map_get(names, "a", &string) != 0 ||
+            strcmp(string, "last") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_string_map_get duplicate\n");
+                goto bail;
+        }
+        if (linearbuffers_string_string_map_find(names, "name-64") >= 0 ||
+            linearbuffers_string_string_map_find(names, "") >= 0 ||
+            linearbuffers_string_string_map_find(names, NULL) >= 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_string_map_find miss\n");
+                goto bail;
+        }
+
+        hosts = linearbuffers_output_hosts_get(output);
+        for (i = 0; i < 16; i++) {
+                snprintf(name, sizeof(name), "host-%02" PRIu64, i);
+                if (linearbuffers_uint64_host_map_get(hosts, UINT64_C(1) << (i * 4), &host) != 0 ||
+                    strcmp(linearbuffers_host_name_get_value(host), name) != 0 ||
+                    linearbuffers_host_port_get(host) != 8000 + i) {
+                        fprintf(stderr, "decoder failed: linearbuffers_uint64_host_map_get\n");
+                        goto bail;
+                }
+        }
+
+        scores = linearbuffers_output_scores_get(output);
+        if (linearbuffers_string_double_map_get(scores, "pi", &score) != 0 || score != 3.25 ||
+            linearbuffers_string_double_map_get(scores, "e", &score) != 0 || score != 2.5 ||
+            linearbuffers_string_double_map_get(scores, "phi", NULL) == 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_string_double_map_get\n");
+                goto bail;
+        }
+
+        if (linearbuffers_output_empty_get_count(output) != 0 ||
+            linearbuffers_int16_float_map_find(linearbuffers_output_empty_get(output), 0) >= 0 ||
+            linearbuffers_int16_float_map_next(linearbuffers_output_empty_get(output), -1) >= 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_empty_get\n");
+                goto bail;
+        }
+
+        route = linearbuffers_output_route_get(output);
+        weights = linearbuffers_route_weights_get(route);
+        for (i = 0; i < 20; i++) {
+                at = linearbuffers_int32_uint8_map_find(weights, (int32_t) i - 10);
+                if (at < 0 ||
+                    linearbuffers_int32_uint8_map_get_value_at(weights, at) != i) {
+                        fprintf(stderr, "decoder failed: linearbuffers_int32_uint8_map_find\n");
+                        goto bail;
+                }
+        }
+        if (strcmp(linearbuffers_route_note_get_value(route), "route") != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_route_note_get_value\n");
+                goto bail;
+        }
+
+        linearbuffers_route_jsonify(route, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
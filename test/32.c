@@ -0,0 +1,150 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* pass a larger count, e.g. 10000000, to benchmark buffers beyond the last level cache */
+#define NITEMS          (1 << 16)
+
+struct sum {
+        uint64_t count;
+        uint64_t ids;
+        uint64_t weights;
+        uint64_t stop;
+};
+
+static int sum_item (void *context, uint64_t at, const struct linearbuffers_item *item)
+{
+        struct sum *sum = context;
+        sum->count   += 1;
+        sum->ids     += linearbuffers_item_id_get(item);
+        sum->weights += linearbuffers_item_weight_get(item);
+        return (at == sum->stop) ? 1 : 0;
+}
+
+static uint64_t clock_get (void)
+{
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ((uint64_t) ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+        uint64_t j;
+        uint64_t t;
+        uint64_t nitems;
+        uint64_t random;
+        uint64_t distance;
+        struct sum sum;
+        struct sum expected;
+        const struct linearbuffers_item **items;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_item *item;
+
+        items = NULL;
+        encoder = NULL;
+
+        nitems = (argc > 1) ? strtoull(argv[1], NULL, 0) : NITEMS;
+
+        items = malloc(sizeof(const struct linearbuffers_item *) * nitems);
+        if (items == NULL) {
+                fprintf(stderr, "can not allocate memory\n");
+                goto bail;
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        /* push tables in shuffled order, so the element offsets are not monotonic */
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_items_start(encoder);
+        for (i = 0; i < nitems; i++) {
+                rc |= linearbuffers_item_start(encoder);
+                rc |= linearbuffers_item_id_set(encoder, i);
+                rc |= linearbuffers_item_weight_set(encoder, i & 0xff);
+                items[i] = linearbuffers_item_end(encoder);
+        }
+        for (i = nitems, random = 0x9e3779b97f4a7c15; i > 1; i--) {
+                random = random * 6364136223846793005 + 1442695040888963407;
+                j = (random >> 33) % i;
+                item = items[i - 1];
+                items[i - 1] = items[j];
+                items[j] = item;
+        }
+        for (i = 0; i < nitems; i++) {
+                rc |= linearbuffers_output_items_push(encoder, items[i]);
+        }
+        rc |= linearbuffers_output_items_set(encoder, linearbuffers_output_items_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        output = linearbuffers_output_decode(linearized_buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+
+        memset(&expected, 0, sizeof(expected));
+        expected.count   = nitems;
+        expected.ids     = nitems * (nitems - 1) / 2;
+        expected.stop    = UINT64_MAX;
+        for (i = 0; i < nitems; i++) {
+                expected.weights += i & 0xff;
+        }
+
+        for (distance = 0; distance <= 64; distance = (distance == 0) ? 1 : distance * 2) {
+                memset(&sum, 0, sizeof(sum));
+                sum.stop = UINT64_MAX;
+                t = clock_get();
+                rc = linearbuffers_item_vector_for_each_distance(linearbuffers_output_items_get(output), distance, sum_item, &sum);
+                t = clock_get() - t;
+                if (rc != 0 ||
+                    memcmp(&sum, &expected, sizeof(sum)) != 0) {
+                        fprintf(stderr, "decoder failed: linearbuffers_item_vector_for_each_distance\n");
+                        goto bail;
+                }
+                fprintf(stderr, "distance: %2" PRIu64 ", elements: %" PRIu64 ", %.2f ns/element\n", distance, nitems, (double) t / nitems);
+        }
+
+        memset(&sum, 0, sizeof(sum));
+        sum.stop = 10;
+        rc = linearbuffers_item_vector_for_each(linearbuffers_output_items_get(output), sum_item, &sum);
+        if (rc != 1 ||
+            sum.count != 11) {
+                fprintf(stderr, "decoder failed: linearbuffers_item_vector_for_each\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        free(items);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        if (items != NULL) {
+                free(items);
+        }
+        return -1;
+}
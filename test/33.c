@@ -0,0 +1,111 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main (int argc, char *argv[])
+{
+        int rc;
+
+        uint64_t linearized_length;
+        const uint8_t *linearized_buffer;
+        uint8_t *buffer;
+
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_output *output;
+        struct linearbuffers_counter *counter;
+
+        (void) argc;
+        (void) argv;
+
+        buffer = NULL;
+        encoder = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_state_set(encoder, linearbuffers_state_busy);
+        rc |= linearbuffers_output_ttl_set(encoder, 30);
+        rc |= linearbuffers_output_offset_set(encoder, -1);
+        rc |= linearbuffers_output_weight_set(encoder, 0.5);
+        rc |= linearbuffers_output_name_create(encoder, "output");
+        rc |= linearbuffers_counter_start(encoder);
+        rc |= linearbuffers_counter_hits_set(encoder, 1);
+        rc |= linearbuffers_counter_ratio_set(encoder, 0.25);
+        rc |= linearbuffers_output_counter_set(encoder, linearbuffers_counter_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+
+        buffer = malloc(linearized_length);
+        if (buffer == NULL) {
+                fprintf(stderr, "can not allocate memory\n");
+                goto bail;
+        }
+        memcpy(buffer, linearized_buffer, linearized_length);
+
+        output = (struct linearbuffers_output *) linearbuffers_output_decode(buffer, linearized_length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        counter = (struct linearbuffers_counter *) linearbuffers_output_counter_get(output);
+
+        rc  = linearbuffers_output_state_mutate(output, linearbuffers_state_done);
+        rc |= linearbuffers_output_ttl_mutate(output, 3600);
+        rc |= linearbuffers_output_offset_mutate(output, INT64_MIN);
+        rc |= linearbuffers_output_weight_mutate(output, 1.5);
+        rc |= linearbuffers_counter_hits_mutate(counter, 2);
+        rc |= linearbuffers_counter_ratio_mutate(counter, 0.75);
+        if (rc != 0) {
+                fprintf(stderr, "mutate failed\n");
+                goto bail;
+        }
+        if (linearbuffers_output_missing_mutate(output, 1) == 0 ||
+            linearbuffers_output_missing_present(output)) {
+                fprintf(stderr, "mutate failed: linearbuffers_output_missing_mutate\n");
+                goto bail;
+        }
+
+        if (linearbuffers_output_verify(buffer, linearized_length, 8) != 0) {
+                fprintf(stderr, "verifier failed: linearbuffers_output_verify\n");
+                goto bail;
+        }
+        if (linearbuffers_output_state_get(output) != linearbuffers_state_done ||
+            linearbuffers_output_ttl_get(output) != 3600 ||
+            linearbuffers_output_offset_get(output) != INT64_MIN ||
+            linearbuffers_output_weight_get(output) != 1.5 ||
+            strcmp(linearbuffers_output_name_get_value(output), "output") != 0 ||
+            linearbuffers_counter_hits_get(counter) != 2 ||
+            linearbuffers_counter_ratio_get(counter) != 0.75f ||
+            linearbuffers_counter_name_present(counter)) {
+                fprintf(stderr, "decoder failed: mutated values\n");
+                goto bail;
+        }
+
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        linearbuffers_encoder_destroy(encoder);
+        free(buffer);
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        if (buffer != NULL) {
+                free(buffer);
+        }
+        return -1;
+}
@@ -0,0 +1,208 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NNODES          1000
+
+static int encode_output (struct linearbuffers_encoder *encoder, int version)
+{
+        int rc;
+        uint64_t i;
+        char name[32];
+        uint32_t ids[] = { 1, 2, 3, 4 };
+        uint8_t mac[6] = { 0, 1, 2, 3, 4, 5 };
+        struct linearbuffers_point origin = { -1, 2 };
+        struct linearbuffers_point points[] = { { 1, 1 }, { 2, 2 } };
+
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_version_set(encoder, version);
+        rc |= linearbuffers_output_ratio_set(encoder, 0.5);
+        rc |= linearbuffers_output_mode_set(encoder, (version == 0) ? linearbuffers_mode_on : linearbuffers_mode_auto);
+        if (version == 0) {
+                rc |= linearbuffers_output_name_create(encoder, "output");
+        }
+        rc |= linearbuffers_output_origin_set(encoder, &origin);
+        mac[5] = version;
+        rc |= linearbuffers_output_mac_set(encoder, mac);
+        rc |= linearbuffers_limits_start(encoder);
+        rc |= linearbuffers_limits_low_set(encoder, -10);
+        rc |= linearbuffers_limits_high_set(encoder, 10 + version);
+        if (version == 1) {
+                rc |= linearbuffers_limits_note_create(encoder, "raised");
+        }
+        rc |= linearbuffers_output_limits_set(encoder, linearbuffers_limits_end(encoder));
+        rc |= linearbuffers_output_ids_create(encoder, ids, (version == 0) ? 4 : 3);
+        rc |= linearbuffers_output_names_start(encoder);
+        rc |= linearbuffers_output_names_push_create(encoder, "a");
+        rc |= linearbuffers_output_names_push_create(encoder, "b");
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= linearbuffers_output_nodes_start(encoder);
+        for (i = 0; i < NNODES; i++) {
+                snprintf(name, sizeof(name), "node-%" PRIu64, (version == 1 && i == 500) ? UINT64_C(9999) : i);
+                rc |= linearbuffers_node_start(encoder);
+                rc |= linearbuffers_node_id_set(encoder, i);
+                rc |= linearbuffers_node_name_create(encoder, name);
+                rc |= linearbuffers_node_origin_set(encoder, &origin);
+                rc |= linearbuffers_output_nodes_push(encoder, linearbuffers_node_end(encoder));
+        }
+        rc |= linearbuffers_output_nodes_set(encoder, linearbuffers_output_nodes_end(encoder));
+        if (version == 1) {
+                rc |= linearbuffers_output_points_create(encoder, points, 2);
+        }
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static const struct linearbuffers_output * encode_decode (struct linearbuffers_encoder *encoder, uint64_t *length)
+{
+        const uint8_t *buffer;
+        buffer = linearbuffers_encoder_linearized(encoder, length);
+        if (buffer == NULL) {
+                return NULL;
+        }
+        if (linearbuffers_output_verify(buffer, *length, 8) != 0) {
+                return NULL;
+        }
+        return linearbuffers_output_decode(buffer, *length);
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t length;
+        uint64_t patch_length;
+        uint64_t from_length;
+        uint64_t to_length;
+
+        struct linearbuffers_encoder *from_encoder;
+        struct linearbuffers_encoder *to_encoder;
+        struct linearbuffers_encoder *patch_encoder;
+        struct linearbuffers_encoder *encoder;
+
+        const struct linearbuffers_output *from;
+        const struct linearbuffers_output *to;
+        const struct linearbuffers_output *patch;
+        const struct linearbuffers_output *output;
+
+        (void) argc;
+        (void) argv;
+
+        from_encoder = NULL;
+        to_encoder = NULL;
+        patch_encoder = NULL;
+        encoder = NULL;
+
+        from_encoder  = linearbuffers_encoder_create(NULL);
+        to_encoder    = linearbuffers_encoder_create(NULL);
+        patch_encoder = linearbuffers_encoder_create(NULL);
+        encoder       = linearbuffers_encoder_create(NULL);
+        if (from_encoder == NULL ||
+            to_encoder == NULL ||
+            patch_encoder == NULL ||
+            encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc  = encode_output(from_encoder, 0);
+        rc |= encode_output(to_encoder, 1);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        from = encode_decode(from_encoder, &from_length);
+        to = encode_decode(to_encoder, &to_length);
+        if (from == NULL || to == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                goto bail;
+        }
+        if (linearbuffers_output_equal(from, to) ||
+            !linearbuffers_output_equal(from, from) ||
+            linearbuffers_output_nodes_compare(from, to) == 0 ||
+            linearbuffers_output_names_compare(from, to) != 0) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_equal\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_output_diff(from, to, patch_encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not diff output\n");
+                goto bail;
+        }
+        patch = linearbuffers_output_decode(linearbuffers_encoder_linearized(patch_encoder, &patch_length), patch_length);
+        fprintf(stderr, "from: %" PRIu64 ", to: %" PRIu64 ", patch: %" PRIu64 "\n", from_length, to_length, patch_length);
+        if (patch == NULL ||
+            patch_length >= to_length / 4 ||
+            linearbuffers_output_version_get(patch) != 1 ||
+            linearbuffers_output_ratio_present(patch) ||
+            linearbuffers_output_name_present(patch) ||
+            linearbuffers_output_names_present(patch) ||
+            !linearbuffers_output_points_present(patch) ||
+            linearbuffers_limits_low_present(linearbuffers_output_limits_get(patch)) ||
+            linearbuffers_limits_high_get(linearbuffers_output_limits_get(patch)) != 11) {
+                fprintf(stderr, "diff failed: linearbuffers_output_diff\n");
+                goto bail;
+        }
+
+        rc = linearbuffers_output_patch(from, patch, encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not patch output\n");
+                goto bail;
+        }
+        output = encode_decode(encoder, &length);
+        if (output == NULL ||
+            length != to_length ||
+            !linearbuffers_output_equal(output, to) ||
+            linearbuffers_output_name_present(output) ||
+            strcmp(linearbuffers_limits_note_get_value(linearbuffers_output_limits_get(output)), "raised") != 0 ||
+            strcmp(linearbuffers_node_name_get_value(linearbuffers_output_nodes_get_at(output, 500)), "node-9999") != 0) {
+                fprintf(stderr, "patch failed: linearbuffers_output_patch\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(patch_encoder, NULL);
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc  = linearbuffers_output_diff(to, to, patch_encoder);
+        patch = linearbuffers_output_decode(linearbuffers_encoder_linearized(patch_encoder, &patch_length), patch_length);
+        rc |= linearbuffers_output_patch(to, patch, encoder);
+        output = encode_decode(encoder, &length);
+        if (rc != 0 ||
+            output == NULL ||
+            !linearbuffers_output_equal(output, to)) {
+                fprintf(stderr, "patch failed: empty patch\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(patch_encoder, NULL);
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc  = linearbuffers_output_diff(NULL, from, patch_encoder);
+        patch = linearbuffers_output_decode(linearbuffers_encoder_linearized(patch_encoder, &patch_length), patch_length);
+        rc |= linearbuffers_output_patch(NULL, patch, encoder);
+        output = encode_decode(encoder, &length);
+        if (rc != 0 ||
+            output == NULL ||
+            !linearbuffers_output_equal(output, from)) {
+                fprintf(stderr, "patch failed: full patch\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(from_encoder);
+        linearbuffers_encoder_destroy(to_encoder);
+        linearbuffers_encoder_destroy(patch_encoder);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (from_encoder != NULL) {
+                linearbuffers_encoder_destroy(from_encoder);
+        }
+        if (to_encoder != NULL) {
+                linearbuffers_encoder_destroy(to_encoder);
+        }
+        if (patch_encoder != NULL) {
+                linearbuffers_encoder_destroy(patch_encoder);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,322 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NSAMPLES        8
+#define NEVENTS         4
+
+struct sink_reference {
+        uint64_t offset;
+        const void *buffer;
+        int64_t length;
+};
+
+struct sink {
+        uint8_t *buffer;
+        uint64_t length;
+        uint64_t size;
+        uint64_t nreferences;
+        struct sink_reference references[NSAMPLES + NEVENTS];
+};
+
+static int sink_reserve (struct sink *sink, uint64_t length)
+{
+        void *tmp;
+        if (sink->size >= length) {
+                return 0;
+        }
+        tmp = realloc(sink->buffer, length);
+        if (tmp == NULL) {
+                return -1;
+        }
+        memset(((uint8_t *) tmp) + sink->size, 0, length - sink->size);
+        sink->buffer = tmp;
+        sink->size = length;
+        return 0;
+}
+
+static int sink_function (void *context, uint64_t offset, const void *buffer, int64_t length)
+{
+        struct sink *sink = context;
+        if (length < 0) {
+                sink->length = offset + length;
+                return 0;
+        }
+        if (sink_reserve(sink, offset + length) != 0) {
+                return -1;
+        }
+        if (buffer == NULL) {
+                memset(sink->buffer + offset, 0, length);
+        } else {
+                memcpy(sink->buffer + offset, buffer, length);
+        }
+        if (sink->length < offset + length) {
+                sink->length = offset + length;
+        }
+        return 0;
+}
+
+static int sink_reference (void *context, uint64_t offset, const void *buffer, int64_t length)
+{
+        struct sink *sink = context;
+        if (sink->nreferences >= sizeof(sink->references) / sizeof(sink->references[0])) {
+                return -1;
+        }
+        if (sink_reserve(sink, offset + length) != 0) {
+                return -1;
+        }
+        if (sink->length < offset + length) {
+                sink->length = offset + length;
+        }
+        sink->references[sink->nreferences].offset = offset;
+        sink->references[sink->nreferences].buffer = buffer;
+        sink->references[sink->nreferences].length = length;
+        sink->nreferences += 1;
+        return 0;
+}
+
+static void * encode_sample (uint64_t id, uint64_t *length)
+{
+        int rc;
+        uint32_t i;
+        void *buffer;
+        const void *linearized;
+        struct linearbuffers_encoder *encoder;
+        buffer = NULL;
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                return NULL;
+        }
+        rc  = linearbuffers_sample_start(encoder);
+        rc |= linearbuffers_sample_id_set(encoder, id);
+        rc |= linearbuffers_sample_name_createf(encoder, "sample-%" PRIu64, id);
+        rc |= linearbuffers_sample_values_start(encoder);
+        for (i = 0; i < id; i++) {
+                rc |= linearbuffers_sample_values_push(encoder, i * 3);
+        }
+        rc |= linearbuffers_sample_values_set(encoder, linearbuffers_sample_values_end(encoder));
+        rc |= linearbuffers_sample_finish(encoder);
+        if (rc == 0) {
+                linearized = linearbuffers_encoder_linearized(encoder, length);
+                buffer = malloc(*length);
+                if (buffer != NULL) {
+                        memcpy(buffer, linearized, *length);
+                }
+        }
+        linearbuffers_encoder_destroy(encoder);
+        return buffer;
+}
+
+static void * encode_event (uint32_t seq, uint64_t *length)
+{
+        int rc;
+        void *buffer;
+        const void *linearized;
+        struct linearbuffers_encoder *encoder;
+        buffer = NULL;
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                return NULL;
+        }
+        rc  = linearbuffers_event_start(encoder);
+        rc |= linearbuffers_event_seq_set(encoder, seq);
+        if (seq % 2) {
+                rc |= linearbuffers_event_tag_createf(encoder, "event-%" PRIu32, seq);
+        }
+        rc |= linearbuffers_event_finish(encoder);
+        if (rc == 0) {
+                linearized = linearbuffers_encoder_linearized(encoder, length);
+                buffer = malloc(*length);
+                if (buffer != NULL) {
+                        memcpy(buffer, linearized, *length);
+                }
+        }
+        linearbuffers_encoder_destroy(encoder);
+        return buffer;
+}
+
+static int encode (struct linearbuffers_encoder *encoder, void **samples, uint64_t *nsamples, void **events, uint64_t *nevents)
+{
+        int rc;
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_count_set(encoder, NSAMPLES + NEVENTS);
+        rc |= linearbuffers_output_samples_create_linearized(encoder, (const void * const *) samples, nsamples, NSAMPLES);
+        rc |= linearbuffers_output_events_start(encoder);
+        rc |= linearbuffers_output_events_push_linearized(encoder, events[0], nevents[0]);
+        rc |= linearbuffers_output_events_push_linearized(encoder, events[1], nevents[1]);
+        rc |= linearbuffers_output_events_push_linearized(encoder, events[2], nevents[2]);
+        rc |= linearbuffers_output_events_push_linearized(encoder, events[3], nevents[3]);
+        rc |= linearbuffers_output_events_set(encoder, linearbuffers_output_events_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static int check (const void *buffer, uint64_t length)
+{
+        uint64_t i;
+        uint64_t j;
+        char name[32];
+        const struct linearbuffers_output *output;
+        const struct linearbuffers_sample *sample;
+        const struct linearbuffers_event *event;
+        output = linearbuffers_output_decode(buffer, length);
+        if (output == NULL) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_decode\n");
+                return -1;
+        }
+        linearbuffers_output_jsonify(output, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+        if (linearbuffers_output_count_get(output) != NSAMPLES + NEVENTS ||
+            linearbuffers_output_samples_get_count(output) != NSAMPLES ||
+            linearbuffers_output_events_get_count(output) != NEVENTS) {
+                fprintf(stderr, "decoder failed: linearbuffers_output_get_count\n");
+                return -1;
+        }
+        for (i = 0; i < NSAMPLES; i++) {
+                sample = linearbuffers_output_samples_get_at(output, i);
+                snprintf(name, sizeof(name), "sample-%" PRIu64, i);
+                if (linearbuffers_sample_id_get(sample) != i ||
+                    strcmp(linearbuffers_sample_name_get_value(sample), name) != 0 ||
+                    linearbuffers_sample_values_get_count(sample) != i) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_samples_get_at\n");
+                        return -1;
+                }
+                for (j = 0; j < i; j++) {
+                        if (linearbuffers_sample_values_get_at(sample, j) != j * 3) {
+                                fprintf(stderr, "decoder failed: linearbuffers_sample_values_get_at\n");
+                                return -1;
+                        }
+                }
+        }
+        for (i = 0; i < NEVENTS; i++) {
+                event = linearbuffers_output_events_get_at(output, i);
+                snprintf(name, sizeof(name), "event-%" PRIu64, i + 100);
+                if (linearbuffers_event_seq_get(event) != i + 100 ||
+                    linearbuffers_event_tag_present(event) != (int) (i % 2) ||
+                    ((i % 2) && strcmp(linearbuffers_event_tag_get_value(event), name) != 0)) {
+                        fprintf(stderr, "decoder failed: linearbuffers_output_events_get_at\n");
+                        return -1;
+                }
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        uint64_t i;
+
+        uint64_t linearized_length;
+        const void *linearized_buffer;
+
+        void *samples[NSAMPLES];
+        uint64_t nsamples[NSAMPLES];
+        void *events[NEVENTS];
+        uint64_t nevents[NEVENTS];
+
+        struct sink sink;
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_encoder_create_options options;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+        memset(&sink, 0, sizeof(struct sink));
+        memset(samples, 0, sizeof(samples));
+        memset(events, 0, sizeof(events));
+
+        for (i = 0; i < NSAMPLES; i++) {
+                samples[i] = encode_sample(i, &nsamples[i]);
+                if (samples[i] == NULL) {
+                        fprintf(stderr, "can not encode sample\n");
+                        goto bail;
+                }
+        }
+        for (i = 0; i < NEVENTS; i++) {
+                events[i] = encode_event(i + 100, &nevents[i]);
+                if (events[i] == NULL) {
+                        fprintf(stderr, "can not encode event\n");
+                        goto bail;
+                }
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder, samples, nsamples, events, nevents);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+        rc = check(linearized_buffer, linearized_length);
+        if (rc != 0) {
+                goto bail;
+        }
+        linearbuffers_encoder_destroy(encoder);
+
+        memset(&options, 0, sizeof(struct linearbuffers_encoder_create_options));
+        options.emitter.function = sink_function;
+        options.emitter.reference = sink_reference;
+        options.emitter.context = &sink;
+        encoder = linearbuffers_encoder_create(&options);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder, samples, nsamples, events, nevents);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        if (sink.nreferences != NSAMPLES + NEVENTS ||
+            sink.references[0].buffer != samples[0] ||
+            sink.references[NSAMPLES].buffer != events[0] ||
+            sink.references[NSAMPLES].length != (int64_t) nevents[0]) {
+                fprintf(stderr, "encoder failed: references are not recorded\n");
+                goto bail;
+        }
+        if (sink.length != linearized_length) {
+                fprintf(stderr, "encoder failed: length mismatch\n");
+                goto bail;
+        }
+        for (i = 0; i < sink.nreferences; i++) {
+                memcpy(sink.buffer + sink.references[i].offset, sink.references[i].buffer, sink.references[i].length);
+        }
+        rc = check(sink.buffer, sink.length);
+        if (rc != 0) {
+                goto bail;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        free(sink.buffer);
+        for (i = 0; i < NSAMPLES; i++) {
+                free(samples[i]);
+        }
+        for (i = 0; i < NEVENTS; i++) {
+                free(events[i]);
+        }
+
+        return 0;
+bail:   if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        if (sink.buffer != NULL) {
+                free(sink.buffer);
+        }
+        for (i = 0; i < NSAMPLES; i++) {
+                free(samples[i]);
+        }
+        for (i = 0; i < NEVENTS; i++) {
+                free(events[i]);
+        }
+        return -1;
+}
@@ -0,0 +1,298 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NRECORDS        16
+#define NSHARED         300
+
+static int encode_tag (struct linearbuffers_encoder *encoder, uint64_t i)
+{
+        int rc;
+        rc  = linearbuffers_tag_start(encoder);
+        rc |= linearbuffers_tag_name_createf(encoder, "tag-%" PRIu64, i % 2);
+        rc |= linearbuffers_tag_level_set(encoder, i % 2);
+        return rc;
+}
+
+static int encode_point (struct linearbuffers_encoder *encoder, int32_t x, int32_t y)
+{
+        int rc;
+        rc  = linearbuffers_point_start(encoder);
+        rc |= linearbuffers_point_x_set(encoder, x);
+        rc |= linearbuffers_point_y_set(encoder, y);
+        rc |= linearbuffers_point_label_create(encoder, "origin");
+        return rc;
+}
+
+static int encode (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        uint64_t i;
+        uint64_t j;
+        char name[32];
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_records_start(encoder);
+        for (i = 0; i < NRECORDS; i++) {
+                rc |= linearbuffers_record_start(encoder);
+                rc |= linearbuffers_record_id_set(encoder, i);
+                rc |= linearbuffers_record_name_createf(encoder, "record-%" PRIu64, i % 4);
+                rc |= encode_tag(encoder, i);
+                rc |= linearbuffers_record_tag_set(encoder, linearbuffers_tag_end(encoder));
+                rc |= linearbuffers_record_values_start(encoder);
+                for (j = 0; j < i % 3; j++) {
+                        rc |= linearbuffers_record_values_push(encoder, j);
+                }
+                rc |= linearbuffers_record_values_set(encoder, linearbuffers_record_values_end(encoder));
+                rc |= linearbuffers_record_points_start(encoder);
+                for (j = 0; j < 2; j++) {
+                        rc |= encode_point(encoder, j, -j);
+                        rc |= linearbuffers_record_points_push(encoder, linearbuffers_point_end(encoder));
+                }
+                rc |= linearbuffers_record_points_set(encoder, linearbuffers_record_points_end(encoder));
+                if (i % 2) {
+                        rc |= encode_point(encoder, 1, 1);
+                        rc |= linearbuffers_record_payload_point_set(encoder, linearbuffers_point_end(encoder));
+                } else {
+                        rc |= linearbuffers_leaf_start(encoder);
+                        rc |= linearbuffers_leaf_value_set(encoder, 42);
+                        rc |= linearbuffers_record_payload_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+                }
+                if (i % 2 == 0) {
+                        rc |= linearbuffers_record_labels_start(encoder);
+                        for (j = 0; j < 2; j++) {
+                                rc |= encode_tag(encoder, j);
+                                rc |= linearbuffers_record_labels_put(encoder, (j == 0) ? "first" : "second", linearbuffers_tag_end(encoder));
+                        }
+                        rc |= linearbuffers_record_labels_set(encoder, linearbuffers_record_labels_end(encoder));
+                }
+                rc |= linearbuffers_output_records_push(encoder, linearbuffers_record_end(encoder));
+        }
+        rc |= linearbuffers_output_records_set(encoder, linearbuffers_output_records_end(encoder));
+        rc |= linearbuffers_output_names_start(encoder);
+        for (i = 0; i < NRECORDS; i++) {
+                snprintf(name, sizeof(name), "name-%" PRIu64, i % 3);
+                rc |= linearbuffers_output_names_push(encoder, linearbuffers_string_create(encoder, name));
+        }
+        rc |= linearbuffers_output_names_set(encoder, linearbuffers_output_names_end(encoder));
+        rc |= encode_point(encoder, 0, 0);
+        rc |= linearbuffers_output_origin_set(encoder, linearbuffers_point_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static int encode_shared (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        uint64_t i;
+        char note[201];
+        memset(note, 'n', sizeof(note) - 1);
+        note[sizeof(note) - 1] = '\0';
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_records_start(encoder);
+        for (i = 0; i < NSHARED; i++) {
+                rc |= linearbuffers_record_start(encoder);
+                rc |= linearbuffers_record_name_create(encoder, note);
+                rc |= encode_tag(encoder, 0);
+                rc |= linearbuffers_record_tag_set(encoder, linearbuffers_tag_end(encoder));
+                rc |= linearbuffers_leaf_start(encoder);
+                rc |= linearbuffers_leaf_value_set(encoder, 42);
+                rc |= linearbuffers_record_payload_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+                rc |= linearbuffers_record_note_create(encoder, note);
+                rc |= linearbuffers_output_records_push(encoder, linearbuffers_record_end(encoder));
+        }
+        rc |= linearbuffers_output_records_set(encoder, linearbuffers_output_records_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static const void * relinearize_check (struct linearbuffers_relinearize *relinearize, const void *buffer, uint64_t length, const char *json, uint64_t *relinearized_length)
+{
+        int rc;
+        char *relinearized_json;
+        const void *relinearized;
+        const struct linearbuffers_output *output;
+        rc = linearbuffers_output_relinearize(relinearize, buffer, length);
+        if (rc != 0) {
+                fprintf(stderr, "can not relinearize buffer\n");
+                return NULL;
+        }
+        relinearized = linearbuffers_relinearize_linearized(relinearize, relinearized_length);
+        if (relinearized == NULL) {
+                fprintf(stderr, "can not get relinearized buffer\n");
+                return NULL;
+        }
+        if (linearbuffers_output_verify(relinearized, *relinearized_length, 8) != 0) {
+                fprintf(stderr, "verifier failed: linearbuffers_output_verify\n");
+                return NULL;
+        }
+        output = linearbuffers_output_decode(relinearized, *relinearized_length);
+        relinearized_json = linearbuffers_output_jsonify_string(output, LINEARBUFFERS_JSONIFY_FLAG_NONE);
+        if (relinearized_json == NULL ||
+            strcmp(relinearized_json, json) != 0) {
+                fprintf(stderr, "relinearize failed: content mismatch\n");
+                free(relinearized_json);
+                return NULL;
+        }
+        free(relinearized_json);
+        return relinearized;
+}
+
+static uint64_t position_of (const void *buffer, uint64_t length, uint64_t at)
+{
+        const struct linearbuffers_output *output;
+        output = linearbuffers_output_decode(buffer, length);
+        return (const uint8_t *) linearbuffers_output_records_get_at(output, at) - (const uint8_t *) buffer;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        int order;
+        int deduplicate;
+        char *json;
+        uint64_t first;
+        uint64_t last;
+        uint64_t profile[2];
+        uint64_t lengths[2];
+
+        uint64_t linearized_length;
+        const void *linearized_buffer;
+        uint64_t relinearized_length;
+        const void *relinearized_buffer;
+
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_relinearize *relinearize;
+        struct linearbuffers_relinearize_create_options options;
+
+        static const enum linearbuffers_relinearize_order orders[] = {
+                linearbuffers_relinearize_order_depth,
+                linearbuffers_relinearize_order_breadth,
+                linearbuffers_relinearize_order_profile
+        };
+
+        (void) argc;
+        (void) argv;
+
+        json = NULL;
+        relinearize = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        fprintf(stderr, "linearized: %p, length: %" PRIu64 "\n", linearized_buffer, linearized_length);
+        json = linearbuffers_output_jsonify_string(linearbuffers_output_decode(linearized_buffer, linearized_length), LINEARBUFFERS_JSONIFY_FLAG_NONE);
+        if (json == NULL) {
+                fprintf(stderr, "jsonify failed\n");
+                goto bail;
+        }
+
+        for (deduplicate = 0; deduplicate < 2; deduplicate++) {
+                for (order = 0; order < 3; order++) {
+                        profile[0] = position_of(linearized_buffer, linearized_length, NRECORDS - 1);
+                        profile[1] = position_of(linearized_buffer, linearized_length, NRECORDS - 2);
+                        memset(&options, 0, sizeof(struct linearbuffers_relinearize_create_options));
+                        options.order = orders[order];
+                        options.deduplicate = deduplicate;
+                        options.profile = profile;
+                        options.nprofile = 2;
+                        relinearize = linearbuffers_relinearize_create(&options);
+                        if (relinearize == NULL) {
+                                fprintf(stderr, "can not create relinearize\n");
+                                goto bail;
+                        }
+                        relinearized_buffer = relinearize_check(relinearize, linearized_buffer, linearized_length, json, &relinearized_length);
+                        if (relinearized_buffer == NULL) {
+                                goto bail;
+                        }
+                        fprintf(stderr, "order: %d, deduplicate: %d, length: %" PRIu64 "\n", orders[order], deduplicate, relinearized_length);
+                        if (relinearized_length >= linearized_length) {
+                                fprintf(stderr, "relinearize failed: absent fields are not trimmed\n");
+                                goto bail;
+                        }
+                        if (order == 0) {
+                                lengths[deduplicate] = relinearized_length;
+                        } else if (relinearized_length != lengths[deduplicate]) {
+                                fprintf(stderr, "relinearize failed: length depends on order\n");
+                                goto bail;
+                        }
+                        first = position_of(relinearized_buffer, relinearized_length, 0);
+                        last = position_of(relinearized_buffer, relinearized_length, NRECORDS - 1);
+                        if ((orders[order] == linearbuffers_relinearize_order_breadth && first > last) ||
+                            (orders[order] == linearbuffers_relinearize_order_profile && first < last) ||
+                            (orders[order] == linearbuffers_relinearize_order_profile && last > position_of(relinearized_buffer, relinearized_length, NRECORDS - 2))) {
+                                fprintf(stderr, "relinearize failed: order is not followed\n");
+                                goto bail;
+                        }
+                        linearbuffers_relinearize_destroy(relinearize);
+                        relinearize = NULL;
+                }
+        }
+        if (lengths[1] >= lengths[0]) {
+                fprintf(stderr, "relinearize failed: duplicates are not merged\n");
+                goto bail;
+        }
+
+        free(json);
+        json = NULL;
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc = encode_shared(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode shared output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        json = linearbuffers_output_jsonify_string(linearbuffers_output_decode(linearized_buffer, linearized_length), LINEARBUFFERS_JSONIFY_FLAG_NONE);
+        if (json == NULL) {
+                fprintf(stderr, "jsonify failed\n");
+                goto bail;
+        }
+        memset(&options, 0, sizeof(struct linearbuffers_relinearize_create_options));
+        options.deduplicate = 1;
+        relinearize = linearbuffers_relinearize_create(&options);
+        if (relinearize == NULL) {
+                fprintf(stderr, "can not create relinearize\n");
+                goto bail;
+        }
+        relinearized_buffer = relinearize_check(relinearize, linearized_buffer, linearized_length, json, &relinearized_length);
+        if (relinearized_buffer == NULL) {
+                goto bail;
+        }
+        fprintf(stderr, "shared: %" PRIu64 ", deduplicated: %" PRIu64 "\n", linearized_length, relinearized_length);
+        if (relinearized_length * 10 >= linearized_length) {
+                fprintf(stderr, "relinearize failed: shared objects are not merged\n");
+                goto bail;
+        }
+        linearbuffers_relinearize_destroy(relinearize);
+        relinearize = NULL;
+
+        free(json);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (relinearize != NULL) {
+                linearbuffers_relinearize_destroy(relinearize);
+        }
+        if (json != NULL) {
+                free(json);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,239 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int encode_item (struct linearbuffers_encoder *encoder, uint32_t id, const char *name, uint16_t weight)
+{
+        int rc;
+        rc  = old_item_start(encoder);
+        rc |= old_item_id_set(encoder, id);
+        rc |= old_item_name_create(encoder, name);
+        rc |= old_item_weight_set(encoder, weight);
+        return rc;
+}
+
+static int encode (struct linearbuffers_encoder *encoder, int full)
+{
+        int rc;
+        uint64_t i;
+        struct old_vec origin;
+        static const int16_t values[] = { -1, 2, -3, 4 };
+        static const char *tags[] = { "red", "green", "blue" };
+        origin.x = 1.5f;
+        origin.y = -2.5f;
+        rc  = old_record_start(encoder);
+        rc |= old_record_a_set(encoder, -8);
+        if (full) {
+                rc |= old_record_b_set(encoder, -16);
+        }
+        rc |= old_record_c_set(encoder, -32);
+        rc |= old_record_d_set(encoder, -64);
+        rc |= old_record_color_set(encoder, old_color_blue);
+        rc |= old_record_ratio_set(encoder, 0.25f);
+        rc |= old_record_origin_set(encoder, &origin);
+        rc |= old_record_name_create(encoder, "record");
+        rc |= old_record_values_create(encoder, values, 4);
+        rc |= old_record_widen_create(encoder, values, 4);
+        rc |= old_record_tags_create(encoder, tags, 3);
+        rc |= old_record_items_start(encoder);
+        for (i = 0; i < 3; i++) {
+                rc |= encode_item(encoder, i, tags[i], i * 10);
+                rc |= old_record_items_push(encoder, old_item_end(encoder));
+        }
+        rc |= old_record_items_set(encoder, old_record_items_end(encoder));
+        if (full) {
+                rc |= encode_item(encoder, 42, "primary", 7);
+                rc |= old_record_primary_set(encoder, old_item_end(encoder));
+                rc |= encode_item(encoder, 43, "payload", 8);
+                rc |= old_record_payload_item_set(encoder, old_item_end(encoder));
+        } else {
+                rc |= old_leaf_start(encoder);
+                rc |= old_leaf_value_set(encoder, 44);
+                rc |= old_record_payload_leaf_set(encoder, old_leaf_end(encoder));
+        }
+        rc |= old_record_legacy_set(encoder, 1234);
+        rc |= old_record_finish(encoder);
+        return rc;
+}
+
+static int check_item (const struct linearbuffers_item *item, uint64_t id, const char *name, uint16_t weight)
+{
+        if (item == NULL) {
+                return -1;
+        }
+        if (linearbuffers_item_id_get(item) != id ||
+            strcmp(linearbuffers_item_name_get_value(item), name) != 0 ||
+            linearbuffers_item_weight_get(item) != weight) {
+                return -1;
+        }
+        if (linearbuffers_item_flags_present(item) ||
+            linearbuffers_item_flags_get(item) != 3) {
+                return -1;
+        }
+        return 0;
+}
+
+static int check (const void *buffer, uint64_t length, int full)
+{
+        uint64_t i;
+        const struct linearbuffers_vec *origin;
+        const struct linearbuffers_record *record;
+        static const char *tags[] = { "red", "green", "blue" };
+        if (linearbuffers_record_verify(buffer, length, 8) != 0) {
+                fprintf(stderr, "verify failed\n");
+                return -1;
+        }
+        record = linearbuffers_record_decode(buffer, length);
+        if (record == NULL) {
+                fprintf(stderr, "decode failed\n");
+                return -1;
+        }
+        linearbuffers_record_jsonify(record, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+        if (linearbuffers_record_a_get(record) != -8 ||
+            linearbuffers_record_b_present(record) != full ||
+            (full && linearbuffers_record_b_get(record) != -16) ||
+            linearbuffers_record_c_get(record) != -32 ||
+            linearbuffers_record_d_get(record) != -64 ||
+            linearbuffers_record_color_get(record) != linearbuffers_color_blue) {
+                fprintf(stderr, "scalars failed\n");
+                return -1;
+        }
+        if (linearbuffers_record_ratio_get(record) != 0.25) {
+                fprintf(stderr, "ratio failed\n");
+                return -1;
+        }
+        origin = linearbuffers_record_origin_get(record);
+        if (origin == NULL ||
+            origin->x != 1.5f ||
+            origin->y != -2.5f) {
+                fprintf(stderr, "origin failed\n");
+                return -1;
+        }
+        if (strcmp(linearbuffers_record_name_get_value(record), "record") != 0) {
+                fprintf(stderr, "name failed\n");
+                return -1;
+        }
+        if (linearbuffers_record_values_get_count(record) != 4 ||
+            linearbuffers_record_values_get_at(record, 2) != -3 ||
+            linearbuffers_record_widen_get_count(record) != 4 ||
+            linearbuffers_record_widen_get_at(record, 0) != -1 ||
+            linearbuffers_record_widen_get_at(record, 3) != 4) {
+                fprintf(stderr, "vectors failed\n");
+                return -1;
+        }
+        if (linearbuffers_record_tags_get_count(record) != 3) {
+                fprintf(stderr, "tags failed\n");
+                return -1;
+        }
+        for (i = 0; i < 3; i++) {
+                if (strcmp(linearbuffers_record_tags_get_at(record, i), tags[i]) != 0) {
+                        fprintf(stderr, "tags failed\n");
+                        return -1;
+                }
+        }
+        if (linearbuffers_record_items_get_count(record) != 3) {
+                fprintf(stderr, "items failed\n");
+                return -1;
+        }
+        for (i = 0; i < 3; i++) {
+                if (check_item(linearbuffers_record_items_get_at(record, i), i, tags[i], i * 10) != 0) {
+                        fprintf(stderr, "items failed\n");
+                        return -1;
+                }
+        }
+        if (full) {
+                if (check_item(linearbuffers_record_primary_get(record), 42, "primary", 7) != 0 ||
+                    linearbuffers_record_payload_get_type(record) != linearbuffers_payload_type_item ||
+                    check_item(linearbuffers_record_payload_item_get(record), 43, "payload", 8) != 0) {
+                        fprintf(stderr, "tables failed\n");
+                        return -1;
+                }
+        } else {
+                if (linearbuffers_record_primary_present(record) ||
+                    linearbuffers_record_payload_get_type(record) != linearbuffers_payload_type_leaf ||
+                    linearbuffers_leaf_value_get(linearbuffers_record_payload_leaf_get(record)) != 44) {
+                        fprintf(stderr, "tables failed\n");
+                        return -1;
+                }
+        }
+        if (linearbuffers_record_legacy_present(record) ||
+            linearbuffers_record_extra_present(record) ||
+            linearbuffers_record_extra_get(record) != 7) {
+                fprintf(stderr, "dropped fields failed\n");
+                return -1;
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        int full;
+        void *old_buffer;
+        uint64_t old_length;
+        const void *linearized_buffer;
+        uint64_t linearized_length;
+        struct linearbuffers_encoder *encoder;
+
+        (void) argc;
+        (void) argv;
+
+        old_buffer = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        for (full = 0; full < 2; full++) {
+                linearbuffers_encoder_reset(encoder, NULL);
+                rc = encode(encoder, full);
+                if (rc != 0) {
+                        fprintf(stderr, "can not encode old record\n");
+                        goto bail;
+                }
+                linearized_buffer = linearbuffers_encoder_linearized(encoder, &old_length);
+                if (linearized_buffer == NULL) {
+                        fprintf(stderr, "can not get linearized buffer\n");
+                        goto bail;
+                }
+                old_buffer = malloc(old_length);
+                if (old_buffer == NULL) {
+                        fprintf(stderr, "can not allocate memory\n");
+                        goto bail;
+                }
+                memcpy(old_buffer, linearized_buffer, old_length);
+
+                linearbuffers_encoder_reset(encoder, NULL);
+                rc = linearbuffers_convert_record_to_record(encoder, old_buffer, old_length);
+                if (rc != 0) {
+                        fprintf(stderr, "can not convert record\n");
+                        goto bail;
+                }
+                linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+                if (linearized_buffer == NULL) {
+                        fprintf(stderr, "can not get linearized buffer\n");
+                        goto bail;
+                }
+                fprintf(stderr, "converted: %" PRIu64 " -> %" PRIu64 " bytes\n", old_length, linearized_length);
+                rc = check(linearized_buffer, linearized_length, full);
+                if (rc != 0) {
+                        fprintf(stderr, "converted record is invalid\n");
+                        goto bail;
+                }
+                free(old_buffer);
+                old_buffer = NULL;
+        }
+
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (old_buffer != NULL) {
+                free(old_buffer);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
@@ -0,0 +1,341 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <linearbuffers/reflect.h>
+
+static int encode_note (struct linearbuffers_encoder *encoder, linearbuffers_level_t level, const char *text, int weight)
+{
+        int rc;
+        rc  = linearbuffers_note_start(encoder);
+        rc |= linearbuffers_note_level_set(encoder, level);
+        rc |= linearbuffers_note_text_create(encoder, text);
+        if (weight >= 0) {
+                rc |= linearbuffers_note_weight_set(encoder, weight);
+        }
+        return rc;
+}
+
+static int encode (struct linearbuffers_encoder *encoder)
+{
+        int rc;
+        uint64_t i;
+        struct linearbuffers_point origin;
+        struct linearbuffers_point points[2];
+        static const int16_t samples[] = { -3, 0, 3 };
+        static const int32_t values[] = { 10, -20, 30, -40 };
+        static const char *names[] = { "zero", "one", "two" };
+        origin.x = -1;
+        origin.y = 2;
+        for (i = 0; i < 2; i++) {
+                points[i].x = i * 10;
+                points[i].y = -(i * 10);
+        }
+        rc  = linearbuffers_output_start(encoder);
+        rc |= linearbuffers_output_id_set(encoder, UINT64_C(0x123456789));
+        rc |= linearbuffers_output_ratio_set(encoder, 0.5);
+        rc |= linearbuffers_output_name_create(encoder, "output");
+        rc |= linearbuffers_output_origin_set(encoder, &origin);
+        rc |= linearbuffers_output_samples_set(encoder, samples);
+        rc |= linearbuffers_output_values_create(encoder, values, 4);
+        rc |= linearbuffers_output_names_create(encoder, names, 3);
+        rc |= linearbuffers_output_points_create(encoder, points, 2);
+        rc |= linearbuffers_output_notes_start(encoder);
+        for (i = 0; i < 3; i++) {
+                rc |= encode_note(encoder, linearbuffers_level_low + i, names[i], (i == 1) ? -1 : (int) i);
+                rc |= linearbuffers_output_notes_push(encoder, linearbuffers_note_end(encoder));
+        }
+        rc |= linearbuffers_output_notes_set(encoder, linearbuffers_output_notes_end(encoder));
+        rc |= encode_note(encoder, linearbuffers_level_mid, "primary", 9);
+        rc |= linearbuffers_output_primary_set(encoder, linearbuffers_note_end(encoder));
+        rc |= linearbuffers_leaf_start(encoder);
+        rc |= linearbuffers_leaf_value_set(encoder, 44);
+        rc |= linearbuffers_output_payload_leaf_set(encoder, linearbuffers_leaf_end(encoder));
+        rc |= linearbuffers_output_finish(encoder);
+        return rc;
+}
+
+static const struct linearbuffers_reflect_field * field (const struct linearbuffers_reflect_table *table, const char *name)
+{
+        const struct linearbuffers_reflect_field *field;
+        field = linearbuffers_reflect_table_field_lookup(table, name);
+        if (field == NULL) {
+                fprintf(stderr, "field: %s.%s not found\n", linearbuffers_reflect_table_name(table), name);
+        }
+        return field;
+}
+
+static int check_lookup (const struct linearbuffers_reflect *reflect)
+{
+        uint64_t i;
+        uint64_t j;
+        const struct linearbuffers_reflect_table *table;
+        const struct linearbuffers_reflect_field *field;
+        if (strcmp(linearbuffers_reflect_namespace(reflect), "linearbuffers") != 0 ||
+            linearbuffers_reflect_table_count(reflect) != 5 ||
+            strcmp(linearbuffers_reflect_table_name(linearbuffers_reflect_root(reflect)), "output") != 0) {
+                return -1;
+        }
+        for (i = 0; i < linearbuffers_reflect_table_count(reflect); i++) {
+                table = linearbuffers_reflect_table_at(reflect, i);
+                if (linearbuffers_reflect_table_lookup(reflect, linearbuffers_reflect_table_name(table)) != table ||
+                    linearbuffers_reflect_table_index(table) != i) {
+                        return -1;
+                }
+                for (j = 0; j < linearbuffers_reflect_table_field_count(table); j++) {
+                        field = linearbuffers_reflect_table_field_at(table, j);
+                        if (linearbuffers_reflect_table_field_lookup(table, linearbuffers_reflect_field_name(field)) != field ||
+                            linearbuffers_reflect_field_index(field) != j) {
+                                return -1;
+                        }
+                }
+        }
+        table = linearbuffers_reflect_table_lookup(reflect, "note");
+        if (linearbuffers_reflect_table_lookup(reflect, "unknown") != NULL ||
+            linearbuffers_reflect_table_field_lookup(table, "unknown") != NULL ||
+            linearbuffers_reflect_table_field_lookup(table, "id") != NULL) {
+                return -1;
+        }
+        if (!linearbuffers_reflect_table_is_compact(table) ||
+            linearbuffers_reflect_table_container(linearbuffers_reflect_table_lookup(reflect, "point")) != linearbuffers_reflect_container_struct ||
+            linearbuffers_reflect_table_container(linearbuffers_reflect_table_lookup(reflect, "payload")) != linearbuffers_reflect_container_union) {
+                return -1;
+        }
+        field = linearbuffers_reflect_table_field_lookup(table, "level");
+        if (linearbuffers_reflect_field_type(field) != linearbuffers_reflect_type_enum ||
+            linearbuffers_reflect_field_scalar_type(field) != linearbuffers_reflect_type_int8 ||
+            strcmp(linearbuffers_reflect_field_enum_name(field, -1), "low") != 0 ||
+            strcmp(linearbuffers_reflect_field_enum_name(field, 1), "high") != 0 ||
+            linearbuffers_reflect_field_enum_name(field, 2) != NULL) {
+                return -1;
+        }
+        return 0;
+}
+
+static int check_note (const struct linearbuffers_reflect_object *note, int64_t level, const char *text, uint64_t weight, int present)
+{
+        int rc;
+        int64_t ivalue;
+        uint64_t uvalue;
+        const char *string;
+        uint64_t length;
+        rc  = linearbuffers_reflect_object_get_int(note, field(note->table, "level"), &ivalue);
+        rc |= linearbuffers_reflect_object_get_string(note, field(note->table, "text"), &string, &length);
+        rc |= linearbuffers_reflect_object_get_uint(note, field(note->table, "weight"), &uvalue);
+        if (rc != 0 ||
+            ivalue != level ||
+            string == NULL ||
+            strcmp(string, text) != 0 ||
+            length != strlen(text) ||
+            uvalue != weight ||
+            linearbuffers_reflect_object_present(note, field(note->table, "weight")) != present) {
+                return -1;
+        }
+        return 0;
+}
+
+static int check (const struct linearbuffers_reflect *reflect, const void *buffer, uint64_t length)
+{
+        int rc;
+        uint64_t i;
+        int64_t ivalue;
+        uint64_t uvalue;
+        double fvalue;
+        uint64_t count;
+        const char *string;
+        const struct linearbuffers_reflect_table *table;
+        struct linearbuffers_reflect_object output;
+        struct linearbuffers_reflect_object object;
+        static const char *names[] = { "zero", "one", "two" };
+
+        rc = linearbuffers_reflect_object_root(reflect, NULL, buffer, length, &output);
+        if (rc != 0) {
+                fprintf(stderr, "root failed\n");
+                return -1;
+        }
+        table = output.table;
+
+        rc  = linearbuffers_reflect_object_get_uint(&output, field(table, "id"), &uvalue);
+        rc |= linearbuffers_reflect_object_get_float(&output, field(table, "ratio"), &fvalue);
+        if (rc != 0 ||
+            uvalue != UINT64_C(0x123456789) ||
+            fvalue != 0.5) {
+                fprintf(stderr, "scalars failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_int(&output, field(table, "level"), &ivalue);
+        if (rc != 0 ||
+            ivalue != linearbuffers_level_high ||
+            linearbuffers_reflect_object_present(&output, field(table, "level"))) {
+                fprintf(stderr, "enum default failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_int(&output, field(table, "missing"), &ivalue);
+        if (rc != 0 ||
+            ivalue != -7 ||
+            strcmp(linearbuffers_reflect_field_value(field(table, "missing")), "-7") != 0) {
+                fprintf(stderr, "default failed\n");
+                return -1;
+        }
+        rc = linearbuffers_reflect_object_get_string(&output, field(table, "name"), &string, NULL);
+        if (rc != 0 ||
+            string == NULL ||
+            strcmp(string, "output") != 0) {
+                fprintf(stderr, "string failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_object(&output, field(table, "origin"), &object);
+        rc |= linearbuffers_reflect_object_get_int(&object, field(object.table, "x"), &ivalue);
+        if (rc != 0 ||
+            ivalue != -1) {
+                fprintf(stderr, "struct failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_count(&output, field(table, "samples"), &count);
+        rc |= linearbuffers_reflect_object_get_int_at(&output, field(table, "samples"), 0, &ivalue);
+        if (rc != 0 ||
+            count != 3 ||
+            ivalue != -3 ||
+            linearbuffers_reflect_object_get_int_at(&output, field(table, "samples"), 3, &ivalue) == 0) {
+                fprintf(stderr, "array failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_count(&output, field(table, "values"), &count);
+        rc |= linearbuffers_reflect_object_get_int_at(&output, field(table, "values"), 3, &ivalue);
+        if (rc != 0 ||
+            count != 4 ||
+            ivalue != -40) {
+                fprintf(stderr, "vector failed\n");
+                return -1;
+        }
+        rc = linearbuffers_reflect_object_get_count(&output, field(table, "names"), &count);
+        if (rc != 0 ||
+            count != 3) {
+                fprintf(stderr, "names failed\n");
+                return -1;
+        }
+        for (i = 0; i < count; i++) {
+                rc = linearbuffers_reflect_object_get_string_at(&output, field(table, "names"), i, &string, NULL);
+                if (rc != 0 ||
+                    strcmp(string, names[i]) != 0) {
+                        fprintf(stderr, "names failed\n");
+                        return -1;
+                }
+        }
+        rc  = linearbuffers_reflect_object_get_object_at(&output, field(table, "points"), 1, &object);
+        rc |= linearbuffers_reflect_object_get_int(&object, field(object.table, "y"), &ivalue);
+        if (rc != 0 ||
+            ivalue != -10) {
+                fprintf(stderr, "points failed\n");
+                return -1;
+        }
+        rc = linearbuffers_reflect_object_get_count(&output, field(table, "notes"), &count);
+        if (rc != 0 ||
+            count != 3) {
+                fprintf(stderr, "notes failed\n");
+                return -1;
+        }
+        for (i = 0; i < count; i++) {
+                rc  = linearbuffers_reflect_object_get_object_at(&output, field(table, "notes"), i, &object);
+                rc |= check_note(&object, (int64_t) i - 1, names[i], (i == 1) ? 5 : i, i != 1);
+                if (rc != 0) {
+                        fprintf(stderr, "notes failed\n");
+                        return -1;
+                }
+        }
+        rc  = linearbuffers_reflect_object_get_object(&output, field(table, "primary"), &object);
+        rc |= check_note(&object, linearbuffers_level_mid, "primary", 9, 1);
+        if (rc != 0) {
+                fprintf(stderr, "primary failed\n");
+                return -1;
+        }
+        rc  = linearbuffers_reflect_object_get_uint(&output, field(table, "payload"), &uvalue);
+        rc |= linearbuffers_reflect_object_get_object(&output, field(table, "payload"), &object);
+        if (rc != 0 ||
+            uvalue != linearbuffers_payload_type_leaf ||
+            object.table != linearbuffers_reflect_table_lookup(reflect, "leaf")) {
+                fprintf(stderr, "union failed\n");
+                return -1;
+        }
+        rc = linearbuffers_reflect_object_get_uint(&object, field(object.table, "value"), &uvalue);
+        if (rc != 0 ||
+            uvalue != 44) {
+                fprintf(stderr, "union failed\n");
+                return -1;
+        }
+        if (linearbuffers_reflect_object_get_uint(&object, field(table, "id"), &uvalue) == 0 ||
+            linearbuffers_reflect_object_get_string(&output, field(table, "id"), &string, NULL) == 0) {
+                fprintf(stderr, "mismatch failed\n");
+                return -1;
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        const void *linearized_buffer;
+        uint64_t linearized_length;
+        struct linearbuffers_encoder *encoder;
+        struct linearbuffers_reflect *reflect;
+
+        (void) argc;
+        (void) argv;
+
+        encoder = NULL;
+        reflect = NULL;
+
+        if (linearbuffers_reflect_create(linearbuffers_reflect, linearbuffers_reflect_length / 2) != NULL) {
+                fprintf(stderr, "truncated reflect is accepted\n");
+                goto bail;
+        }
+        reflect = linearbuffers_reflect_create(linearbuffers_reflect, linearbuffers_reflect_length);
+        if (reflect == NULL) {
+                fprintf(stderr, "can not create linearbuffers reflect\n");
+                goto bail;
+        }
+        rc = check_lookup(reflect);
+        if (rc != 0) {
+                fprintf(stderr, "lookup failed\n");
+                goto bail;
+        }
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+        rc = encode(encoder);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode output\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        linearbuffers_output_jsonify(linearbuffers_output_decode(linearized_buffer, linearized_length), LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+
+        rc = check(reflect, linearized_buffer, linearized_length);
+        if (rc != 0) {
+                fprintf(stderr, "reflect check failed\n");
+                goto bail;
+        }
+        if (linearbuffers_reflect_object_root(reflect, NULL, linearized_buffer, 2, &(struct linearbuffers_reflect_object) { 0 }) == 0) {
+                fprintf(stderr, "truncated buffer is accepted\n");
+                goto bail;
+        }
+
+        linearbuffers_reflect_destroy(reflect);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (reflect != NULL) {
+                linearbuffers_reflect_destroy(reflect);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}
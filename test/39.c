@@ -0,0 +1,178 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int encode (struct linearbuffers_encoder *encoder, uint8_t last, int sparse)
+{
+        int rc;
+        rc  = linearbuffers_wide_start(encoder);
+        rc |= linearbuffers_wide_f03_set(encoder, 3);
+        rc |= linearbuffers_wide_f63_set(encoder, 63);
+        rc |= linearbuffers_wide_f64_set(encoder, 64);
+        rc |= linearbuffers_note_start(encoder);
+        rc |= linearbuffers_note_text_create(encoder, "note");
+        rc |= linearbuffers_wide_f65_set(encoder, linearbuffers_note_end(encoder));
+        rc |= linearbuffers_wide_f69_set(encoder, last);
+        if (!sparse) {
+                rc |= linearbuffers_wide_f00_set(encoder, 0);
+        }
+        rc |= linearbuffers_wide_finish(encoder);
+        return rc;
+}
+
+static int check (const struct linearbuffers_wide *wide)
+{
+        uint64_t i;
+        uint64_t mask;
+        uint64_t word;
+        uint64_t fields[8];
+        uint64_t nfields;
+        const struct linearbuffers_note *note;
+
+        if (linearbuffers_wide_field_f00 != 0 ||
+            linearbuffers_wide_field_f65 != 65 ||
+            linearbuffers_wide_field_COUNT != 70 ||
+            linearbuffers_note_field_value != 1 ||
+            linearbuffers_note_field_COUNT != 2) {
+                fprintf(stderr, "field constants failed\n");
+                return -1;
+        }
+        if (linearbuffers_wide_present_mask(wide, 0) != ((UINT64_C(1) << 3) | (UINT64_C(1) << 63)) ||
+            linearbuffers_wide_present_mask(wide, 1) != ((UINT64_C(1) << 0) | (UINT64_C(1) << 1) | (UINT64_C(1) << 5)) ||
+            linearbuffers_wide_present_mask(wide, 2) != 0) {
+                fprintf(stderr, "present mask failed\n");
+                return -1;
+        }
+
+        nfields = 0;
+        for (word = 0; word < (linearbuffers_wide_field_COUNT + 63) / 64; word++) {
+                mask = linearbuffers_wide_present_mask(wide, word);
+                while (mask != 0 && nfields < 8) {
+                        fields[nfields++] = word * 64 + __builtin_ctzll(mask);
+                        mask &= mask - 1;
+                }
+        }
+        if (nfields != 5 ||
+            fields[0] != linearbuffers_wide_field_f03 ||
+            fields[1] != linearbuffers_wide_field_f63 ||
+            fields[2] != linearbuffers_wide_field_f64 ||
+            fields[3] != linearbuffers_wide_field_f65 ||
+            fields[4] != linearbuffers_wide_field_f69) {
+                fprintf(stderr, "present iteration failed\n");
+                return -1;
+        }
+        for (i = 0; i < nfields; i++) {
+                fprintf(stderr, "present: %" PRIu64 "\n", fields[i]);
+        }
+
+        note = linearbuffers_wide_f65_get(wide);
+        if (note == NULL ||
+            linearbuffers_note_present_mask(note, 0) != (UINT64_C(1) << linearbuffers_note_field_text) ||
+            linearbuffers_note_present_mask(note, 1) != 0) {
+                fprintf(stderr, "compact present mask failed\n");
+                return -1;
+        }
+        return 0;
+}
+
+int main (int argc, char *argv[])
+{
+        int rc;
+        void *buffer;
+        uint64_t length;
+        const void *linearized_buffer;
+        uint64_t linearized_length;
+        const struct linearbuffers_wide *wide;
+        struct linearbuffers_encoder *encoder;
+
+        (void) argc;
+        (void) argv;
+
+        buffer = NULL;
+
+        encoder = linearbuffers_encoder_create(NULL);
+        if (encoder == NULL) {
+                fprintf(stderr, "can not create linearbuffers encoder\n");
+                goto bail;
+        }
+
+        rc = encode(encoder, 69, 1);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode wide\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &length);
+        if (linearized_buffer == NULL) {
+                fprintf(stderr, "can not get linearized buffer\n");
+                goto bail;
+        }
+        buffer = malloc(length);
+        if (buffer == NULL) {
+                fprintf(stderr, "can not allocate memory\n");
+                goto bail;
+        }
+        memcpy(buffer, linearized_buffer, length);
+
+        wide = linearbuffers_wide_decode(buffer, length);
+        if (wide == NULL) {
+                fprintf(stderr, "decode failed\n");
+                goto bail;
+        }
+        linearbuffers_wide_jsonify(wide, LINEARBUFFERS_JSONIFY_FLAG_DEFAULT, (int (*) (void *context, const char *fmt, ...)) fprintf, stderr);
+        rc = check(wide);
+        if (rc != 0) {
+                fprintf(stderr, "check failed\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc = encode(encoder, 69, 1);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode wide\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL ||
+            !linearbuffers_wide_equal(wide, linearbuffers_wide_decode(linearized_buffer, linearized_length))) {
+                fprintf(stderr, "equal failed\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc = encode(encoder, 70, 1);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode wide\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL ||
+            linearbuffers_wide_equal(wide, linearbuffers_wide_decode(linearized_buffer, linearized_length))) {
+                fprintf(stderr, "value not equal failed\n");
+                goto bail;
+        }
+
+        linearbuffers_encoder_reset(encoder, NULL);
+        rc = encode(encoder, 69, 0);
+        if (rc != 0) {
+                fprintf(stderr, "can not encode wide\n");
+                goto bail;
+        }
+        linearized_buffer = linearbuffers_encoder_linearized(encoder, &linearized_length);
+        if (linearized_buffer == NULL ||
+            linearbuffers_wide_equal(wide, linearbuffers_wide_decode(linearized_buffer, linearized_length))) {
+                fprintf(stderr, "present not equal failed\n");
+                goto bail;
+        }
+
+        free(buffer);
+        linearbuffers_encoder_destroy(encoder);
+        return 0;
+bail:   if (buffer != NULL) {
+                free(buffer);
+        }
+        if (encoder != NULL) {
+                linearbuffers_encoder_destroy(encoder);
+        }
+        return -1;
+}